@@ -108,7 +108,7 @@ static int a9g_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(A9G_IEMI_RESP_SIZE, 0, A9G_INFO_RESP_TIMO);
+    resp = at_device_resp_get(device, A9G_IEMI_RESP_SIZE, 0, A9G_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -218,7 +218,7 @@ static int a9g_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -243,7 +243,7 @@ static void check_link_status_entry(void *parameter)
         return;
     }
 
-    resp = at_create_resp(A9G_LINK_RESP_SIZE, 0, A9G_LINK_RESP_TIMO);
+    resp = at_device_resp_get(device, A9G_LINK_RESP_SIZE, 0, A9G_LINK_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for response create.");
@@ -364,7 +364,7 @@ static int a9g_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip_
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(a9g_DNS_RESP_LEN, 0, a9g_DNS_RESP_TIMEO);
+    resp = at_device_resp_get(device, a9g_DNS_RESP_LEN, 0, a9g_DNS_RESP_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_D("a9g set dns server failed, no memory for response object.");
@@ -384,7 +384,7 @@ static int a9g_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip_
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -397,7 +397,7 @@ static int a9g_ping_domain_resolve(struct at_device *device, const char *name, c
     at_response_t resp = RT_NULL;
 
     /* The maximum response time is 14 seconds, affected by network status */
-    resp = at_create_resp(512, 4, 14 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 512, 4, 14 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for a9g device(%s) response structure.", device->name);
@@ -436,7 +436,7 @@ static int a9g_ping_domain_resolve(struct at_device *device, const char *name, c
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -522,7 +522,11 @@ static struct netdev *a9g_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, resp_line, timeout, cmd)                                         \
     do {                                                                                           \
-        (resp) = at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout));    \
+        if (at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout)) == RT_NULL) \
+        {                                                                                          \
+            result = -RT_ENOMEM;                                                                   \
+            goto __exit;                                                                           \
+        }                                                                                          \
         if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                                          \
         {                                                                                          \
             result = -RT_ERROR;                                                                    \
@@ -546,7 +550,7 @@ static void a9g_init_thread_entry(void *parameter)
     struct at_device *device = (struct at_device *)parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for a9g device(%s) response structure.", device->name);
@@ -630,7 +634,11 @@ static void a9g_init_thread_entry(void *parameter)
         /* the device default response timeout is 40 seconds, but it set to 15 seconds is convenient to use. */
         for (uint8_t ii = 0; ii < INIT_RETRY; ii++)
         {
-            resp = at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(10 * 1000));
+            if (at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(10 * 1000)) == RT_NULL)
+            {
+                result = -RT_ENOMEM;
+                goto __exit;
+            }
             if (at_obj_exec_cmd(client, resp, "AT+CGATT=0") == RT_EOK)
             {
                 break;
@@ -644,7 +652,11 @@ static void a9g_init_thread_entry(void *parameter)
             for (uint8_t ii = 0; ii < INIT_RETRY; ii++)
             {
                 //AT_SEND_CMD(client, resp, 0, 5 * 1000, "AT+CGATT=1");
-                resp = at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(10 * 1000));
+                if (at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(10 * 1000)) == RT_NULL)
+                {
+                    result = -RT_ENOMEM;
+                    goto __exit;
+                }
                 if (at_obj_exec_cmd(client, resp, "AT+CGATT=1") == RT_EOK)
                 {
                     break;
@@ -756,7 +768,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result == RT_EOK)
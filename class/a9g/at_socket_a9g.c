@@ -18,10 +18,9 @@
 
 #if defined(AT_DEVICE_USING_A9G) && defined(AT_USING_SOCKET)
 
+#if !defined (A9G_MODULE_SEND_MAX_SIZE)
 #define A9G_MODULE_SEND_MAX_SIZE   1000
-
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
+#endif
 
 /* AT socket event type */
 #define A9G_EVENT_CONN_OK          (1L << 0)
@@ -36,25 +35,6 @@ static at_evt_cb_t at_evt_cb_set[] = {
         [AT_SOCKET_EVT_CLOSED] = NULL,
 };
 
-static int a9g_socket_event_send(struct at_device *device, uint32_t event)
-{
-    return (int) rt_event_send(device->socket_event, event);
-}
-
-static int a9g_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option)
-{
-    int result = RT_EOK;
-    rt_uint32_t recved;
-
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
-    if (result != RT_EOK)
-    {
-        return -RT_ETIMEOUT;
-    }
-
-    return recved;
-}
-
 /**
  * close socket by AT commands.
  *
@@ -72,7 +52,7 @@ static int a9g_socket_close(struct at_socket *socket)
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(600));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(600));
 
     if (resp == RT_NULL)
     {
@@ -80,7 +60,7 @@ static int a9g_socket_close(struct at_socket *socket)
         return -RT_ENOMEM;
     }
 
-    if (at_obj_exec_cmd(device->client, resp, "AT+CIPCLOSE=%d", device_socket) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CIPCLOSE=%d", device_socket) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -89,7 +69,7 @@ static int a9g_socket_close(struct at_socket *socket)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -112,7 +92,6 @@ __exit:
  */
 static int a9g_socket_connect(struct at_socket *socket, char *ip, int32_t port, enum at_socket_type type, rt_bool_t is_client)
 {
-    uint32_t event = 0;
     rt_bool_t retryed = RT_FALSE;
     at_response_t resp = RT_NULL;
     int result = RT_EOK, event_result = 0;
@@ -122,7 +101,7 @@ static int a9g_socket_connect(struct at_socket *socket, char *ip, int32_t port,
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for a9g device(%s) response structure.", device->name);
@@ -132,8 +111,7 @@ static int a9g_socket_connect(struct at_socket *socket, char *ip, int32_t port,
 __retry:
 
     /* clear socket connect event */
-    event = SET_EVENT(device_socket, A9G_EVENT_CONN_OK | A9G_EVENT_CONN_FAIL);
-    a9g_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, A9G_EVENT_CONN_OK | A9G_EVENT_CONN_FAIL, 0, RT_EVENT_FLAG_OR);
 
     if (is_client)
     {
@@ -141,7 +119,7 @@ __retry:
         {
         case AT_SOCKET_TCP:
             /* send AT commands(eg: AT+QIOPEN=0,"TCP","x.x.x.x", 1234) to connect TCP server */
-            if (at_obj_exec_cmd(device->client, RT_NULL, "AT+CIPSTART=\"TCP\",\"%s\",%d", ip, port) < 0)
+            if (at_device_exec_cmd(device, RT_NULL, "AT+CIPSTART=\"TCP\",\"%s\",%d", ip, port) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -149,7 +127,7 @@ __retry:
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, RT_NULL, "AT+CIPSTART=\"UDP\",\"%s\",%d", ip, port) < 0)
+            if (at_device_exec_cmd(device, RT_NULL, "AT+CIPSTART=\"UDP\",\"%s\",%d", ip, port) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -164,15 +142,8 @@ __retry:
             }
 
     /* waiting result event from AT URC, the device default connection timeout is 75 seconds, but it set to 10 seconds is convenient to use */
-    if (a9g_socket_event_recv(device, SET_EVENT(device_socket, 0), 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-    {
-        LOG_E("a9g device(%s) socket(%d) connect failed, wait connect result timeout.",device->name, device_socket);
-        result = -RT_ETIMEOUT;
-        goto __exit;
-    }
-    /* waiting OK or failed result */
-    event_result = a9g_socket_event_recv(device,
-            A9G_EVENT_CONN_OK | A9G_EVENT_CONN_FAIL, 1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+    event_result = at_device_socket_event_recv(device, device_socket, A9G_EVENT_CONN_OK | A9G_EVENT_CONN_FAIL,
+                                               10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
     if (event_result < 0)
     {
         LOG_E("a9g device(%s) socket(%d) connect failed, wait connect OK|FAIL timeout.", device->name, device_socket);
@@ -192,6 +163,7 @@ __retry:
                 goto __exit;
             }
             retryed = RT_TRUE;
+            AT_DEVICE_STATS_INC(device, retries);
             goto __retry;
         }
         LOG_E("a9g device(%s) socket(%d) connect failed.", device->name, device_socket);
@@ -202,7 +174,7 @@ __retry:
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -232,7 +204,7 @@ static int a9g_socket_send(struct at_socket *socket, const char *buff, size_t bf
 
     RT_ASSERT(buff);
 
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 2, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for a9g device(%s) response structure.", device->name);
@@ -256,7 +228,7 @@ static int a9g_socket_send(struct at_socket *socket, const char *buff, size_t bf
         }
 
         /* send the "AT+CIPSEND" commands to AT server than receive the '>' response on the first line. */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -272,13 +244,14 @@ static int a9g_socket_send(struct at_socket *socket, const char *buff, size_t bf
 
         /* waiting OK or failed result */
         at_resp_set_info(resp, 128, 0, 30 * RT_TICK_PER_SECOND);
-        if (at_obj_exec_cmd(device->client, resp, "") < 0)
+        if (at_device_exec_cmd(device, resp, "") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
         }
         at_resp_set_info(resp, 128, 2, 5 * RT_TICK_PER_SECOND);
 
+        at_device_stats_send(device, device_socket, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -290,7 +263,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -299,6 +272,7 @@ __exit:
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -307,27 +281,19 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int a9g_domain_resolve(const char *name, char ip[16])
+static int a9g_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
 #define RESOLVE_RETRY                  5
 
     int i, result = RT_EOK;
     char recv_ip[16] = { 0 };
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first initialization a9g device failed.");
-        return -RT_ERROR;
-    }
-
     /* The maximum response time is 14 seconds, affected by network status */
-    resp = at_create_resp(1024, 3, 14 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 1024, 3, 14 * RT_TICK_PER_SECOND);
 
     if (resp == RT_NULL)
     {
@@ -339,7 +305,7 @@ static int a9g_domain_resolve(const char *name, char ip[16])
     {
         int err_code = 0;
 
-        if (at_obj_exec_cmd(device->client, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -382,7 +348,7 @@ static int a9g_domain_resolve(const char *name, char ip[16])
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -410,7 +376,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get a9g device by client name(%s) failed.", client_name);
@@ -422,11 +388,11 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
 
     if (strstr(data, "CONNECT OK"))
     {
-        a9g_socket_event_send(device, SET_EVENT(device_socket, A9G_EVENT_CONN_OK));
+        at_device_socket_event_send(device, device_socket, A9G_EVENT_CONN_OK);
     }
     else if (strstr(data, "CONNECT FAIL"))
     {
-        a9g_socket_event_send(device, SET_EVENT(device_socket, A9G_EVENT_CONN_FAIL));
+        at_device_socket_event_send(device, device_socket, A9G_EVENT_CONN_FAIL);
     }
 }
 
@@ -438,7 +404,7 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get a9g device by client name(%s) failed.", client_name);
@@ -450,11 +416,11 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     if (rt_strstr(data, "SEND OK"))
     {
-        a9g_socket_event_send(device, SET_EVENT(device_socket, A9G_EVENT_SEND_OK));
+        at_device_socket_event_send(device, device_socket, A9G_EVENT_SEND_OK);
     }
     else if (rt_strstr(data, "SEND FAIL"))
     {
-        a9g_socket_event_send(device, SET_EVENT(device_socket, A9G_EVENT_SEND_FAIL));
+        at_device_socket_event_send(device, device_socket, A9G_EVENT_SEND_FAIL);
     }
 }
 
@@ -466,7 +432,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get a9g device by client name(%s) failed.", client_name);
@@ -478,7 +444,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     if (rt_strstr(data, "CLOSE OK"))
     {
-        a9g_socket_event_send(device, SET_EVENT(device_socket, A9G_EVENT_CLOSE_OK));
+        at_device_socket_event_send(device, device_socket, A9G_EVENT_CLOSE_OK);
     }
     else if (rt_strstr(data, "CLOSED"))
     {
@@ -519,14 +485,14 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get a9g device by client name(%s) failed.", client_name);
         return;
     }
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    recv_buf = (char *) at_device_recv_buf_alloc(device, bfsz);
     if (recv_buf == RT_NULL)
     {
         LOG_E("no memory for a9g device(%s) URC receive buffer (%d).", device->name, bfsz);
@@ -561,6 +527,8 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     socket = &(device->sockets[device_socket]);
 
     /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
@@ -582,7 +550,7 @@ static const struct at_socket_ops a9g_socket_ops =
     a9g_socket_connect,
     a9g_socket_close,
     a9g_socket_send,
-    a9g_domain_resolve,
+    RT_NULL,
     a9g_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
@@ -605,6 +573,7 @@ int a9g_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_A9G_SOCKETS_NUM;
     class->socket_ops = &a9g_socket_ops;
+    class->domain_resolve = a9g_domain_resolve;
 
     return RT_EOK;
 }
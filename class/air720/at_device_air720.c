@@ -93,7 +93,7 @@ static int air720_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(air720_IEMI_RESP_SIZE, 0, air720_INFO_RESP_TIMO);
+    resp = at_device_resp_get(device, air720_IEMI_RESP_SIZE, 0, air720_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("air720 device(%s) set IP address failed, no memory for response object.", device->name);
@@ -201,7 +201,7 @@ static int air720_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -239,7 +239,7 @@ static void check_link_status_entry(void *parameter)
         return;
     }
     air720 = (struct at_device_air720 *)device->user_data;
-    resp = at_create_resp(air720_LINK_RESP_SIZE, 0, air720_LINK_RESP_TIMO);
+    resp = at_device_resp_get(device, air720_LINK_RESP_SIZE, 0, air720_LINK_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("air720 device(%s) set check link status failed, no memory for response object.", device->name);
@@ -383,7 +383,7 @@ static int air720_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(air720_DNS_RESP_LEN, 0, air720_DNS_RESP_TIMEO);
+    resp = at_device_resp_get(device, air720_DNS_RESP_LEN, 0, air720_DNS_RESP_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_D("air720 set dns server failed, no memory for response object.");
@@ -403,7 +403,7 @@ static int air720_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -416,7 +416,7 @@ static int air720_ping_domain_resolve(struct at_device *device, const char *name
     at_response_t resp = RT_NULL;
 
     /* The maximum response time is 14 seconds, affected by network status */
-    resp = at_create_resp(128, 4, 14 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 4, 14 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for air720 device(%s) response structure.", device->name);
@@ -450,7 +450,7 @@ static int air720_ping_domain_resolve(struct at_device *device, const char *name
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -505,7 +505,7 @@ static int air720_netdev_ping(struct netdev *netdev, const char *host, size_t da
         rt_memset(ip_addr, 0x00, air720_PING_IP_SIZE);
     }
 
-    resp = at_create_resp(air720_PING_RESP_SIZE, 0, air720_PING_TIMEO);
+    resp = at_device_resp_get(device, air720_PING_RESP_SIZE, 0, air720_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("air720 device(%s) set dns server failed, no memory for response object.", device->name);
@@ -555,7 +555,7 @@ static int air720_netdev_ping(struct netdev *netdev, const char *host, size_t da
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -625,7 +625,11 @@ static struct netdev *air720_netdev_add(const char *netdev_name)
 #define AT_SEND_CMD(client, resp, resp_line, timeout, cmd)                                      \
     do                                                                                          \
     {                                                                                           \
-        (resp) = at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout)); \
+        if (at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout)) == RT_NULL) \
+        {                                                                                       \
+            result = -RT_ENOMEM;                                                                \
+            goto __exit;                                                                        \
+        }                                                                                       \
         if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                                       \
         {                                                                                       \
             result = -RT_ERROR;                                                                 \
@@ -651,7 +655,7 @@ static void air720_init_thread_entry(void *parameter)
     struct at_device *device = (struct at_device *)parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for air720 device(%s) response structure.", device->name);
@@ -823,7 +827,7 @@ static void air720_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result == RT_EOK)
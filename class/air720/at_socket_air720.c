@@ -22,10 +22,9 @@
 
 #if defined(AT_DEVICE_USING_AIR720) && defined(AT_USING_SOCKET)
 
+#if !defined (AIR720_MODULE_SEND_MAX_SIZE)
 #define AIR720_MODULE_SEND_MAX_SIZE 1000
-
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event) (((socket + 1) << 16) | (event))
+#endif
 
 /* AT socket event type */
 #define AIR720_EVENT_CONN_OK (1L << 0)
@@ -40,25 +39,6 @@ static at_evt_cb_t at_evt_cb_set[] = {
     [AT_SOCKET_EVT_CLOSED] = NULL,
 };
 
-static int air720_socket_event_send(struct at_device *device, uint32_t event)
-{
-    return (int)rt_event_send(device->socket_event, event);
-}
-
-static int air720_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option)
-{
-    int result = RT_EOK;
-    rt_uint32_t recved;
-
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
-    if (result != RT_EOK)
-    {
-        return -RT_ETIMEOUT;
-    }
-
-    return recved;
-}
-
 /**
  * close socket by AT commands.
  *
@@ -71,22 +51,20 @@ static int air720_socket_event_recv(struct at_device *device, uint32_t event, ui
  */
 static int air720_socket_close(struct at_socket *socket)
 {
-    uint32_t event = 0;
     int result = RT_EOK;
     int device_socket = (int)socket->user_data;
     struct at_device *device = (struct at_device *)socket->device;
 
     /* clear socket close event */
-    event = SET_EVENT(device_socket, AIR720_EVNET_CLOSE_OK);
-    air720_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, AIR720_EVNET_CLOSE_OK, 0, RT_EVENT_FLAG_OR);
 
-    if (at_obj_exec_cmd(device->client, NULL, "AT+CIPCLOSE=%d", device_socket) < 0)
+    if (at_device_exec_cmd(device, NULL, "AT+CIPCLOSE=%d", device_socket) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
     }
 
-    if (air720_socket_event_recv(device, event, rt_tick_from_millisecond(300 * 3), RT_EVENT_FLAG_AND) < 0)
+    if (at_device_socket_event_recv(device, device_socket, AIR720_EVNET_CLOSE_OK, rt_tick_from_millisecond(300 * 3), RT_EVENT_FLAG_AND) < 0)
     {
         LOG_E("air720 device(%s) socket(%d) close failed, wait close OK timeout.", device->name, device_socket);
         result = -RT_ETIMEOUT;
@@ -113,7 +91,6 @@ __exit:
  */
 static int air720_socket_connect(struct at_socket *socket, char *ip, int32_t port, enum at_socket_type type, rt_bool_t is_client)
 {
-    uint32_t event = 0;
     rt_bool_t retryed = RT_FALSE;
     at_response_t resp = RT_NULL;
     int result = RT_EOK, event_result = 0;
@@ -123,7 +100,7 @@ static int air720_socket_connect(struct at_socket *socket, char *ip, int32_t por
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for air720 device(%s) response structure.", device->name);
@@ -133,8 +110,7 @@ static int air720_socket_connect(struct at_socket *socket, char *ip, int32_t por
 __retry:
 
     /* clear socket connect event */
-    event = SET_EVENT(device_socket, AIR720_EVENT_CONN_OK | AIR720_EVENT_CONN_FAIL);
-    air720_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, AIR720_EVENT_CONN_OK | AIR720_EVENT_CONN_FAIL, 0, RT_EVENT_FLAG_OR);
 
     if (is_client)
     {
@@ -142,8 +118,8 @@ __retry:
         {
         case AT_SOCKET_TCP:
             /* send AT commands(eg: AT+QIOPEN=0,"TCP","x.x.x.x", 1234) to connect TCP server */
-            if (at_obj_exec_cmd(device->client, RT_NULL,
-                                "AT+CIPSTART=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
+            if (at_device_exec_cmd(device, RT_NULL,
+                                   "AT+CIPSTART=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -151,8 +127,8 @@ __retry:
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, RT_NULL,
-                                "AT+CIPSTART=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
+            if (at_device_exec_cmd(device, RT_NULL,
+                                   "AT+CIPSTART=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -167,15 +143,8 @@ __retry:
     }
 
     /* waiting result event from AT URC, the device default connection timeout is 75 seconds, but it set to 10 seconds is convenient to use */
-    if (air720_socket_event_recv(device, SET_EVENT(device_socket, 0), 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-    {
-        LOG_E("air720 device(%s) socket(%d) connect failed, wait connect result timeout.", device->name, device_socket);
-        result = -RT_ETIMEOUT;
-        goto __exit;
-    }
-    /* waiting OK or failed result */
-    event_result = air720_socket_event_recv(device,
-                                            AIR720_EVENT_CONN_OK | AIR720_EVENT_CONN_FAIL, 1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+    event_result = at_device_socket_event_recv(device, device_socket, AIR720_EVENT_CONN_OK | AIR720_EVENT_CONN_FAIL,
+                                               10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
     if (event_result < 0)
     {
         LOG_E("air720 device(%s) socket(%d) connect failed, wait connect OK|FAIL timeout.", device->name, device_socket);
@@ -195,6 +164,7 @@ __retry:
                 goto __exit;
             }
             retryed = RT_TRUE;
+            AT_DEVICE_STATS_INC(device, retries);
             goto __retry;
         }
         LOG_E("air720 device(%s) socket(%d) connect failed.", device->name, device_socket);
@@ -205,7 +175,7 @@ __retry:
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result != RT_EOK)
@@ -230,7 +200,6 @@ __exit:
  */
 static int air720_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
 {
-    uint32_t event = 0;
     int result = RT_EOK, event_result = 0;
     size_t cur_pkt_size = 0, sent_size = 0;
     at_response_t resp = RT_NULL;
@@ -240,7 +209,7 @@ static int air720_socket_send(struct at_socket *socket, const char *buff, size_t
 
     RT_ASSERT(buff);
 
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 2, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for air720 device(%s) response structure.", device->name);
@@ -250,8 +219,7 @@ static int air720_socket_send(struct at_socket *socket, const char *buff, size_t
     rt_mutex_take(lock, RT_WAITING_FOREVER);
 
     /* clear socket connect event */
-    event = SET_EVENT(device_socket, AIR720_EVENT_SEND_OK | AIR720_EVENT_SEND_FAIL);
-    air720_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, AIR720_EVENT_SEND_OK | AIR720_EVENT_SEND_FAIL, 0, RT_EVENT_FLAG_OR);
 
     /* set AT client end sign to deal with '>' sign.*/
     at_obj_set_end_sign(device->client, '>');
@@ -268,7 +236,7 @@ static int air720_socket_send(struct at_socket *socket, const char *buff, size_t
         }
 
         /* send the "AT+QISEND" commands to AT server than receive the '>' response on the first line. */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -283,15 +251,8 @@ static int air720_socket_send(struct at_socket *socket, const char *buff, size_t
         }
 
         /* waiting result event from AT URC */
-        if (air720_socket_event_recv(device, SET_EVENT(device_socket, 0), 15 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-        {
-            LOG_E("air720 device(%s) socket(%d) send failed, wait connect result timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-        /* waiting OK or failed result */
-        event_result = air720_socket_event_recv(device,
-                                                AIR720_EVENT_SEND_OK | AIR720_EVENT_SEND_FAIL, 5 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+        event_result = at_device_socket_event_recv(device, device_socket, AIR720_EVENT_SEND_OK | AIR720_EVENT_SEND_FAIL,
+                                                   15 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
         if (event_result < 0)
         {
             LOG_E("air720 device(%s) socket(%d) send failed, wait connect OK|FAIL timeout.", device->name, device_socket);
@@ -306,6 +267,7 @@ static int air720_socket_send(struct at_socket *socket, const char *buff, size_t
             goto __exit;
         }
 
+        at_device_stats_send(device, device_socket, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -317,7 +279,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result > 0 ? sent_size : result;
@@ -326,6 +288,7 @@ __exit:
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -334,27 +297,19 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int air720_domain_resolve(const char *name, char ip[16])
+static int air720_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
 #define RESOLVE_RETRY 5
 
     int i, result = RT_EOK;
     char recv_ip[16] = {0};
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first initialization air720 device failed.");
-        return -RT_ERROR;
-    }
-
     /* The maximum response time is 14 seconds, affected by network status */
-    resp = at_create_resp(128, 4, 14 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 4, 14 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for air720 device(%s) response structure.", device->name);
@@ -365,7 +320,7 @@ static int air720_domain_resolve(const char *name, char ip[16])
     {
         int err_code = 0;
 
-        if (at_obj_exec_cmd(device->client, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -408,7 +363,7 @@ static int air720_domain_resolve(const char *name, char ip[16])
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -436,7 +391,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get air720 device by client name(%s) failed.", client_name);
@@ -448,11 +403,11 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
 
     if (strstr(data, "CONNECT OK"))
     {
-        air720_socket_event_send(device, SET_EVENT(device_socket, AIR720_EVENT_CONN_OK));
+        at_device_socket_event_send(device, device_socket, AIR720_EVENT_CONN_OK);
     }
     else if (strstr(data, "CONNECT FAIL"))
     {
-        air720_socket_event_send(device, SET_EVENT(device_socket, AIR720_EVENT_CONN_FAIL));
+        at_device_socket_event_send(device, device_socket, AIR720_EVENT_CONN_FAIL);
     }
 }
 
@@ -464,7 +419,7 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get air720 device by client name(%s) failed.", client_name);
@@ -476,11 +431,11 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     if (rt_strstr(data, "SEND OK"))
     {
-        air720_socket_event_send(device, SET_EVENT(device_socket, AIR720_EVENT_SEND_OK));
+        at_device_socket_event_send(device, device_socket, AIR720_EVENT_SEND_OK);
     }
     else if (rt_strstr(data, "SEND FAIL"))
     {
-        air720_socket_event_send(device, SET_EVENT(device_socket, AIR720_EVENT_SEND_FAIL));
+        at_device_socket_event_send(device, device_socket, AIR720_EVENT_SEND_FAIL);
     }
 }
 
@@ -492,7 +447,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get air720 device by client name(%s) failed.", client_name);
@@ -504,7 +459,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     if (rt_strstr(data, "CLOSE OK"))
     {
-        air720_socket_event_send(device, SET_EVENT(device_socket, AIR720_EVNET_CLOSE_OK));
+        at_device_socket_event_send(device, device_socket, AIR720_EVNET_CLOSE_OK);
     }
     else if (rt_strstr(data, "CLOSED"))
     {
@@ -545,14 +500,14 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get air720 device by client name(%s) failed.", client_name);
         return;
     }
 
-    recv_buf = (char *)rt_calloc(1, bfsz);
+    recv_buf = (char *) at_device_recv_buf_alloc(device, bfsz);
     if (recv_buf == RT_NULL)
     {
         LOG_E("no memory for air720 device(%s) URC receive buffer (%d).", device->name, bfsz);
@@ -584,6 +539,8 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     socket = &(device->sockets[device_socket]);
 
     /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
@@ -602,7 +559,7 @@ static void urc_dataaccept_func(struct at_client *client, const char *data, rt_s
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get air720 device by client name(%s) failed.", client_name);
@@ -612,7 +569,7 @@ static void urc_dataaccept_func(struct at_client *client, const char *data, rt_s
     /* get the current socket by receive data */
     rt_sscanf(data, "DATA ACCEPT:%d,%d", &device_socket, (int *)&bfsz);
 
-    air720_socket_event_send(device, SET_EVENT(device_socket, AIR720_EVENT_SEND_OK));
+    at_device_socket_event_send(device, device_socket, AIR720_EVENT_SEND_OK);
 }
 
 //DATA ACCEPT:
@@ -635,7 +592,7 @@ static const struct at_socket_ops air720_socket_ops =
     air720_socket_connect,
     air720_socket_close,
     air720_socket_send,
-    air720_domain_resolve,
+    RT_NULL,
     air720_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
@@ -658,6 +615,7 @@ int air720_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_AIR720_SOCKETS_NUM;
     class->socket_ops = &air720_socket_ops;
+    class->domain_resolve = air720_domain_resolve;
 
     return RT_EOK;
 }
@@ -47,7 +47,7 @@ static int bc26_power_off(struct at_device *device)
     at_response_t resp = RT_NULL;
     struct at_device_bc26 *bc26 = RT_NULL;
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_D("no memory for resp create.");
@@ -57,11 +57,11 @@ static int bc26_power_off(struct at_device *device)
     if (at_obj_exec_cmd(device->client, resp, "AT+QPOWD=0") != RT_EOK)
     {
         LOG_D("power off fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return (-RT_ERROR);
     }
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
 
     bc26 = (struct at_device_bc26 *)device->user_data;
     bc26->power_status = RT_FALSE;
@@ -84,7 +84,7 @@ static int bc26_sleep(struct at_device *device)
         return (RT_EOK);
     }
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_D("no memory for resp create.");
@@ -96,7 +96,7 @@ static int bc26_sleep(struct at_device *device)
 
     {
         LOG_D("enable sleep fail.\"AT+QSCLK=1\" execute fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return (-RT_ERROR);
     }
 
@@ -105,20 +105,20 @@ static int bc26_sleep(struct at_device *device)
 
     {
         LOG_D("enable sleep fail.\"AT+CPSMS=1...\" execute fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return (-RT_ERROR);
     }
 
     if (at_obj_exec_cmd(device->client, resp, "AT+QRELLOCK") != RT_EOK)
     {
         LOG_D("startup entry into sleep fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return (-RT_ERROR);
     }
 
     bc26->sleep_status = RT_TRUE;
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
     return (RT_EOK);
 }
 
@@ -138,7 +138,7 @@ static int bc26_wakeup(struct at_device *device)
         return (RT_EOK);
     }
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_D("no memory for resp create.");
@@ -158,7 +158,7 @@ static int bc26_wakeup(struct at_device *device)
     if (at_obj_exec_cmd(device->client, resp, "AT+QSCLK=0") != RT_EOK)
     {
         LOG_D("wake up fail. \"AT+QSCLK=0\" execute fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return (-RT_ERROR);
     }
 
@@ -166,13 +166,13 @@ static int bc26_wakeup(struct at_device *device)
     if (at_obj_exec_cmd(device->client, resp, "AT+CPSMS=0") != RT_EOK)
     {
         LOG_D("wake up fail.\"AT+CPSMS=0\" execute fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return (-RT_ERROR);
     }
 
     bc26->sleep_status = RT_FALSE;
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
     return (RT_EOK);
 }
 
@@ -200,7 +200,7 @@ static int bc26_check_link_status(struct at_device *device)
         }
     }
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_D("no memory for resp create.");
@@ -228,7 +228,7 @@ static int bc26_check_link_status(struct at_device *device)
         }
     }
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
 
     return (result);
 }
@@ -259,7 +259,7 @@ static int bc26_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(BC26_INFO_RESP_SIZE, 0, BC26_INFO_RESP_TIMO);
+    resp = at_device_resp_get(device, BC26_INFO_RESP_SIZE, 0, BC26_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -367,7 +367,7 @@ static int bc26_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -489,7 +489,7 @@ static int bc26_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(BC26_DNS_RESP_LEN, 0, BC26_DNS_RESP_TIMEO);
+    resp = at_device_resp_get(device, BC26_DNS_RESP_LEN, 0, BC26_DNS_RESP_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_D("no memory for resp create.");
@@ -510,7 +510,7 @@ static int bc26_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -549,7 +549,7 @@ static int bc26_netdev_ping(struct netdev *netdev, const char *host, size_t data
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(BC26_PING_RESP_SIZE, 4, BC26_PING_TIMEO);
+    resp = at_device_resp_get(device, BC26_PING_RESP_SIZE, 4, BC26_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create");
@@ -596,7 +596,7 @@ static int bc26_netdev_ping(struct netdev *netdev, const char *host, size_t data
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -670,7 +670,7 @@ static void bc26_init_thread_entry(void *parameter)
     struct at_device *device = (struct at_device *)parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -832,6 +832,16 @@ static void bc26_init_thread_entry(void *parameter)
             goto __exit;
         }
 
+#ifdef AT_DEVICE_USING_UPLINK
+        /* report the RRC connection state, the uplink datagrams wait for the connected state */
+        if (at_obj_exec_cmd(device->client, resp, "AT+CSCON=1") != RT_EOK)
+        {
+            LOG_W("%s device RRC connection report is not supported.", device->name);
+        }
+        /* the current state is answered by "+CSCON: <n>,<mode>" and taken by the URC */
+        at_obj_exec_cmd(device->client, resp, "AT+CSCON?");
+#endif
+
         /* initialize successfully  */
         result = RT_EOK;
         break;
@@ -849,7 +859,7 @@ static void bc26_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result == RT_EOK)
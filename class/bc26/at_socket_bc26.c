@@ -12,30 +12,32 @@
 #include <string.h>
 
 #include <at_device_bc26.h>
+#include <at_device_dialect.h>
 
 #define LOG_TAG                        "at.skt.bc26"
 #include <at_log.h>
 
 #if defined(AT_DEVICE_USING_BC26) && defined(AT_USING_SOCKET)
 
+#if !defined (BC26_MODULE_SEND_MAX_SIZE)
 #define BC26_MODULE_SEND_MAX_SIZE       1024
+#endif
 
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
+/* The maximum TCP bytes sent and not acknowledged by peer kept in the module */
+#if !defined (BC26_MODULE_SEND_WINDOW)
+#define BC26_MODULE_SEND_WINDOW         (2 * BC26_MODULE_SEND_MAX_SIZE)
+#endif
 
-/* AT socket event type */
-#define BC26_EVENT_CONN_OK             (1L << 0)
-#define BC26_EVENT_SEND_OK             (1L << 1)
-#define BC26_EVENT_RECV_OK             (1L << 2)
-#define BC26_EVNET_CLOSE_OK            (1L << 3)
-#define BC26_EVENT_CONN_FAIL           (1L << 4)
-#define BC26_EVENT_SEND_FAIL           (1L << 5)
+/* AT device event of the domain resolve, the socket events are kept by the socket dialect engine */
 #define BC26_EVENT_DOMAIN_OK           (1L << 6)
 
-static at_evt_cb_t at_evt_cb_set[] = {
-        [AT_SOCKET_EVT_RECV] = NULL,
-        [AT_SOCKET_EVT_CLOSED] = NULL,
-};
+/* QIOPEN access mode, the data is buffered in the module and read by AT+QIRD in pull mode */
+#ifdef AT_DEVICE_BC26_RECV_PULL
+#define BC26_ACCESS_MODE_STR          "0"
+#else
+#define BC26_ACCESS_MODE_STR          "1"
+#endif
+
 
 static void at_tcp_ip_errcode_parse(int result)//TCP/IP_QIGETERROR
 {
@@ -72,7 +74,6 @@ static void at_tcp_ip_errcode_parse(int result)//TCP/IP_QIGETERROR
     }
 }
 
-
 static int bc26_socket_event_send(struct at_device *device, uint32_t event)
 {
     return (int) rt_event_send(device->socket_event, event);
@@ -93,330 +94,55 @@ static int bc26_socket_event_recv(struct at_device *device, uint32_t event, uint
 }
 
 /**
- * close socket by AT commands.
+ * get the TCP bytes acknowledged and not acknowledged by peer by AT commands.
  *
- * @param current socket
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ * @param acked the bytes acknowledged by peer
+ * @param unacked the bytes not acknowledged by peer
  *
- * @return  0: close socket success
- *         -1: send AT commands error
- *         -2: wait socket event timeout
+ * @return  0: get success
+ *         -1: send AT commands error or response error
  *         -5: no memory
  */
-static int bc26_socket_close(struct at_socket *socket)
+static int bc26_socket_send_ack(struct at_device *device, int device_socket, size_t *acked, size_t *unacked)
 {
     int result = RT_EOK;
+    int sent = 0, acked_size = 0, unacked_size = 0;
     at_response_t resp = RT_NULL;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
-
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for resp create.");
-        return -RT_ENOMEM;
-    }
-
-    result = at_obj_exec_cmd(device->client, resp, "AT+QICLOSE=%d", device_socket);
-
-    at_delete_resp(resp);
-
-    return result;
-}
-
-/**
- * create TCP/UDP client or server connect by AT commands.
- *
- * @param socket current socket
- * @param ip server or client IP address
- * @param port server or client port
- * @param type connect socket type(tcp, udp)
- * @param is_client connection is client
- *
- * @return   0: connect success
- *          -1: connect failed, send commands error or type error
- *          -2: wait socket event timeout
- *          -5: no memory
- */
-static int bc26_socket_connect(struct at_socket *socket, char *ip, int32_t port,
-    enum at_socket_type type, rt_bool_t is_client)
-{
-    #define CONN_RETRY  2
-
-    int i = 0;
-    const char *type_str = RT_NULL;
-    uint32_t event = 0;
-    at_response_t resp = RT_NULL;
-    int result = 0, event_result = 0;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
 
-    RT_ASSERT(ip);
-    RT_ASSERT(port >= 0);
-
-    if ( ! is_client)
-    {
-        return -RT_ERROR;
-    }
-
-    switch(type)
-    {
-        case AT_SOCKET_TCP:
-            type_str = "TCP";
-            break;
-        case AT_SOCKET_UDP:
-            type_str = "UDP";
-            break;
-        default:
-            LOG_E("%s device socket(%d)  connect type error.", device->name, device_socket);
-            return -RT_ERROR;
-    }
-
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
         return -RT_ENOMEM;
     }
 
-    for(i=0; i<CONN_RETRY; i++)
-    {
-        /* clear socket connect event */
-        event = SET_EVENT(device_socket, BC26_EVENT_CONN_OK | BC26_EVENT_CONN_FAIL);
-        bc26_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
-
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIOPEN=1,%d,\"%s\",\"%s\",%d,0,1",
-                            device_socket, type_str, ip, port) < 0)
-        {
-            result = -RT_ERROR;
-            break;
-        }
-
-        /* waiting result event from AT URC, the device default connection timeout is 60 seconds*/
-        if (bc26_socket_event_recv(device, SET_EVENT(device_socket, 0),
-                                    60 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-        {
-            LOG_E("%s device socket(%d) wait connect result timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            break;
-        }
-        /* waiting OK or failed result */
-        event_result = bc26_socket_event_recv(device, BC26_EVENT_CONN_OK | BC26_EVENT_CONN_FAIL,
-                                                1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
-        if (event_result < 0)
-        {
-            LOG_E("%s device socket(%d) wait connect OK|FAIL timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            break;
-        }
-        /* check result */
-        if (event_result & BC26_EVENT_CONN_OK)
-        {
-            result = RT_EOK;
-            break;
-        }
-
-        LOG_D("%s device socket(%d) connect failed, the socket was not be closed and now will connect retry.",
-                    device->name, device_socket);
-        if (bc26_socket_close(socket) < 0)
-        {
-            result = -RT_ERROR;
-            break;
-        }
-    }
-
-    if (i == CONN_RETRY)
-    {
-        LOG_E("%s device socket(%d) connect failed.", device->name, device_socket);
-        result = -RT_ERROR;
-    }
-
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
-
-    return result;
-}
-
-static int at_get_send_size(struct at_socket *socket, size_t *size, size_t *acked, size_t *nacked)
-{
-    int result = 0;
-    at_response_t resp = RT_NULL;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
-
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for resp create.", device->name);
-        return -RT_ENOMEM;
-    }
-
-    if (at_obj_exec_cmd(device->client, resp, "AT+QISEND=%d,0", device_socket) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+QISEND=%d,0", device_socket) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
     }
 
-    if (at_resp_parse_line_args_by_kw(resp, "+QISEND:", "+QISEND: %d,%d,%d", size, acked, nacked) <= 0)
+    if (at_resp_parse_line_args_by_kw(resp, "+QISEND:", "+QISEND: %d,%d,%d", &sent, &acked_size, &unacked_size) <= 0)
     {
         result = -RT_ERROR;
         goto __exit;
     }
 
-__exit:
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
-
-    return result;
-}
-
-static int at_wait_send_finish(struct at_socket *socket, size_t settings_size)
-{
-    /* get the timeout by the input data size */
-    rt_tick_t timeout = rt_tick_from_millisecond(settings_size);
-    rt_tick_t last_time = rt_tick_get();
-    size_t size = 0, acked = 0, nacked = 0xFFFF;
-
-    while (rt_tick_get() - last_time <= timeout)
-    {
-        at_get_send_size(socket, &size, &acked, &nacked);
-        if (nacked == 0)
-        {
-            return RT_EOK;
-        }
-        rt_thread_mdelay(100);
-    }
-
-    return -RT_ETIMEOUT;
-}
-
-/**
- * send data to server or client by AT commands.
- *
- * @param socket current socket
- * @param buff send buffer
- * @param bfsz send buffer size
- * @param type connect socket type(tcp, udp)
- *
- * @return >=0: the size of send success
- *          -1: send AT commands error or send data error
- *          -2: waited socket event timeout
- *          -5: no memory
- */
-static int bc26_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
-{
-    uint32_t event = 0;
-    int result = 0, event_result = 0;
-    size_t cur_pkt_size = 0, sent_size = 0;
-    at_response_t resp = RT_NULL;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
-    struct at_device_bc26 *bc26 = (struct at_device_bc26 *) device->user_data;
-    rt_mutex_t lock = at_device_get_client_lock(device);
-
-    RT_ASSERT(buff);
-
-    resp = at_create_resp(128, 2, rt_tick_from_millisecond(300));
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for resp create.");
-        return -RT_ENOMEM;
-    }
-
-    rt_mutex_take(lock, RT_WAITING_FOREVER);
-
-    /* set current socket for send URC event */
-    bc26->user_data = (void *) device_socket;
-
-    /* clear socket send event */
-    event = SET_EVENT(device_socket, BC26_EVENT_SEND_OK | BC26_EVENT_SEND_FAIL);
-    bc26_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
-
-    /* set AT client end sign to deal with '>' sign.*/
-    at_obj_set_end_sign(device->client, '>');
-
-    while (sent_size < bfsz)
-    {
-        if (bfsz - sent_size < BC26_MODULE_SEND_MAX_SIZE)
-        {
-            cur_pkt_size = bfsz - sent_size;
-        }
-        else
-        {
-            cur_pkt_size = BC26_MODULE_SEND_MAX_SIZE;
-        }
-
-        /* send the "AT+QISEND" commands to AT server than receive the '>' response on the first line. */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QISEND=%d,%d", device_socket, (int)cur_pkt_size) < 0)
-        {
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        rt_thread_mdelay(5);//delay at least 4ms
-
-        /* send the real data to server or client */
-        result = (int) at_client_obj_send(device->client, buff + sent_size, cur_pkt_size);
-        if (result == 0)
-        {
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* waiting result event from AT URC */
-        event = SET_EVENT(device_socket, 0);
-        event_result = bc26_socket_event_recv(device, event, 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
-        if (event_result < 0)
-        {
-            LOG_E("%s device socket(%d) wait event timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-        /* waiting OK or failed result */
-        event = BC26_EVENT_SEND_OK | BC26_EVENT_SEND_FAIL;
-        event_result = bc26_socket_event_recv(device, event, 1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
-        if (event_result < 0)
-        {
-            LOG_E("%s device socket(%d) wait sned OK|FAIL timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-        /* check result */
-        if (event_result & BC26_EVENT_SEND_FAIL)
-        {
-            LOG_E("%s device socket(%d) send failed.", device->name, device_socket);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        if (type == AT_SOCKET_TCP)
-        {
-            at_wait_send_finish(socket, 2*cur_pkt_size);
-        }
-
-        sent_size += cur_pkt_size;
-    }
+    *acked = acked_size;
+    *unacked = unacked_size;
 
 __exit:
-    /* reset the end sign for data conflict */
-    at_obj_set_end_sign(device->client, 0);
-
-    rt_mutex_release(lock);
+    at_device_resp_put(device, resp);
 
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
-
-    return result > 0 ? sent_size : result;
+    return result;
 }
 
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -425,27 +151,19 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int bc26_domain_resolve(const char *name, char ip[16])
+static int bc26_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
     #define RESOLVE_RETRY  3
 
     int i, result;
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
     struct at_device_bc26 *bc26 = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first init device failed.");
-        return -RT_ERROR;
-    }
-
     /* the maximum response time is 60 seconds, but it set to 10 seconds is convenient to use. */
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (!resp)
     {
         LOG_E("no memory for resp create.");
@@ -458,7 +176,7 @@ static int bc26_domain_resolve(const char *name, char ip[16])
     bc26 = (struct at_device_bc26 *) device->user_data;
     bc26->socket_data = ip;
 
-    if (at_obj_exec_cmd(device->client, resp, "AT+QIDNSGIP=1,\"%s\"", name) != RT_EOK)
+    if (at_device_exec_cmd(device, resp, "AT+QIDNSGIP=1,\"%s\"", name) != RT_EOK)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -493,65 +211,39 @@ static int bc26_domain_resolve(const char *name, char ip[16])
     bc26->socket_data = RT_NULL;
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
 
 }
 
-/**
- * set AT socket event notice callback
- *
- * @param event notice event
- * @param cb notice callback
- */
-static void bc26_socket_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
-{
-    if (event < sizeof(at_evt_cb_set) / sizeof(at_evt_cb_set[1]))
-    {
-        at_evt_cb_set[event] = cb;
-    }
-}
-
 static void urc_connect_func(struct at_client *client, const char *data, rt_size_t size)
 {
     int device_socket = 0, result = 0;
-    struct at_device *device = RT_NULL;
-    char *client_name = client->device->parent.name;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
-    if (device == RT_NULL)
-    {
-        LOG_E("get device(%s) failed.", client_name);
-        return;
-    }
-
-    rt_sscanf(data, "+QIOPEN: %d,%d", &device_socket , &result);
-
-    if (result == 0)
-    {
-        bc26_socket_event_send(device, SET_EVENT(device_socket, BC26_EVENT_CONN_OK));
-    }
-    else
+    rt_sscanf(data, "+QIOPEN: %d,%d", &device_socket, &result);
+    if (result)
     {
         at_tcp_ip_errcode_parse(result);
-        bc26_socket_event_send(device, SET_EVENT(device_socket, BC26_EVENT_CONN_FAIL));
     }
+
+    at_device_dialect_urc_connect_func(client, data, size);
 }
 
-static void urc_send_func(struct at_client *client, const char *data, rt_size_t size)
+static void urc_dnsqip_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int device_socket = 0;
+    char recv_ip[AT_DEVICE_DNS_ADDR_LEN] = {0};
+    int result = 0, ip_count = 0, dns_ttl = 0;
     struct at_device *device = RT_NULL;
     struct at_device_bc26 *bc26 = RT_NULL;
     char *client_name = client->device->parent.name;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -559,168 +251,73 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
     }
 
     bc26 = (struct at_device_bc26 *) device->user_data;
-    device_socket = (int) bc26->user_data;
-
-    if (rt_strstr(data, "SEND OK"))
-    {
-        bc26_socket_event_send(device, SET_EVENT(device_socket, BC26_EVENT_SEND_OK));
-    }
-    else if (rt_strstr(data, "SEND FAIL"))
-    {
-        bc26_socket_event_send(device, SET_EVENT(device_socket, BC26_EVENT_SEND_FAIL));
-    }
-}
-
-static void urc_close_func(struct at_client *client, const char *data, rt_size_t size)
-{
-    int device_socket = 0;
-    struct at_socket *socket = RT_NULL;
-    struct at_device *device = RT_NULL;
-    char *client_name = client->device->parent.name;
-
-    RT_ASSERT(data && size);
-
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
-    if (device == RT_NULL)
-    {
-        LOG_E("get device(%s) failed.", client_name);
-        return;
-    }
-
-    rt_sscanf(data, "+QIURC: \"closed\",%d", &device_socket);
-    /* get at socket object by device socket descriptor */
-    socket = &(device->sockets[device_socket]);
-
-    /* notice the socket is disconnect by remote */
-    if (at_evt_cb_set[AT_SOCKET_EVT_CLOSED])
-    {
-        at_evt_cb_set[AT_SOCKET_EVT_CLOSED](socket, AT_SOCKET_EVT_CLOSED, NULL, 0);
-    }
-}
-
-static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
-{
-    int device_socket = 0;
-    rt_int32_t timeout;
-    rt_size_t bfsz = 0, temp_size = 0;
-    char *recv_buf = RT_NULL, temp[8] = {0};
-    struct at_socket *socket = RT_NULL;
-    struct at_device *device = RT_NULL;
-    char *client_name = client->device->parent.name;
-
-    RT_ASSERT(data && size);
-
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
-    if (device == RT_NULL)
+    if (bc26->socket_data == RT_NULL)
     {
-        LOG_E("get device(%s) failed.", client_name);
+        LOG_D("%s device socket_data no config.", bc26->device_name);
         return;
     }
 
-    /* get the current socket and receive buffer size by receive data */
-    rt_sscanf(data, "+QIURC: \"recv\",%d,%d", &device_socket, (int *) &bfsz);
-    /* set receive timeout by receive buffer length, not less than 10 ms */
-    timeout = bfsz > 10 ? bfsz : 10;
-
-    if (device_socket < 0 || bfsz == 0)
+    /* There would be several dns result, keep all of them and pickup an IPv4 one */
+    if (rt_sscanf(data, "+QIURC: \"dnsgip\",\"%45[^\"]", recv_ip) == 1)
     {
-        return;
-    }
+        if (rt_strlen(recv_ip) < 16 && strchr(recv_ip, ':') == RT_NULL)
+        {
+            rt_memcpy(bc26->socket_data, recv_ip, 16);
+        }
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
-    if (recv_buf == RT_NULL)
-    {
-        LOG_E("no memory for URC receive buffer(%d).", bfsz);
-        /* read and clean the coming data */
-        while (temp_size < bfsz)
+        /* all addresses are received */
+        if (at_device_dns_addr_add(device, recv_ip) >= device->dns_addr_expect)
         {
-            if (bfsz - temp_size > sizeof(temp))
-            {
-                at_client_obj_recv(client, temp, sizeof(temp), timeout);
-            }
-            else
-            {
-                at_client_obj_recv(client, temp, bfsz - temp_size, timeout);
-            }
-            temp_size += sizeof(temp);
+            bc26_socket_event_send(device, BC26_EVENT_DOMAIN_OK);
         }
-        return;
     }
-
-    /* sync receive data */
-    if (at_client_obj_recv(client, recv_buf, bfsz, timeout) != bfsz)
+    else
     {
-        LOG_E("%s device receive size(%d) data failed.", device->name, bfsz);
-        rt_free(recv_buf);
-        return;
+        rt_sscanf(data, "+QIURC: \"dnsgip\",%d,%d,%d", &result, &ip_count, &dns_ttl);
+        if (result)
+        {
+            at_tcp_ip_errcode_parse(result);
+        }
+        else
+        {
+            /* the addresses follow with this TTL, keep them for DNS cache */
+            device->dns_ttl = dns_ttl;
+            device->dns_addr_expect = ip_count;
+        }
     }
+}
 
-    /* get at socket object by device socket descriptor */
-    socket = &(device->sockets[device_socket]);
+static void urc_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    RT_ASSERT(data);
 
-    /* notice the receive buffer and buffer size */
-    if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
-    {
-        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
-    }
+    LOG_I("URC data : %.*s", size, data);
 }
 
-static void urc_dnsqip_func(struct at_client *client, const char *data, rt_size_t size)
+#ifdef AT_DEVICE_USING_UPLINK
+static void urc_cscon_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int i = 0, j = 0;
-    char recv_ip[16] = {0};
-    int result, ip_count, dns_ttl;
+    int n = 0, mode = 0;
     struct at_device *device = RT_NULL;
-    struct at_device_bc26 *bc26 = RT_NULL;
     char *client_name = client->device->parent.name;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
-    bc26 = (struct at_device_bc26 *) device->user_data;
-    if (bc26->socket_data == RT_NULL)
-    {
-        LOG_D("%s device socket_data no config.", bc26->device_name);
-        return;
-    }
-
-    for (i = 0; i < size; i++)
-    {
-        if (*(data + i) == '.')
-            j++;
-    }
-    /* There would be several dns result, we just pickup one */
-    if (j == 3)
-    {
-        rt_sscanf(data, "+QIURC: \"dnsgip\",\"%[^\"]", recv_ip);
-        recv_ip[15] = '\0';
-
-        rt_memcpy(bc26->socket_data, recv_ip, sizeof(recv_ip));
-
-        bc26_socket_event_send(device, BC26_EVENT_DOMAIN_OK);
-    }
-    else
+    /* "+CSCON: <mode>" reports the RRC connection change, "+CSCON: <n>,<mode>" answers the query */
+    if (rt_sscanf(data, "+CSCON:%d,%d", &n, &mode) == 1)
     {
-        rt_sscanf(data, "+QIURC: \"dnsgip\",%d,%d,%d", &result, &ip_count, &dns_ttl);
-        if (result)
-        {
-            at_tcp_ip_errcode_parse(result);
-        }
+        mode = n;
     }
+    at_device_uplink_notice(device, mode == 1);
 }
-
-static void urc_func(struct at_client *client, const char *data, rt_size_t size)
-{
-    RT_ASSERT(data);
-
-    LOG_I("URC data : %.*s", size, data);
-}
+#endif /* AT_DEVICE_USING_UPLINK */
 
 static void urc_qiurc_func(struct at_client *client, const char *data, rt_size_t size)
 {
@@ -728,8 +325,12 @@ static void urc_qiurc_func(struct at_client *client, const char *data, rt_size_t
 
     switch(*(data + 9))
     {
-    case 'c' : urc_close_func(client, data, size); break;//+QIURC: "closed"
-    case 'r' : urc_recv_func(client, data, size); break;//+QIURC: "recv"
+    case 'c' : at_device_dialect_urc_close_func(client, data, size); break;//+QIURC: "closed"
+#ifdef AT_DEVICE_BC26_RECV_PULL
+    case 'r' : at_device_dialect_urc_notice_func(client, data, size); break;//+QIURC: "recv"
+#else
+    case 'r' : at_device_dialect_urc_recv_func(client, data, size); break;//+QIURC: "recv"
+#endif
     case 'd' : urc_dnsqip_func(client, data, size); break;//+QIURC: "dnsgip"
     default  : urc_func(client, data, size);      break;
     }
@@ -737,32 +338,92 @@ static void urc_qiurc_func(struct at_client *client, const char *data, rt_size_t
 
 static const struct at_urc urc_table[] =
 {
-    {"SEND OK",     "\r\n",                 urc_send_func},
-    {"SEND FAIL",   "\r\n",                 urc_send_func},
+    {"SEND OK",     "\r\n",                 at_device_dialect_urc_send_func},
+    {"SEND FAIL",   "\r\n",                 at_device_dialect_urc_send_func},
     {"+QIOPEN:",    "\r\n",                 urc_connect_func},
     {"+QIURC:",     "\r\n",                 urc_qiurc_func},
+#ifdef AT_DEVICE_BC26_RECV_PULL
+    {"+QIRD:",      "\r\n",                 at_device_dialect_urc_pull_func},
+#endif
+#ifdef AT_DEVICE_USING_UPLINK
+    {"+CSCON:",     "\r\n",                 urc_cscon_func},
+#endif
 };
 
 static const struct at_socket_ops bc26_socket_ops =
 {
-    bc26_socket_connect,
-    bc26_socket_close,
-    bc26_socket_send,
-    bc26_domain_resolve,
-    bc26_socket_set_event_cb,
+    at_device_dialect_socket_connect,
+    at_device_dialect_socket_close,
+    at_device_dialect_socket_send,
+    RT_NULL,
+    at_device_dialect_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
 #endif
 };
 
+/* The QIOPEN/QISEND sockets, contextID 1 is activated by AT+QIACT, the local port is assigned automatically */
+static const struct at_device_dialect bc26_socket_dialect =
+{
+    "AT+QIOPEN=1,%d,\"TCP\",\"%s\",%d,0," BC26_ACCESS_MODE_STR,
+    "AT+QIOPEN=1,%d,\"UDP\",\"%s\",%d,0," BC26_ACCESS_MODE_STR,
+    "AT+QICLOSE=%d",
+    RT_NULL,
+    "AT+QISEND=%d,%d",
+
+    "+QIURC: \"recv\",%d,%d",
+    "+QIURC: \"closed\",%d",
+    RT_NULL,
+    "SEND OK",
+    "SEND FAIL",
+
+    '>',
+    AT_DEVICE_DIALECT_SEND_UNLOCKED,
+    2,
+    BC26_MODULE_SEND_MAX_SIZE,
+
+    300,
+    300,
+    300,
+    10000,
+
+    urc_table,
+    sizeof(urc_table) / sizeof(urc_table[0]),
+
+    RT_NULL,
+
+#ifdef AT_DEVICE_BC26_RECV_PULL
+    "AT+QIRD=%d,%d",
+    "+QIRD: %d",
+    "+QIURC: \"recv\",%d",
+#else
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+#endif
+
+    /* the device default connection timeout is 60 seconds */
+    "+QIOPEN: %d,%d",
+    60000,
+};
+
 int bc26_socket_init(struct at_device *device)
 {
+    int result = RT_EOK;
+
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
+    result = at_device_dialect_socket_init(device);
+#ifdef AT_DEVICE_USING_UPLINK
+    if (result == RT_EOK)
+    {
+        /* the datagrams wait for the active window of PSM and eDRX */
+        result = at_device_uplink_init(device);
+    }
+#endif
 
-    return RT_EOK;
+    return result;
 }
 
 int bc26_socket_class_register(struct at_device_class *class)
@@ -771,9 +432,12 @@ int bc26_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_BC26_SOCKETS_NUM;
     class->socket_ops = &bc26_socket_ops;
+    class->domain_resolve = bc26_domain_resolve;
+    class->dialect = &bc26_socket_dialect;
+    class->send_window = BC26_MODULE_SEND_WINDOW;
+    class->send_ack = bc26_socket_send_ack;
 
     return RT_EOK;
 }
 
 #endif /* AT_DEVICE_USING_BC26 && AT_USING_SOCKET */
-
@@ -63,7 +63,7 @@ static int bc28_check_link_status(struct at_device *device)
         }
     }
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -83,7 +83,7 @@ static int bc28_check_link_status(struct at_device *device)
         }
     }
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
     return(result);
 }
 
@@ -113,7 +113,7 @@ static int bc28_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(BC28_INFO_RESP_SIZE, 0, BC28_INFO_RESP_TIMOUT);
+    resp = at_device_resp_get(device, BC28_INFO_RESP_SIZE, 0, BC28_INFO_RESP_TIMOUT);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -234,7 +234,7 @@ static int bc28_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -355,7 +355,7 @@ static int bc28_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(BC28_DNS_RESP_LEN, 0, BC28_DNS_RESP_TIMEOUT);
+    resp = at_device_resp_get(device, BC28_DNS_RESP_LEN, 0, BC28_DNS_RESP_TIMEOUT);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -374,14 +374,14 @@ static int bc28_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
 }
 
 #ifdef AT_USING_SOCKET
-    int bc28_domain_resolve(const char *name, char ip[16]);
+    int bc28_domain_resolve(struct at_device *device, const char *name, char ip[16]);
 #endif
 #ifdef NETDEV_USING_PING
 static int bc28_netdev_ping(struct netdev *netdev, const char *host, size_t data_len,
@@ -416,7 +416,7 @@ static int bc28_netdev_ping(struct netdev *netdev, const char *host, size_t data
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(BC28_PING_RESP_SIZE, 4, BC28_PING_TIMEOUT);
+    resp = at_device_resp_get(device, BC28_PING_RESP_SIZE, 4, BC28_PING_TIMEOUT);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create");
@@ -432,7 +432,7 @@ static int bc28_netdev_ping(struct netdev *netdev, const char *host, size_t data
 #ifdef AT_USING_SOCKET
     else
     {
-        if(0 > bc28_domain_resolve(host, ip_addr))
+        if(0 > bc28_domain_resolve(device, host, ip_addr))
         {
             LOG_E("can not resolve domain");
             goto __exit;
@@ -478,7 +478,7 @@ static int bc28_netdev_ping(struct netdev *netdev, const char *host, size_t data
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -553,7 +553,7 @@ static void bc28_init_thread_entry(void *parameter)
     struct at_device *device = (struct at_device *) parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(AT_DEFAULT_TIMEOUT));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(AT_DEFAULT_TIMEOUT));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -785,6 +785,16 @@ static void bc28_init_thread_entry(void *parameter)
             goto __exit;
         }
 
+#ifdef AT_DEVICE_USING_UPLINK
+        /* report the RRC connection state, the uplink datagrams wait for the connected state */
+        if (at_obj_exec_cmd(device->client, resp, "AT+CSCON=1") != RT_EOK)
+        {
+            LOG_W("%s device RRC connection report is not supported.", device->name);
+        }
+        /* the current state is answered by "+CSCON: <n>,<mode>" and taken by the URC */
+        at_obj_exec_cmd(device->client, resp, "AT+CSCON?");
+#endif
+
         /* initialize successfully  */
         result = RT_EOK;
         break;
@@ -802,7 +812,7 @@ static void bc28_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result == RT_EOK)
@@ -23,12 +23,11 @@
 
 #if defined(AT_DEVICE_USING_BC28) && defined(AT_USING_SOCKET)
 
+#if !defined (BC28_MODULE_SEND_MAX_SIZE)
 #define BC28_MODULE_SEND_MAX_SIZE       1358
+#endif
 #define BC28_MODULE_RECV_MAX_SIZE       1358
 
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
-
 /* AT socket event type */
 #define BC28_EVENT_CONN_OK             (1L << 0)
 #define BC28_EVENT_SEND_OK             (1L << 1)
@@ -51,42 +50,6 @@ static struct at_socket_ip_info
     int  port;
 } bc28_sock_info[AT_DEVICE_BC28_SOCKETS_NUM];
 
-/**
- * convert data from Hex string to ASCII string.
- *
- * @param hex  input Hex string
- * @param str  output ASCII string
- * @param len  length of str, or the size you want to convert
- *
- * @return =0: convert failed, or no data need to convert
- *         >0: the size of convert success
- */
-static int hex_to_string(const char *hex, char *str, const rt_size_t len)
-{
-    RT_ASSERT(hex && str);
-
-    int hex_len = rt_strlen(hex);
-    int pos = 0, left, right, i;
-
-    if (len < 1 || hex_len/2 < len)
-    {
-        return 0;
-    }
-
-    for (i = 0; i < len*2; i++, pos++)
-    {
-        left = hex[i++];
-        right = hex[i];
-
-        left  = (left  < 58) ? (left  - 48) : (left  - 55);
-        right = (right < 58) ? (right - 48) : (right - 55);
-
-        str[pos] = (left << 4) | right;
-    }
-
-    return pos;
-}
-
 static int bc28_socket_event_send(struct at_device *device, uint32_t event)
 {
     return (int) rt_event_send(device->socket_event, event);
@@ -123,14 +86,14 @@ static int bc28_socket_close(struct at_socket *socket)
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(3000));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(3000));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
         return -RT_ENOMEM;
     }
 
-    result = at_obj_exec_cmd(device->client, resp, "AT+NSOCL=%d", device_socket);
+    result = at_device_exec_cmd(device, resp, "AT+NSOCL=%d", device_socket);
     if (result < 0)
     {
         LOG_E("%s device close socket(%d) failed [%d].", device->name, device_socket, result);
@@ -140,7 +103,7 @@ static int bc28_socket_close(struct at_socket *socket)
         LOG_D("%s device close socket(%d).", device->name, device_socket);
     }
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
 
     return result;
 }
@@ -176,7 +139,7 @@ static int bc28_socket_create(struct at_device *device, enum at_socket_type type
             return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -184,7 +147,7 @@ static int bc28_socket_create(struct at_device *device, enum at_socket_type type
     }
 
     /* create socket */
-    if (at_obj_exec_cmd(device->client, resp, "AT+NSOCR=%s,%d,%d,1", type_str, protocol, port) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+NSOCR=%s,%d,%d,1", type_str, protocol, port) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -206,7 +169,7 @@ static int bc28_socket_create(struct at_device *device, enum at_socket_type type
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -245,7 +208,7 @@ static int bc28_socket_connect(struct at_socket *socket, char *ip, int32_t port,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -266,7 +229,7 @@ static int bc28_socket_connect(struct at_socket *socket, char *ip, int32_t port,
     for(i=0; i<CONN_RETRY; i++)
     {
 
-        if (at_obj_exec_cmd(device->client, resp, "AT+NSOCO=%d,%s,%d", device_socket, ip, port) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+NSOCO=%d,%s,%d", device_socket, ip, port) < 0)
         {
             result = -RT_ERROR;
             continue;
@@ -283,7 +246,7 @@ static int bc28_socket_connect(struct at_socket *socket, char *ip, int32_t port,
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -305,9 +268,9 @@ static int bc28_socket_connect(struct at_socket *socket, char *ip, int32_t port,
 static int bc28_socket_send(struct at_socket *socket, const char *buff,
                             size_t bfsz, enum at_socket_type type)
 {
-    uint32_t event = 0;
     int result = 0, event_result = 0;
     size_t cur_pkt_size = 0, sent_size = 0;
+    char cmd[64] = {0};
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
@@ -315,7 +278,7 @@ static int bc28_socket_send(struct at_socket *socket, const char *buff,
 
     RT_ASSERT(buff);
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -325,8 +288,7 @@ static int bc28_socket_send(struct at_socket *socket, const char *buff,
     rt_mutex_take(lock, RT_WAITING_FOREVER);
 
     /* clear socket send event */
-    event = SET_EVENT(device_socket, BC28_EVENT_SEND_OK | BC28_EVENT_SEND_FAIL);
-    bc28_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, BC28_EVENT_SEND_OK | BC28_EVENT_SEND_FAIL, 0, RT_EVENT_FLAG_OR);
 
     /* only use for UDP socket */
     const char *ip = bc28_sock_info[device_socket].ip_addr;
@@ -343,37 +305,53 @@ static int bc28_socket_send(struct at_socket *socket, const char *buff,
             cur_pkt_size = BC28_MODULE_SEND_MAX_SIZE;
         }
 
-        size_t i = 0, ind = 0;
-        char hex_data[cur_pkt_size * 2 + 1];
-        rt_memset(hex_data, 0, sizeof(hex_data));
-
-        for (i=0, ind=0; i<cur_pkt_size; i++, ind+=2)
-        {
-            rt_sprintf(&hex_data[ind], "%02X", buff[sent_size + i]);
-
-        }
+        /* the hex data is streamed between the command head and tail */
         switch (type)
         {
         case AT_SOCKET_TCP:
             /* AT+NSOSD=<socket>,<length>,<data>[,<flag>[,<sequence>]] */
-            if (at_obj_exec_cmd(device->client, resp, "AT+NSOSD=%d,%d,%s,0x100,1", device_socket,
-                                (int)cur_pkt_size, hex_data) < 0)
+            rt_snprintf(cmd, sizeof(cmd), "AT+NSOSD=%d,%d,", device_socket, (int)cur_pkt_size);
+            if (at_client_obj_send(device->client, cmd, rt_strlen(cmd)) == 0)
+            {
+                result = -RT_ERROR;
+                goto __exit;
+            }
+            if (at_device_hex_send(device, buff + sent_size, cur_pkt_size) != cur_pkt_size)
             {
+                /* terminate the broken command line and drain its ERROR */
+                at_device_hex_abort(device, resp);
                 result = -RT_ERROR;
                 goto __exit;
             }
-            LOG_D("%s device tcp socket(%d) send %d bytes.\n>> %s", device->name, device_socket, (int)cur_pkt_size, hex_data);
+            if (at_device_exec_cmd(device, resp, ",0x100,1") < 0)
+            {
+                result = -RT_ERROR;
+                goto __exit;
+            }
+            LOG_D("%s device tcp socket(%d) send %d bytes.", device->name, device_socket, (int)cur_pkt_size);
             break;
 
         case AT_SOCKET_UDP:
             /* AT+NSOST=<socket>,<remote_addr>,<remote_port>,<length>,<data>[,<sequence>] */
-            if (at_obj_exec_cmd(device->client, resp, "AT+NSOST=%d,%s,%d,%d,%s,1", device_socket,
-                                ip, port, (int)cur_pkt_size, hex_data) < 0)
+            rt_snprintf(cmd, sizeof(cmd), "AT+NSOST=%d,%s,%d,%d,", device_socket, ip, port, (int)cur_pkt_size);
+            if (at_client_obj_send(device->client, cmd, rt_strlen(cmd)) == 0)
+            {
+                result = -RT_ERROR;
+                goto __exit;
+            }
+            if (at_device_hex_send(device, buff + sent_size, cur_pkt_size) != cur_pkt_size)
+            {
+                /* terminate the broken command line and drain its ERROR */
+                at_device_hex_abort(device, resp);
+                result = -RT_ERROR;
+                goto __exit;
+            }
+            if (at_device_exec_cmd(device, resp, ",1") < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
             }
-            LOG_D("%s device udp socket(%d) send %d bytes to %s:%d.\n>> %s", device->name, device_socket, ip, port, (int)cur_pkt_size, hex_data);
+            LOG_D("%s device udp socket(%d) send %d bytes to %s:%d.", device->name, device_socket, (int)cur_pkt_size, ip, port);
             break;
 
         default:
@@ -391,16 +369,14 @@ static int bc28_socket_send(struct at_socket *socket, const char *buff,
         }
 
         /* waiting result event from AT URC, the device default timeout is 60 seconds*/
-        if (bc28_socket_event_recv(device, SET_EVENT(device_socket, 0),
-                                   60 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
+        event_result = at_device_socket_event_recv(device, device_socket, BC28_EVENT_SEND_OK | BC28_EVENT_SEND_FAIL,
+                                                   60 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+        if (event_result < 0)
         {
             LOG_E("%s device socket(%d) wait send result timeout.", device->name, device_socket);
             result = -RT_ETIMEOUT;
             goto __exit;
         }
-        /* waiting OK or failed result */
-        event_result = bc28_socket_event_recv(device, BC28_EVENT_SEND_OK | BC28_EVENT_SEND_FAIL,
-                                              1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
         if (event_result & BC28_EVENT_SEND_FAIL)
         {
             LOG_E("%s device socket(%d) send failed.", device->name, device_socket);
@@ -410,6 +386,7 @@ static int bc28_socket_send(struct at_socket *socket, const char *buff,
         else
         {
             LOG_D("%s device socket(%d) send success.", device->name, device_socket);
+            at_device_stats_send(device, device_socket, cur_pkt_size);
             sent_size += cur_pkt_size;
             result = sent_size;
         }
@@ -420,7 +397,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result > 0 ? sent_size : result;
@@ -431,6 +408,7 @@ static struct rt_mutex dns_mutex;
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -439,27 +417,19 @@ static struct rt_mutex dns_mutex;
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-int bc28_domain_resolve(const char *name, char ip[16])
+int bc28_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
 #define RESOLVE_RETRY  1
 
     int i, result, event_result = 0;
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
     struct at_device_bc28 *bc28 = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first init device failed.");
-        return -RT_ERROR;
-    }
-
     /* the maximum response time is 60 seconds, but it set to 10 seconds is convenient to use. */
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (!resp)
     {
         LOG_E("no memory for resp create.");
@@ -474,7 +444,7 @@ int bc28_domain_resolve(const char *name, char ip[16])
     bc28 = (struct at_device_bc28 *) device->user_data;
     bc28->socket_data = ip;
 
-    if (at_obj_exec_cmd(device->client, resp, "AT+QDNS=0,%s", name) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+QDNS=0,%s", name) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -508,7 +478,7 @@ __exit:
     bc28->socket_data = RT_NULL;
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -536,7 +506,7 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
     char *client_name = client->device->parent.name;
 
     RT_ASSERT(data && size);
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -547,11 +517,11 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     if (1 == status)
     {
-        bc28_socket_event_send(device, SET_EVENT(device_socket, BC28_EVENT_SEND_OK));
+        at_device_socket_event_send(device, device_socket, BC28_EVENT_SEND_OK);
     }
     else
     {
-        bc28_socket_event_send(device, SET_EVENT(device_socket, BC28_EVENT_SEND_FAIL));
+        at_device_socket_event_send(device, device_socket, BC28_EVENT_SEND_FAIL);
     }
 }
 
@@ -564,7 +534,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -573,7 +543,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     rt_sscanf(data, "+NSOCLI: %d", &device_socket);
 
-    bc28_socket_event_send(device, SET_EVENT(device_socket, BC28_EVENT_CONN_FAIL));
+    at_device_socket_event_send(device, device_socket, BC28_EVENT_CONN_FAIL);
 
     if (device_socket >= 0)
     {
@@ -590,10 +560,9 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
 static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int device_socket = 0;
-    rt_int32_t timeout;
-    rt_size_t bfsz = 0, temp_size = 0;
-    char *recv_buf = RT_NULL, *hex_buf = RT_NULL, temp[8] = {0};
+    int device_socket = 0, hex_offset = 0;
+    rt_size_t bfsz = 0;
+    char *recv_buf = RT_NULL;
     char remote_addr[IP_ADDR_SIZE_MAX] = {0};
     int remote_port = -1;
 
@@ -602,61 +571,40 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     char *client_name = client->device->parent.name;
 
     RT_ASSERT(data && size);
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
-    hex_buf = (char *) rt_calloc(1, BC28_MODULE_RECV_MAX_SIZE * 2 + 1);
-
     /* get the current socket and receive buffer size by receive data */
 
     /* mode 2 => +NSONMI:<socket>,<remote_addr>, <remote_port>,<length>,<data> */
-    rt_sscanf(data, "+NSONMI:%d,%[0123456789.],%d,%d,%s", &device_socket, remote_addr, &remote_port, (int *) &bfsz, hex_buf);
-    LOG_D("device socket(%d) recv %d bytes from %s:%d\n>> %s", device_socket, bfsz, remote_addr, remote_port, hex_buf);
+    rt_sscanf(data, "+NSONMI:%d,%[0123456789.],%d,%d,%n", &device_socket, remote_addr, &remote_port, (int *) &bfsz, &hex_offset);
+    LOG_D("device socket(%d) recv %d bytes from %s:%d", device_socket, bfsz, remote_addr, remote_port);
 
-    /* set receive timeout by receive buffer length, not less than 10 ms */
-    timeout = bfsz > 10 ? bfsz : 10;
-
-    if (device_socket < 0 || bfsz == 0)
+    if (device_socket < 0 || bfsz == 0 || hex_offset == 0 || size - hex_offset < bfsz * 2)
     {
         return;
     }
 
-    recv_buf = (char *) rt_calloc(1, bfsz + 1);
-
-    if (recv_buf == RT_NULL || hex_buf == RT_NULL)
+    recv_buf = (char *) at_device_recv_buf_alloc(device, bfsz + 1);
+    if (recv_buf == RT_NULL)
     {
         LOG_E("no memory for URC receive buffer(%d).", bfsz);
-        /* read and clean the coming data */
-        while (temp_size < bfsz)
-        {
-            if (bfsz - temp_size > sizeof(temp))
-            {
-                at_client_obj_recv(client, temp, sizeof(temp), timeout);
-            }
-            else
-            {
-                at_client_obj_recv(client, temp, bfsz - temp_size, timeout);
-            }
-            temp_size += sizeof(temp);
-        }
-
-        if (recv_buf) rt_free(recv_buf);
-        if (hex_buf)  rt_free(hex_buf);
         return;
     }
 
-    /* convert receive data */
-    hex_to_string(hex_buf, recv_buf, bfsz);
-    rt_free(hex_buf);
+    /* convert receive data from the URC line */
+    at_device_hex_decode(recv_buf, data + hex_offset, bfsz);
 
     /* get at socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
     /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
@@ -672,7 +620,7 @@ static void urc_dns_func(struct at_client *client, const char *data, rt_size_t s
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -700,6 +648,31 @@ static void urc_dns_func(struct at_client *client, const char *data, rt_size_t s
     }
 }
 
+#ifdef AT_DEVICE_USING_UPLINK
+static void urc_cscon_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int n = 0, mode = 0;
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_client(client);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return;
+    }
+
+    /* "+CSCON: <mode>" reports the RRC connection change, "+CSCON: <n>,<mode>" answers the query */
+    if (rt_sscanf(data, "+CSCON:%d,%d", &n, &mode) == 1)
+    {
+        mode = n;
+    }
+    at_device_uplink_notice(device, mode == 1);
+}
+#endif /* AT_DEVICE_USING_UPLINK */
+
 /* +NSOSTR:<socket>,<sequence>,<status> */
 static const struct at_urc urc_table[] =
 {
@@ -707,6 +680,9 @@ static const struct at_urc urc_table[] =
     {"+NSOSTR:",    "\r\n",       urc_send_func},
     {"+NSONMI:",    "\r\n",       urc_recv_func},
     {"+NSOCLI:",    "\r\n",       urc_close_func},
+#ifdef AT_DEVICE_USING_UPLINK
+    {"+CSCON:",     "\r\n",       urc_cscon_func},
+#endif
 };
 
 static const struct at_socket_ops bc28_socket_ops =
@@ -714,7 +690,7 @@ static const struct at_socket_ops bc28_socket_ops =
     bc28_socket_connect,
     bc28_socket_close,
     bc28_socket_send,
-    bc28_domain_resolve,
+    RT_NULL,
     bc28_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     bc28_socket_create,
@@ -728,7 +704,12 @@ int bc28_socket_init(struct at_device *device)
     /* register URC data execution function  */
     at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
+#ifdef AT_DEVICE_USING_UPLINK
+    /* the datagrams wait for the active window of PSM and eDRX */
+    return at_device_uplink_init(device);
+#else
     return RT_EOK;
+#endif
 }
 
 int bc28_socket_class_register(struct at_device_class *class)
@@ -737,6 +718,7 @@ int bc28_socket_class_register(struct at_device_class *class)
     rt_mutex_init(&dns_mutex, "dns", RT_IPC_FLAG_PRIO);
     class->socket_num = AT_DEVICE_BC28_SOCKETS_NUM;
     class->socket_ops = &bc28_socket_ops;
+    class->domain_resolve = bc28_domain_resolve;
 
     return RT_EOK;
 }
@@ -234,7 +234,7 @@ static int ec20_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(EC20_IMEI_RESP_SIZE, 0, EC20_INFO_RESP_TIMO);
+    resp = at_device_resp_get(device, EC20_IMEI_RESP_SIZE, 0, EC20_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -286,7 +286,11 @@ static int ec20_netdev_set_info(struct netdev *netdev)
         #define IP_ADDR_SIZE_MAX    16
         char ipaddr[IP_ADDR_SIZE_MAX] = {0};
 
-        resp = at_resp_set_info(resp, EC20_IPADDR_RESP_SIZE, 0, EC20_INFO_RESP_TIMO);
+        if (at_resp_set_info(resp, EC20_IPADDR_RESP_SIZE, 0, EC20_INFO_RESP_TIMO) == RT_NULL)
+        {
+            result = -RT_ENOMEM;
+            goto __exit;
+        }
 
         /* send "AT+QIACT?" commond to get IP address */
         if (at_obj_exec_cmd(device->client, resp, "AT+QIACT?") < 0)
@@ -315,7 +319,11 @@ static int ec20_netdev_set_info(struct netdev *netdev)
         #define DNS_ADDR_SIZE_MAX   16
         char dns_server1[DNS_ADDR_SIZE_MAX] = {0}, dns_server2[DNS_ADDR_SIZE_MAX] = {0};
 
-        resp = at_resp_set_info(resp, EC20_DNS_RESP_SIZE, 0, EC20_INFO_RESP_TIMO);
+        if (at_resp_set_info(resp, EC20_DNS_RESP_SIZE, 0, EC20_INFO_RESP_TIMO) == RT_NULL)
+        {
+            result = -RT_ENOMEM;
+            goto __exit;
+        }
 
         /* send "AT+QIDNSCFG=1" commond to get DNS servers address */
         if (at_obj_exec_cmd(device->client, resp, "AT+QIDNSCFG=1") < 0)
@@ -346,99 +354,12 @@ static int ec20_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
 }
 
-static void ec20_check_link_status_entry(void *parameter)
-{
-#define EC20_LINK_RESP_SIZE     64
-#define EC20_LINK_RESP_TIMO     (3 * RT_TICK_PER_SECOND)
-#define EC20_LINK_DELAY_TIME    (30 * RT_TICK_PER_SECOND)
-
-    int link_stat = 0;
-    at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
-    struct netdev *netdev = (struct netdev *) parameter;
-
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_NETDEV, netdev->name);
-    if (device == RT_NULL)
-    {
-        LOG_E("get device(%s) failed.", netdev->name);
-        return;
-    }
-
-    resp = at_create_resp(EC20_LINK_RESP_SIZE, 0, EC20_LINK_RESP_TIMO);
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for resp ceate.");
-        return;
-    }
-
-    while (1)
-    {
-        /* send "AT+CGREG" commond  to check netweork interface device link status */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CGREG?") < 0)
-        {
-            if (netdev_is_link_up(netdev))
-            {
-                netdev_low_level_set_link_status(netdev, RT_FALSE);
-            }
-
-            rt_thread_mdelay(EC20_LINK_DELAY_TIME);
-            continue;
-        }
-        else
-        {
-            at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %*d,%d", &link_stat);
-
-            /* 1 Registered, home network,5 Registered, roaming */
-            if (link_stat == 1 || link_stat == 5)
-            {
-                if (netdev_is_link_up(netdev) == RT_FALSE)
-                {
-                    netdev_low_level_set_link_status(netdev, RT_TRUE);
-                }
-            }
-            else
-            {
-                if (netdev_is_link_up(netdev))
-                {
-                    netdev_low_level_set_link_status(netdev, RT_FALSE);
-                }
-            }
-        }
-
-        rt_thread_mdelay(EC20_LINK_DELAY_TIME);
-    }
-}
-
-static int ec20_netdev_check_link_status(struct netdev *netdev)
-{
-#define EC20_LINK_THREAD_TICK           20
-#define EC20_LINK_THREAD_STACK_SIZE     (1024 + 512)
-#define EC20_LINK_THREAD_PRIORITY       (RT_THREAD_PRIORITY_MAX - 2)
-
-    rt_thread_t tid;
-    char tname[RT_NAME_MAX] = {0};
-
-    RT_ASSERT(netdev);
-
-    rt_snprintf(tname, RT_NAME_MAX, "%s", netdev->name);
-
-    /* create ec20 link status polling thread  */
-    tid = rt_thread_create(tname, ec20_check_link_status_entry, (void *)netdev,
-                           EC20_LINK_THREAD_STACK_SIZE, EC20_LINK_THREAD_PRIORITY, EC20_LINK_THREAD_TICK);
-    if (tid != RT_NULL)
-    {
-        rt_thread_startup(tid);
-    }
-
-    return RT_EOK;
-}
-
 static int ec20_net_init(struct at_device *device);
 
 static int ec20_netdev_set_up(struct netdev *netdev)
@@ -506,7 +427,7 @@ static int ec20_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(EC20_DNS_RESP_LEN, 0, EC20_DNS_RESP_TIMEO);
+    resp = at_device_resp_get(device, EC20_DNS_RESP_LEN, 0, EC20_DNS_RESP_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_D("no memory for resp create.");
@@ -526,7 +447,7 @@ static int ec20_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -565,7 +486,7 @@ static int ec20_netdev_ping(struct netdev *netdev, const char *host,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(EC20_PING_RESP_SIZE, 4, EC20_PING_TIMEO);
+    resp = at_device_resp_get(device, EC20_PING_RESP_SIZE, 4, EC20_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create");
@@ -612,7 +533,7 @@ static int ec20_netdev_ping(struct netdev *netdev, const char *host,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -674,7 +595,11 @@ static struct netdev *ec20_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, resp_line, timeout, cmd)                                         \
     do {                                                                                           \
-        (resp) = at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout));    \
+        if (at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout)) == RT_NULL) \
+        {                                                                                          \
+            result = -RT_ENOMEM;                                                                   \
+            goto __exit;                                                                           \
+        }                                                                                          \
         if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                                          \
         {                                                                                          \
             result = -RT_ERROR;                                                                    \
@@ -682,6 +607,46 @@ static struct netdev *ec20_netdev_add(const char *netdev_name)
         }                                                                                          \
     } while(0)                                                                                     \
 
+/* activate the lost packet data context of ec20 again, it's called by the link thread */
+static int ec20_link_recover(struct at_device *device)
+{
+    int result = RT_EOK;
+    char ipaddr[20] = {0};
+    at_response_t resp = RT_NULL;
+    struct at_client *client = device->client;
+
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    /* Deactivate context profile */
+    AT_SEND_CMD(client, resp, 0, 40 * 1000, "AT+QIDEACT=1");
+    /* Activate context profile */
+    AT_SEND_CMD(client, resp, 0, 150 * 1000, "AT+QIACT=1");
+    /* Query the status of the context profile */
+    AT_SEND_CMD(client, resp, 0, 150 * 1000, "AT+QIACT?");
+    if (at_resp_parse_line_args_by_kw(resp, "+QIACT:", "+QIACT: %*[^\"]\"%19[^\"]", ipaddr) <= 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+    LOG_I("%s device IP address: %s", device->name, ipaddr);
+
+__exit:
+    at_device_resp_put(device, resp);
+
+    if (result == RT_EOK)
+    {
+        /* the address may change with the context */
+        result = ec20_netdev_set_info(device->netdev);
+    }
+
+    return result;
+}
+
 /* initialize for ec20 */
 static void ec20_init_thread_entry(void *parameter)
 {
@@ -693,13 +658,14 @@ static void ec20_init_thread_entry(void *parameter)
 
     int i, qi_arg[3] = {0};
     int retry_num = INIT_RETRY;
+    int link_stat = -1;
     char parsed_data[20] = {0};
     rt_err_t result = RT_EOK;
     at_response_t resp = RT_NULL;
     struct at_device *device = (struct at_device *) parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -756,7 +722,11 @@ static void ec20_init_thread_entry(void *parameter)
         /* Use AT+CIMI to query the IMSI of SIM card */
         // AT_SEND_CMD(client, resp, 2, 300, "AT+CIMI");
         i = 0;
-        resp = at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(300));
+        if (at_resp_set_info(resp, 128, 0, rt_tick_from_millisecond(300)) == RT_NULL)
+        {
+            result = -RT_ENOMEM;
+            goto __exit;
+        }
         while(at_obj_exec_cmd(device->client, resp, "AT+CIMI") < 0)
         {
             i++;
@@ -809,27 +779,25 @@ static void ec20_init_thread_entry(void *parameter)
             result = -RT_ERROR;
             goto __exit;
         }
-        /* check the GPRS network is registered */
+        /* check the GPRS network is registered, the answer is taken by the registration URC */
         for (i = 0; i < CGREG_RETRY; i++)
         {
-            AT_SEND_CMD(client, resp, 0, 300, "AT+CGREG?");
-            at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %s", &parsed_data);
-            if (!rt_strncmp(parsed_data, "0,1", sizeof(parsed_data)) ||
-                    !rt_strncmp(parsed_data, "0,5", sizeof(parsed_data)))
+            link_stat = at_device_link_query(device, AT_DEVICE_LINK_GPRS);
+            if (link_stat == 1 || link_stat == 5)
             {
-                LOG_D("%s device GPRS is registered(%s)", device->name, parsed_data);
+                LOG_D("%s device GPRS is registered(%d)", device->name, link_stat);
                 break;
             }
             rt_thread_mdelay(1000);
         }
         if (i == CGREG_RETRY)
         {
-            LOG_E("%s device GPRS is register failed (%s)", device->name, parsed_data);
+            LOG_E("%s device GPRS is register failed (%d)", device->name, link_stat);
             result = -RT_ERROR;
             goto __exit;
         }
         /*Use AT+CEREG? to query current EPS Network Registration Status*/
-        AT_SEND_CMD(client, resp, 0, 300, "AT+CEREG?");
+        at_device_link_query(device, AT_DEVICE_LINK_EPS);
         /* Use AT+COPS? to query current Network Operator */
         AT_SEND_CMD(client, resp, 0, 300, "AT+COPS?");
         at_resp_parse_line_args_by_kw(resp, "+COPS:", "+COPS: %*[^\"]\"%[^\"]", &parsed_data);
@@ -882,18 +850,15 @@ static void ec20_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result == RT_EOK)
     {
         /* set network interface device status and address information */
         ec20_netdev_set_info(device->netdev);
-        /* check and create link staus sync thread  */
-        if (rt_thread_find(device->netdev->name) == RT_NULL)
-        {
-            ec20_netdev_check_link_status(device->netdev);
-        }
+        /* follow the link status by the registration reports */
+        at_device_link_watch(device, RT_NULL, ec20_link_recover);
 
         LOG_I("%s device network initialize success.", device->name);
     }
@@ -950,6 +915,7 @@ static int ec20_init(struct at_device *device)
 #ifdef AT_USING_SOCKET
     ec20_socket_init(device);
 #endif
+    at_device_link_init(device);
 
     /* add ec20 device to the netdev list */
     device->netdev = ec20_netdev_add(ec20->device_name);
@@ -20,9 +20,15 @@
 #ifdef AT_DEVICE_USING_EC200X
 
 #define EC200X_WAIT_CONNECT_TIME          10000
+#define EC200X_WAKEUP_TIME                1000
 #define EC200X_THREAD_STACK_SIZE          2048
 #define EC200X_THREAD_PRIORITY            (RT_THREAD_PRIORITY_MAX/2)
 
+/* The idle time in milliseconds before the module is put into sleep by auto sleep */
+#ifndef AT_DEVICE_EC200X_SLEEP_IDLE_TIME
+#define AT_DEVICE_EC200X_SLEEP_IDLE_TIME  5000
+#endif
+
 static int ec200x_power_on(struct at_device *device)
 {
     struct at_device_ec200x *ec200x = RT_NULL;
@@ -117,9 +123,10 @@ static int ec200x_power_off(struct at_device *device)
     return(RT_EOK);
 }
 
+/* the sleep state is kept by at_device_control(), so the sleep and wakeup are done on every call */
 static int ec200x_sleep(struct at_device *device)
 {
-    //at_response_t resp = RT_NULL;
+    at_response_t resp = RT_NULL;
     struct at_device_ec200x *ec200x = RT_NULL;
 
     ec200x = (struct at_device_ec200x *)device->user_data;
@@ -127,44 +134,36 @@ static int ec200x_sleep(struct at_device *device)
     {
         return(RT_EOK);
     }
-    if (ec200x->sleep_status)//is sleep status
-    {
-        return(RT_EOK);
-    }
     if (ec200x->wakeup_pin == -1)//use wakeup pin
     {
         LOG_E("no config wakeup pin, can not entry into sleep mode.");
         return(-RT_ERROR);
     }
-    /*
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_D("no memory for resp create.");
         return(-RT_ERROR);
     }
 
+    /* the module sleeps when it's idle and the wakeup pin (DTR) is high */
     if (at_obj_exec_cmd(device->client, resp, "AT+QSCLK=1") != RT_EOK)//enable sleep mode
-
     {
         LOG_D("enable sleep fail.\"AT+QSCLK=1\" execute fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return(-RT_ERROR);
     }
 
-    at_delete_resp(resp);
-    */
+    at_device_resp_put(device, resp);
 
     rt_pin_write(ec200x->wakeup_pin, PIN_HIGH);
 
-    ec200x->sleep_status = RT_TRUE;
-
     return(RT_EOK);
 }
 
 static int ec200x_wakeup(struct at_device *device)
 {
-    //at_response_t resp = RT_NULL;
     struct at_device_ec200x *ec200x = RT_NULL;
 
     ec200x = (struct at_device_ec200x *)device->user_data;
@@ -173,93 +172,35 @@ static int ec200x_wakeup(struct at_device *device)
         LOG_E("the power is off and the wake-up cannot be performed");
         return(-RT_ERROR);
     }
-    if ( ! ec200x->sleep_status)//no sleep status
+    if (ec200x->wakeup_pin == -1)//use wakeup pin
     {
         return(RT_EOK);
     }
 
+    /* the module is kept awake while the wakeup pin (DTR) is low */
     rt_pin_write(ec200x->wakeup_pin, PIN_LOW);
-    rt_thread_mdelay(200);
 
-    /*
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
-    if (resp == RT_NULL)
-    {
-        LOG_D("no memory for resp create.");
-        return(-RT_ERROR);
-    }
-    if (at_obj_exec_cmd(device->client, resp, "AT+QSCLK=0") != RT_EOK)//disable sleep mode
+    /* the module answers as soon as it's woken up */
+    if (at_device_ready_wait(device, EC200X_WAKEUP_TIME) != RT_EOK)
     {
-        LOG_D("wake up fail. \"AT+QSCLK=0\" execute fail.");
-        at_delete_resp(resp);
-        return(-RT_ERROR);
+        LOG_W("%s device is not ready after wake up.", device->name);
+        return(-RT_ETIMEOUT);
     }
-    at_delete_resp(resp);
-    */
-
-    ec200x->sleep_status = RT_FALSE;
 
     return(RT_EOK);
 }
 
-static int ec200x_check_link_status(struct at_device *device)
-{
-    at_response_t resp = RT_NULL;
-    struct at_device_ec200x *ec200x = RT_NULL;
-    int result = -RT_ERROR;
-
-    ec200x = (struct at_device_ec200x *)device->user_data;
-    if ( ! ec200x->power_status)//power off
-    {
-        LOG_D("the power is off.");
-        return(-RT_ERROR);
-    }
-    if (ec200x->sleep_status)//is sleep status
-    {
-        rt_pin_write(ec200x->wakeup_pin, PIN_LOW);
-        rt_thread_mdelay(200);
-    }
-
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
-    if (resp == RT_NULL)
-    {
-        LOG_D("no memory for resp create.");
-        return(-RT_ERROR);
-    }
-
-    result = -RT_ERROR;
-    if (at_obj_exec_cmd(device->client, resp, "AT+CGREG?") == RT_EOK)
-    {
-        int link_stat = 0;
-        if (at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %*d,%d", &link_stat) > 0)
-        {
-            if (link_stat == 1 || link_stat == 5)
-            {
-                result = RT_EOK;
-            }
-        }
-    }
-
-    at_delete_resp(resp);
-
-    if (ec200x->sleep_status)//is sleep status
-    {
-        rt_pin_write(ec200x->wakeup_pin, PIN_HIGH);
-    }
-
-    return(result);
-}
-
 static int ec200x_read_rssi(struct at_device *device)
 {
     int result = -RT_ERROR;
-    at_response_t resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    at_response_t resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_D("no memory for resp create.");
         return(result);
     }
 
+    at_device_wake_get(device);
     if (at_obj_exec_cmd(device->client, resp, "AT+CSQ") == RT_EOK)
     {
         int rssi = 0;
@@ -277,8 +218,9 @@ static int ec200x_read_rssi(struct at_device *device)
             result = RT_EOK;
         }
     }
+    at_device_wake_put(device);
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
 
     return(result);
 }
@@ -309,7 +251,7 @@ static int ec200x_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(EC200X_INFO_RESP_SIZE, 0, EC200X_INFO_RESP_TIMO);
+    resp = at_device_resp_get(device, EC200X_INFO_RESP_SIZE, 0, EC200X_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -429,63 +371,12 @@ static int ec200x_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
 }
 
-static void ec200x_check_link_status_entry(void *parameter)
-{
-#define EC200X_LINK_DELAY_TIME    (60 * RT_TICK_PER_SECOND)
-
-    rt_bool_t is_link_up;
-    struct at_device *device = RT_NULL;
-    struct netdev *netdev = (struct netdev *) parameter;
-
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_NETDEV, netdev->name);
-    if (device == RT_NULL)
-    {
-        LOG_E("get device(%s) failed.", netdev->name);
-        return;
-    }
-
-    while (1)
-    {
-        ec200x_read_rssi(device);
-
-        rt_thread_delay(EC200X_LINK_DELAY_TIME);
-
-        is_link_up = (ec200x_check_link_status(device) == RT_EOK);
-
-        netdev_low_level_set_link_status(netdev, is_link_up);
-    }
-}
-
-static int ec200x_netdev_check_link_status(struct netdev *netdev)
-{
-#define EC200X_LINK_THREAD_TICK           20
-#define EC200X_LINK_THREAD_STACK_SIZE     (1024 + 512)
-#define EC200X_LINK_THREAD_PRIORITY       (RT_THREAD_PRIORITY_MAX - 2)
-
-    rt_thread_t tid;
-    char tname[RT_NAME_MAX] = {0};
-
-    RT_ASSERT(netdev);
-
-    rt_snprintf(tname, RT_NAME_MAX, "%s", netdev->name);
-
-    /* create ec200x link status polling thread  */
-    tid = rt_thread_create(tname, ec200x_check_link_status_entry, (void *)netdev,
-                           EC200X_LINK_THREAD_STACK_SIZE, EC200X_LINK_THREAD_PRIORITY, EC200X_LINK_THREAD_TICK);
-    if (tid != RT_NULL)
-    {
-        rt_thread_startup(tid);
-    }
-
-    return RT_EOK;
-}
-
 static int ec200x_net_init(struct at_device *device);
 
 static int ec200x_netdev_set_up(struct netdev *netdev)
@@ -553,7 +444,7 @@ static int ec200x_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(EC200X_DNS_RESP_LEN, 0, EC200X_DNS_RESP_TIMEO);
+    resp = at_device_resp_get(device, EC200X_DNS_RESP_LEN, 0, EC200X_DNS_RESP_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_D("no memory for resp create.");
@@ -574,7 +465,7 @@ static int ec200x_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -613,7 +504,7 @@ static int ec200x_netdev_ping(struct netdev *netdev, const char *host,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(EC200X_PING_RESP_SIZE, 4, EC200X_PING_TIMEO);
+    resp = at_device_resp_get(device, EC200X_PING_RESP_SIZE, 4, EC200X_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create");
@@ -660,7 +551,7 @@ static int ec200x_netdev_ping(struct netdev *netdev, const char *host,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -696,7 +587,7 @@ void ec200x_netdev_netstat(struct netdev *netdev)
         goto __exit;
     }
 
-    resp = at_create_resp(EC200X_NETSTAT_RESP_SIZE, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, EC200X_NETSTAT_RESP_SIZE, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.", device->name);
@@ -729,7 +620,7 @@ void ec200x_netdev_netstat(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
     
     if (type)
@@ -799,6 +690,52 @@ static struct netdev *ec200x_netdev_add(const char *netdev_name)
 
 /* =============================  ec200x device operations ============================= */
 
+/* activate the lost packet data context of ec200x again, it's called by the link thread */
+static int ec200x_link_recover(struct at_device *device)
+{
+#define EC200X_RECOVER_RESP_SIZE       128
+
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+
+    resp = at_device_resp_get(device, EC200X_RECOVER_RESP_SIZE, 0, rt_tick_from_millisecond(40 * 1000));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    /* Deactivate context profile */
+    if (at_obj_exec_cmd(device->client, resp, "AT+QIDEACT=1") != RT_EOK)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* Activate context profile */
+    if (at_resp_set_info(resp, EC200X_RECOVER_RESP_SIZE, 0, rt_tick_from_millisecond(150 * 1000)) == RT_NULL)
+    {
+        result = -RT_ENOMEM;
+        goto __exit;
+    }
+    if (at_obj_exec_cmd(device->client, resp, "AT+QIACT=1") != RT_EOK)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+__exit:
+    at_device_resp_put(device, resp);
+
+    if (result == RT_EOK)
+    {
+        /* the address may change with the context */
+        result = ec200x_netdev_set_info(device->netdev);
+    }
+
+    return result;
+}
+
 /* initialize for ec200x */
 static void ec200x_init_thread_entry(void *parameter)
 {
@@ -816,7 +753,7 @@ static void ec200x_init_thread_entry(void *parameter)
     struct at_device *device = (struct at_device *) parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -908,22 +845,17 @@ static void ec200x_init_thread_entry(void *parameter)
             goto __exit;
         }
 
-        /* check the GPRS network is registered */
+        /* check the GPRS network is registered, the answer is taken by the registration URC */
         for (i = 0; i < CGREG_RETRY; i++)
         {
+            int link_stat = 0;
+
             rt_thread_mdelay(1000);
-            if (at_obj_exec_cmd(device->client, resp, "AT+CGREG?") == RT_EOK)
+            link_stat = at_device_link_query(device, AT_DEVICE_LINK_GPRS);
+            if ((link_stat == 1) || (link_stat == 5))
             {
-                int link_stat = 0;
-
-                if (at_resp_parse_line_args_by_kw(resp, "+CGREG:", "+CGREG: %*d,%d", &link_stat) > 0)
-                {
-                    if ((link_stat == 1) || (link_stat == 5))
-                    {
-                        LOG_D("%s device GPRS is registered", device->name);
-                        break;
-                    }
-                }
+                LOG_D("%s device GPRS is registered", device->name);
+                break;
             }
         }
         if (i == CGREG_RETRY)
@@ -950,7 +882,11 @@ static void ec200x_init_thread_entry(void *parameter)
         }
 
         /* Deactivate context profile */
-        resp = at_resp_set_info(resp, RESP_SIZE, 0, rt_tick_from_millisecond(40*1000));
+        if (at_resp_set_info(resp, RESP_SIZE, 0, rt_tick_from_millisecond(40*1000)) == RT_NULL)
+        {
+            result = -RT_ENOMEM;
+            goto __exit;
+        }
         if (at_obj_exec_cmd(device->client, resp, "AT+QIDEACT=1") != RT_EOK)
         {
             result = -RT_ERROR;
@@ -958,7 +894,11 @@ static void ec200x_init_thread_entry(void *parameter)
         }
 
         /* Activate context profile */
-        resp = at_resp_set_info(resp, RESP_SIZE, 0, rt_tick_from_millisecond(150*1000));
+        if (at_resp_set_info(resp, RESP_SIZE, 0, rt_tick_from_millisecond(150*1000)) == RT_NULL)
+        {
+            result = -RT_ENOMEM;
+            goto __exit;
+        }
         if (at_obj_exec_cmd(device->client, resp, "AT+QIACT=1") != RT_EOK)
         {
             result = -RT_ERROR;
@@ -982,18 +922,23 @@ static void ec200x_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result == RT_EOK)
     {
         /* set network interface device status and address information */
         ec200x_netdev_set_info(device->netdev);
-        /* check and create link staus sync thread  */
-        if (rt_thread_find(device->netdev->name) == RT_NULL)
+        /* follow the link status by the registration reports, the signal is read in the fallback */
+        at_device_link_watch(device, ec200x_read_rssi, ec200x_link_recover);
+
+#if defined(AT_USING_SOCKET) && defined(AT_DEVICE_USING_AUTO_SLEEP)
+        /* the sleep mode is enabled with wakeup pin, the module sleeps when it's idle */
+        if (((struct at_device_ec200x *)(device->user_data))->wakeup_pin != -1)
         {
-            ec200x_netdev_check_link_status(device->netdev);
+            at_device_auto_sleep_set(device, AT_DEVICE_EC200X_SLEEP_IDLE_TIME);
         }
+#endif
 
         LOG_I("%s device network initialize success.", device->name);
     }
@@ -1035,7 +980,6 @@ static int ec200x_init(struct at_device *device)
 
     ec200x = (struct at_device_ec200x *) device->user_data;
     ec200x->power_status = RT_FALSE;//default power is off.
-    ec200x->sleep_status = RT_FALSE;//default sleep is disabled.
 
     /* initialize AT client */
 #if RT_VER_NUM >= 0x50100
@@ -1055,6 +999,7 @@ static int ec200x_init(struct at_device *device)
 #ifdef AT_USING_SOCKET
     ec200x_socket_init(device);
 #endif
+    at_device_link_init(device);
 
     /* add ec200x device to the netdev list */
     device->netdev = ec200x_netdev_add(ec200x->device_name);
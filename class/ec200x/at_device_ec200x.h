@@ -38,7 +38,6 @@ struct at_device_ec200x
     void *user_data;
 
     rt_bool_t power_status;
-    rt_bool_t sleep_status;
     int rssi;
 };
 
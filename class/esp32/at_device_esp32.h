@@ -21,8 +21,14 @@ extern "C" {
 #define ESP32_DEFAULT_AT_VERSION         "1.4.0.0"
 #define ESP32_DEFAULT_AT_VERSION_NUM     0x1040000
 
-/* The maximum number of sockets supported by the esp32 device */
+/* The maximum number of sockets supported by the esp32 device, only one
+ * connection is supported in passthrough. The module reconnects by itself and
+ * doesn't report the connection closed by remote in passthrough */
+#ifdef AT_DEVICE_ESP32_PASSTHROUGH
+#define AT_DEVICE_ESP32_SOCKETS_NUM  1
+#else
 #define AT_DEVICE_ESP32_SOCKETS_NUM  5
+#endif
 
 struct at_device_esp32
 {
@@ -34,7 +40,6 @@ struct at_device_esp32
     size_t recv_line_num;
     struct at_device device;
 
-    uint16_t urc_socket;
     void *user_data;
 };
 typedef struct at_AP_INFO
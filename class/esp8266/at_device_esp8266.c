@@ -29,6 +29,20 @@ unsigned int ESP8266_GMR_AT_VERSION;
 
 static int esp8266_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip_addr_t *dns_server);
 
+/* the AT commands are taken as the socket data while the socket streams in passthrough */
+static rt_bool_t esp8266_is_passthrough(struct at_device *device)
+{
+#ifdef AT_DEVICE_ESP8266_PASSTHROUGH
+    if (device->passthrough)
+    {
+        LOG_E("%s device socket is in passthrough, close it first.", device->name);
+        return RT_TRUE;
+    }
+#endif
+
+    return RT_FALSE;
+}
+
 static void esp8266_get_netdev_info(struct rt_work *work, void *work_data)
 {
 #define AT_ADDR_LEN          32
@@ -53,7 +67,7 @@ static void esp8266_get_netdev_info(struct rt_work *work, void *work_data)
         rt_free(work);
     }
 
-    resp = at_create_resp(512, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 512, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -154,7 +168,7 @@ static void esp8266_get_netdev_info(struct rt_work *work, void *work_data)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 }
 
@@ -224,7 +238,12 @@ static int esp8266_netdev_set_addr_info(struct netdev *netdev, ip_addr_t *ip_add
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(IPADDR_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    if (esp8266_is_passthrough(device))
+    {
+        return -RT_EBUSY;
+    }
+
+    resp = at_device_resp_get(device, IPADDR_RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -273,7 +292,7 @@ static int esp8266_netdev_set_addr_info(struct netdev *netdev, ip_addr_t *ip_add
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -297,7 +316,12 @@ static int esp8266_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(DNS_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    if (esp8266_is_passthrough(device))
+    {
+        return -RT_EBUSY;
+    }
+
+    resp = at_device_resp_get(device, DNS_RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -318,7 +342,7 @@ static int esp8266_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num,
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -343,7 +367,12 @@ static int esp8266_netdev_set_dhcp(struct netdev *netdev, rt_bool_t is_enabled)
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    if (esp8266_is_passthrough(device))
+    {
+        return -RT_EBUSY;
+    }
+
+    resp = at_device_resp_get(device, RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp struct.");
@@ -366,7 +395,7 @@ static int esp8266_netdev_set_dhcp(struct netdev *netdev, rt_bool_t is_enabled)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -403,7 +432,12 @@ static int esp8266_netdev_ping(struct netdev *netdev, const char *host,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(64, 0, timeout);
+    if (esp8266_is_passthrough(device))
+    {
+        return -RT_EBUSY;
+    }
+
+    resp = at_device_resp_get(device, 64, 0, timeout);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -448,7 +482,7 @@ static int esp8266_netdev_ping(struct netdev *netdev, const char *host,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -476,6 +510,11 @@ void esp8266_netdev_netstat(struct netdev *netdev)
         return;
     }
 
+    if (esp8266_is_passthrough(device))
+    {
+        return;
+    }
+
     type = (char *) rt_calloc(1, ESP8266_NETSTAT_TYPE_SIZE);
     ipaddr = (char *) rt_calloc(1, ESP8266_NETSTAT_IPADDR_SIZE);
     if ((type && ipaddr) == RT_NULL)
@@ -484,7 +523,7 @@ void esp8266_netdev_netstat(struct netdev *netdev)
         goto __exit;
     }
 
-    resp = at_create_resp(ESP8266_NETSTAT_RESP_SIZE, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, ESP8266_NETSTAT_RESP_SIZE, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.", device->name);
@@ -516,7 +555,7 @@ void esp8266_netdev_netstat(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (type)
@@ -588,7 +627,11 @@ static struct netdev *esp8266_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, cmd)                                     \
     do {                                                                   \
-        (resp) = at_resp_set_info((resp), 256, 0, 5 * RT_TICK_PER_SECOND); \
+        if (at_resp_set_info((resp), 256, 0, 5 * RT_TICK_PER_SECOND) == RT_NULL) \
+        {                                                                  \
+            result = -RT_ENOMEM;                                           \
+            goto __exit;                                                   \
+        }                                                                  \
         if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                  \
         {                                                                  \
             result = -RT_ERROR;                                            \
@@ -629,7 +672,7 @@ static void esp8266_init_thread_entry(void *parameter)
         return;
     }
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -656,7 +699,16 @@ static void esp8266_init_thread_entry(void *parameter)
             LOG_D("%s", at_resp_get_line(resp, i + 1));
         }
 
+#ifdef AT_DEVICE_ESP8266_PASSTHROUGH
+        /* passthrough is only supported in single connection mode */
+        AT_SEND_CMD(client, resp, "AT+CIPMUX=0");
+#else
         AT_SEND_CMD(client, resp, "AT+CIPMUX=1");
+#endif
+#ifdef AT_DEVICE_ESP8266_RECV_PASSIVE
+        /* the received data is buffered in the module and read by AT+CIPRECVDATA */
+        AT_SEND_CMD(client, resp, "AT+CIPRECVMODE=1");
+#endif
 
         /* initialize successfully  */
         result = RT_EOK;
@@ -684,7 +736,7 @@ static void esp8266_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result != RT_EOK)
@@ -745,7 +797,7 @@ static void urc_func(struct at_client *client, const char *data, rt_size_t size)
     RT_ASSERT(client && data && size);
     char *client_name = client->device->parent.name;
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -830,6 +882,11 @@ static int esp8266_reset(struct at_device *device)
     int result = RT_EOK;
     struct at_client *client = device->client;
 
+    if (esp8266_is_passthrough(device))
+    {
+        return -RT_EBUSY;
+    }
+
     /* send "AT+RST" commonds to esp8266 device */
     result = at_obj_exec_cmd(client, RT_NULL, "AT+RST");
     rt_thread_mdelay(1000);
@@ -861,7 +918,12 @@ static int esp8266_wifi_info_set(struct at_device *device, struct at_device_ssid
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 0, 20 * RT_TICK_PER_SECOND);
+    if (esp8266_is_passthrough(device))
+    {
+        return -RT_EBUSY;
+    }
+
+    resp = at_device_resp_get(device, 128, 0, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -878,7 +940,7 @@ static int esp8266_wifi_info_set(struct at_device *device, struct at_device_ssid
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
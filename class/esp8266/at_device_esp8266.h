@@ -21,8 +21,14 @@ extern "C" {
 #define ESP8266_DEFAULT_AT_VERSION         "1.4.0.0"
 #define ESP8266_DEFAULT_AT_VERSION_NUM     0x1040000
 
-/* The maximum number of sockets supported by the esp8266 device */
+/* The maximum number of sockets supported by the esp8266 device, only one
+ * connection is supported in passthrough. The module reconnects by itself and
+ * doesn't report the connection closed by remote in passthrough */
+#ifdef AT_DEVICE_ESP8266_PASSTHROUGH
+#define AT_DEVICE_ESP8266_SOCKETS_NUM  1
+#else
 #define AT_DEVICE_ESP8266_SOCKETS_NUM  5
+#endif
 
 struct at_device_esp8266
 {
@@ -94,7 +94,7 @@ static int l610_sleep(struct at_device *device)
         return(RT_EOK);
     }
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -104,7 +104,7 @@ static int l610_sleep(struct at_device *device)
     if (at_obj_exec_cmd(device->client, resp, "AT+GTWAKE=1,2") != RT_EOK)
     {
         LOG_D("enable sleep fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return(-RT_ERROR);
     }
 
@@ -112,11 +112,11 @@ static int l610_sleep(struct at_device *device)
     if (at_obj_exec_cmd(device->client, resp, "ATS24=1") != RT_EOK)
     {
         LOG_D("startup entry into sleep fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return(-RT_ERROR);
     }
     #endif
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
     l610->sleep_status = RT_TRUE;
 
     LOG_D("sleep success.");
@@ -141,7 +141,7 @@ static int l610_wakeup(struct at_device *device)
     return(RT_EOK);
     }
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -161,11 +161,11 @@ static int l610_wakeup(struct at_device *device)
     if (at_obj_exec_cmd(device->client, resp, "AT+GTWAKE=0,2") != RT_EOK)
     {
         LOG_D("wake up fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return(-RT_ERROR);
     }
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
     l610->sleep_status = RT_FALSE;
 
     LOG_D("wake up success.");
@@ -203,7 +203,7 @@ static int l610_check_link_status(struct at_device *device)
     }
     #endif
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -233,7 +233,7 @@ static int l610_check_link_status(struct at_device *device)
     }
     #endif
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
 
     return(result);
 }
@@ -268,7 +268,7 @@ static int l610_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(L610_IMEI_RESP_SIZE, 0, L610_INFO_RESP_TIMO);
+    resp = at_device_resp_get(device, L610_IMEI_RESP_SIZE, 0, L610_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -344,7 +344,7 @@ static int l610_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -454,7 +454,7 @@ static int l610_ping_domain_resolve(struct at_device *device, const char *name,
     at_response_t resp = RT_NULL;
 
     /* The maximum response time is 14 seconds, affected by network status */
-    resp = at_create_resp(128, 4, 14 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 4, 14 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -500,7 +500,7 @@ static int l610_ping_domain_resolve(struct at_device *device, const char *name,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -554,7 +554,7 @@ static int l610_netdev_ping(struct netdev *netdev, const char *host,
         rt_memset(ip_addr, 0x00, L610_PING_IP_SIZE);
     }
 
-    resp = at_create_resp(L610_PING_RESP_SIZE,6, L610_PING_TIMEO);
+    resp = at_device_resp_get(device, L610_PING_RESP_SIZE,6, L610_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -600,7 +600,7 @@ static int l610_netdev_ping(struct netdev *netdev, const char *host,
  __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -662,7 +662,11 @@ static struct netdev *l610_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, resp_line, timeout, cmd)                                         \
     do {                                                                                           \
-        (resp) = at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout));    \
+        if (at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout)) == RT_NULL) \
+        {                                                                                          \
+            result = -RT_ENOMEM;                                                                   \
+            goto __exit;                                                                           \
+        }                                                                                          \
         if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                                          \
         {                                                                                          \
             result = -RT_ERROR;                                                                    \
@@ -691,7 +695,7 @@ static void l610_init_thread_entry(void *parameter)
     struct at_client *client = device->client;
 
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -881,7 +885,7 @@ static void l610_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result == RT_EOK)
@@ -21,12 +21,11 @@
 
 #if defined(AT_DEVICE_USING_L610) && defined(AT_USING_SOCKET)
 
+#if !defined (L610_MODULE_SEND_MAX_SIZE)
 #define L610_MODULE_SEND_MAX_SIZE   2048
+#endif
 static int l610_socket_fd[AT_DEVICE_L610_SOCKETS_NUM] = {-1};
 
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
-
 /* AT socket event type */
 #define L610_EVENT_CONN_OK          (1L << 0)
 #define L610_EVENT_SEND_OK          (1L << 1)
@@ -61,25 +60,6 @@ static int l610_get_socket_idx(int sock)
     return(-1);
 }
 
-static int l610_socket_event_send(struct at_device *device, uint32_t event)
-{
-    return (int) rt_event_send(device->socket_event, event);
-}
-
-static int l610_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option)
-{
-    int result = RT_EOK;
-    rt_uint32_t recved;
-
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
-    if (result != RT_EOK)
-    {
-        return -RT_ETIMEOUT;
-    }
-
-    return recved;
-}
-
 /**
  * close socket by AT commands.
  *
@@ -92,7 +72,6 @@ static int l610_socket_event_recv(struct at_device *device, uint32_t event, uint
  */
 static int l610_socket_close(struct at_socket *socket)
 {
-    uint32_t event = 0;
     int result = RT_EOK;
     int device_socket = (int) socket->user_data;
     int device_socket_id = (int) socket->user_data;
@@ -102,17 +81,18 @@ static int l610_socket_close(struct at_socket *socket)
         return RT_EOK;
     }
     device_socket_id=l610_socket_fd[device_socket];
+    /* the data buffered in the module is dropped with the connection */
+    at_device_pull_clear(device, device_socket);
     /* clear socket close event */
-    event = SET_EVENT(device_socket_id, L610_EVNET_CLOSE_OK);
-    l610_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, L610_EVNET_CLOSE_OK, 0, RT_EVENT_FLAG_OR);
 
-    if (at_obj_exec_cmd(device->client, NULL, "AT+MIPCLOSE=%d", device_socket_id) < 0)
+    if (at_device_exec_cmd(device, NULL, "AT+MIPCLOSE=%d", device_socket_id) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
     }
 
-    if (l610_socket_event_recv(device, event, rt_tick_from_millisecond(300*3), RT_EVENT_FLAG_AND) < 0)
+    if (at_device_socket_event_recv(device, device_socket, L610_EVNET_CLOSE_OK, rt_tick_from_millisecond(300*3), RT_EVENT_FLAG_AND) < 0)
     {
         LOG_E("%s device socket(%d) wait close OK timeout.", device->name, device_socket_id);
         result = -RT_ETIMEOUT;
@@ -173,7 +153,7 @@ static int l610_socket_connect(struct at_socket *socket, char *ip, int32_t port,
             return -RT_ERROR;
     }
 
-    resp = at_create_resp(CONN_RESP_SIZE, 0, rt_tick_from_millisecond(2000));
+    resp = at_device_resp_get(device, CONN_RESP_SIZE, 0, rt_tick_from_millisecond(2000));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -187,7 +167,7 @@ static int l610_socket_connect(struct at_socket *socket, char *ip, int32_t port,
 
 
 
-    if (at_obj_exec_cmd(device->client, resp, "AT+MIPOPEN?") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+MIPOPEN?") < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -202,7 +182,7 @@ static int l610_socket_connect(struct at_socket *socket, char *ip, int32_t port,
 
     at_resp_set_info(resp, CONN_RESP_SIZE, 4, (45*RT_TICK_PER_SECOND));
 
-    if(at_obj_exec_cmd(device->client, resp,"AT+MIPOPEN=%d,,\"%s\",%d,%d",sock, ip, port,type_code) < 0)
+    if(at_device_exec_cmd(device, resp,"AT+MIPOPEN=%d,,\"%s\",%d,%d",sock, ip, port,type_code) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -228,7 +208,7 @@ static int l610_socket_connect(struct at_socket *socket, char *ip, int32_t port,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -249,7 +229,6 @@ __exit:
  */
 static int l610_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
 {
-    uint32_t event = 0;
     int result = RT_EOK, event_result = 0;
     size_t cur_pkt_size = 0, sent_size = 0;
     at_response_t resp = RT_NULL;
@@ -267,7 +246,7 @@ static int l610_socket_send(struct at_socket *socket, const char *buff, size_t b
 
     RT_ASSERT(buff);
 
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 2, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -277,8 +256,7 @@ static int l610_socket_send(struct at_socket *socket, const char *buff, size_t b
     rt_mutex_take(lock, RT_WAITING_FOREVER);
 
     /* clear socket connect event */
-    event = SET_EVENT(sock, L610_EVENT_SEND_OK | L610_EVENT_SEND_FAIL);
-    l610_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, L610_EVENT_SEND_OK | L610_EVENT_SEND_FAIL, 0, RT_EVENT_FLAG_OR);
 
     /* set AT client end sign to deal with '>' sign.*/
     at_obj_set_end_sign(device->client, '>');
@@ -294,7 +272,7 @@ static int l610_socket_send(struct at_socket *socket, const char *buff, size_t b
         }
 
         /* send the "AT+QISEND" commands to AT server than receive the '>' response on the first line. */
-        if (at_obj_exec_cmd(device->client, resp, "AT+MIPSEND=%d,%d", sock, cur_pkt_size) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+MIPSEND=%d,%d", sock, cur_pkt_size) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -309,16 +287,8 @@ static int l610_socket_send(struct at_socket *socket, const char *buff, size_t b
         }
 
         /* waiting result event from AT URC */
-        if (l610_socket_event_recv(device, SET_EVENT(sock, 0), 15 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-        {
-            LOG_E("%s device socket(%d) wait send result timeout.", device->name, sock);
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-
-        /* waiting OK or failed result */
-        event_result = l610_socket_event_recv(device,
-                L610_EVENT_SEND_OK | L610_EVENT_SEND_FAIL, 5 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+        event_result = at_device_socket_event_recv(device, device_socket, L610_EVENT_SEND_OK | L610_EVENT_SEND_FAIL,
+                                                   15 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
         if (event_result < 0)
         {
             LOG_E("%s device socket(%d) wait send connect OK|FAIL timeout.", device->name, sock);
@@ -333,6 +303,7 @@ static int l610_socket_send(struct at_socket *socket, const char *buff, size_t b
             goto __exit;
         }
 
+        at_device_stats_send(device, device_socket, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -344,7 +315,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result > 0 ? sent_size : result;
@@ -353,6 +324,7 @@ __exit:
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -361,23 +333,15 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int l610_domain_resolve(const char *name, char ip[16])
+static int l610_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
     int result;
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first init device failed.");
-        return -RT_ERROR;
-    }
-
-    resp = at_create_resp(128, 0, (15 * RT_TICK_PER_SECOND));
+    resp = at_device_resp_get(device, 128, 0, (15 * RT_TICK_PER_SECOND));
     if (!resp)
     {
         LOG_E("no memory for resp create.");
@@ -387,7 +351,7 @@ static int l610_domain_resolve(const char *name, char ip[16])
         //      1: IPV6 address
         //      2: IPV4/IPV6 address
         //      <IP>: resolved IPV4 or IPV6 address (string without double quotes)
-    result = at_obj_exec_cmd(device->client, resp, "AT+MIPDNS=\"%s\",2", name);
+    result = at_device_exec_cmd(device, resp, "AT+MIPDNS=\"%s\",2", name);
     if (result != RT_EOK)
     {
         LOG_E("%s device \"AT+MIPDNS=\"%s\"\" cmd error.", device->name, name);
@@ -413,7 +377,7 @@ static int l610_domain_resolve(const char *name, char ip[16])
  __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -445,7 +409,7 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -454,16 +418,18 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     /* get the current socket by receive data */
     rt_sscanf(data, "+MIPPUSH: %d,%d", &device_socket,&result);
+    /* the completion event is kept by the index of the module socket */
+    device_socket = l610_get_socket_idx(device_socket);
 
 
     if (rt_strstr(data, "+MIPPUSH: ")){
         if(result==0)
         {
-            l610_socket_event_send(device, SET_EVENT(device_socket, L610_EVENT_SEND_OK));
+            at_device_socket_event_send(device, device_socket, L610_EVENT_SEND_OK);
         }
         else
         {
-            l610_socket_event_send(device, SET_EVENT(device_socket, L610_EVENT_SEND_FAIL));
+            at_device_socket_event_send(device, device_socket, L610_EVENT_SEND_FAIL);
         }
     }
 
@@ -478,7 +444,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -486,10 +452,15 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
     }
     /* get the current socket by receive data */
     rt_sscanf(data, "+MIPCLOSE: %d,%d", &device_socket,&result);
+    device_socket = l610_get_socket_idx(device_socket);
+    if (device_socket < 0)
+    {
+        return;
+    }
 
     if(result==0)
     {
-        l610_socket_event_send(device, SET_EVENT(device_socket, L610_EVNET_CLOSE_OK));
+        at_device_socket_event_send(device, device_socket, L610_EVNET_CLOSE_OK);
     }
     else
     {
@@ -507,114 +478,88 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 }
 
 
-//Receive data from buffer
+/**
+ * read the data buffered in the module by AT commands, the data is taken by
+ * the +MIPDATA URC.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ * @param size receive buffer size
+ *
+ * @return  0: read success
+ *         -1: send AT commands error or the socket is closed
+ *         -5: no memory
+ */
+static int l610_socket_pull_read(struct at_device *device, int device_socket, rt_size_t size)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+
+    if (l610_socket_fd[device_socket] == -1)
+    {
+        return -RT_ERROR;
+    }
+
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(5000));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    result = at_device_exec_cmd(device, resp, "AT+MIPREAD=%d,%d", l610_socket_fd[device_socket], size);
+
+    at_device_resp_put(device, resp);
+
+    return result;
+}
+
 static void urc_recv_cmd(struct at_client *client, const char *data, rt_size_t size)
 {
     int sock = -1;
-    rt_size_t bfsz;
+    rt_size_t bfsz = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
 
-
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
-    rt_sscanf(data,"+MIPREAD: %d,%d", &sock, (int *) &bfsz);
+    rt_sscanf(data, "+MIPREAD: %d,%d", &sock, (int *) &bfsz);
 
-    if(bfsz>0)
+    /* the data is read in the pull thread, AT commands can't be sent in URC */
+    if (bfsz > 0)
     {
-        if (at_obj_exec_cmd(client, NULL, "AT+MIPREAD=%d,%d", sock,bfsz) < 0)
-            {
-                LOG_E("send (%s) failed.", client_name);
-                return;
-            }
+        at_device_pull_notice(device, l610_get_socket_idx(sock));
     }
 }
 
-
-
 static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int device_socket = 0;
-    rt_int32_t timeout;
-    rt_size_t bfsz = 0, temp_size = 0;
-    char *recv_buf = RT_NULL, temp[8] = {0};
-    struct at_socket *socket = RT_NULL;
+    int sock = -1;
+    rt_size_t bfsz = 0;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
-    int sock = -1;
-    rt_size_t data_len;
-    RT_ASSERT(data && size);
-
 
-    /* get the current socket and receive buffer size by receive data */
-    rt_sscanf(data,"+MIPDATA: %d,%d", &sock, (int *) &bfsz);
-
-    device_socket = l610_get_socket_idx(sock);
-
-    if (device_socket < 0)
-    {
-        return;
-    }
-
-    /* set receive timeout by receive buffer length, not less than 10 ms */
-    timeout = bfsz > 10 ? bfsz : 10;
-
-    if (device_socket < 0 || bfsz == 0)
-    {
-        return;
-    }
+    RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
-    if (recv_buf == RT_NULL)
-    {
-        LOG_E("no memory for receive buffer(%d).", bfsz);
-        /* read and clean the coming data */
-        while (temp_size < bfsz)
-        {
-            if (bfsz - temp_size > sizeof(temp))
-            {
-                at_client_obj_recv(client, temp, sizeof(temp), timeout);
-            }
-            else
-            {
-                at_client_obj_recv(client, temp, bfsz - temp_size, timeout);
-            }
-            temp_size += sizeof(temp);
-        }
-        return;
-    }
-
-    /* sync receive data */
-    data_len=at_client_obj_recv(client, recv_buf, bfsz, timeout);
-    if (data_len != bfsz)
-    {
-        LOG_E("%s device receive size(%d) data failed.", device->name, bfsz);
-        rt_free(recv_buf);
-        return;
-    }
-
-    /* get AT socket object by device socket descriptor */
-    socket = &(device->sockets[device_socket]);
+    /* get the current socket and receive buffer size by receive data */
+    rt_sscanf(data, "+MIPDATA: %d,%d", &sock, (int *) &bfsz);
 
-    /* notice the receive buffer and buffer size */
-    if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
-    {
-        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
-    }
+    /* the data is taken by the read in progress */
+    at_device_pull_recv(device, bfsz);
 }
 
 
@@ -634,7 +579,7 @@ static const struct at_socket_ops l610_socket_ops =
     l610_socket_connect,
     l610_socket_close,
     l610_socket_send,
-    l610_domain_resolve,
+    RT_NULL,
     l610_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
@@ -648,7 +593,7 @@ int l610_socket_init(struct at_device *device)
     /* register URC data execution function  */
     at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
-    return RT_EOK;
+    return at_device_pull_init(device);
 }
 
 int l610_socket_class_register(struct at_device_class *class)
@@ -657,6 +602,8 @@ int l610_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_L610_SOCKETS_NUM;
     class->socket_ops = &l610_socket_ops;
+    class->domain_resolve = l610_domain_resolve;
+    class->pull_read = l610_socket_pull_read;
 
     return RT_EOK;
 }
@@ -103,7 +103,7 @@ static int m26_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(M26_IMEI_RESP_SIZE, 0, M26_INFO_RESP_TIMO);
+    resp = at_device_resp_get(device, M26_IMEI_RESP_SIZE, 0, M26_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -213,7 +213,7 @@ static int m26_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -238,7 +238,7 @@ static void check_link_status_entry(void *parameter)
         return;
     }
 
-    resp = at_create_resp(M26_LINK_RESP_SIZE, 0, M26_LINK_RESP_TIMO);
+    resp = at_device_resp_get(device, M26_LINK_RESP_SIZE, 0, M26_LINK_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -359,7 +359,7 @@ static int m26_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip_
         return - RT_ERROR;
     }
 
-    resp = at_create_resp(M26_DNS_RESP_LEN, 0, M26_DNS_RESP_TIMEO);
+    resp = at_device_resp_get(device, M26_DNS_RESP_LEN, 0, M26_DNS_RESP_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -378,7 +378,7 @@ static int m26_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip_
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
     return result;
 }
@@ -416,7 +416,7 @@ static int m26_netdev_ping(struct netdev *netdev, const char *host,
         return - RT_ERROR;
     }
 
-    resp = at_create_resp(M26_PING_RESP_SIZE, 5, M26_PING_TIMEO);
+    resp = at_device_resp_get(device, M26_PING_RESP_SIZE, 5, M26_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -462,7 +462,7 @@ static int m26_netdev_ping(struct netdev *netdev, const char *host,
  __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -523,7 +523,11 @@ static struct netdev *m26_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, resp_line, timeout, cmd)                                         \
     do {                                                                                           \
-        (resp) = at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout));    \
+        if (at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout)) == RT_NULL) \
+        {                                                                                          \
+            result = -RT_ENOMEM;                                                                   \
+            goto __exit;                                                                           \
+        }                                                                                          \
         if (at_obj_exec_cmd((client),(resp), (cmd)) < 0)                                           \
         {                                                                                          \
             result = -RT_ERROR;                                                                    \
@@ -548,7 +552,7 @@ static void m26_init_thread_entry(void *parameter)
     struct at_device *device = (struct at_device *)parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -701,7 +705,7 @@ static void m26_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result == RT_EOK)
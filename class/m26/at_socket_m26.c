@@ -19,10 +19,14 @@
 
 #if defined(AT_DEVICE_USING_M26) && defined(AT_USING_SOCKET)
 
+#if !defined (M26_MODULE_SEND_MAX_SIZE)
 #define M26_MODULE_SEND_MAX_SIZE       1460
+#endif
 
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
+/* The maximum TCP bytes sent and not acknowledged by peer kept in the module */
+#if !defined (M26_MODULE_SEND_WINDOW)
+#define M26_MODULE_SEND_WINDOW         (2 * M26_MODULE_SEND_MAX_SIZE)
+#endif
 
 /* AT socket event type */
 #define M26_EVENT_CONN_OK              (1L << 0)
@@ -38,25 +42,6 @@ static at_evt_cb_t at_evt_cb_set[] =
     [AT_SOCKET_EVT_CLOSED] = NULL,
 };
 
-static int m26_socket_event_send(struct at_device *device, uint32_t event)
-{
-    return (int) rt_event_send(device->socket_event, event);
-}
-
-static int m26_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option)
-{
-    int result = 0;
-    rt_uint32_t recved = 0;
-
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
-    if (result != RT_EOK)
-    {
-        return -RT_ETIMEOUT;
-    }
-
-    return recved;
-}
-
 /**
  * close socket by AT commands.
  *
@@ -74,15 +59,15 @@ static int m26_socket_close(struct at_socket *socket)
     struct at_device *device  = (struct at_device *) socket->device;
 
     /* clear socket close event */
-    m26_socket_event_recv(device, SET_EVENT(device_socke, M26_EVNET_CLOSE_OK), 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socke, M26_EVNET_CLOSE_OK, 0, RT_EVENT_FLAG_OR);
 
-    if (at_obj_exec_cmd(device->client, NULL, "AT+QICLOSE=%d", device_socke) < 0)
+    if (at_device_exec_cmd(device, NULL, "AT+QICLOSE=%d", device_socke) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
     }
 
-    if (m26_socket_event_recv(device, SET_EVENT(device_socke, M26_EVNET_CLOSE_OK),
+    if (at_device_socket_event_recv(device, device_socke, M26_EVNET_CLOSE_OK,
             rt_tick_from_millisecond(300 * 3), RT_EVENT_FLAG_AND) < 0)
     {
         LOG_E("%s device socket(%d) close failed, wait close OK timeout.", device->name, device_socke);
@@ -116,7 +101,7 @@ static int m26_socket_connect(struct at_socket *socket, char *ip, int32_t port,
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -129,8 +114,7 @@ static int m26_socket_connect(struct at_socket *socket, char *ip, int32_t port,
 __retry:
 
     /* clear socket connect event */
-    event_result = SET_EVENT(device_socket, M26_EVENT_CONN_OK | M26_EVENT_CONN_FAIL);
-    m26_socket_event_recv(device, event_result, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, M26_EVENT_CONN_OK | M26_EVENT_CONN_FAIL, 0, RT_EVENT_FLAG_OR);
 
     if (is_client)
     {
@@ -138,8 +122,8 @@ __retry:
         {
         case AT_SOCKET_TCP:
             /* send AT commands(eg: AT+QIOPEN=0,"TCP","x.x.x.x", 1234) to connect TCP server */
-            if (at_obj_exec_cmd(device->client, resp,
-                                "AT+QIOPEN=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
+            if (at_device_exec_cmd(device, resp,
+                                   "AT+QIOPEN=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -147,8 +131,8 @@ __retry:
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, resp,
-                                "AT+QIOPEN=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
+            if (at_device_exec_cmd(device, resp,
+                                   "AT+QIOPEN=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -162,15 +146,8 @@ __retry:
     }
 
     /* waiting result event from AT URC, the device default connection timeout is 75 seconds, but it set to 10 seconds is convenient to use.*/
-    if (m26_socket_event_recv(device, SET_EVENT(device_socket, 0), 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-    {
-        LOG_E("%s device socket(%d) wait connect result timeout.", device->name, device_socket);
-        result = -RT_ETIMEOUT;
-        goto __exit;
-    }
-    /* waiting OK or failed result */
-    if ((event_result = m26_socket_event_recv(device, M26_EVENT_CONN_OK | M26_EVENT_CONN_FAIL,
-            1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR)) < 0)
+    if ((event_result = at_device_socket_event_recv(device, device_socket, M26_EVENT_CONN_OK | M26_EVENT_CONN_FAIL,
+                                                    10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR)) < 0)
     {
         LOG_E("%s device socket(%d) wait connect OK|FAIL timeout.", device->name, device_socket);
         result = -RT_ETIMEOUT;
@@ -188,6 +165,7 @@ __retry:
                 goto __exit;
             }
             retryed = RT_TRUE;
+            AT_DEVICE_STATS_INC(device, retries);
             goto __retry;
         }
         LOG_E("%s device socket(%d) connect failed.", device->name, device_socket);
@@ -198,67 +176,119 @@ __retry:
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
 }
 
-static int at_get_send_size(struct at_socket *socket, size_t *size, size_t *acked, size_t *nacked)
+/**
+ * get the TCP bytes acknowledged and not acknowledged by peer by AT commands.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ * @param acked the bytes acknowledged by peer
+ * @param unacked the bytes not acknowledged by peer
+ *
+ * @return  0: get success
+ *         -1: send AT commands error or response error
+ *         -5: no memory
+ */
+static int m26_socket_send_ack(struct at_device *device, int device_socket, size_t *acked, size_t *unacked)
 {
-    int result = 0;
+    int result = RT_EOK;
+    int sent = 0, acked_size = 0, unacked_size = 0;
     at_response_t resp = RT_NULL;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
 
-    resp = at_create_resp(64, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 64, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
-        result = -RT_ENOMEM;
-        goto __exit;
+        return -RT_ENOMEM;
     }
 
-    if (at_obj_exec_cmd(device->client, resp, "AT+QISACK=%d", device_socket) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+QISACK=%d", device_socket) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
     }
 
-    if (at_resp_parse_line_args_by_kw(resp, "+QISACK:", "+QISACK: %d, %d, %d", size, acked, nacked) <= 0)
+    if (at_resp_parse_line_args_by_kw(resp, "+QISACK:", "+QISACK: %d, %d, %d", &sent, &acked_size, &unacked_size) <= 0)
     {
-        LOG_E("%s device prase \"AT+QISACK\" cmd error.", device->name);
         result = -RT_ERROR;
         goto __exit;
     }
 
+    *acked = acked_size;
+    *unacked = unacked_size;
+
 __exit:
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
+    at_device_resp_put(device, resp);
 
     return result;
 }
 
-static int at_wait_send_finish(struct at_socket *socket, size_t settings_size)
+/**
+ * send one packet to server or client by AT commands, the AT client is only locked
+ * until the packet is handed to the module, the "SEND OK" is waited without lock so
+ * that the packets of other sockets can be sent in the meantime.
+ *
+ * @param device current AT device
+ * @param resp AT response object
+ * @param device_socket current device socket
+ * @param buff packet buffer
+ * @param size packet size
+ *
+ * @return  0: send success
+ *         -1: send AT commands error or send data error
+ *         -3: the send completion queue is full
+ */
+static int m26_socket_send_packet(struct at_device *device, at_response_t resp, int device_socket,
+                                  const char *buff, size_t size)
 {
-    /* get the timeout by the input data size */
-    rt_tick_t timeout = rt_tick_from_millisecond(settings_size);
-    rt_tick_t last_time = rt_tick_get();
-    size_t size = 0, acked = 0, nacked = 0xFFFF;
+    int result = RT_EOK;
+    rt_mutex_t lock = at_device_get_client_lock(device);
+
+    rt_mutex_take(lock, RT_WAITING_FOREVER);
 
-    while (rt_tick_get() - last_time <= timeout)
+    /* queue current socket for send URC event */
+    if (at_device_socket_send_push(device, device_socket) < 0)
     {
-        at_get_send_size(socket, &size, &acked, &nacked);
-        if (nacked == 0)
-        {
-            return RT_EOK;
-        }
-        rt_thread_mdelay(50);
+        LOG_E("%s device socket(%d) send queue is full.", device->name, device_socket);
+        rt_mutex_release(lock);
+        return -RT_EFULL;
+    }
+
+    /* set AT client end sign to deal with '>' sign.*/
+    at_obj_set_end_sign(device->client, '>');
+
+    /* send the "AT+QISEND" commands to AT server than receive the '>' response on the first line. */
+    if (at_device_exec_cmd(device, resp, "AT+QISEND=%d,%d", device_socket, (int)size) < 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* send the real data to server or client */
+    if (at_client_obj_send(device->client, buff, size) == 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
     }
 
-    return -RT_ETIMEOUT;
+__exit:
+    if (result < 0)
+    {
+        /* the send result is no longer waited */
+        at_device_socket_send_remove(device, device_socket);
+    }
+
+    /* reset the end sign for data conflict */
+    at_obj_set_end_sign(device->client, 0);
+
+    rt_mutex_release(lock);
+
+    return result;
 }
 
 /**
@@ -277,71 +307,58 @@ static int at_wait_send_finish(struct at_socket *socket, size_t settings_size)
 static int m26_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
 {
     int result = 0, event_result = 0;
-    size_t pkt_size = 0, sent_size = 0;
+    size_t cur_pkt_size = 0, sent_size = 0;
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
-    struct at_device_m26 *m26 = (struct at_device_m26 *) device->user_data;
-    rt_mutex_t lock = at_device_get_client_lock(device);
 
     RT_ASSERT(buff);
 
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 2, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
         return -RT_ENOMEM;
     }
 
-    rt_mutex_take(lock, RT_WAITING_FOREVER);
-
-    /* Clear socket send event */
-    event_result = SET_EVENT(device_socket, M26_EVENT_SEND_OK | M26_EVENT_SEND_FAIL);
-    m26_socket_event_recv(device, event_result, 0, RT_EVENT_FLAG_OR);
-
-    /* set current socket for send URC event */
-    m26->user_data = (void *) device_socket;
-    /* set AT client end sign to deal with '>' sign.*/
-    at_obj_set_end_sign(device->client, '>');
+    /* clear socket send event */
+    at_device_socket_event_recv(device, device_socket, M26_EVENT_SEND_OK | M26_EVENT_SEND_FAIL, 0, RT_EVENT_FLAG_OR);
 
     while (sent_size < bfsz)
     {
         if (bfsz - sent_size < M26_MODULE_SEND_MAX_SIZE)
         {
-            pkt_size = bfsz - sent_size;
+            cur_pkt_size = bfsz - sent_size;
         }
         else
         {
-            pkt_size = M26_MODULE_SEND_MAX_SIZE;
+            cur_pkt_size = M26_MODULE_SEND_MAX_SIZE;
         }
 
-        /* send the "AT+QISEND" commands to AT server than receive the '>' response on the first line. */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QISEND=%d,%d", device_socket, pkt_size) < 0)
+        if (type == AT_SOCKET_TCP)
         {
-            result = -RT_ERROR;
-            goto __exit;
+            /* the module buffer is kept full, the peer is only asked when the send window is exhausted */
+            result = at_device_send_window_wait(device, device_socket, cur_pkt_size, 15 * RT_TICK_PER_SECOND);
+            if (result < 0)
+            {
+                goto __exit;
+            }
         }
 
-        /* send the real data to server or client */
-        result = (int) at_client_obj_send(device->client, buff + sent_size, pkt_size);
-        if (result == 0)
+        result = m26_socket_send_packet(device, resp, device_socket, buff + sent_size, cur_pkt_size);
+        if (result < 0)
         {
-            result = -RT_ERROR;
             goto __exit;
         }
 
-        /* waiting result event from AT URC */
-        if (m26_socket_event_recv(device, SET_EVENT(device_socket, 0), 15 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-        {
-            LOG_E("%s device socket(%d) wait send result timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-        /* waiting OK or failed result */
-        if ((event_result = m26_socket_event_recv(device, M26_EVENT_SEND_OK | M26_EVENT_SEND_FAIL,
-                1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR)) < 0)
+        /* waiting OK or failed result event from AT URC */
+        event_result = at_device_socket_event_recv(device, device_socket, M26_EVENT_SEND_OK | M26_EVENT_SEND_FAIL,
+                                                   15 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+        if (event_result < 0)
         {
             LOG_E("%s device socket(%d) wait send OK|FAIL timeout.", device->name, device_socket);
+            /* the late send result is taken by the cancelled send instead of the next one */
+            at_device_socket_send_cancel(device, device_socket, 15 * RT_TICK_PER_SECOND);
             result = -RT_ETIMEOUT;
             goto __exit;
         }
@@ -355,29 +372,26 @@ static int m26_socket_send(struct at_socket *socket, const char *buff, size_t bf
 
         if (type == AT_SOCKET_TCP)
         {
-            at_wait_send_finish(socket, pkt_size);
+            at_device_send_window_sent(device, device_socket, cur_pkt_size);
         }
 
-        sent_size += pkt_size;
+        at_device_stats_send(device, device_socket, cur_pkt_size);
+        sent_size += cur_pkt_size;
     }
 
 __exit:
-    /* reset the end sign for data conflict */
-    at_obj_set_end_sign(device->client, 0);
-
-    rt_mutex_release(lock);
-
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
-    return result > 0 ? sent_size : result;
+    return result < 0 ? result : (int) sent_size;
 }
 
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -386,27 +400,19 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int m26_domain_resolve(const char *name, char ip[16])
+static int m26_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
 #define RESOLVE_RETRY                  5
 
     int i, result = RT_EOK;
     char recv_ip[16] = { 0 };
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first init device failed.");
-        return -RT_ERROR;
-    }
-
     /* The maximum response time is 14 seconds, affected by network status */
-    resp = at_create_resp(128, 4, 14 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 4, 14 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -415,7 +421,7 @@ static int m26_domain_resolve(const char *name, char ip[16])
 
     for(i = 0; i < RESOLVE_RETRY; i++)
     {
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIDNSGIP=\"%s\"", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+QIDNSGIP=\"%s\"", name) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -447,7 +453,7 @@ static int m26_domain_resolve(const char *name, char ip[16])
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -476,7 +482,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -487,11 +493,11 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
 
     if (rt_strstr(data, "CONNECT OK"))
     {
-        m26_socket_event_send(device, SET_EVENT(device_socket, M26_EVENT_CONN_OK));
+        at_device_socket_event_send(device, device_socket, M26_EVENT_CONN_OK);
     }
     else
     {
-        m26_socket_event_send(device, SET_EVENT(device_socket, M26_EVENT_CONN_FAIL));
+        at_device_socket_event_send(device, device_socket, M26_EVENT_CONN_FAIL);
     }
 }
 
@@ -499,27 +505,30 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 {
     int device_socket = 0;
     struct at_device *device = RT_NULL;
-    struct at_device_m26 *m26 = RT_NULL;
     char *client_name = client->device->parent.name;
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
         return;
     }
-    m26 = (struct at_device_m26 *) device->user_data;
-    device_socket = (int) m26->user_data;
+    /* the send result has no socket number, it belongs to the oldest waiting send */
+    device_socket = at_device_socket_send_pop(device);
+    if (device_socket < 0)
+    {
+        return;
+    }
 
     if (rt_strstr(data, "SEND OK"))
     {
-        m26_socket_event_send(device, SET_EVENT(device_socket, M26_EVENT_SEND_OK));
+        at_device_socket_event_send(device, device_socket, M26_EVENT_SEND_OK);
     }
     else if (rt_strstr(data, "SEND FAIL"))
     {
-        m26_socket_event_send(device, SET_EVENT(device_socket, M26_EVENT_SEND_FAIL));
+        at_device_socket_event_send(device, device_socket, M26_EVENT_SEND_FAIL);
     }
 }
 
@@ -531,7 +540,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -542,7 +551,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     if (rt_strstr(data, "CLOSE OK"))
     {
-        m26_socket_event_send(device, SET_EVENT(device_socket, M26_EVNET_CLOSE_OK));
+        at_device_socket_event_send(device, device_socket, M26_EVNET_CLOSE_OK);
     }
     else if (rt_strstr(data, "CLOSED"))
     {
@@ -571,7 +580,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -589,7 +598,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    recv_buf = (char *) at_device_recv_buf_alloc(device, bfsz);
     if (recv_buf == RT_NULL)
     {
         LOG_E("no memory for receive buffer (%d).", device->name, bfsz);
@@ -621,6 +630,8 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     socket = &(device->sockets[device_socket]);
 
     /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
@@ -643,7 +654,7 @@ static const struct at_socket_ops m26_socket_ops =
     m26_socket_connect,
     m26_socket_close,
     m26_socket_send,
-    m26_domain_resolve,
+    RT_NULL,
     m26_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
@@ -666,6 +677,9 @@ int m26_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_M26_SOCKETS_NUM;
     class->socket_ops = &m26_socket_ops;
+    class->domain_resolve = m26_domain_resolve;
+    class->send_window = M26_MODULE_SEND_WINDOW;
+    class->send_ack = m26_socket_send_ack;
 
     return RT_EOK;
 }
@@ -87,7 +87,7 @@ static int m5311_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(M5311_IMEI_RESP_SIZE, 0, M5311_INFO_RESP_TIMO);
+    resp = at_device_resp_get(device, M5311_IMEI_RESP_SIZE, 0, M5311_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create <m5311 module>.");
@@ -199,7 +199,7 @@ static int m5311_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
     return result;
 }
@@ -228,7 +228,7 @@ static void check_link_status_entry(void *parameter)
         return;
     }
 
-    resp = at_create_resp(M5311_LINK_RESP_SIZE, 0, M5311_LINK_RESP_TIMO);
+    resp = at_device_resp_get(device, M5311_LINK_RESP_SIZE, 0, M5311_LINK_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -355,7 +355,7 @@ static int m5311_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, i
         return - RT_ERROR;
     }
 
-    resp = at_create_resp(M5311_DNS_RESP_LEN, 0, M5311_DNS_RESP_TIMEO);
+    resp = at_device_resp_get(device, M5311_DNS_RESP_LEN, 0, M5311_DNS_RESP_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -375,7 +375,7 @@ static int m5311_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, i
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
     return result;
 }
@@ -423,7 +423,7 @@ static int m5311_netdev_ping(struct netdev *netdev, const char *host,
         return - RT_ERROR;
     }
 
-    resp = at_create_resp(M5311_PING_RESP_SIZE, 5, M5311_PING_TIMEO);
+    resp = at_device_resp_get(device, M5311_PING_RESP_SIZE, 5, M5311_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -469,7 +469,7 @@ static int m5311_netdev_ping(struct netdev *netdev, const char *host,
  __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -528,7 +528,11 @@ static struct netdev *m5311_netdev_add(const char *netdev_name)
 /* =============================  m5311 device operations ============================= */
 #define AT_SEND_CMD(client, resp, resp_line, timeout, cmd)                                          \
     do {                                                                                            \
-        (resp) = at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout));     \
+        if (at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout)) == RT_NULL) \
+        {                                                                                           \
+            result = -RT_ENOMEM;                                                                    \
+            goto __exit;                                                                            \
+        }                                                                                           \
         if (at_obj_exec_cmd((client),(resp), (cmd)) < 0) {                                          \
             result = -RT_ERROR;                                                                     \
             goto __exit;                                                                            \
@@ -551,7 +555,7 @@ static void m5311_init_thread_entry(void *parameter)
     struct at_device *device = (struct at_device *)parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create(m5311).");
@@ -669,7 +673,7 @@ static void m5311_init_thread_entry(void *parameter)
     } //while end
 
     if (resp)
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
 
     if (result == RT_EOK)
     {
@@ -21,9 +21,6 @@
 
 #if defined(AT_DEVICE_USING_M5311) && defined(AT_USING_SOCKET)
 
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
-
 /* AT socket event type */
 #define M5311_EVENT_CONN_OK              (1L << 0)
 #define M5311_EVENT_SEND_OK              (1L << 1)
@@ -32,78 +29,6 @@
 #define M5311_EVENT_CONN_FAIL            (1L << 4)
 #define M5311_EVENT_SEND_FAIL            (1L << 5)
 
-/**
- * convert data from string to ASCII string.
- * @param source
- * @param dest
- * @param max_dest_len
- * @return
- */
-static int str_to_hex(const char *source, char *dest, int max_dest_len)
-{
-    int i = 0, j = 0;
-    char ch1, ch2;
-
-    while (j + 1 < max_dest_len)
-    {
-        ch1 = (source[i] & 0xF0) >> 4;
-        ch2 = source[i] & 0x0F;
-
-        if(ch1 <= 9)
-            *(dest + j) = ch1 + '0';
-        else
-            *(dest + j) = ch1 + 'A' - 10;
-
-        if(ch2 <= 9)
-            *(dest + j + 1) = ch2 + '0';
-        else
-            *(dest + j + 1) = ch2 + 'A' - 10;
-
-        i++;
-        j += 2;
-    }
-
-    *(dest + j) = '\0';
-
-    return j;
-}
-
-/**
- * convert data from Hex string to ASCII string.
- *
- * @param hex  input Hex string
- * @param str  output ASCII string
- * @param len  length of str, or the size you want to convert
- *
- * @return =0: convert failed, or no data need to convert
- *         >0: the size of convert success
- */
-static int hex_to_string(const char *hex, char *str, const rt_size_t len)
-{
-    RT_ASSERT(hex && str);
-
-    int hex_len = rt_strlen(hex);
-    int pos = 0, left, right, i;
-
-    if (len < 1 || hex_len/2 < len)
-    {
-        return 0;
-    }
-
-    for (i = 0; i < len*2; i++, pos++)
-    {
-        left = hex[i++];
-        right = hex[i];
-
-        left  = (left  < 58) ? (left  - 48) : (left  - 55);
-        right = (right < 58) ? (right - 48) : (right - 55);
-
-        str[pos] = (left << 4) | right;
-    }
-
-    return pos;
-}
-
 static at_evt_cb_t at_evt_cb_set[] =
 {
     [AT_SOCKET_EVT_RECV]    = NULL,
@@ -116,24 +41,6 @@ static struct at_socket_ip_info
     int  port;
 } m5311_sock_info[AT_DEVICE_M5311_SOCKETS_NUM];
 
-static int m5311_socket_event_send(struct at_device *device, uint32_t event)
-{
-    return (int) rt_event_send(device->socket_event, event);
-}
-
-static int m5311_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option)
-{
-    int result = 0;
-    rt_uint32_t recved = 0;
-
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
-    if (result != RT_EOK)
-    {
-        return -RT_ETIMEOUT;
-    }
-
-    return recved;
-}
 /**
  * close socket by AT commands.
  *
@@ -151,7 +58,7 @@ static int m5311_socket_close(struct at_socket *socket)
     int device_socket = (int) socket->user_data;
     struct at_device *device  = (struct at_device *) socket->device;
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(500));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(500));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.", device->name);
@@ -159,9 +66,9 @@ static int m5311_socket_close(struct at_socket *socket)
     }
 
     /* clear socket close event */
-    m5311_socket_event_recv(device, SET_EVENT(device_socket, M5311_EVNET_CLOSE_OK), 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, M5311_EVNET_CLOSE_OK, 0, RT_EVENT_FLAG_OR);
 
-    result = at_obj_exec_cmd(device->client, resp, "AT+IPCLOSE=%d", device_socket);
+    result = at_device_exec_cmd(device, resp, "AT+IPCLOSE=%d", device_socket);
     if (result == 0)
     {
         LOG_I("%s device close socket(%d).", device->name, device_socket);
@@ -171,7 +78,7 @@ static int m5311_socket_close(struct at_socket *socket)
         LOG_E("%s device socket(%d) close failed, wait close OK timeout.", device->name, device_socket);
     }
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
 
     return result;
 }
@@ -194,11 +101,11 @@ static int m5311_socket_connect(struct at_socket *socket, char *ip, int32_t port
 {
     rt_bool_t retryed = RT_FALSE;
     at_response_t resp = RT_NULL;
-    int result = 0, event_result = 0;
+    int result = 0;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
 
-    resp = at_create_resp(128, 0, 3 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 3 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -219,16 +126,19 @@ static int m5311_socket_connect(struct at_socket *socket, char *ip, int32_t port
 
 __retry:
     /* clear socket connect event */
-    event_result = SET_EVENT(device_socket, M5311_EVENT_CONN_OK | M5311_EVENT_CONN_FAIL);
-    m5311_socket_event_recv(device, event_result, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, M5311_EVENT_CONN_OK | M5311_EVENT_CONN_FAIL, 0, RT_EVENT_FLAG_OR);
 
     switch (type)
     {
     case AT_SOCKET_TCP:
-        resp = at_resp_set_info(resp, 128, 3, 10 * RT_TICK_PER_SECOND);
+        if (at_resp_set_info(resp, 128, 3, 10 * RT_TICK_PER_SECOND) == RT_NULL)
+        {
+            result = -RT_ENOMEM;
+            goto __exit;
+        }
         /* send AT commands(eg: AT+IPSTART=0,"TCP","x.x.x.x", 1234) to connect TCP server */
         /* AT+IPSTART=<sockid>,<type>,<addr>,<port>[,<cid>[,<domian>[,<protocol>]]] */
-        if (at_obj_exec_cmd(device->client, resp,
+        if (at_device_exec_cmd(device, resp,
                 "AT+IPSTART=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
         {
             result = -RT_ERROR;
@@ -242,7 +152,7 @@ __retry:
         break;
 
     case AT_SOCKET_UDP:
-        if (at_obj_exec_cmd(device->client, resp,
+        if (at_device_exec_cmd(device, resp,
                 "AT+IPSTART=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
         {
             result = -RT_ERROR;
@@ -269,6 +179,7 @@ __retry:
             goto __exit;
         }
         retryed = RT_TRUE;
+        AT_DEVICE_STATS_INC(device, retries);
         result = RT_EOK;
         goto __retry;
     }
@@ -276,7 +187,7 @@ __retry:
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -298,9 +209,9 @@ __exit:
 static int m5311_socket_send(struct at_socket *socket, const char *buff,
                             size_t bfsz, enum at_socket_type type)
 {
-    uint32_t event = 0;
     int result = 0, event_result = 0;
     size_t cur_pkt_size = 0, sent_size = 0;
+    char cmd[64] = {0};
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
@@ -308,7 +219,7 @@ static int m5311_socket_send(struct at_socket *socket, const char *buff,
 
     RT_ASSERT(buff);
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -318,8 +229,7 @@ static int m5311_socket_send(struct at_socket *socket, const char *buff,
     rt_mutex_take(lock, RT_WAITING_FOREVER);
 
     /* clear socket send event */
-    event = SET_EVENT(device_socket, M5311_EVENT_SEND_OK | M5311_EVENT_SEND_FAIL);
-    m5311_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, M5311_EVENT_SEND_OK | M5311_EVENT_SEND_FAIL, 0, RT_EVENT_FLAG_OR);
 
     /* only use for UDP socket */
     const char *ip = m5311_sock_info[device_socket].ip_addr;
@@ -336,30 +246,49 @@ static int m5311_socket_send(struct at_socket *socket, const char *buff,
             cur_pkt_size = M5311_MODULE_SEND_MAX_SIZE;
         }
 
-        char hex_data[bfsz * 2];
-        rt_memset(hex_data, 0, sizeof(hex_data));
-        str_to_hex(buff, hex_data, bfsz * 2);
-
+        /* the hex data is streamed between the command head and tail */
         switch (type)
         {
         case AT_SOCKET_TCP:
             /* TCP : AT+IPSEND=<socket_id>,[<data_len>],<data>[,<pri_flag>] */
-            if (at_obj_exec_cmd(device->client, resp, "AT+IPSEND=%d,%d,%s",
-                                device_socket, (int)cur_pkt_size, hex_data) < 0)
+            rt_snprintf(cmd, sizeof(cmd), "AT+IPSEND=%d,%d,", device_socket, (int)cur_pkt_size);
+            if (at_client_obj_send(device->client, cmd, rt_strlen(cmd)) == 0)
             {
-                LOG_D("%s", buff);
                 result = -RT_ERROR;
                 goto __exit;
             }
-            LOG_D("%s device TCP socket(%d) send %d bytes.\n>> %s", device->name, device_socket, (int)cur_pkt_size, buff);
+            if (at_device_hex_send(device, buff + sent_size, cur_pkt_size) != cur_pkt_size)
+            {
+                /* terminate the broken command line and drain its ERROR */
+                at_device_hex_abort(device, resp);
+                result = -RT_ERROR;
+                goto __exit;
+            }
+            if (at_device_exec_cmd(device, resp, "") < 0)
+            {
+                result = -RT_ERROR;
+                goto __exit;
+            }
+            LOG_D("%s device TCP socket(%d) send %d bytes.", device->name, device_socket, (int)cur_pkt_size);
             break;
 
         case AT_SOCKET_UDP:
             /* UDP : AT+IPSEND=<socket_id>,[<data_len>],<data>[,<addr>,<port>[,<pri_flag>]] */
-            if (at_obj_exec_cmd(device->client, resp, "AT+IPSEND=%d,%d,\"%s\",%s,%d,1",
-                                device_socket, (int)cur_pkt_size, hex_data, ip, port) < 0)
+            rt_snprintf(cmd, sizeof(cmd), "AT+IPSEND=%d,%d,\"", device_socket, (int)cur_pkt_size);
+            if (at_client_obj_send(device->client, cmd, rt_strlen(cmd)) == 0)
+            {
+                result = -RT_ERROR;
+                goto __exit;
+            }
+            if (at_device_hex_send(device, buff + sent_size, cur_pkt_size) != cur_pkt_size)
+            {
+                /* terminate the broken command line and drain its ERROR */
+                at_device_hex_abort(device, resp);
+                result = -RT_ERROR;
+                goto __exit;
+            }
+            if (at_device_exec_cmd(device, resp, "\",%s,%d,1", ip, port) < 0)
             {
-
                 result = -RT_ERROR;
                 goto __exit;
             }
@@ -381,16 +310,14 @@ static int m5311_socket_send(struct at_socket *socket, const char *buff,
         }
 
         /* waiting result event from AT URC, the device default timeout is 60 seconds*/
-        if (m5311_socket_event_recv(device, SET_EVENT(device_socket, 0),
-                                   60 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
+        event_result = at_device_socket_event_recv(device, device_socket, M5311_EVENT_SEND_OK | M5311_EVENT_SEND_FAIL,
+                                                   60 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+        if (event_result < 0)
         {
             LOG_E("%s device socket(%d) wait send result timeout.", device->name, device_socket);
             result = -RT_ETIMEOUT;
             goto __exit;
         }
-        /* waiting OK or failed result */
-        event_result = m5311_socket_event_recv(device, M5311_EVENT_SEND_OK | M5311_EVENT_SEND_FAIL,
-                                              1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
         if (event_result & M5311_EVENT_SEND_FAIL)
         {
             LOG_E("%s device socket(%d) send failed.", device->name, device_socket);
@@ -400,10 +327,10 @@ static int m5311_socket_send(struct at_socket *socket, const char *buff,
         else
         {
             LOG_D("%s device socket(%d) send success.", device->name, device_socket);
+            at_device_stats_send(device, device_socket, cur_pkt_size);
             sent_size += cur_pkt_size;
             result = sent_size;
         }
-        rt_memset(hex_data, 0, bfsz * 2);
     }
 
 __exit:
@@ -411,7 +338,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result > 0 ? sent_size : result;
@@ -420,6 +347,7 @@ __exit:
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -428,27 +356,19 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int m5311_domain_resolve(const char *name, char ip[16])
+static int m5311_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
 #define RESOLVE_RETRY                  5
 
     int i, result = RT_EOK;
     char recv_ip[16] = { 0 };
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first init device failed.");
-        return -RT_ERROR;
-    }
-
     /* The maximum response time is 3 seconds, affected by network status */
-    resp = at_create_resp(256, 4, 3 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 256, 4, 3 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -457,7 +377,7 @@ static int m5311_domain_resolve(const char *name, char ip[16])
 
     for(i = 0; i < RESOLVE_RETRY; i++)
     {
-        if (at_obj_exec_cmd(device->client, resp, "AT+CMDNS=\"%s\"", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CMDNS=\"%s\"", name) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -490,7 +410,7 @@ static int m5311_domain_resolve(const char *name, char ip[16])
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -518,7 +438,7 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -529,11 +449,11 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     if (data_size > 0)
     {
-        m5311_socket_event_send(device, SET_EVENT(device_socket, M5311_EVENT_SEND_OK));
+        at_device_socket_event_send(device, device_socket, M5311_EVENT_SEND_OK);
     }
     else
     {
-        m5311_socket_event_send(device, SET_EVENT(device_socket, M5311_EVENT_SEND_FAIL));
+        at_device_socket_event_send(device, device_socket, M5311_EVENT_SEND_FAIL);
     }
 }
 
@@ -546,7 +466,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -564,10 +484,9 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
 static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
 {
-    int device_socket = 0;
-    rt_int32_t timeout;
-    rt_size_t bfsz = 0, temp_size = 0;
-    char *recv_buf = RT_NULL, *hex_buf = RT_NULL, temp[8] = {0};
+    int device_socket = 0, hex_offset = 0;
+    rt_size_t bfsz = 0;
+    char *recv_buf = RT_NULL;
     char remote_addr[16] = {0};
     int remote_port = -1;
 
@@ -577,57 +496,36 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
-    hex_buf = (char *) rt_calloc(1, M5311_MODULE_RECV_MAX_SIZE * 2 + 1);
-
     /* get the current socket and receive buffer size by receive data */
     /* mode 2 => +IPRD: <socket>,<remote_addr>, <remote_port>,<length>,<data> */
-    rt_sscanf(data, "+IPRD: %d,\"%[0-9.]\",%d,%d,%s", &device_socket, remote_addr, &remote_port, (int *) &bfsz, hex_buf);
-
-    /* set receive timeout by receive buffer length, not less than 10 ms */
-    timeout = bfsz > 10 ? bfsz : 10;
+    rt_sscanf(data, "+IPRD: %d,\"%[0-9.]\",%d,%d,%n", &device_socket, remote_addr, &remote_port, (int *) &bfsz, &hex_offset);
 
-    if (device_socket < 0 || bfsz == 0)
+    if (device_socket < 0 || bfsz == 0 || hex_offset == 0 || size - hex_offset < bfsz * 2)
         return;
 
-    recv_buf = (char *) rt_calloc(1, bfsz + 1);
-
-    if (recv_buf == RT_NULL || hex_buf == RT_NULL)
+    recv_buf = (char *) at_device_recv_buf_alloc(device, bfsz + 1);
+    if (recv_buf == RT_NULL)
     {
         LOG_E("no memory for URC receive buffer(%d).", bfsz);
-        /* read and clean the coming data */
-        while (temp_size < bfsz)
-        {
-            if (bfsz - temp_size > sizeof(temp))
-            {
-                at_client_obj_recv(client, temp, sizeof(temp), timeout);
-            }
-            else
-            {
-                at_client_obj_recv(client, temp, bfsz - temp_size, timeout);
-            }
-            temp_size += sizeof(temp);
-        }
-
-        if (recv_buf) rt_free(recv_buf);
-        if (hex_buf)  rt_free(hex_buf);
         return;
     }
 
-    /* convert receive data */
-    hex_to_string(hex_buf, recv_buf, bfsz);
-    rt_free(hex_buf);
+    /* convert receive data from the URC line */
+    at_device_hex_decode(recv_buf, data + hex_offset, bfsz);
 
     /* get at socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
     /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
@@ -646,7 +544,7 @@ static const struct at_socket_ops m5311_socket_ops =
     m5311_socket_connect,
     m5311_socket_close,
     m5311_socket_send,
-    m5311_domain_resolve,
+    RT_NULL,
     m5311_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
@@ -669,6 +567,7 @@ int m5311_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_M5311_SOCKETS_NUM;
     class->socket_ops = &m5311_socket_ops;
+    class->domain_resolve = m5311_domain_resolve;
 
     return RT_EOK;
 }
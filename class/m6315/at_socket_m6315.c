@@ -19,10 +19,9 @@
 
 #if defined(AT_DEVICE_USING_M6315) && defined(AT_USING_SOCKET)
 
+#if !defined (M6315_MODULE_SEND_MAX_SIZE)
 #define M6315_MODULE_SEND_MAX_SIZE   1000
-
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
+#endif
 
 /* AT socket event type */
 #define M6315_EVENT_CONN_OK          (1L << 0)
@@ -38,25 +37,6 @@ static at_evt_cb_t at_evt_cb_set[] = {
         [AT_SOCKET_EVT_CLOSED] = NULL,
 };
 
-static int m6315_socket_event_send(struct at_device *device, uint32_t event)
-{
-    return (int) rt_event_send(device->socket_event, event);
-}
-
-static int m6315_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option)
-{
-    int result = RT_EOK;
-    rt_uint32_t recved;
-
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
-    if (result != RT_EOK)
-    {
-        return -RT_ETIMEOUT;
-    }
-
-    return recved;
-}
-
 /**
  * close socket by AT commands.
  *
@@ -69,22 +49,20 @@ static int m6315_socket_event_recv(struct at_device *device, uint32_t event, uin
  */
 static int m6315_socket_close(struct at_socket *socket)
 {
-    uint32_t event = 0;
     int result = RT_EOK;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
 
     /* clear socket close event */
-    event = SET_EVENT(device_socket, M6315_EVNET_CLOSE_OK);
-    m6315_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, M6315_EVNET_CLOSE_OK, 0, RT_EVENT_FLAG_OR);
 
-    if (at_obj_exec_cmd(device->client, NULL, "AT+QICLOSE=%d", device_socket) < 0)
+    if (at_device_exec_cmd(device, NULL, "AT+QICLOSE=%d", device_socket) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
     }
 
-    if (m6315_socket_event_recv(device, event, rt_tick_from_millisecond(300*3), RT_EVENT_FLAG_AND) < 0)
+    if (at_device_socket_event_recv(device, device_socket, M6315_EVNET_CLOSE_OK, rt_tick_from_millisecond(300*3), RT_EVENT_FLAG_AND) < 0)
     {
         LOG_E("%s device socket(%d) wait close OK timeout.", device->name, device_socket);
         result = -RT_ETIMEOUT;
@@ -112,7 +90,6 @@ __exit:
  */
 static int m6315_socket_connect(struct at_socket *socket, char *ip, int32_t port, enum at_socket_type type, rt_bool_t is_client)
 {
-    uint32_t event = 0;
     rt_bool_t retryed = RT_FALSE;
     at_response_t resp = RT_NULL;
     int result = RT_EOK, event_result = 0;
@@ -122,7 +99,7 @@ static int m6315_socket_connect(struct at_socket *socket, char *ip, int32_t port
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -132,8 +109,7 @@ static int m6315_socket_connect(struct at_socket *socket, char *ip, int32_t port
 __retry:
 
     /* clear socket connect event */
-    event = SET_EVENT(device_socket, M6315_EVENT_CONN_OK | M6315_EVENT_CONN_FAIL | M6315_EVENT_CONN_ALREADY);
-    m6315_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, M6315_EVENT_CONN_OK | M6315_EVENT_CONN_FAIL | M6315_EVENT_CONN_ALREADY, 0, RT_EVENT_FLAG_OR);
 
     if (is_client)
     {
@@ -141,8 +117,8 @@ __retry:
         {
         case AT_SOCKET_TCP:
             /* send AT commands(eg: AT+QIOPEN=0,"TCP","x.x.x.x", 1234) to connect TCP server */
-            if (at_obj_exec_cmd(device->client, RT_NULL,
-                                "AT+QIOPEN=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
+            if (at_device_exec_cmd(device, RT_NULL,
+                                   "AT+QIOPEN=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -150,8 +126,8 @@ __retry:
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, RT_NULL,
-                                "AT+QIOPEN=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
+            if (at_device_exec_cmd(device, RT_NULL,
+                                   "AT+QIOPEN=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -166,15 +142,8 @@ __retry:
     }
 
     /* waiting result event from AT URC, the device default connection timeout is 75 seconds, but it set to 10 seconds is convenient to use */
-    if (m6315_socket_event_recv(device, SET_EVENT(device_socket, 0), 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-    {
-        LOG_E("%s device socket(%d) wait connect result timeout.", device->name, device_socket);
-        result = -RT_ETIMEOUT;
-        goto __exit;
-    }
-    /* waiting OK or failed result */
-    event_result = m6315_socket_event_recv(device,
-            M6315_EVENT_CONN_OK | M6315_EVENT_CONN_FAIL | M6315_EVENT_CONN_ALREADY, 1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+    event_result = at_device_socket_event_recv(device, device_socket, M6315_EVENT_CONN_OK | M6315_EVENT_CONN_FAIL | M6315_EVENT_CONN_ALREADY,
+                                               10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
     if (event_result < 0)
     {
         LOG_E("%s device socket(%d) wait connect OK|FAIL|ALREADY timeout.", device->name, device_socket);
@@ -194,6 +163,7 @@ __retry:
                 goto __exit;
             }
             retryed = RT_TRUE;
+            AT_DEVICE_STATS_INC(device, retries);
             goto __retry;
         }
         LOG_E("%s device socket(%d) connect failed.", device->name, device_socket);
@@ -204,7 +174,7 @@ __retry:
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -225,7 +195,6 @@ __exit:
  */
 static int m6315_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
 {
-    uint32_t event = 0;
     int result = RT_EOK, event_result = 0;
     size_t cur_pkt_size = 0, sent_size = 0;
     at_response_t resp = RT_NULL;
@@ -235,7 +204,7 @@ static int m6315_socket_send(struct at_socket *socket, const char *buff, size_t
 
     RT_ASSERT(buff);
 
-    resp = at_create_resp(128, 2, 20 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 2, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -245,8 +214,7 @@ static int m6315_socket_send(struct at_socket *socket, const char *buff, size_t
     rt_mutex_take(lock, RT_WAITING_FOREVER);
 
     /* clear socket connect event */
-    event = SET_EVENT(device_socket, M6315_EVENT_SEND_OK | M6315_EVENT_SEND_FAIL);
-    m6315_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, M6315_EVENT_SEND_OK | M6315_EVENT_SEND_FAIL, 0, RT_EVENT_FLAG_OR);
 
     /* set AT client end sign to deal with '>' sign.*/
     at_obj_set_end_sign(device->client, '>');
@@ -263,7 +231,7 @@ static int m6315_socket_send(struct at_socket *socket, const char *buff, size_t
         }
 
         /* send the "AT+QISEND" commands to AT server than receive the '>' response on the first line. */
-        if (at_obj_exec_cmd(device->client, resp, "AT+QISEND=%d,%d", device_socket, cur_pkt_size) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+QISEND=%d,%d", device_socket, cur_pkt_size) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -278,15 +246,8 @@ static int m6315_socket_send(struct at_socket *socket, const char *buff, size_t
         }
 
         /* waiting result event from AT URC */
-        if (m6315_socket_event_recv(device, SET_EVENT(device_socket, 0), 20 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-        {
-            LOG_E("%s device socket(%d) wait send result timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-        /* waiting OK or failed result */
-        event_result = m6315_socket_event_recv(device,
-                M6315_EVENT_SEND_OK | M6315_EVENT_SEND_FAIL, 15 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+        event_result = at_device_socket_event_recv(device, device_socket, M6315_EVENT_SEND_OK | M6315_EVENT_SEND_FAIL,
+                                                   20 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
         if (event_result < 0)
         {
             LOG_E("%s device socket(%d) wait send connect OK|FAIL timeout.", device->name, device_socket);
@@ -301,6 +262,7 @@ static int m6315_socket_send(struct at_socket *socket, const char *buff, size_t
             goto __exit;
         }
 
+        at_device_stats_send(device, device_socket, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -312,7 +274,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result > 0 ? sent_size : result;
@@ -321,6 +283,7 @@ __exit:
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -329,27 +292,19 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int m6315_domain_resolve(const char *name, char ip[16])
+static int m6315_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
 #define RESOLVE_RETRY                  5
 
     int i, result = RT_EOK;
     char recv_ip[16] = { 0 };
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first init device failed.");
-        return -RT_ERROR;
-    }
-
     /* The maximum response time is 20 seconds, affected by network status */
-    resp = at_create_resp(128, 4, 20 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 4, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -359,7 +314,7 @@ static int m6315_domain_resolve(const char *name, char ip[16])
     for (i = 0; i < RESOLVE_RETRY; i++)
     {
 
-        if (at_obj_exec_cmd(device->client, resp, "AT+QIDNSGIP=\"%s\"", name) < 0)      //MODIFY name
+        if (at_device_exec_cmd(device, resp, "AT+QIDNSGIP=\"%s\"", name) < 0)      //MODIFY name
         {
             result = -RT_ERROR;
             goto __exit;
@@ -390,7 +345,7 @@ static int m6315_domain_resolve(const char *name, char ip[16])
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -419,7 +374,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -428,7 +383,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
 
     if (strstr(data, "ALREADY CONNECT"))
     {
-        m6315_socket_event_send(device, SET_EVENT(device_socket, M6315_EVENT_CONN_ALREADY));
+        at_device_socket_event_send(device, device_socket, M6315_EVENT_CONN_ALREADY);
         return;
     }
 
@@ -437,11 +392,11 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
 
     if (strstr(data, "CONNECT OK"))
     {
-        m6315_socket_event_send(device, SET_EVENT(device_socket, M6315_EVENT_CONN_OK));
+        at_device_socket_event_send(device, device_socket, M6315_EVENT_CONN_OK);
     }
     else if (strstr(data, "CONNECT FAIL"))
     {
-        m6315_socket_event_send(device, SET_EVENT(device_socket, M6315_EVENT_CONN_FAIL));
+        at_device_socket_event_send(device, device_socket, M6315_EVENT_CONN_FAIL);
     }
 }
 
@@ -453,7 +408,7 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -465,11 +420,11 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     if (rt_strstr(data, "SEND OK"))
     {
-        m6315_socket_event_send(device, SET_EVENT(device_socket, M6315_EVENT_SEND_OK));
+        at_device_socket_event_send(device, device_socket, M6315_EVENT_SEND_OK);
     }
     else if (rt_strstr(data, "SEND FAIL"))
     {
-        m6315_socket_event_send(device, SET_EVENT(device_socket, M6315_EVENT_SEND_FAIL));
+        at_device_socket_event_send(device, device_socket, M6315_EVENT_SEND_FAIL);
     }
 }
 
@@ -481,7 +436,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -493,7 +448,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     if (rt_strstr(data, "CLOSE OK"))
     {
-        m6315_socket_event_send(device, SET_EVENT(device_socket, M6315_EVNET_CLOSE_OK));
+        at_device_socket_event_send(device, device_socket, M6315_EVNET_CLOSE_OK);
     }
     else if (rt_strstr(data, "CLOSED"))
     {
@@ -532,14 +487,14 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    recv_buf = (char *) at_device_recv_buf_alloc(device, bfsz);
     if (recv_buf == RT_NULL)
     {
         LOG_E("no memory for receive buffer(%d).", bfsz);
@@ -571,6 +526,8 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     socket = &(device->sockets[device_socket]);
 
     /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
@@ -595,7 +552,7 @@ static const struct at_socket_ops m6315_socket_ops =
     m6315_socket_connect,
     m6315_socket_close,
     m6315_socket_send,
-    m6315_domain_resolve,
+    RT_NULL,
     m6315_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
@@ -618,6 +575,7 @@ int m6315_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_M6315_SOCKETS_NUM;
     class->socket_ops = &m6315_socket_ops;
+    class->domain_resolve = m6315_domain_resolve;
 
     return RT_EOK;
 }
@@ -53,7 +53,7 @@ static int me3616_power_off(struct at_device *device)
     at_response_t resp = RT_NULL;
     struct at_device_me3616 *me3616 = RT_NULL;
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -64,11 +64,11 @@ static int me3616_power_off(struct at_device *device)
     /*if (at_obj_exec_cmd(device->client, resp, "AT+ZTURNOFF") != RT_EOK)
     {
         LOG_D("power off fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return(-RT_ERROR);
     }*/
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
 
     me3616 = (struct at_device_me3616 *)device->user_data;
     me3616->power_status = RT_FALSE;
@@ -93,7 +93,7 @@ static int me3616_sleep(struct at_device *device)
         return(RT_EOK);
     }
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -103,7 +103,7 @@ static int me3616_sleep(struct at_device *device)
     if (at_obj_exec_cmd(device->client, resp, "AT+CPSMS=1,,,\"00111110\",\"00000001\"") != RT_EOK)
     {
         LOG_D("enable sleep fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return(-RT_ERROR);
     }
 
@@ -111,12 +111,12 @@ static int me3616_sleep(struct at_device *device)
     if (at_obj_exec_cmd(device->client, resp, "AT+ZSLR") != RT_EOK)
     {
         LOG_D("startup entry into sleep fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return(-RT_ERROR);
     }
     #endif
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
     me3616->sleep_status = RT_TRUE;
 
     LOG_D("sleep success.");
@@ -140,7 +140,7 @@ static int me3616_wakeup(struct at_device *device)
         return(RT_EOK);
     }
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -160,11 +160,11 @@ static int me3616_wakeup(struct at_device *device)
     if (at_obj_exec_cmd(device->client, resp, "AT+CPSMS=0") != RT_EOK)
     {
         LOG_D("wake up fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return(-RT_ERROR);
     }
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
     me3616->sleep_status = RT_FALSE;
 
     LOG_D("wake up success.");
@@ -200,7 +200,7 @@ static int me3616_check_link_status(struct at_device *device)
     }
     #endif
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -230,7 +230,7 @@ static int me3616_check_link_status(struct at_device *device)
     }
     #endif
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
 
     return(result);
 }
@@ -262,7 +262,7 @@ static int me3616_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(ME3616_INFO_RESP_SIZE, 0, ME3616_INFO_RESP_TIMO);
+    resp = at_device_resp_get(device, ME3616_INFO_RESP_SIZE, 0, ME3616_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -339,7 +339,7 @@ static int me3616_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -475,7 +475,7 @@ static int me3616_netdev_ping(struct netdev *netdev, const char *host,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(ME3616_PING_RESP_SIZE, 0, ME3616_PING_TIMEO);
+    resp = at_device_resp_get(device, ME3616_PING_RESP_SIZE, 0, ME3616_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create");
@@ -518,7 +518,7 @@ static int me3616_netdev_ping(struct netdev *netdev, const char *host,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -593,7 +593,7 @@ static void me3616_init_thread_entry(void *parameter)
     struct at_device *device = (struct at_device *) parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(256, 0, rt_tick_from_millisecond(500));
+    resp = at_device_resp_get(device, 256, 0, rt_tick_from_millisecond(500));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -779,7 +779,7 @@ static void me3616_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result == RT_EOK)
@@ -18,7 +18,9 @@
 
 #if defined(AT_DEVICE_USING_ME3616) && defined(AT_USING_SOCKET)
 
+#if !defined (ME3616_MODULE_SEND_MAX_SIZE)
 #define ME3616_MODULE_SEND_MAX_SIZE       512
+#endif
 
 static int me3616_socket_fd[AT_DEVICE_ME3616_SOCKETS_NUM] = {0};
 
@@ -67,17 +69,17 @@ static int me3616_socket_close(struct at_socket *socket)
         return RT_EOK;
     }
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
         return -RT_ENOMEM;
     }
 
-    result = at_obj_exec_cmd(device->client, resp, "AT+ESOCL=%d", me3616_socket_fd[device_socket]);
+    result = at_device_exec_cmd(device, resp, "AT+ESOCL=%d", me3616_socket_fd[device_socket]);
     me3616_socket_fd[device_socket] = -1;
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
 
     return result;
 }
@@ -129,7 +131,7 @@ static int me3616_socket_connect(struct at_socket *socket, char *ip, int32_t por
             return -RT_ERROR;
     }
 
-    resp = at_create_resp(CONN_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, CONN_RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -138,11 +140,11 @@ static int me3616_socket_connect(struct at_socket *socket, char *ip, int32_t por
 
     if (me3616_socket_fd[device_socket] != -1)
     {
-        at_obj_exec_cmd(device->client, resp, "AT+ESOCL=%d", me3616_socket_fd[device_socket]);
+        at_device_exec_cmd(device, resp, "AT+ESOCL=%d", me3616_socket_fd[device_socket]);
         me3616_socket_fd[device_socket] = -1;
     }
 
-    if (at_obj_exec_cmd(device->client, resp, "AT+ESOC=1,%d,1", type_code) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+ESOC=1,%d,1", type_code) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -155,10 +157,10 @@ static int me3616_socket_connect(struct at_socket *socket, char *ip, int32_t por
     }
 
     at_resp_set_info(resp, CONN_RESP_SIZE, 0, (45*RT_TICK_PER_SECOND));
-    if (at_obj_exec_cmd(device->client, resp, "AT+ESOCON=%d,%d,\"%s\"", sock, port, ip) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+ESOCON=%d,%d,\"%s\"", sock, port, ip) < 0)
     {
         at_resp_set_info(resp, CONN_RESP_SIZE, 0, rt_tick_from_millisecond(300));
-        at_obj_exec_cmd(device->client, resp, "AT+ESOCL=%d", sock);
+        at_device_exec_cmd(device, resp, "AT+ESOCL=%d", sock);
         result = -RT_ERROR;
         goto __exit;
     }
@@ -168,7 +170,7 @@ static int me3616_socket_connect(struct at_socket *socket, char *ip, int32_t por
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -182,14 +184,14 @@ static int at_get_send_size(struct at_socket *socket, size_t *nacked)
     struct at_device *device = (struct at_device *) socket->device;
     int remain_size;
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.", device->name);
         return -RT_ENOMEM;
     }
 
-    if (at_obj_exec_cmd(device->client, resp, "AT+ESOTCPBUF=%d", me3616_socket_fd[device_socket]) < 0)
+    if (at_device_exec_cmd(device, resp, "AT+ESOTCPBUF=%d", me3616_socket_fd[device_socket]) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -206,7 +208,7 @@ static int at_get_send_size(struct at_socket *socket, size_t *nacked)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -256,7 +258,7 @@ static int me3616_socket_send(struct at_socket *socket, const char *buff, size_t
 
     RT_ASSERT(buff);
 
-    resp = at_create_resp(SEND_RESP_SIZE, 2, RT_TICK_PER_SECOND/2);
+    resp = at_device_resp_get(device, SEND_RESP_SIZE, 2, RT_TICK_PER_SECOND/2);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -277,7 +279,7 @@ static int me3616_socket_send(struct at_socket *socket, const char *buff, size_t
         }
 
         at_resp_set_info(resp, SEND_RESP_SIZE, 2, RT_TICK_PER_SECOND/2);
-        if (at_obj_exec_cmd(device->client, resp, "AT+ESOSENDRAW=%d,%d", me3616_socket_fd[device_socket], (int)cur_pkt_size) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+ESOSENDRAW=%d,%d", me3616_socket_fd[device_socket], (int)cur_pkt_size) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -301,7 +303,7 @@ static int me3616_socket_send(struct at_socket *socket, const char *buff, size_t
 
         /* wait respone "NO CARRIER ... OK " */
         at_resp_set_info(resp, SEND_RESP_SIZE, 0, (2*RT_TICK_PER_SECOND));
-        if (at_obj_exec_cmd(device->client, resp, "") < 0)
+        if (at_device_exec_cmd(device, resp, "") < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -316,6 +318,7 @@ static int me3616_socket_send(struct at_socket *socket, const char *buff, size_t
             rt_thread_mdelay(10);//delay at least 10 ms
         }
 
+        at_device_stats_send(device, device_socket, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -325,7 +328,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result > 0 ? sent_size : result;
@@ -334,6 +337,7 @@ __exit:
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -342,30 +346,22 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int me3616_domain_resolve(const char *name, char ip[16])
+static int me3616_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
     int result;
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first init device failed.");
-        return -RT_ERROR;
-    }
-
-    resp = at_create_resp(128, 0, (15 * RT_TICK_PER_SECOND));
+    resp = at_device_resp_get(device, 128, 0, (15 * RT_TICK_PER_SECOND));
     if (!resp)
     {
         LOG_E("no memory for resp create.");
         return -RT_ENOMEM;
     }
 
-    result = at_obj_exec_cmd(device->client, resp, "AT+EDNS=\"%s\"", name);
+    result = at_device_exec_cmd(device, resp, "AT+EDNS=\"%s\"", name);
     if (result != RT_EOK)
     {
         LOG_E("%s device \"AT+EDNS=\"%s\"\" cmd error.", device->name, name);
@@ -392,7 +388,7 @@ static int me3616_domain_resolve(const char *name, char ip[16])
  __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -423,7 +419,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -461,7 +457,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -498,7 +494,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 
     timeout = bfsz > 10 ? bfsz : 10;
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    recv_buf = (char *) at_device_recv_buf_alloc(device, bfsz);
     if (recv_buf == RT_NULL)
     {
         LOG_E("no memory for URC receive buffer(%d).", bfsz);
@@ -533,6 +529,8 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     socket = &(device->sockets[device_socket]);
 
     /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
@@ -550,7 +548,7 @@ static const struct at_socket_ops me3616_socket_ops =
     me3616_socket_connect,
     me3616_socket_close,
     me3616_socket_send,
-    me3616_domain_resolve,
+    RT_NULL,
     me3616_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
@@ -575,6 +573,7 @@ int me3616_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_ME3616_SOCKETS_NUM;
     class->socket_ops = &me3616_socket_ops;
+    class->domain_resolve = me3616_domain_resolve;
 
     return RT_EOK;
 }
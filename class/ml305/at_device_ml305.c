@@ -99,7 +99,7 @@ static int ml305_check_link_status(struct at_device *device)
 
     ml305 = (struct at_device_ml305 *)device->user_data;
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -135,7 +135,7 @@ __exit:
 
     if(resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return(result);
@@ -170,7 +170,7 @@ static int ml305_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(ML305_IMEI_RESP_SIZE, 0, ML305_INFO_RESP_TIMO);
+    resp = at_device_resp_get(device, ML305_IMEI_RESP_SIZE, 0, ML305_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -277,7 +277,7 @@ static int ml305_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -302,7 +302,7 @@ static void check_link_status_entry(void *parameter)
         return;
     }
 
-    resp = at_create_resp(ML305_LINK_RESP_SIZE, 0, ML305_LINK_RESP_TIMO);
+    resp = at_device_resp_get(device, ML305_LINK_RESP_SIZE, 0, ML305_LINK_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for response create.");
@@ -420,7 +420,7 @@ static int ml305_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, i
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(ML305_DNS_RESP_LEN, 0, ML305_DNS_RESP_TIMEO);
+    resp = at_device_resp_get(device, ML305_DNS_RESP_LEN, 0, ML305_DNS_RESP_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_D("ml305 set dns server failed, no memory for response object.");
@@ -440,7 +440,7 @@ static int ml305_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, i
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -453,7 +453,7 @@ static int ml305_ping_domain_resolve(struct at_device *device, const char *name,
     at_response_t resp = RT_NULL;
 
     /* The maximum response time is 14 seconds, affected by network status */
-    resp = at_create_resp(512, 4, 14 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 512, 4, 14 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for ml305 device(%s) response structure.", device->name);
@@ -492,7 +492,7 @@ static int ml305_ping_domain_resolve(struct at_device *device, const char *name,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -578,7 +578,11 @@ static struct netdev *ml305_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, resp_line, timeout, cmd)                                         \
     do {                                                                                           \
-        (resp) = at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout));    \
+        if (at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout)) == RT_NULL) \
+        {                                                                                          \
+            result = -RT_ENOMEM;                                                                   \
+            goto __exit;                                                                           \
+        }                                                                                          \
         if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                                          \
         {                                                                                          \
             result = -RT_ERROR;                                                                    \
@@ -604,7 +608,7 @@ static void ml305_init_thread_entry(void *parameter)
     struct at_device *device = (struct at_device *)parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(500));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(500));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for ml305 device(%s) response structure.", device->name);
@@ -816,7 +820,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result == RT_EOK)
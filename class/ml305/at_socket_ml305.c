@@ -20,9 +20,6 @@
 #if !defined (ML305_MODULE_SEND_MAX_SIZE)
 #define ML305_MODULE_SEND_MAX_SIZE   4096
 #endif
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
-
 /* AT socket event type */
 #define ML305_EVENT_CONN_OK          (1L << 0)
 #define ML305_EVENT_SEND_OK          (1L << 1)
@@ -36,25 +33,6 @@ static at_evt_cb_t at_evt_cb_set[] = {
         [AT_SOCKET_EVT_CLOSED] = NULL,
 };
 
-static int ml305_socket_event_send(struct at_device *device, uint32_t event)
-{
-    return (int) rt_event_send(device->socket_event, event);
-}
-
-static int ml305_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option)
-{
-    int result = RT_EOK;
-    rt_uint32_t recved;
-
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
-    if (result != RT_EOK)
-    {
-        return -RT_ETIMEOUT;
-    }
-
-    return recved;
-}
-
 /**
  * close socket by AT commands.
  *
@@ -67,22 +45,20 @@ static int ml305_socket_event_recv(struct at_device *device, uint32_t event, uin
  */
 static int ml305_socket_close(struct at_socket *socket)
 {
-    uint32_t event = 0;
     int result = RT_EOK;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
 
     /* clear socket close event */
-    event = SET_EVENT(device_socket, ML305_EVENT_CLOSE_OK);
-    ml305_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, ML305_EVENT_CLOSE_OK, 0, RT_EVENT_FLAG_OR);
 
-    if (at_obj_exec_cmd(device->client, NULL, "AT+MIPCLOSE=%d", device_socket) < 0)
+    if (at_device_exec_cmd(device, NULL, "AT+MIPCLOSE=%d", device_socket) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
     }
 
-    if (ml305_socket_event_recv(device, event, rt_tick_from_millisecond(300 * 3), RT_EVENT_FLAG_AND) < 0)
+    if (at_device_socket_event_recv(device, device_socket, ML305_EVENT_CLOSE_OK, rt_tick_from_millisecond(300 * 3), RT_EVENT_FLAG_AND) < 0)
     {
         LOG_E("ml305 device(%s) socket(%d) close failed, wait close OK timeout.", device->name, device_socket);
         result = -RT_ETIMEOUT;
@@ -109,7 +85,6 @@ __exit:
  */
 static int ml305_socket_connect(struct at_socket *socket, char *ip, int32_t port, enum at_socket_type type, rt_bool_t is_client)
 {
-    uint32_t event = 0;
     rt_bool_t retryed = RT_FALSE;
     at_response_t resp = RT_NULL;
     int result = RT_EOK, event_result = 0;
@@ -119,7 +94,7 @@ static int ml305_socket_connect(struct at_socket *socket, char *ip, int32_t port
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for ml305 device(%s) response structure.", device->name);
@@ -129,8 +104,7 @@ static int ml305_socket_connect(struct at_socket *socket, char *ip, int32_t port
 __retry:
 
     /* clear socket connect event */
-    event = SET_EVENT(device_socket, ML305_EVENT_CONN_OK | ML305_EVENT_CONN_FAIL);
-    ml305_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, ML305_EVENT_CONN_OK | ML305_EVENT_CONN_FAIL, 0, RT_EVENT_FLAG_OR);
 
     if (is_client)
     {
@@ -138,7 +112,7 @@ __retry:
         {
         case AT_SOCKET_TCP:
             /* send AT commands(eg: AT+MIPOPEN=0,"TCP","x.x.x.x", 1234) to connect TCP server */
-            if (at_obj_exec_cmd(device->client, RT_NULL, "AT+MIPOPEN=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
+            if (at_device_exec_cmd(device, RT_NULL, "AT+MIPOPEN=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -146,7 +120,7 @@ __retry:
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, RT_NULL, "AT+MIPOPEN=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
+            if (at_device_exec_cmd(device, RT_NULL, "AT+MIPOPEN=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -161,15 +135,8 @@ __retry:
             }
 
     /* waiting result event from AT URC, the device default connection timeout is 75 seconds, but it set to 10 seconds is convenient to use */
-    if (ml305_socket_event_recv(device, SET_EVENT(device_socket, 0), 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-    {
-        LOG_E("ml305 device(%s) socket(%d) connect failed, wait connect result timeout.",device->name, device_socket);
-        result = -RT_ETIMEOUT;
-        goto __exit;
-    }
-    /* waiting OK or failed result */
-    event_result = ml305_socket_event_recv(device,
-            ML305_EVENT_CONN_OK | ML305_EVENT_CONN_FAIL, 1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+    event_result = at_device_socket_event_recv(device, device_socket, ML305_EVENT_CONN_OK | ML305_EVENT_CONN_FAIL,
+                                               10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
     if (event_result < 0)
     {
         LOG_E("ml305 device(%s) socket(%d) connect failed, wait connect OK|FAIL timeout.", device->name, device_socket);
@@ -189,6 +156,7 @@ __retry:
                 goto __exit;
             }
             retryed = RT_TRUE;
+            AT_DEVICE_STATS_INC(device, retries);
             goto __retry;
         }
         LOG_E("ml305 device(%s) socket(%d) connect failed.", device->name, device_socket);
@@ -199,7 +167,7 @@ __retry:
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -220,7 +188,6 @@ __exit:
  */
 static int ml305_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
 {
-    uint32_t event = 0;
     int result = RT_EOK, event_result = 0;
     size_t cur_pkt_size = 0, sent_size = 0;
     at_response_t resp = RT_NULL;
@@ -230,7 +197,7 @@ static int ml305_socket_send(struct at_socket *socket, const char *buff, size_t
 
     RT_ASSERT(buff);
 
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 2, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for ml305 device(%s) response structure.", device->name);
@@ -240,8 +207,7 @@ static int ml305_socket_send(struct at_socket *socket, const char *buff, size_t
     rt_mutex_take(lock, RT_WAITING_FOREVER);
 
     /* clear socket connect event */
-    event = SET_EVENT(device_socket, ML305_EVENT_SEND_OK | ML305_EVENT_SEND_FAIL);
-    ml305_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, ML305_EVENT_SEND_OK | ML305_EVENT_SEND_FAIL, 0, RT_EVENT_FLAG_OR);
 
     /* set AT client end sign to deal with '>' sign.*/
     at_obj_set_end_sign(device->client, '>');
@@ -258,7 +224,7 @@ static int ml305_socket_send(struct at_socket *socket, const char *buff, size_t
         }
 
         /* send the "AT+CIPSEND" commands to AT server than receive the '>' response on the first line. */
-        if (at_obj_exec_cmd(device->client, resp, "AT+MIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+MIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -272,15 +238,8 @@ static int ml305_socket_send(struct at_socket *socket, const char *buff, size_t
             goto __exit;
         }
         /* waiting result event from AT URC */
-        if (ml305_socket_event_recv(device, SET_EVENT(device_socket, 0), 15 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-        {
-            LOG_E("ml305 device(%s) socket(%d) send failed, wait connect result timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-        /* waiting OK or failed result */
-        event_result = ml305_socket_event_recv(device,
-                                                ML305_EVENT_SEND_OK | ML305_EVENT_SEND_FAIL, 5 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+        event_result = at_device_socket_event_recv(device, device_socket, ML305_EVENT_SEND_OK | ML305_EVENT_SEND_FAIL,
+                                                   15 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
         if (event_result < 0)
         {
             LOG_E("ml305 device(%s) socket(%d) send failed, wait connect OK|FAIL timeout.", device->name, device_socket);
@@ -295,6 +254,7 @@ static int ml305_socket_send(struct at_socket *socket, const char *buff, size_t
             goto __exit;
         }
 
+        at_device_stats_send(device, device_socket, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -306,7 +266,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -315,6 +275,7 @@ __exit:
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -323,27 +284,19 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int ml305_domain_resolve(const char *name, char ip[16])
+static int ml305_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
 #define RESOLVE_RETRY                  5
 
     int i, result = RT_EOK;
     char recv_ip[16] = { 0 };
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first initialization ml305 device failed.");
-        return -RT_ERROR;
-    }
-
     /* The maximum response time is 14 seconds, affected by network status */
-    resp = at_create_resp(1024, 4, 14 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 1024, 4, 14 * RT_TICK_PER_SECOND);
 
     if (resp == RT_NULL)
     {
@@ -355,7 +308,7 @@ static int ml305_domain_resolve(const char *name, char ip[16])
     {
         int err_code = 0;
 
-        if (at_obj_exec_cmd(device->client, resp, "AT+MDNSGIP=\"%s\"", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+MDNSGIP=\"%s\"", name) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -398,7 +351,7 @@ static int ml305_domain_resolve(const char *name, char ip[16])
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -426,7 +379,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get ml305 device by client name(%s) failed.", client_name);
@@ -438,11 +391,11 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
 
     if (strstr(data, "CONNECT OK"))
     {
-        ml305_socket_event_send(device, SET_EVENT(device_socket, ML305_EVENT_CONN_OK));
+        at_device_socket_event_send(device, device_socket, ML305_EVENT_CONN_OK);
     }
     else if (strstr(data, "CONNECT FAIL"))
     {
-        ml305_socket_event_send(device, SET_EVENT(device_socket, ML305_EVENT_CONN_FAIL));
+        at_device_socket_event_send(device, device_socket, ML305_EVENT_CONN_FAIL);
     }
 }
 
@@ -454,7 +407,7 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get ml305 device by client name(%s) failed.", client_name);
@@ -466,11 +419,11 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     if (rt_strstr(data, "SEND OK"))
     {
-        ml305_socket_event_send(device, SET_EVENT(device_socket, ML305_EVENT_SEND_OK));
+        at_device_socket_event_send(device, device_socket, ML305_EVENT_SEND_OK);
     }
     else if (rt_strstr(data, "SEND FAIL"))
     {
-        ml305_socket_event_send(device, SET_EVENT(device_socket, ML305_EVENT_SEND_FAIL));
+        at_device_socket_event_send(device, device_socket, ML305_EVENT_SEND_FAIL);
     }
 }
 
@@ -482,7 +435,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get ml305 device by client name(%s) failed.", client_name);
@@ -494,7 +447,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     if (rt_strstr(data, "CLOSE OK"))
     {
-        ml305_socket_event_send(device, SET_EVENT(device_socket, ML305_EVENT_CLOSE_OK));
+        at_device_socket_event_send(device, device_socket, ML305_EVENT_CLOSE_OK);
     }
     else if (rt_strstr(data, "CLOSED"))
     {
@@ -535,14 +488,14 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get ml305 device by client name(%s) failed.", client_name);
         return;
     }
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    recv_buf = (char *) at_device_recv_buf_alloc(device, bfsz);
     if (recv_buf == RT_NULL)
     {
         LOG_E("no memory for ml305 device(%s) URC receive buffer (%d).", device->name, bfsz);
@@ -575,6 +528,8 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     socket = &(device->sockets[device_socket]);
 
     /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
@@ -619,7 +574,7 @@ static struct at_socket_ops ml305_socket_ops =
     ml305_socket_connect,
     ml305_socket_close,
     ml305_socket_send,
-    ml305_domain_resolve,
+    RT_NULL,
     ml305_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
@@ -642,6 +597,7 @@ int ml305_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_ML305_SOCKETS_NUM;
     class->socket_ops = &ml305_socket_ops;
+    class->domain_resolve = ml305_domain_resolve;
 
     return RT_EOK;
 }
@@ -52,7 +52,7 @@ static void mw31_get_netdev_info(struct rt_work *work, void *work_data)
         rt_free(work);
     }
 
-    resp = at_create_resp(512, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 512, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -129,7 +129,7 @@ static void mw31_get_netdev_info(struct rt_work *work, void *work_data)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 }
 
@@ -193,7 +193,7 @@ static int mw31_netdev_set_addr_info(struct netdev *netdev, ip_addr_t *ip_addr,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(IPADDR_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, IPADDR_RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -242,7 +242,7 @@ static int mw31_netdev_set_addr_info(struct netdev *netdev, ip_addr_t *ip_addr,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -266,7 +266,7 @@ static int mw31_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(DNS_RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, DNS_RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -288,7 +288,7 @@ static int mw31_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -313,7 +313,7 @@ static int mw31_netdev_set_dhcp(struct netdev *netdev, rt_bool_t is_enabled)
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -344,7 +344,7 @@ static int mw31_netdev_set_dhcp(struct netdev *netdev, rt_bool_t is_enabled)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -407,7 +407,11 @@ static struct netdev *mw31_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, cmd)                                     \
     do {                                                                   \
-        (resp) = at_resp_set_info((resp), 256, 0, 5 * RT_TICK_PER_SECOND); \
+        if (at_resp_set_info((resp), 256, 0, 5 * RT_TICK_PER_SECOND) == RT_NULL) \
+        {                                                                  \
+            result = -RT_ENOMEM;                                           \
+            goto __exit;                                                   \
+        }                                                                  \
         if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                  \
         {                                                                  \
             result = -RT_ERROR;                                            \
@@ -447,7 +451,7 @@ static void mw31_init_thread_entry(void *parameter)
         return;
     }
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -494,7 +498,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result != RT_EOK)
@@ -542,7 +546,7 @@ static void urc_func(struct at_client *client, const char *data, rt_size_t size)
 
     RT_ASSERT(client && data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -655,7 +659,7 @@ static int mw31_wifi_info_set(struct at_device *device, struct at_device_ssid_pw
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 0, 20 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -672,7 +676,7 @@ static int mw31_wifi_info_set(struct at_device *device, struct at_device_ssid_pw
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -18,10 +18,9 @@
 
 #if defined(AT_DEVICE_USING_MW31) && defined(AT_USING_SOCKET)
 
+#if !defined (MW31_MODULE_SEND_MAX_SIZE)
 #define MW31_MODULE_SEND_MAX_SIZE   1024
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
-
+#endif
 /* AT socket event type */
 #define MW31_EVENT_CONN_OK          (1L << 0)
 #define MW31_EVENT_SEND_OK          (1L << 1)
@@ -55,14 +54,14 @@ static int mw31_socket_close(struct at_socket *socket)
     struct at_device *device = (struct at_device *) socket->device;
     char type[15] = {0}, status[15] = {0};
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
         return -RT_ENOMEM;
     }
 
-    at_obj_exec_cmd(device->client, resp, "AT+CIPSTATUS=%d", device_socket);
+    at_device_exec_cmd(device, resp, "AT+CIPSTATUS=%d", device_socket);
 
     if (at_resp_parse_line_args_by_kw(resp, "+CIPSTATU:", "+CIPSTATU:%[^,],%s", type, status) > 0)
     {
@@ -74,12 +73,12 @@ static int mw31_socket_close(struct at_socket *socket)
         goto __exit;
     }
 
-    result = at_obj_exec_cmd(device->client, resp, "AT+CIPSTOP=%d", device_socket);
+    result = at_device_exec_cmd(device, resp, "AT+CIPSTOP=%d", device_socket);
 
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -110,7 +109,7 @@ static int mw31_socket_connect(struct at_socket *socket, char *ip, int32_t port,
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -124,16 +123,16 @@ __retry:
         {
         case AT_SOCKET_TCP:
             /* send AT commands to connect TCP server */
-            if (at_obj_exec_cmd(device->client, resp,
-                                "AT+CIPSTART=%d,tcp_client,%s,%d,%d", device_socket, ip, port, device_socket) < 0)
+            if (at_device_exec_cmd(device, resp,
+                                   "AT+CIPSTART=%d,tcp_client,%s,%d,%d", device_socket, ip, port, device_socket) < 0)
             {
                 result = -RT_ERROR;
             }
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, resp,
-                                "AT+CIPSTART=%d,udp_unicast,%s,%d,%d", device_socket, ip, port, device_socket) < 0)
+            if (at_device_exec_cmd(device, resp,
+                                   "AT+CIPSTART=%d,udp_unicast,%s,%d,%d", device_socket, ip, port, device_socket) < 0)
             {
                 result = -RT_ERROR;
             }
@@ -155,6 +154,7 @@ __retry:
             goto __exit;
         }
         retryed = RT_TRUE;
+        AT_DEVICE_STATS_INC(device, retries);
         result = RT_EOK;
         goto __retry;
     }
@@ -162,7 +162,7 @@ __retry:
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -188,14 +188,13 @@ static int mw31_socket_send(struct at_socket *socket, const char *buff, size_t b
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
-    struct at_device_mw31 *mw31 = (struct at_device_mw31 *) device->user_data;
     rt_mutex_t lock = at_device_get_client_lock(device);
     char send_buf[20] = {0};
 
     RT_ASSERT(buff);
     RT_ASSERT(bfsz > 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -204,9 +203,6 @@ static int mw31_socket_send(struct at_socket *socket, const char *buff, size_t b
 
     rt_mutex_take(lock, RT_WAITING_FOREVER);
 
-    /* set current socket for send URC event */
-    mw31->user_data = (void *) device_socket;
-
     /* set AT client end sign to deal with '>' sign */
     at_obj_set_end_sign(device->client, '>');
 
@@ -235,6 +231,7 @@ static int mw31_socket_send(struct at_socket *socket, const char *buff, size_t b
             goto __exit;
         }
 
+        at_device_stats_send(device, device_socket, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -246,7 +243,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result > 0 ? sent_size : result;
@@ -255,6 +252,7 @@ __exit:
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -262,7 +260,7 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int mw31_domain_resolve(const char *name, char ip[16])
+static int mw31_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
 #define RESOLVE_RETRY        5
 
@@ -270,19 +268,11 @@ static int mw31_domain_resolve(const char *name, char ip[16])
     rt_uint8_t recv_ip_num = 0;
     char recv_ip[16] = { 0 };
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first init device failed.");
-        return -RT_ERROR;
-    }
-
-    resp = at_create_resp(128, 0, 20 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -291,7 +281,7 @@ static int mw31_domain_resolve(const char *name, char ip[16])
 
     for (i = 0; i < RESOLVE_RETRY; i++)
     {
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIPDOMAIN=%s", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CIPDOMAIN=%s", name) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -324,7 +314,7 @@ static int mw31_domain_resolve(const char *name, char ip[16])
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -350,7 +340,7 @@ static const struct at_socket_ops mw31_socket_ops =
     mw31_socket_connect,
     mw31_socket_close,
     mw31_socket_send,
-    mw31_domain_resolve,
+    RT_NULL,
     mw31_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
@@ -370,7 +360,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -399,7 +389,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     if (device_socket < 0 || bfsz == 0)
         return;
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    recv_buf = (char *) at_device_recv_buf_alloc(device, bfsz);
     if (recv_buf == RT_NULL)
     {
         LOG_E("no memory for receive buffer(%d).", bfsz);
@@ -431,6 +421,8 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     socket = &(device->sockets[device_socket]);
 
     /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
@@ -459,6 +451,7 @@ int mw31_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_MW31_SOCKETS_NUM;
     class->socket_ops = &mw31_socket_ops;
+    class->domain_resolve = mw31_domain_resolve;
 
     return RT_EOK;
 }
@@ -129,7 +129,7 @@ static int n21_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(N21_SET_INFO_RESP_SIZE, 0, N21_INFO_RESP_TIMO);
+    resp = at_device_resp_get(device, N21_SET_INFO_RESP_SIZE, 0, N21_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("n21 device(%s) set IP address failed, no memory for response object.", device->name);
@@ -208,7 +208,7 @@ static int n21_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -242,7 +242,7 @@ static void check_link_status_entry(void *parameter)
 #if (N21_SAMPLE_STATUS_PIN != -1)
     n21 = (struct at_device_n21 *)device->user_data;
 #endif
-    resp = at_create_resp(N21_LINK_RESP_SIZE, 0, N21_LINK_RESP_TIMO);
+    resp = at_device_resp_get(device, N21_LINK_RESP_SIZE, 0, N21_LINK_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("n21 device(%s) set check link status failed, no memory for response object.", device->name);
@@ -409,7 +409,7 @@ static int n21_netdev_ping(struct netdev *netdev, const char *host,
     for (i = 0; i < rt_strlen(host) && !isalpha(host[i]); i++)
         ;
 
-    resp = at_create_resp(N21_PING_RESP_SIZE, 7, N21_PING_TIMEO);
+    resp = at_device_resp_get(device, N21_PING_RESP_SIZE, 7, N21_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("n21 device(%s) set dns server failed, no memory for response object.", device->name);
@@ -449,7 +449,7 @@ static int n21_netdev_ping(struct netdev *netdev, const char *host,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -519,7 +519,11 @@ static struct netdev *n21_netdev_add(const char *netdev_name)
 #define AT_SEND_CMD(client, resp, resp_line, timeout, cmd)                                      \
     do                                                                                          \
     {                                                                                           \
-        (resp) = at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout)); \
+        if (at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout)) == RT_NULL) \
+        {                                                                                       \
+            result = -RT_ENOMEM;                                                                \
+            goto __exit;                                                                        \
+        }                                                                                       \
         if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                                       \
         {                                                                                       \
             result = -RT_ERROR;                                                                 \
@@ -545,7 +549,7 @@ static void n21_init_thread_entry(void *parameter)
     struct at_device *device = (struct at_device *)parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for n21 device(%s) response structure.", device->name);
@@ -718,7 +722,7 @@ static void n21_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result == RT_EOK)
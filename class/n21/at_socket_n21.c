@@ -21,10 +21,9 @@
 
 #if defined(AT_DEVICE_USING_N21) && defined(AT_USING_SOCKET)
 
+#if !defined (N21_MODULE_SEND_MAX_SIZE)
 #define N21_MODULE_SEND_MAX_SIZE 1000
-
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event) (((socket + 1) << 16) | (event))
+#endif
 
 /* AT socket event type */
 #define N21_EVENT_CONN_OK (1L << 0)
@@ -39,25 +38,6 @@ static at_evt_cb_t at_evt_cb_set[] = {
     [AT_SOCKET_EVT_CLOSED] = NULL,
 };
 
-static int n21_socket_event_send(struct at_device *device, uint32_t event)
-{
-    return (int)rt_event_send(device->socket_event, event);
-}
-
-static int n21_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option)
-{
-    int result = RT_EOK;
-    rt_uint32_t recved;
-
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
-    if (result != RT_EOK)
-    {
-        return -RT_ETIMEOUT;
-    }
-
-    return recved;
-}
-
 /**
  * close socket by AT commands.
  *
@@ -70,19 +50,17 @@ static int n21_socket_event_recv(struct at_device *device, uint32_t event, uint3
  */
 static int n21_socket_close(struct at_socket *socket)
 {
-    uint32_t event = 0;
     int result = RT_EOK;
     int device_socket = (int)socket->user_data;
     enum at_socket_type type_socket = socket->type;
     struct at_device *device = (struct at_device *)socket->device;
 
     /* clear socket close event */
-    event = SET_EVENT(device_socket, N21_EVNET_CLOSE_OK);
-    n21_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, N21_EVNET_CLOSE_OK, 0, RT_EVENT_FLAG_OR);
 
     if (type_socket == AT_SOCKET_TCP)
     {
-        if (at_obj_exec_cmd(device->client, NULL, "AT+TCPCLOSE=%d", device_socket) < 0)
+        if (at_device_exec_cmd(device, NULL, "AT+TCPCLOSE=%d", device_socket) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -90,14 +68,14 @@ static int n21_socket_close(struct at_socket *socket)
     }
     else if (type_socket == AT_SOCKET_UDP)
     {
-        if (at_obj_exec_cmd(device->client, NULL, "AT+UDPCLOSE=%d", device_socket) < 0)
+        if (at_device_exec_cmd(device, NULL, "AT+UDPCLOSE=%d", device_socket) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
         }
     }
 
-    if (n21_socket_event_recv(device, event, rt_tick_from_millisecond(300 * 3), RT_EVENT_FLAG_AND) < 0)
+    if (at_device_socket_event_recv(device, device_socket, N21_EVNET_CLOSE_OK, rt_tick_from_millisecond(300 * 3), RT_EVENT_FLAG_AND) < 0)
     {
         LOG_E("n21 device(%s) socket(%d) close failed, wait close OK timeout.", device->name, device_socket);
         result = -RT_ETIMEOUT;
@@ -124,7 +102,6 @@ __exit:
  */
 static int n21_socket_connect(struct at_socket *socket, char *ip, int32_t port, enum at_socket_type type, rt_bool_t is_client)
 {
-    uint32_t event = 0;
     rt_bool_t retryed = RT_FALSE;
     at_response_t resp = RT_NULL;
     int result = RT_EOK, event_result = 0;
@@ -134,7 +111,7 @@ static int n21_socket_connect(struct at_socket *socket, char *ip, int32_t port,
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for n21 device(%s) response structure.", device->name);
@@ -144,8 +121,7 @@ static int n21_socket_connect(struct at_socket *socket, char *ip, int32_t port,
 __retry:
 
     /* clear socket connect event */
-    event = SET_EVENT(device_socket, N21_EVENT_CONN_OK | N21_EVENT_CONN_FAIL);
-    n21_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, N21_EVENT_CONN_OK | N21_EVENT_CONN_FAIL, 0, RT_EVENT_FLAG_OR);
 
     if (is_client)
     {
@@ -153,8 +129,8 @@ __retry:
         {
         case AT_SOCKET_TCP:
             /* send AT commands(eg: AT+TCPSETUP=<n>,<ip>,<port>) to connect TCP server */
-            if (at_obj_exec_cmd(device->client, RT_NULL,
-                                "AT+TCPSETUP=%d,%s,%d", device_socket, ip, port) < 0)
+            if (at_device_exec_cmd(device, RT_NULL,
+                                   "AT+TCPSETUP=%d,%s,%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -162,8 +138,8 @@ __retry:
             break;
             /* send AT commands(eg: AT+UDPSETUP=<n>,<ip>,<port>) to connect TCP server */
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, RT_NULL,
-                                "AT+UDPSETUP=%d,%s,%d", device_socket, ip, port) < 0)
+            if (at_device_exec_cmd(device, RT_NULL,
+                                   "AT+UDPSETUP=%d,%s,%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -178,15 +154,8 @@ __retry:
     }
 
     /* waiting result event from AT URC, the device default connection timeout is 75 seconds, but it set to 10 seconds is convenient to use */
-    if (n21_socket_event_recv(device, SET_EVENT(device_socket, 0), 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-    {
-        LOG_E("n21 device(%s) socket(%d) connect failed, wait connect result timeout.", device->name, device_socket);
-        result = -RT_ETIMEOUT;
-        goto __exit;
-    }
-    /* waiting OK or failed result */
-    event_result = n21_socket_event_recv(device,
-                                         N21_EVENT_CONN_OK | N21_EVENT_CONN_FAIL, 1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+    event_result = at_device_socket_event_recv(device, device_socket, N21_EVENT_CONN_OK | N21_EVENT_CONN_FAIL,
+                                               10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
     if (event_result < 0)
     {
         LOG_E("n21 device(%s) socket(%d) connect failed, wait connect OK|FAIL timeout.", device->name, device_socket);
@@ -206,6 +175,7 @@ __retry:
                 goto __exit;
             }
             retryed = RT_TRUE;
+            AT_DEVICE_STATS_INC(device, retries);
             goto __retry;
         }
         LOG_E("n21 device(%s) socket(%d) connect failed.", device->name, device_socket);
@@ -216,7 +186,7 @@ __retry:
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -237,7 +207,6 @@ __exit:
  */
 static int n21_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
 {
-    uint32_t event = 0;
     int result = RT_EOK, event_result = 0;
     size_t cur_pkt_size = 0, sent_size = 0;
     at_response_t resp = RT_NULL;
@@ -247,7 +216,7 @@ static int n21_socket_send(struct at_socket *socket, const char *buff, size_t bf
 
     RT_ASSERT(buff);
 
-    resp = at_create_resp(128, 2, 10 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 2, 10 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for n21 device(%s) response structure.", device->name);
@@ -257,8 +226,7 @@ static int n21_socket_send(struct at_socket *socket, const char *buff, size_t bf
     rt_mutex_take(lock, RT_WAITING_FOREVER);
 
     /* clear socket connect event */
-    event = SET_EVENT(device_socket, N21_EVENT_SEND_OK | N21_EVENT_SEND_FAIL);
-    n21_socket_event_recv(device, event, 0, RT_EVENT_FLAG_OR);
+    at_device_socket_event_recv(device, device_socket, N21_EVENT_SEND_OK | N21_EVENT_SEND_FAIL, 0, RT_EVENT_FLAG_OR);
 
     /* set AT client end sign to deal with '>' sign.*/
     at_obj_set_end_sign(device->client, '>');
@@ -277,7 +245,7 @@ static int n21_socket_send(struct at_socket *socket, const char *buff, size_t bf
         /* send the "AT+QISEND" commands to AT server than receive the '>' response on the first line. */
         if (type == AT_SOCKET_TCP)
         {
-            if (at_obj_exec_cmd(device->client, resp, "AT+TCPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
+            if (at_device_exec_cmd(device, resp, "AT+TCPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -285,7 +253,7 @@ static int n21_socket_send(struct at_socket *socket, const char *buff, size_t bf
         }
         else if (type == AT_SOCKET_UDP)
         {
-            if (at_obj_exec_cmd(device->client, resp, "AT+UDPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
+            if (at_device_exec_cmd(device, resp, "AT+UDPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -302,8 +270,8 @@ static int n21_socket_send(struct at_socket *socket, const char *buff, size_t bf
         }
 
         /* waiting OK or failed result */
-        event_result = n21_socket_event_recv(device,
-                                             N21_EVENT_SEND_OK | N21_EVENT_SEND_FAIL, 5 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+        event_result = at_device_socket_event_recv(device, device_socket,
+                                                   N21_EVENT_SEND_OK | N21_EVENT_SEND_FAIL, 5 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
         if (event_result < 0)
         {
             LOG_E("n21 device(%s) socket(%d) send failed, wait connect OK|FAIL timeout.", device->name, device_socket);
@@ -318,6 +286,7 @@ static int n21_socket_send(struct at_socket *socket, const char *buff, size_t bf
             goto __exit;
         }
 
+        at_device_stats_send(device, device_socket, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -329,7 +298,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -338,6 +307,7 @@ __exit:
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -346,27 +316,19 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int n21_domain_resolve(const char *name, char ip[16])
+static int n21_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
 #define RESOLVE_RETRY 5
 
     int i, result = RT_EOK;
     char recv_ip[16] = {0};
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first initialization n21 device failed.");
-        return -RT_ERROR;
-    }
-
     /* The maximum response time is 14 seconds, affected by network status */
-    resp = at_create_resp(128, 4, 14 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 4, 14 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for n21 device(%s) response structure.", device->name);
@@ -377,7 +339,7 @@ static int n21_domain_resolve(const char *name, char ip[16])
     {
         int err_code = 0;
 
-        if (at_obj_exec_cmd(device->client, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -420,7 +382,7 @@ static int n21_domain_resolve(const char *name, char ip[16])
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -448,7 +410,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get n21 device by client name(%s) failed.", client_name);
@@ -465,12 +427,12 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
     if (strstr(constat, "OK"))
     {
         LOG_D("socket %d:connect ok!", device_socket);
-        n21_socket_event_send(device, SET_EVENT(device_socket, N21_EVENT_CONN_OK));
+        at_device_socket_event_send(device, device_socket, N21_EVENT_CONN_OK);
     }
     else if (strstr(constat, "FAIL"))
     {
         LOG_D("socket %d:connect fail!", device_socket);
-        n21_socket_event_send(device, SET_EVENT(device_socket, N21_EVENT_CONN_FAIL));
+        at_device_socket_event_send(device, device_socket, N21_EVENT_CONN_FAIL);
     }
 }
 
@@ -482,7 +444,7 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get n21 device by client name(%s) failed.", client_name);
@@ -495,15 +457,15 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
     if (rt_strstr(data, "OPERATION"))
     {
         LOG_E("input data timeout!");
-        n21_socket_event_send(device, SET_EVENT(device_socket, N21_EVENT_SEND_FAIL));
+        at_device_socket_event_send(device, device_socket, N21_EVENT_SEND_FAIL);
     }
     else if (rt_strstr(data, "ERROR")) //链路号错误
     {
-        n21_socket_event_send(device, SET_EVENT(device_socket, N21_EVENT_SEND_FAIL));
+        at_device_socket_event_send(device, device_socket, N21_EVENT_SEND_FAIL);
     }
     else //没有错误就是成功
     {
-        n21_socket_event_send(device, SET_EVENT(device_socket, N21_EVENT_SEND_OK));
+        at_device_socket_event_send(device, device_socket, N21_EVENT_SEND_OK);
     }
 }
 
@@ -515,7 +477,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get n21 device by client name(%s) failed.", client_name);
@@ -528,7 +490,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     if (rt_strstr(data, "OK"))
     {
-        n21_socket_event_send(device, SET_EVENT(device_socket, N21_EVNET_CLOSE_OK));
+        at_device_socket_event_send(device, device_socket, N21_EVNET_CLOSE_OK);
     }
     else if (rt_strstr(data, "Link Closed"))
     {
@@ -560,7 +522,19 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     /* get the current socket and receive buffer size by receive data */
     rt_sscanf(data, "%*[^ ] %d,%d,", &device_socket, (int *)&bfsz);
 
-    recv_buf = (char *)rt_calloc(1, bfsz + 1);
+    if (device_socket < 0 || bfsz == 0)
+    {
+        return;
+    }
+
+    device = at_device_get_by_client(client);
+    if (device == RT_NULL)
+    {
+        LOG_E("get n21 device by client name(%s) failed.", client_name);
+        return;
+    }
+
+    recv_buf = (char *) at_device_recv_buf_alloc(device, bfsz + 1);
 
     if (recv_buf == RT_NULL)
     {
@@ -579,22 +553,12 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 
     LOG_D("recv socket:%d", device_socket);
 
-    if (device_socket < 0 || bfsz == 0)
-    {
-        return;
-    }
-
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
-    if (device == RT_NULL)
-    {
-        LOG_E("get n21 device by client name(%s) failed.", client_name);
-        return;
-    }
-
     /* get AT socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
     /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
@@ -619,7 +583,7 @@ static const struct at_socket_ops n21_socket_ops =
     n21_socket_connect,
     n21_socket_close,
     n21_socket_send,
-    n21_domain_resolve,
+    RT_NULL,
     n21_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
@@ -642,6 +606,7 @@ int n21_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_N21_SOCKETS_NUM;
     class->socket_ops = &n21_socket_ops;
+    class->domain_resolve = n21_domain_resolve;
 
     return RT_EOK;
 }
@@ -128,7 +128,7 @@ static int n58_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(N58_SET_INFO_RESP_SIZE, 0, N58_INFO_RESP_TIMO);
+    resp = at_device_resp_get(device, N58_SET_INFO_RESP_SIZE, 0, N58_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("n58 device(%s) set IP address failed, no memory for response object.", device->name);
@@ -235,7 +235,7 @@ static int n58_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -272,7 +272,7 @@ static void check_link_status_entry(void *parameter)
     n58 = (struct at_device_n58 *)device->user_data;
 #endif
 
-    resp = at_create_resp(N58_LINK_RESP_SIZE, 0, N58_LINK_RESP_TIMO);
+    resp = at_device_resp_get(device, N58_LINK_RESP_SIZE, 0, N58_LINK_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("n58 device(%s) set check link status failed, no memory for response object.", device->name);
@@ -417,7 +417,7 @@ static int n58_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip_
         LOG_E("get n58 device by netdev name(%s) failed.", netdev->name);
     }
 
-    resp = at_create_resp(N58_DNS_RESP_LEN, 0, N58_DNS_RESP_TIMEO);
+    resp = at_device_resp_get(device, N58_DNS_RESP_LEN, 0, N58_DNS_RESP_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_D("n58 set dns server failed, no memory for response object.");
@@ -437,7 +437,7 @@ static int n58_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip_
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
     result = -RT_ERROR;
 
@@ -483,7 +483,7 @@ static int n58_netdev_ping(struct netdev *netdev, const char *host,
     for (i = 0; i < rt_strlen(host) && !isalpha(host[i]); i++)
         ;
 
-    resp = at_create_resp(N58_PING_RESP_SIZE, 7, N58_PING_TIMEO);
+    resp = at_device_resp_get(device, N58_PING_RESP_SIZE, 7, N58_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("n58 device(%s) set dns server failed, no memory for response object.", device->name);
@@ -523,7 +523,7 @@ static int n58_netdev_ping(struct netdev *netdev, const char *host,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -593,7 +593,11 @@ static struct netdev *n58_netdev_add(const char *netdev_name)
 #define AT_SEND_CMD(client, resp, resp_line, timeout, cmd)                                      \
     do                                                                                          \
     {                                                                                           \
-        (resp) = at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout)); \
+        if (at_resp_set_info((resp), 128, (resp_line), rt_tick_from_millisecond(timeout)) == RT_NULL) \
+        {                                                                                       \
+            result = -RT_ENOMEM;                                                                \
+            goto __exit;                                                                        \
+        }                                                                                       \
         if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                                       \
         {                                                                                       \
             result = -RT_ERROR;                                                                 \
@@ -619,7 +623,7 @@ static void n58_init_thread_entry(void *parameter)
     struct at_device *device = (struct at_device *)parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for n58 device(%s) response structure.", device->name);
@@ -795,7 +799,7 @@ static void n58_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result == RT_EOK)
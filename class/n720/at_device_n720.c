@@ -134,7 +134,7 @@ static int n720_sleep(struct at_device *device)
         return(-RT_ERROR);
     }
     /*
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_D("no memory for resp create.");
@@ -145,11 +145,11 @@ static int n720_sleep(struct at_device *device)
 
     {
         LOG_D("enable sleep fail.\"AT+QSCLK=1\" execute fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return(-RT_ERROR);
     }
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
     */
 
     rt_pin_write(n720->wakeup_pin, PIN_HIGH);
@@ -179,7 +179,7 @@ static int n720_wakeup(struct at_device *device)
     rt_thread_mdelay(200);
 
     /*
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_D("no memory for resp create.");
@@ -188,10 +188,10 @@ static int n720_wakeup(struct at_device *device)
     if (at_obj_exec_cmd(device->client, resp, "AT+QSCLK=0") != RT_EOK)//disable sleep mode
     {
         LOG_D("wake up fail. \"AT+QSCLK=0\" execute fail.");
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         return(-RT_ERROR);
     }
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
     */
 
     n720->sleep_status = RT_FALSE;
@@ -217,7 +217,7 @@ static int n720_check_link_status(struct at_device *device)
         rt_thread_mdelay(200);
     }
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_D("no memory for resp create.");
@@ -237,7 +237,7 @@ static int n720_check_link_status(struct at_device *device)
         }
     }
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
 
     if (n720->sleep_status)//is sleep status
     {
@@ -274,7 +274,7 @@ static int n720_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(N720_INFO_RESP_SIZE, 0, N720_INFO_RESP_TIMO);
+    resp = at_device_resp_get(device, N720_INFO_RESP_SIZE, 0, N720_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -379,7 +379,7 @@ static int n720_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -501,7 +501,7 @@ static int n720_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(N720_DNS_RESP_LEN, 0, N720_DNS_RESP_TIMEO);
+    resp = at_device_resp_get(device, N720_DNS_RESP_LEN, 0, N720_DNS_RESP_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_D("no memory for resp create.");
@@ -521,7 +521,7 @@ static int n720_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -560,7 +560,7 @@ static int n720_netdev_ping(struct netdev *netdev, const char *host,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(N720_PING_RESP_SIZE, 4, N720_PING_TIMEO);
+    resp = at_device_resp_get(device, N720_PING_RESP_SIZE, 4, N720_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create");
@@ -607,7 +607,7 @@ static int n720_netdev_ping(struct netdev *netdev, const char *host,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -684,7 +684,7 @@ static void n720_init_thread_entry(void *parameter)
     struct at_device *device = (struct at_device *) parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(RESP_SIZE, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, RESP_SIZE, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -812,7 +812,11 @@ static void n720_init_thread_entry(void *parameter)
         }
 
         /* Activate context profile */
-        resp = at_resp_set_info(resp, RESP_SIZE, 0, rt_tick_from_millisecond(30*1000));
+        if (at_resp_set_info(resp, RESP_SIZE, 0, rt_tick_from_millisecond(30*1000)) == RT_NULL)
+        {
+            result = -RT_ENOMEM;
+            goto __exit;
+        }
         if (at_obj_exec_cmd(device->client, resp, "AT+CGATT=1") != RT_EOK)
         {
             result = -RT_ERROR;
@@ -820,7 +824,11 @@ static void n720_init_thread_entry(void *parameter)
         }
 
         /* Activate PPP */
-        resp = at_resp_set_info(resp, RESP_SIZE, 0, rt_tick_from_millisecond(30*1000));
+        if (at_resp_set_info(resp, RESP_SIZE, 0, rt_tick_from_millisecond(30*1000)) == RT_NULL)
+        {
+            result = -RT_ENOMEM;
+            goto __exit;
+        }
         if (at_obj_exec_cmd(device->client, resp, "AT$MYNETACT=0,1") != RT_EOK)
         {
             result = -RT_ERROR;
@@ -856,7 +864,7 @@ static void n720_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result == RT_EOK)
@@ -18,10 +18,9 @@
 
 #if defined(AT_DEVICE_USING_N720) && defined(AT_USING_SOCKET)
 
+#if !defined (N720_MODULE_SEND_MAX_SIZE)
 #define N720_MODULE_SEND_MAX_SIZE       2000
-
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
+#endif
 
 /* AT socket event type */
 #define N720_EVENT_CONN_OK             (1L << 0)
@@ -54,16 +53,16 @@ static int n720_socket_close(struct at_socket *socket)
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
 
-    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
         return -RT_ENOMEM;
     }
 
-    result = at_obj_exec_cmd(device->client, resp, "AT$MYNETCLOSE=%d", device_socket);
+    result = at_device_exec_cmd(device, resp, "AT$MYNETCLOSE=%d", device_socket);
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
 
     return result;
 }
@@ -111,28 +110,28 @@ static int n720_socket_connect(struct at_socket *socket, char *ip, int32_t port,
             return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(15*1000));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(15*1000));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
         return -RT_ENOMEM;
     }
 
-    if (at_obj_exec_cmd(device->client, resp, "AT$MYNETSRV=0,%d,%d,0,\"%s:%d\"", device_socket, type_val, ip, port) < 0)
+    if (at_device_exec_cmd(device, resp, "AT$MYNETSRV=0,%d,%d,0,\"%s:%d\"", device_socket, type_val, ip, port) < 0)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         LOG_E("%s device socket(%d) config params fail.", device->name, device_socket);
         return -RT_ERROR;
     }
 
-    if (at_obj_exec_cmd(device->client, resp, "AT$MYNETOPEN=%d", device_socket) < 0)
+    if (at_device_exec_cmd(device, resp, "AT$MYNETOPEN=%d", device_socket) < 0)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
         LOG_E("%s device socket(%d) connect failed.", device->name, device_socket);
         return -RT_ERROR;
     }
 
-    at_delete_resp(resp);
+    at_device_resp_put(device, resp);
     return RT_EOK;
 }
 
@@ -143,14 +142,14 @@ static int at_get_send_size(struct at_socket *socket, size_t *nacked)
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.", device->name);
         return -RT_ENOMEM;
     }
 
-    if (at_obj_exec_cmd(device->client, resp, "AT$MYNETACK=%d", device_socket) < 0)
+    if (at_device_exec_cmd(device, resp, "AT$MYNETACK=%d", device_socket) < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -165,7 +164,7 @@ static int at_get_send_size(struct at_socket *socket, size_t *nacked)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -211,12 +210,11 @@ static int n720_socket_send(struct at_socket *socket, const char *buff, size_t b
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
-    struct at_device_n720 *n720 = (struct at_device_n720 *) device->user_data;
     rt_mutex_t lock = at_device_get_client_lock(device);
 
     RT_ASSERT(buff);
 
-    resp = at_create_resp(128, 2, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 2, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -225,9 +223,6 @@ static int n720_socket_send(struct at_socket *socket, const char *buff, size_t b
 
     rt_mutex_take(lock, RT_WAITING_FOREVER);
 
-    /* set current socket for send URC event */
-    n720->user_data = (void *) device_socket;
-
     while (sent_size < bfsz)
     {
         if (bfsz - sent_size < N720_MODULE_SEND_MAX_SIZE)
@@ -239,7 +234,7 @@ static int n720_socket_send(struct at_socket *socket, const char *buff, size_t b
             cur_pkt_size = N720_MODULE_SEND_MAX_SIZE;
         }
 
-        if (at_obj_exec_cmd(device->client, resp, "AT$MYNETWRITE=%d,%d", device_socket, (int)cur_pkt_size) < 0)
+        if (at_device_exec_cmd(device, resp, "AT$MYNETWRITE=%d,%d", device_socket, (int)cur_pkt_size) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -265,6 +260,7 @@ static int n720_socket_send(struct at_socket *socket, const char *buff, size_t b
             //rt_thread_mdelay(10);
         }
 
+        at_device_stats_send(device, device_socket, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -274,7 +270,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result > 0 ? sent_size : result;
@@ -283,6 +279,7 @@ __exit:
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -291,27 +288,19 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int n720_domain_resolve(const char *name, char ip[16])
+static int n720_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
     #define RESOLVE_RETRY 3
 
     int i, result = RT_EOK;
     char recv_ip[20] = {0};
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first initialization n58 device failed.");
-        return -RT_ERROR;
-    }
-
     /* The maximum response time is 14 seconds, affected by network status */
-    resp = at_create_resp(128, 0, 15 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 15 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for n58 device(%s) response structure.", device->name);
@@ -320,7 +309,7 @@ static int n720_domain_resolve(const char *name, char ip[16])
 
     for (i = 0; i < RESOLVE_RETRY; i++)
     {
-        if (at_obj_exec_cmd(device->client, resp, "AT+DNS=%s", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+DNS=%s", name) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -352,7 +341,7 @@ static int n720_domain_resolve(const char *name, char ip[16])
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -382,7 +371,7 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -422,7 +411,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -449,7 +438,7 @@ static void read_ack_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -466,7 +455,7 @@ static void read_ack_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    recv_buf = (char *) at_device_recv_buf_alloc(device, bfsz);
     if (recv_buf == RT_NULL)
     {
         LOG_E("no memory for URC receive buffer(%d).", bfsz);
@@ -498,6 +487,8 @@ static void read_ack_func(struct at_client *client, const char *data, rt_size_t
     socket = &(device->sockets[device_socket]);
 
     /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
@@ -518,7 +509,7 @@ static const struct at_socket_ops n720_socket_ops =
     n720_socket_connect,
     n720_socket_close,
     n720_socket_send,
-    n720_domain_resolve,
+    RT_NULL,
     n720_socket_set_event_cb,
 };
 
@@ -538,6 +529,7 @@ int n720_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_N720_SOCKETS_NUM;
     class->socket_ops = &n720_socket_ops;
+    class->domain_resolve = n720_domain_resolve;
 
     return RT_EOK;
 }
@@ -72,7 +72,11 @@ static struct netdev *rw007_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, cmd)                                     \
     do {                                                                   \
-        (resp) = at_resp_set_info((resp), 256, 0, 5 * RT_TICK_PER_SECOND); \
+        if (at_resp_set_info((resp), 256, 0, 5 * RT_TICK_PER_SECOND) == RT_NULL) \
+        {                                                                  \
+            result = -RT_ENOMEM;                                           \
+            goto __exit;                                                   \
+        }                                                                  \
         if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                  \
         {                                                                  \
             result = -RT_ERROR;                                            \
@@ -97,7 +101,7 @@ static void rw007_init_thread_entry(void *parameter)
         return;
     }
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -147,7 +151,7 @@ static void rw007_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result != RT_EOK)
@@ -202,7 +206,7 @@ static void urc_func(struct at_client *client, const char *data, rt_size_t size)
 
     RT_ASSERT(client && data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -307,7 +311,7 @@ static int rw007_wifi_info_set(struct at_device *device, struct at_device_ssid_p
          return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 0, 20 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -324,7 +328,7 @@ static int rw007_wifi_info_set(struct at_device *device, struct at_device_ssid_p
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
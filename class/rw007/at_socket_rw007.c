@@ -13,277 +13,21 @@
 #include <string.h>
 
 #include <at_device_rw007.h>
+#include <at_device_dialect.h>
 
 #define LOG_TAG                       "at.skt.rw007"
 #include <at_log.h>
 
 #if defined(AT_DEVICE_USING_RW007) && defined(AT_USING_SOCKET)
 
+#if !defined (RW007_MODULE_SEND_MAX_SIZE)
 #define RW007_MODULE_SEND_MAX_SIZE     2048
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
-
-/* AT socket event type */
-#define RW007_EVENT_CONN_OK            (1L << 0)
-#define RW007_EVENT_SEND_OK            (1L << 1)
-#define RW007_EVENT_RECV_OK            (1L << 2)
-#define RW007_EVNET_CLOSE_OK           (1L << 3)
-#define RW007_EVENT_CONN_FAIL          (1L << 4)
-#define RW007_EVENT_SEND_FAIL          (1L << 5)
-
-static at_evt_cb_t at_evt_cb_set[] = {
-        [AT_SOCKET_EVT_RECV] = NULL,
-        [AT_SOCKET_EVT_CLOSED] = NULL,
-};
-
-static int rw007_socket_event_send(struct at_device *device, uint32_t event)
-{
-    return (int) rt_event_send(device->socket_event, event);
-}
-
-static int rw007_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option)
-{
-    int result = RT_EOK;
-    rt_uint32_t recved;
-
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
-    if (result != RT_EOK)
-    {
-        return -RT_ETIMEOUT;
-    }
-
-    return recved;
-}
-
-/**
- * close socket by AT commands.
- *
- * @param current socket
- *
- * @return  0: close socket success
- *         -1: send AT commands error
- *         -2: wait socket event timeout
- *         -5: no memory
- */
-static int rw007_socket_close(struct at_socket *socket)
-{
-    int result = RT_EOK;
-    at_response_t resp = RT_NULL;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
-
-    resp = at_create_resp(64, 0, RT_TICK_PER_SECOND);
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for resp create.");
-        return -RT_ENOMEM;
-    }
-
-    result = at_obj_exec_cmd(device->client, resp, "AT+CIPCLOSE=%d", device_socket);
-
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
-
-    return result;
-}
-
-/**
- * create TCP/UDP client or server connect by AT commands.
- *
- * @param socket current socket
- * @param ip server or client IP address
- * @param port server or client port
- * @param type connect socket type(tcp, udp)
- * @param is_client connection is client
- *
- * @return   0: connect success
- *          -1: connect failed, send commands error or type error
- *          -2: wait socket event timeout
- *          -5: no memory
- */
-static int rw007_socket_connect(struct at_socket *socket, char *ip, int32_t port, enum at_socket_type type, rt_bool_t is_client)
-{
-    int result = RT_EOK;
-    rt_bool_t retryed = RT_FALSE;
-    at_response_t resp = RT_NULL;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
-
-    RT_ASSERT(ip);
-    RT_ASSERT(port >= 0);
-
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for resp create.");
-        return -RT_ENOMEM;
-    }
-
-__retry:
-    if (is_client)
-    {
-        switch (type)
-        {
-        case AT_SOCKET_TCP:
-            /* send AT commands to connect TCP server */
-            if (at_obj_exec_cmd(device->client, resp,
-                                "AT+CIPSTART=%d,\"TCP\",\"%s\",%d,60", device_socket, ip, port) < 0)
-            {
-                result = -RT_ERROR;
-            }
-            break;
-
-        case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, resp,
-                                "AT+CIPSTART=%d,\"UDP\",\"%s\",%d", device_socket, ip, port) < 0)
-            {
-                result = -RT_ERROR;
-            }
-            break;
-
-        default:
-            LOG_E("not supported connect type %d.", type);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-    }
-
-    if (result != RT_EOK && retryed == RT_FALSE)
-    {
-        LOG_D("%s device socket(%d) connect failed, the socket was not be closed and now will connect retry.",
-                device->name, socket);
-        if (rw007_socket_close(socket) < 0)
-        {
-            goto __exit;
-        }
-        retryed = RT_TRUE;
-        result = RT_EOK;
-        goto __retry;
-    }
-
-__exit:
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
-
-    return result;
-}
-
-/**
- * send data to server or client by AT commands.
- *
- * @param socket current socket
- * @param buff send buffer
- * @param bfsz send buffer size
- * @param type connect socket type(tcp, udp)
- *
- * @return >=0: the size of send success
- *          -1: send AT commands error or send data error
- *          -2: waited socket event timeout
- *          -5: no memory
- */
-static int rw007_socket_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
-{
-    int result = RT_EOK;
-    int event_result = 0;
-    size_t cur_pkt_size = 0, sent_size = 0;
-    at_response_t resp = RT_NULL;
-    int device_socket = (int) socket->user_data;
-    struct at_device *device = (struct at_device *) socket->device;
-    struct at_device_rw007 *rw007 = (struct at_device_rw007 *) device->user_data;
-    rt_mutex_t lock = at_device_get_client_lock(device);
-
-    RT_ASSERT(buff);
-    RT_ASSERT(bfsz > 0);
-
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
-    if (resp == RT_NULL)
-    {
-        LOG_E("no memory for resp create.");
-        return -RT_ENOMEM;
-    }
-
-    rt_mutex_take(lock, RT_WAITING_FOREVER);
-
-    /* set current socket for send URC event */
-    rw007->user_data = (void *) device_socket;
-
-    /* set AT client end sign to deal with '>' sign */
-    at_obj_set_end_sign(device->client, '>');
-
-    while (sent_size < bfsz)
-    {
-        if (bfsz - sent_size < RW007_MODULE_SEND_MAX_SIZE)
-        {
-            cur_pkt_size = bfsz - sent_size;
-        }
-        else
-        {
-            cur_pkt_size = RW007_MODULE_SEND_MAX_SIZE;
-        }
-
-        /* send the "AT+CIPSEND" commands to AT server than receive the '>' response on the first line */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
-        {
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* send the real data to server or client */
-        result = (int) at_client_obj_send(device->client, buff + sent_size, cur_pkt_size);
-        if (result == 0)
-        {
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        /* waiting result event from AT URC */
-        if (rw007_socket_event_recv(device, SET_EVENT(device_socket, 0), 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-        {
-            LOG_E("%s device socket(%d) wait send result timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-        /* waiting OK or failed result */
-        event_result = rw007_socket_event_recv(device, RW007_EVENT_SEND_OK | RW007_EVENT_SEND_FAIL,
-                            5 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
-        if (event_result  < 0)
-        {
-            LOG_E("%s device socket(%d) wait send OK|FAIL timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-        /* check result */
-        if (event_result & RW007_EVENT_SEND_FAIL)
-        {
-            LOG_E("%s device socket(%d) send failed.", device->name, device_socket);
-            result = -RT_ERROR;
-            goto __exit;
-        }
-
-        sent_size += cur_pkt_size;
-    }
-
-__exit:
-    /* reset the end sign for data */
-    at_obj_set_end_sign(device->client, 0);
-
-    rt_mutex_release(lock);
-
-    if (resp)
-    {
-        at_delete_resp(resp);
-    }
-
-    return result > 0 ? sent_size : result;
-}
+#endif
 
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -291,26 +35,18 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int rw007_domain_resolve(const char *name, char ip[16])
+static int rw007_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
 #define RESOLVE_RETRY        5
 
     int i, result = RT_EOK;
     char recv_ip[16] = { 0 };
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first init device failed.");
-        return -RT_ERROR;
-    }
-
-    resp = at_create_resp(128, 0, 20 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -319,7 +55,7 @@ static int rw007_domain_resolve(const char *name, char ip[16])
 
     for (i = 0; i < RESOLVE_RETRY; i++)
     {
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIPDOMAIN=\"%s\"", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CIPDOMAIN=\"%s\"", name) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -350,177 +86,62 @@ static int rw007_domain_resolve(const char *name, char ip[16])
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
 
 }
 
-/**
- * set AT socket event notice callback
- *
- * @param event notice event
- * @param cb notice callback
- */
-static void rw007_socket_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
-{
-    if (event < sizeof(at_evt_cb_set) / sizeof(at_evt_cb_set[1]))
-    {
-        at_evt_cb_set[event] = cb;
-    }
-}
-
 static const struct at_socket_ops rw007_socket_ops =
 {
-    rw007_socket_connect,
-    rw007_socket_close,
-    rw007_socket_send,
-    rw007_domain_resolve,
-    rw007_socket_set_event_cb,
+    at_device_dialect_socket_connect,
+    at_device_dialect_socket_close,
+    at_device_dialect_socket_send,
+    RT_NULL,
+    at_device_dialect_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
 #endif
 };
 
-static void urc_send_func(struct at_client *client, const char *data, rt_size_t size)
+static const struct at_urc urc_table[] =
 {
-    int device_socket = 0;
-    struct at_device *device = RT_NULL;
-    struct at_device_rw007 *rw007 = RT_NULL;
-    char *client_name = client->device->parent.name;
-
-    RT_ASSERT(data && size);
-
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
-    if (device == RT_NULL)
-    {
-        LOG_E("get device(%s) failed.", client_name);
-        return;
-    }
-    rw007 = (struct at_device_rw007 *) device->user_data;
-    device_socket = (int) rw007->user_data;
-
-    if (rt_strstr(data, "SEND OK"))
-    {
-        rw007_socket_event_send(device, SET_EVENT(device_socket, RW007_EVENT_SEND_OK));
-    }
-    else if (rt_strstr(data, "SEND FAIL"))
-    {
-        rw007_socket_event_send(device, SET_EVENT(device_socket, RW007_EVENT_SEND_FAIL));
-    }
-}
-
-static void urc_send_bfsz_func(struct at_client *client, const char *data, rt_size_t size)
-{
-    static int cur_send_bfsz = 0;
-
-    RT_ASSERT(data && size);
-
-    rt_sscanf(data, "Recv %d bytes", &cur_send_bfsz);
-}
-
-static void urc_close_func(struct at_client *client, const char *data, rt_size_t size)
-{
-    int device_socket = 0;
-    struct at_socket *socket = RT_NULL;
-    struct at_device *device = RT_NULL;
-    char *client_name = client->device->parent.name;
-
-    RT_ASSERT(data && size);
-
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
-    if (device == RT_NULL)
-    {
-        LOG_E("get device(%s) failed.", client_name);
-        return;
-    }
-
-    rt_sscanf(data, "%d,CLOSED", &device_socket);
-    /* get at socket object by device socket descriptor */
-    socket = &(device->sockets[device_socket]);
-
-    /* notice the socket is disconnect by remote */
-    if (at_evt_cb_set[AT_SOCKET_EVT_CLOSED])
-    {
-        at_evt_cb_set[AT_SOCKET_EVT_CLOSED](socket, AT_SOCKET_EVT_CLOSED, RT_NULL, 0);
-    }
-}
+    {"SEND OK",          "\r\n",           at_device_dialect_urc_send_func},
+    {"SEND FAIL",        "\r\n",           at_device_dialect_urc_send_func},
+    {"Recv",             "bytes\r\n",      at_device_dialect_urc_ignore_func},
+    {"",                 ",CLOSED\r\n",    at_device_dialect_urc_close_func},
+    {"+IPD",             ":",              at_device_dialect_urc_recv_func},
+};
 
-static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
+static const struct at_device_dialect rw007_socket_dialect =
 {
-    int device_socket = 0;
-    rt_int32_t timeout = 0;
-    rt_size_t bfsz = 0, temp_size = 0;
-    char *recv_buf = RT_NULL, temp[8] = {0};
-    struct at_socket *socket = RT_NULL;
-    struct at_device *device = RT_NULL;
-    char *client_name = client->device->parent.name;
-
-    RT_ASSERT(data && size);
-
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
-    if (device == RT_NULL)
-    {
-        LOG_E("get device(%s) failed.", client_name);
-        return;
-    }
-
-    /* get the current socket and receive buffer size by receive data */
-    rt_sscanf(data, "+IPD,%d,%d:", &device_socket, (int *) &bfsz);
-    /* set receive timeout by receive buffer length, not less than 10 ms */
-    timeout = bfsz > 10 ? bfsz : 10;
-
-    if (device_socket < 0 || bfsz == 0)
-    {
-        return;
-    }
+    "AT+CIPSTART=%d,\"TCP\",\"%s\",%d,60",
+    "AT+CIPSTART=%d,\"UDP\",\"%s\",%d",
+    "AT+CIPCLOSE=%d",
+    RT_NULL,
+    "AT+CIPSEND=%d,%d",
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
-    if (recv_buf == RT_NULL)
-    {
-        LOG_E("no memory for receive buffer (%d).", bfsz);
-        /* read and clean the coming data */
-        while (temp_size < bfsz)
-        {
-            if (bfsz - temp_size > sizeof(temp))
-            {
-                at_client_obj_recv(client, temp, sizeof(temp), timeout);
-            }
-            else
-            {
-                at_client_obj_recv(client, temp, bfsz - temp_size, timeout);
-            }
-            temp_size += sizeof(temp);
-        }
-        return;
-    }
+    "+IPD,%d,%d:",
+    "%d,CLOSED",
+    RT_NULL,
+    "SEND OK",
+    "SEND FAIL",
 
-    /* sync receive data */
-    if (at_client_obj_recv(client, recv_buf, bfsz, timeout) != bfsz)
-    {
-        LOG_E("%s device receive size(%d) data failed.", device->name, bfsz);
-        rt_free(recv_buf);
-        return;
-    }
+    '>',
+    0,
+    2,
+    RW007_MODULE_SEND_MAX_SIZE,
 
-    /* get at socket object by device socket descriptor */
-    socket = &(device->sockets[device_socket]);
+    5000,
+    1000,
+    5000,
+    10000,
 
-    /* notice the receive buffer and buffer size */
-    if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
-    {
-        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
-    }
-}
+    urc_table,
+    sizeof(urc_table) / sizeof(urc_table[0]),
 
-static struct at_urc urc_table[] =
-{
-    {"SEND OK",          "\r\n",           urc_send_func},
-    {"SEND FAIL",        "\r\n",           urc_send_func},
-    {"Recv",             "bytes\r\n",      urc_send_bfsz_func},
-    {"",                 ",CLOSED\r\n",    urc_close_func},
-    {"+IPD",             ":",              urc_recv_func},
+    RT_NULL,
 };
 
 int rw007_socket_init(struct at_device *device)
@@ -528,9 +149,7 @@ int rw007_socket_init(struct at_device *device)
     RT_ASSERT(device);
 
     /* register URC data execution function  */
-    at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
-
-    return RT_EOK;
+    return at_device_dialect_socket_init(device);
 }
 
 int rw007_socket_class_register(struct at_device_class *class)
@@ -539,6 +158,8 @@ int rw007_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_RW007_SOCKETS_NUM;
     class->socket_ops = &rw007_socket_ops;
+    class->domain_resolve = rw007_domain_resolve;
+    class->dialect = &rw007_socket_dialect;
 
     return RT_EOK;
 }
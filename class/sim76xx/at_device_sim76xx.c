@@ -107,7 +107,7 @@ static int sim76xx_netdev_set_info(struct netdev *netdev)
     netdev_low_level_set_link_status(netdev, RT_TRUE);
     netdev_low_level_set_dhcp_status(netdev, RT_TRUE);
 
-    resp = at_create_resp(SIM76XX_IMEI_RESP_SIZE, 0, SIM76XX_INFO_RESP_TIMO);
+    resp = at_device_resp_get(device, SIM76XX_IMEI_RESP_SIZE, 0, SIM76XX_INFO_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -196,7 +196,7 @@ static int sim76xx_netdev_set_info(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -222,7 +222,7 @@ static void check_link_status_entry(void *parameter)
         return;
     }
 
-    resp = at_create_resp(SIM76XX_LINK_RESP_SIZE, 0, SIM76XX_LINK_RESP_TIMO);
+    resp = at_device_resp_get(device, SIM76XX_LINK_RESP_SIZE, 0, SIM76XX_LINK_RESP_TIMO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -359,7 +359,7 @@ static int sim76xx_netdev_ping(struct netdev *netdev, const char *host,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(SIM76XX_PING_RESP_SIZE, 6, SIM76XX_PING_TIMEO);
+    resp = at_device_resp_get(device, SIM76XX_PING_RESP_SIZE, 6, SIM76XX_PING_TIMEO);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -398,7 +398,7 @@ static int sim76xx_netdev_ping(struct netdev *netdev, const char *host,
  __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -462,7 +462,11 @@ static struct netdev *sim76xx_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, cmd)                                          \
     do {                                                                        \
-        (resp) = at_resp_set_info((resp), 256, 0, 5 * RT_TICK_PER_SECOND);      \
+        if (at_resp_set_info((resp), 256, 0, 5 * RT_TICK_PER_SECOND) == RT_NULL) \
+        {                                                                       \
+            result = -RT_ENOMEM;                                                \
+            goto __exit;                                                        \
+        }                                                                       \
         if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                       \
         {                                                                       \
             result = -RT_ERROR;                                                 \
@@ -489,7 +493,7 @@ static void sim76xx_init_thread_entry(void *parameter)
     struct at_device *device = (struct at_device *)parameter;
     struct at_client *client = device->client;
 
-    resp = at_create_resp(128, 0, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -697,7 +701,7 @@ static void sim76xx_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result == RT_EOK)
@@ -22,13 +22,12 @@
 
 #ifdef AT_DEVICE_USING_SIM76XX
 
+#if !defined (SIM76XX_MODULE_SEND_MAX_SIZE)
 #define SIM76XX_MODULE_SEND_MAX_SIZE   1500
+#endif
 #define SIM76XX_MAX_CONNECTIONS        10
 #define SIM76XX_IPADDR_LEN             16
 
-/* set real event by current socket and current state */
-#define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
-
 /* AT socket event type */
 #define SIM76XX_EVENT_CONN_OK          (1L << 0)
 #define SIM76XX_EVENT_SEND_OK          (1L << 1)
@@ -67,25 +66,6 @@ static void at_tcp_ip_errcode_parse(int result)
     }
 }
 
-static int sim76xx_socket_event_send(struct at_device *device, uint32_t event)
-{
-    return (int)rt_event_send(device->socket_event, event);
-}
-
-static int sim76xx_socket_event_recv(struct at_device *device, uint32_t event, uint32_t timeout, rt_uint8_t option)
-{
-    int result = RT_EOK;
-    rt_uint32_t recved;
-
-    result = rt_event_recv(device->socket_event, event, option | RT_EVENT_FLAG_CLEAR, timeout, &recved);
-    if (result != RT_EOK)
-    {
-        return -RT_ETIMEOUT;
-    }
-
-    return recved;
-}
-
 /**
  * close socket by AT commands.
  *
@@ -104,7 +84,7 @@ static int sim76xx_socket_close(struct at_socket *socket)
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
 
-    resp = at_create_resp(64, 0, RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 64, 0, RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -114,7 +94,7 @@ static int sim76xx_socket_close(struct at_socket *socket)
     rt_thread_mdelay(100);
 
     /* check socket link_state */
-    if (at_obj_exec_cmd(device->client, resp, "AT+CIPCLOSE?") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+CIPCLOSE?") < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -134,7 +114,7 @@ static int sim76xx_socket_close(struct at_socket *socket)
         int i = 0;
 
         /* close tcp or udp socket if connected */
-        if (at_obj_exec_cmd(device->client, resp, "AT+CIPCLOSE=%d", device_socket) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CIPCLOSE=%d", device_socket) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -143,7 +123,7 @@ static int sim76xx_socket_close(struct at_socket *socket)
         /* wait sim76xx device sockt closed */
         for (i = 0; i < CLOSE_COUNTS; i++)
         {
-            if (at_obj_exec_cmd(device->client, resp, "AT+CIPCLOSE?") < 0)
+            if (at_device_exec_cmd(device, resp, "AT+CIPCLOSE?") < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -163,7 +143,7 @@ static int sim76xx_socket_close(struct at_socket *socket)
  __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -195,7 +175,7 @@ static int sim76xx_socket_connect(struct at_socket *socket, char *ip, int32_t po
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -214,14 +194,14 @@ __retry:
         {
         case AT_SOCKET_TCP:
             /* send AT commands to connect TCP server */
-            if (at_obj_exec_cmd(device->client, resp, "AT+CIPOPEN=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
+            if (at_device_exec_cmd(device, resp, "AT+CIPOPEN=%d,\"TCP\",\"%s\",%d", device_socket, ip, port) < 0)
             {
                 result = -RT_ERROR;
             }
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, resp, "AT+CIPOPEN=%d,\"UDP\",,,%d", device_socket, port) < 0)
+            if (at_device_exec_cmd(device, resp, "AT+CIPOPEN=%d,\"UDP\",,,%d", device_socket, port) < 0)
             {
                 result = -RT_ERROR;
             }
@@ -237,15 +217,8 @@ __retry:
     }
 
     /* waiting result event from AT URC, the device default connection timeout is 75 seconds, but it set to 10 seconds is convenient to use.*/
-    if (sim76xx_socket_event_recv(device, SET_EVENT(device_socket, 0), 10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-    {
-        LOG_E("%s device socket(%d) wait connect result timeout.", device->name, device_socket);
-        result = -RT_ETIMEOUT;
-        goto __exit;
-    }
-    /* waiting OK or failed result */
-    event_result = sim76xx_socket_event_recv(device, SIM76XX_EVENT_CONN_OK | SIM76XX_EVENT_CONN_FAIL,
-                                        1 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+    event_result = at_device_socket_event_recv(device, device_socket, SIM76XX_EVENT_CONN_OK | SIM76XX_EVENT_CONN_FAIL,
+                                               10 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
     if (event_result < 0)
     {
         LOG_E("%s device socket(%d) wait connect OK|FAIL timeout.", device->name, device_socket);
@@ -264,6 +237,7 @@ __retry:
                 goto __exit;
             }
             retryed = RT_TRUE;
+            AT_DEVICE_STATS_INC(device, retries);
             goto __retry;
         }
         LOG_E("%s device socket(%d) connect failed.", device->name, device_socket);
@@ -276,7 +250,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -309,7 +283,7 @@ static int sim76xx_socket_send(struct at_socket *socket, const char *buff, size_
     RT_ASSERT(buff);
     RT_ASSERT(bfsz > 0);
 
-    resp = at_create_resp(128, 2, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 2, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -338,7 +312,7 @@ static int sim76xx_socket_send(struct at_socket *socket, const char *buff, size_
         {
         case AT_SOCKET_TCP:
             /* send the "AT+CIPSEND" commands to AT server than receive the '>' response on the first line. */
-            if (at_obj_exec_cmd(device->client, resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
+            if (at_device_exec_cmd(device, resp, "AT+CIPSEND=%d,%d", device_socket, cur_pkt_size) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -346,8 +320,8 @@ static int sim76xx_socket_send(struct at_socket *socket, const char *buff, size_
             break;
         case AT_SOCKET_UDP:
             /* send the "AT+CIPSEND" commands to AT server than receive the '>' response on the first line. */
-            if (at_obj_exec_cmd(device->client, resp, "AT+CIPSEND=%d,%d,\"%s\",%d",
-                                device_socket, cur_pkt_size, udp_ipstr[device_socket], udp_port[device_socket]) < 0)
+            if (at_device_exec_cmd(device, resp, "AT+CIPSEND=%d,%d,\"%s\",%d",
+                                   device_socket, cur_pkt_size, udp_ipstr[device_socket], udp_port[device_socket]) < 0)
             {
                 result = -RT_ERROR;
                 goto __exit;
@@ -367,15 +341,8 @@ static int sim76xx_socket_send(struct at_socket *socket, const char *buff, size_
         }
 
         /* waiting result event from AT URC */
-        if (sim76xx_socket_event_recv(device, SET_EVENT(device_socket, 0), 5 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR) < 0)
-        {
-            LOG_E("%s device socket (%d) wait send result timeout.", device->name, device_socket);
-            result = -RT_ETIMEOUT;
-            goto __exit;
-        }
-        /* waiting OK or failed result */
-        event_result = sim76xx_socket_event_recv(device, SIM76XX_EVENT_SEND_OK | SIM76XX_EVENT_SEND_FAIL,
-                                                 5 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+        event_result = at_device_socket_event_recv(device, device_socket, SIM76XX_EVENT_SEND_OK | SIM76XX_EVENT_SEND_FAIL,
+                                                   5 * RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
         if (event_result < 0)
         {
             LOG_E("%s device socket(%d) wait send OK|FAIL timeout.", device->name, device_socket);
@@ -390,6 +357,7 @@ static int sim76xx_socket_send(struct at_socket *socket, const char *buff, size_
             goto __exit;
         }
 
+        at_device_stats_send(device, device_socket, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -401,7 +369,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result > 0 ? sent_size : result;
@@ -410,6 +378,7 @@ __exit:
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -417,7 +386,7 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int sim76xx_domain_resolve(const char *name, char ip[16])
+static int sim76xx_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
 #define RESOLVE_RETRY        5
 
@@ -425,19 +394,11 @@ static int sim76xx_domain_resolve(const char *name, char ip[16])
     char domain[32] = {0};
     char domain_ip[16] = {0};
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first init device failed.");
-        return -RT_ERROR;
-    }
-
-    resp = at_create_resp(128, 0, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 0, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -446,7 +407,7 @@ static int sim76xx_domain_resolve(const char *name, char ip[16])
 
     for (i = 0; i < RESOLVE_RETRY; i++)
     {
-        if (at_obj_exec_cmd(device->client, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+CDNSGIP=\"%s\"", name) < 0)
         {
             rt_thread_mdelay(200);
             /* resolve failed, maybe receive an URC CRLF */
@@ -483,7 +444,7 @@ static int sim76xx_domain_resolve(const char *name, char ip[16])
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -511,15 +472,15 @@ static void urc_send_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
-        LOG_E("get device(%s) failed.");
+        LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
     rt_sscanf(data, "+CIPSEND: %d,%d,%d", &device_socket, &rqst_size, &cnf_size);
-    sim76xx_socket_event_send(device, SET_EVENT(device_socket, SIM76XX_EVENT_SEND_OK));
+    at_device_socket_event_send(device, device_socket, SIM76XX_EVENT_SEND_OK);
 }
 
 static void urc_connect_func(struct at_client *client, const char *data, rt_size_t size)
@@ -530,7 +491,7 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -541,12 +502,12 @@ static void urc_connect_func(struct at_client *client, const char *data, rt_size
 
     if (result == 0)
     {
-        sim76xx_socket_event_send(device, SET_EVENT(device_socket, SIM76XX_EVENT_CONN_OK));
+        at_device_socket_event_send(device, device_socket, SIM76XX_EVENT_CONN_OK);
     }
     else
     {
         at_tcp_ip_errcode_parse(result);
-        sim76xx_socket_event_send(device, SET_EVENT(device_socket, SIM76XX_EVENT_CONN_FAIL));
+        at_device_socket_event_send(device, device_socket, SIM76XX_EVENT_CONN_FAIL);
     }
 }
 
@@ -559,10 +520,10 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
-        LOG_E("get device(%s) failed.", device->name);
+        LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
@@ -590,7 +551,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -607,7 +568,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     if (bfsz == 0)
         return;
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    recv_buf = (char *) at_device_recv_buf_alloc(device, bfsz);
     if (recv_buf == RT_NULL)
     {
         LOG_E("no memory for receive buffer(%d).", bfsz);
@@ -641,6 +602,8 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     socket = &(device->sockets[device_socket]);
 
     /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
@@ -660,7 +623,7 @@ static const struct at_socket_ops sim76xx_socket_ops =
     sim76xx_socket_connect,
     sim76xx_socket_close,
     sim76xx_socket_send,
-    sim76xx_domain_resolve,
+    RT_NULL,
     sim76xx_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
@@ -685,6 +648,7 @@ int sim76xx_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_SIM76XX_SOCKETS_NUM;
     class->socket_ops = &sim76xx_socket_ops;
+    class->domain_resolve = sim76xx_domain_resolve;
 
     return RT_EOK;
 }
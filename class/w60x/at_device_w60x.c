@@ -58,7 +58,7 @@ static void w60x_get_netdev_info(struct rt_work *work, void *work_data)
         rt_free(work);
     }
 
-    resp = at_create_resp(512, 1, rt_tick_from_millisecond(3000));
+    resp = at_device_resp_get(device, 512, 1, rt_tick_from_millisecond(3000));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -155,7 +155,7 @@ static void w60x_get_netdev_info(struct rt_work *work, void *work_data)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 }
 
@@ -227,7 +227,7 @@ static int w60x_netdev_set_addr_info(struct netdev *netdev, ip_addr_t *ip_addr,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 1, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 1, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -288,7 +288,7 @@ static int w60x_netdev_set_addr_info(struct netdev *netdev, ip_addr_t *ip_addr,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -316,7 +316,7 @@ static int w60x_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 1, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 1, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -356,7 +356,7 @@ static int w60x_netdev_set_dns_server(struct netdev *netdev, uint8_t dns_num, ip
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -383,7 +383,7 @@ static int w60x_netdev_set_dhcp(struct netdev *netdev, rt_bool_t is_enabled)
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 1, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 128, 1, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp struct.");
@@ -419,7 +419,7 @@ static int w60x_netdev_set_dhcp(struct netdev *netdev, rt_bool_t is_enabled)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -456,7 +456,7 @@ static int w60x_netdev_ping(struct netdev *netdev, const char *host,
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(256, 1, timeout);
+    resp = at_device_resp_get(device, 256, 1, timeout);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -492,7 +492,7 @@ static int w60x_netdev_ping(struct netdev *netdev, const char *host,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -512,7 +512,7 @@ void w60x_netdev_netstat(struct netdev *netdev)
         return;
     }
 
-    resp = at_create_resp(128, 1, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 1, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.", device->name);
@@ -532,7 +532,7 @@ void w60x_netdev_netstat(struct netdev *netdev)
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 }
 #endif /* NETDEV_USING_NETSTAT */
@@ -594,7 +594,11 @@ static struct netdev *w60x_netdev_add(const char *netdev_name)
 
 #define AT_SEND_CMD(client, resp, cmd)                                     \
     do {                                                                   \
-        (resp) = at_resp_set_info((resp), 256, 1, 3 * RT_TICK_PER_SECOND); \
+        if (at_resp_set_info((resp), 256, 1, 3 * RT_TICK_PER_SECOND) == RT_NULL) \
+        {                                                                  \
+            result = -RT_ENOMEM;                                           \
+            goto __exit;                                                   \
+        }                                                                  \
         if (at_obj_exec_cmd((client), (resp), (cmd)) < 0)                  \
         {                                                                  \
             result = -RT_ERROR;                                            \
@@ -633,7 +637,7 @@ static void w60x_init_thread_entry(void *parameter)
     /* wait w60x device startup finish */
     rt_thread_mdelay(1000);
 
-    resp = at_create_resp(256, 1, 3 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 256, 1, 3 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -691,7 +695,7 @@ static void w60x_init_thread_entry(void *parameter)
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     if (result != RT_EOK)
@@ -809,7 +813,7 @@ static int w60x_wifi_info_set(struct at_device *device, struct at_device_ssid_pw
         return -RT_ERROR;
     }
 
-    resp = at_create_resp(128, 1, 20 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 1, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -838,7 +842,7 @@ static int w60x_wifi_info_set(struct at_device *device, struct at_device_ssid_pw
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -19,7 +19,9 @@
 
 #if defined(AT_DEVICE_USING_W60X) && defined(AT_USING_SOCKET)
 
+#if !defined (W60X_MODULE_SEND_MAX_SIZE)
 #define W60X_MODULE_SEND_MAX_SIZE   512
+#endif
 
 static rt_int32_t w60x_socket_fd[AT_DEVICE_W60X_SOCKETS_NUM] = {-1};
 
@@ -47,7 +49,7 @@ static int w60x_socket_close(struct at_socket *socket)
     int wsk = w60x_socket_fd[device_socket];
 
     w60x_socket_fd[device_socket] = -1;
-    resp = at_create_resp(64, 1, rt_tick_from_millisecond(300));
+    resp = at_device_resp_get(device, 64, 1, rt_tick_from_millisecond(300));
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -56,11 +58,11 @@ static int w60x_socket_close(struct at_socket *socket)
 
     at_obj_set_end_sign(device->client, '\r');
 
-    result = at_obj_exec_cmd(device->client, resp, "AT+SKCLS=%d", wsk);
+    result = at_device_exec_cmd(device, resp, "AT+SKCLS=%d", wsk);
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -91,7 +93,7 @@ static int w60x_socket_connect(struct at_socket *socket, char *ip, int32_t port,
     RT_ASSERT(ip);
     RT_ASSERT(port >= 0);
 
-    resp = at_create_resp(64, 1, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 64, 1, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -101,7 +103,7 @@ static int w60x_socket_connect(struct at_socket *socket, char *ip, int32_t port,
     at_obj_set_end_sign(device->client, '\r');
 
     /* send the "AT+SKRPTM" commands */
-    if (at_obj_exec_cmd(device->client, resp, "AT+SKRPTM=1") < 0)
+    if (at_device_exec_cmd(device, resp, "AT+SKRPTM=1") < 0)
     {
         result = -RT_ERROR;
         goto __exit;
@@ -112,16 +114,16 @@ static int w60x_socket_connect(struct at_socket *socket, char *ip, int32_t port,
     {
         case AT_SOCKET_TCP:
             /* send AT commands */
-            if (at_obj_exec_cmd(device->client, resp,
-                                "AT+SKCT=0,%d,%s,%d", is_client ? 0 : 1, is_client ? ip : 0, port) < 0)
+            if (at_device_exec_cmd(device, resp,
+                                   "AT+SKCT=0,%d,%s,%d", is_client ? 0 : 1, is_client ? ip : 0, port) < 0)
             {
                 result = -RT_ERROR;
             }
             break;
 
         case AT_SOCKET_UDP:
-            if (at_obj_exec_cmd(device->client, resp,
-                                "AT+SKCT=1,%d,%s,%d", is_client ? 0 : 1, is_client ? ip : 0, port) < 0)
+            if (at_device_exec_cmd(device, resp,
+                                   "AT+SKCT=1,%d,%s,%d", is_client ? 0 : 1, is_client ? ip : 0, port) < 0)
             {
                 result = -RT_ERROR;
             }
@@ -146,7 +148,7 @@ static int w60x_socket_connect(struct at_socket *socket, char *ip, int32_t port,
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -172,13 +174,12 @@ static int w60x_socket_send(struct at_socket *socket, const char *buff, size_t b
     at_response_t resp = RT_NULL;
     int device_socket = (int) socket->user_data;
     struct at_device *device = (struct at_device *) socket->device;
-    struct at_device_w60x *w60x = (struct at_device_w60x *) device->user_data;
     rt_mutex_t lock = at_device_get_client_lock(device);
 
     RT_ASSERT(buff);
     RT_ASSERT(bfsz > 0);
 
-    resp = at_create_resp(128, 1, 5 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 1, 5 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -187,9 +188,6 @@ static int w60x_socket_send(struct at_socket *socket, const char *buff, size_t b
 
     rt_mutex_take(lock, RT_WAITING_FOREVER);
 
-    /* set current socket for send URC event */
-    w60x->user_data = (void *) device_socket;
-
     /* set AT client end sign to deal with '\n' sign */
     at_obj_set_end_sign(device->client, '\n');
 
@@ -206,7 +204,7 @@ static int w60x_socket_send(struct at_socket *socket, const char *buff, size_t b
 
         rt_thread_mdelay(5);
         /* send the "AT+SKSND" commands */
-        if (at_obj_exec_cmd(device->client, resp, "AT+SKSND=%d,%d", w60x_socket_fd[device_socket], cur_pkt_size) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+SKSND=%d,%d", w60x_socket_fd[device_socket], cur_pkt_size) < 0)
         {
             result = -RT_ERROR;
             goto __exit;
@@ -226,6 +224,7 @@ static int w60x_socket_send(struct at_socket *socket, const char *buff, size_t b
             goto __exit;
         }
 
+        at_device_stats_send(device, device_socket, cur_pkt_size);
         sent_size += cur_pkt_size;
     }
 
@@ -237,7 +236,7 @@ __exit:
 
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result > 0 ? sent_size : result;
@@ -246,6 +245,7 @@ __exit:
 /**
  * domain resolve by AT commands.
  *
+ * @param device AT device object
  * @param name domain name
  * @param ip parsed IP address, it's length must be 16
  *
@@ -253,27 +253,19 @@ __exit:
  *         -2: wait socket event timeout
  *         -5: no memory
  */
-static int w60x_domain_resolve(const char *name, char ip[16])
+static int w60x_domain_resolve(struct at_device *device, const char *name, char ip[16])
 {
 #define RESOLVE_RETRY        5
 
     int i, result = -RT_ERROR;
     char recv_ip[16] = { 0 };
     at_response_t resp = RT_NULL;
-    struct at_device *device = RT_NULL;
     char *pos;
 
     RT_ASSERT(name);
     RT_ASSERT(ip);
 
-    device = at_device_get_first_initialized();
-    if (device == RT_NULL)
-    {
-        LOG_E("get first init device failed.");
-        return -RT_ERROR;
-    }
-
-    resp = at_create_resp(128, 1, 20 * RT_TICK_PER_SECOND);
+    resp = at_device_resp_get(device, 128, 1, 20 * RT_TICK_PER_SECOND);
     if (resp == RT_NULL)
     {
         LOG_E("no memory for resp create.");
@@ -284,7 +276,7 @@ static int w60x_domain_resolve(const char *name, char ip[16])
 
     for (i = 0; i < RESOLVE_RETRY; i++)
     {
-        if (at_obj_exec_cmd(device->client, resp, "AT+SKGHBN=%s", name) < 0)
+        if (at_device_exec_cmd(device, resp, "AT+SKGHBN=%s", name) < 0)
         {
             goto __exit;
         }
@@ -318,7 +310,7 @@ static int w60x_domain_resolve(const char *name, char ip[16])
 __exit:
     if (resp)
     {
-        at_delete_resp(resp);
+        at_device_resp_put(device, resp);
     }
 
     return result;
@@ -344,7 +336,7 @@ static const struct at_socket_ops w60x_socket_ops =
     w60x_socket_connect,
     w60x_socket_close,
     w60x_socket_send,
-    w60x_domain_resolve,
+    RT_NULL,
     w60x_socket_set_event_cb,
 #if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
     RT_NULL,
@@ -368,7 +360,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 
     RT_ASSERT(data && size);
 
-    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    device = at_device_get_by_client(client);
     if (device == RT_NULL)
     {
         LOG_E("get device(%s) failed.", client_name);
@@ -394,7 +386,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     if (device_socket < 0 || bfsz == 0)
         return;
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
+    recv_buf = (char *) at_device_recv_buf_alloc(device, bfsz);
     if (recv_buf == RT_NULL)
     {
         LOG_E("no memory receive buffer(%d).", bfsz);
@@ -429,6 +421,8 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     socket = &(device->sockets[device_socket]);
 
     /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
     if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
     {
         at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
@@ -459,6 +453,7 @@ int w60x_socket_class_register(struct at_device_class *class)
 
     class->socket_num = AT_DEVICE_W60X_SOCKETS_NUM;
     class->socket_ops = &w60x_socket_ops;
+    class->domain_resolve = w60x_domain_resolve;
 
     return RT_EOK;
 }
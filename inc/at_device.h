@@ -72,12 +72,85 @@ extern "C" {
 #define AT_DEVICE_CTRL_GET_GPS         0x0BL
 #define AT_DEVICE_CTRL_GET_VER         0x0CL
 #define AT_DEVICE_CTRL_SET_HOST_NAME   0x0DL
+
 /* Name type */
 #define AT_DEVICE_NAMETYPE_DEVICE      0x01
 #define AT_DEVICE_NAMETYPE_NETDEV      0x02
 #define AT_DEVICE_NAMETYPE_CLIENT      0x03
 
+/* The number of maximum size receive buffers in the AT device receive pool */
+#ifndef AT_DEVICE_RECV_POOL_NUM
+#define AT_DEVICE_RECV_POOL_NUM        4
+#endif
+
+/* The default maximum size of the receive buffer, used when the device class has no MTU */
+#ifndef AT_DEVICE_RECV_POOL_MTU
+#define AT_DEVICE_RECV_POOL_MTU        1500
+#endif
+
+/* The number and buffer size of small and large response objects in the AT device response pool */
+#ifndef AT_DEVICE_RESP_POOL_SMALL_NUM
+#define AT_DEVICE_RESP_POOL_SMALL_NUM  3
+#endif
+
+#ifndef AT_DEVICE_RESP_POOL_SMALL_SIZE
+#define AT_DEVICE_RESP_POOL_SMALL_SIZE 128
+#endif
+
+#ifndef AT_DEVICE_RESP_POOL_LARGE_NUM
+#define AT_DEVICE_RESP_POOL_LARGE_NUM  1
+#endif
+
+#ifndef AT_DEVICE_RESP_POOL_LARGE_SIZE
+#define AT_DEVICE_RESP_POOL_LARGE_SIZE 512
+#endif
+
+#define AT_DEVICE_RESP_POOL_NUM        (AT_DEVICE_RESP_POOL_SMALL_NUM + AT_DEVICE_RESP_POOL_LARGE_NUM)
+
+/* The network domains of AT device registration */
+#define AT_DEVICE_LINK_GPRS            0 /* "+CGREG" */
+#define AT_DEVICE_LINK_EPS             1 /* "+CEREG" */
+#define AT_DEVICE_LINK_DOMAIN_NUM      2
+
+/* The maximum number of addresses kept for one resolved domain name */
+#ifndef AT_DEVICE_DNS_ADDR_NUM
+#define AT_DEVICE_DNS_ADDR_NUM         4
+#endif
+
+/* The maximum length of one resolved address string, IPv4 or IPv6 */
+#define AT_DEVICE_DNS_ADDR_LEN         46
+
+/* The socket passthrough is used by the device classes running it */
+#if defined(AT_USING_SOCKET) && (defined(AT_DEVICE_ESP8266_PASSTHROUGH) || defined(AT_DEVICE_ESP32_PASSTHROUGH))
+#define AT_DEVICE_USING_PASSTHROUGH
+#endif
+
+/* The link status follows the registration reports for the cellular device classes using it */
+#if defined(AT_DEVICE_USING_EC20) || defined(AT_DEVICE_USING_EC200X)
+#define AT_DEVICE_USING_LINK
+#endif
+
+/* The pull-mode receive is used by the device classes reading the data buffered in the module */
+#if defined(AT_USING_SOCKET) && (defined(AT_DEVICE_USING_L610) || defined(AT_DEVICE_BC26_RECV_PULL) || \
+        defined(AT_DEVICE_EC20_RECV_PULL) || defined(AT_DEVICE_EC200X_RECV_PULL) || \
+        defined(AT_DEVICE_ESP8266_RECV_PASSIVE) || defined(AT_DEVICE_ESP32_RECV_PASSIVE))
+#define AT_DEVICE_USING_PULL
+#endif
+
+/* The receive pool is enabled by AT_DEVICE_USING_RECV_POOL. The receive buffers
+ * are released by rt_free() in AT socket, so the pool needs the system heap
+ * managed by memheap, otherwise all buffers are allocated from the system heap */
+#if defined(AT_DEVICE_USING_RECV_POOL) && !defined(RT_USING_MEMHEAP_AS_HEAP)
+#error "AT_DEVICE_USING_RECV_POOL requires RT_USING_MEMHEAP_AS_HEAP, please enable it or disable the receive pool"
+#endif
+
+#if defined(AT_DEVICE_USING_RECV_POOL) && (AT_DEVICE_RECV_POOL_NUM <= 0)
+#error "AT_DEVICE_RECV_POOL_NUM must be greater than 0 when AT_DEVICE_USING_RECV_POOL is enabled"
+#endif
+
 struct at_device;
+struct at_device_dialect;
+struct at_device_uplink;
 
 /* AT device wifi ssid and password information */
 struct at_device_ssid_pwd
@@ -100,11 +173,110 @@ struct at_device_class
     const struct at_device_ops *device_ops;      /* AT device operaiotns */
 #ifdef AT_USING_SOCKET
     uint32_t socket_num;                         /* The maximum number of sockets support */
+    uint32_t recv_mtu;                           /* The maximum size of one socket receive data */
     const struct at_socket_ops *socket_ops;      /* AT device socket operations */
+#ifndef AT_DEVICE_USING_SINGLE_CLASS
+    struct at_socket_ops dns_socket_ops;         /* AT device socket operations with DNS cache */
 #endif
+    int (*domain_resolve)(struct at_device *device, const char *name, char ip[16]); /* AT device class domain resolve */
+    int (*connect)(struct at_socket *socket, char *ip, int32_t port,
+            enum at_socket_type type, rt_bool_t is_client); /* AT device class socket connect */
+    void (*set_event_cb)(at_socket_evt_t event, at_evt_cb_t cb); /* AT device class socket event callback set */
+    const struct at_device_dialect *dialect;     /* AT device class socket dialect, RT_NULL for none */
+#ifdef AT_DEVICE_USING_PULL
+    int (*pull_read)(struct at_device *device, int device_socket, rt_size_t size); /* AT device class pull-mode read command */
+#endif
+    uint32_t send_window;                        /* The maximum bytes sent and not acknowledged by peer in TCP */
+    int (*send_ack)(struct at_device *device, int device_socket,
+            size_t *acked, size_t *unacked);     /* AT device class query of TCP acknowledged bytes */
+#if defined(AT_DEVICE_USING_UPLINK) || defined(AT_DEVICE_USING_AUTO_SLEEP) || defined(AT_DEVICE_USING_FAILOVER) || \
+        defined(AT_DEVICE_USING_SINGLE_CLASS)
+    int (*send)(struct at_socket *socket, const char *buff, size_t bfsz,
+            enum at_socket_type type);           /* AT device class socket send */
+    int (*close)(struct at_socket *socket);      /* AT device class socket close */
+#endif
+#if defined(AT_DEVICE_USING_SINGLE_CLASS) && defined(AT_USING_SOCKET_SERVER)
+    int (*listen)(struct at_socket *socket, int backlog); /* AT device class socket listen */
+#endif
+#endif
+/* AT_DEVICE_USING_SINGLE_CLASS is defined by SConscript when exactly one AT
+ * device class is enabled, the class is then kept without the class list and
+ * its socket operations are wrapped by one constant table instead of the
+ * dns_socket_ops copy */
+#ifndef AT_DEVICE_USING_SINGLE_CLASS
     rt_slist_t list;                             /* AT device class list */
+#endif
+};
+
+#ifdef AT_USING_SOCKET
+#ifdef AT_DEVICE_USING_RECV_POOL
+/* AT device socket receive buffer pool */
+struct at_device_recv_pool
+{
+    struct rt_memheap heap;                      /* The memory heap of pool buffers */
+    void *start;                                 /* The start address of pool memory */
+    rt_size_t block_size;                        /* The size of every pool buffer, the device class MTU */
+};
+#endif /* AT_DEVICE_USING_RECV_POOL */
+
+/* AT device statistics, the counters are updated without lock and wrap around */
+struct at_device_stats
+{
+    rt_uint32_t cmds;                            /* AT commands issued by socket operations */
+    rt_uint32_t cmd_timeouts;                    /* AT commands waited response timeout */
+    rt_uint32_t retries;                         /* Socket operations retried */
+    rt_uint32_t urcs;                            /* Socket URC events dispatched */
+    rt_uint32_t chunks_sent;                     /* Socket data chunks sent */
+    rt_uint32_t bytes_sent;                      /* Socket data bytes sent */
+    rt_uint32_t bytes_recv;                      /* Socket data bytes received */
+    rt_uint32_t recv_pool_hits;                  /* Receive buffers allocated from receive pool */
+    rt_uint32_t recv_pool_misses;                /* Receive buffers allocated from system heap */
+    rt_uint32_t recv_alloc_fails;                /* Receive buffers allocate failed */
+    rt_uint32_t recv_dropped;                    /* Socket data bytes dropped for no receive buffer */
+    rt_uint32_t window_polls;                    /* Send window acknowledged bytes queried */
+    rt_uint32_t window_stalls;                   /* Sends waited for the send window */
+    rt_uint32_t sleeps;                          /* Module put into sleep by auto sleep */
+    rt_uint32_t wakeups;                         /* Module woken up by auto sleep */
+    rt_uint32_t wake_time;                       /* Milliseconds spent waking up the module */
+};
+
+/* AT device send completion queue entry */
+struct at_device_send_entry
+{
+    int device_socket;                           /* The socket waiting for send completion, -1 for a cancelled send */
+    rt_tick_t expire;                            /* The tick the late result of the cancelled send is no longer waited */
 };
 
+/* AT device socket TCP send window, the counters restart on every connection */
+struct at_device_send_window
+{
+    rt_uint32_t sent;                            /* Bytes handed to the module */
+    rt_uint32_t acked;                           /* Bytes acknowledged by peer */
+};
+
+/* AT device uplink scheduler statistics */
+struct at_device_uplink_stats
+{
+    rt_uint32_t wakeups;                         /* Radio wake-ups reported by the module */
+    rt_uint32_t forced_wakeups;                  /* Datagrams sent while the radio sleeps */
+    rt_uint32_t datagrams;                       /* Datagrams sent by the scheduler */
+    rt_uint32_t bytes;                           /* Datagram bytes sent by the scheduler */
+    rt_uint32_t queued;                          /* Datagram bytes waiting for the active window */
+    rt_uint32_t dropped;                         /* Queued datagrams dropped without sending */
+    rt_uint32_t dropped_bytes;                   /* Queued datagram bytes dropped without sending */
+    rt_uint32_t uptime;                          /* Seconds from the scheduler start */
+    rt_uint32_t wakeups_per_hour;                /* Radio wake-ups per hour */
+    rt_uint32_t bytes_per_wake;                  /* Datagram bytes sent per radio wake-up */
+};
+
+/* AT device socket statistics */
+struct at_device_socket_stats
+{
+    rt_uint32_t bytes_sent;                      /* Socket data bytes sent */
+    rt_uint32_t bytes_recv;                      /* Socket data bytes received */
+};
+#endif /* AT_USING_SOCKET */
+
 struct at_device
 {
     char name[RT_NAME_MAX];                      /* AT device name */
@@ -114,7 +286,67 @@ struct at_device
     struct netdev *netdev;                       /* Network interface device for AT device */
 #ifdef AT_USING_SOCKET
     rt_event_t socket_event;                     /* AT device socket event */
+    struct rt_event *socket_events;              /* AT device per-socket completion events */
+    struct at_device_send_entry *send_sockets;   /* AT device sockets waiting for send completion, in issue order */
+    rt_uint16_t send_head;                       /* AT device oldest waiting send socket index */
+    rt_uint16_t send_count;                      /* AT device waiting send socket count, cancelled sends included */
     struct at_socket *sockets;                   /* AT device sockets list */
+#ifdef AT_DEVICE_USING_RECV_POOL
+    struct at_device_recv_pool recv_pool;        /* AT device socket receive buffer pool */
+#endif
+    struct at_device_stats stats;                /* AT device statistics */
+    struct at_device_socket_stats *socket_stats; /* AT device per-socket statistics */
+    struct at_device_send_window *send_windows;  /* AT device per-socket TCP send windows, RT_NULL for none */
+    struct rt_mutex dns_lock;                    /* AT device domain resolve lock */
+    rt_uint16_t dns_busy;                        /* AT device outstanding domain resolve count */
+    rt_uint32_t dns_ttl;                         /* AT device last resolved name TTL, 0 for unknown */
+    rt_uint32_t connect_time;                    /* AT device average socket connect time in ms */
+    rt_uint8_t dns_addr_expect;                  /* AT device last resolved name address count, 0 for unknown */
+    rt_uint8_t dns_addr_num;                     /* AT device last resolved name reported address count */
+    rt_uint8_t dns_addr_max;                     /* AT device resolve in progress address buffer count */
+    char (*dns_addrs)[AT_DEVICE_DNS_ADDR_LEN];   /* AT device resolve in progress address buffer of the caller, RT_NULL for none */
+#ifdef AT_DEVICE_USING_PASSTHROUGH
+    struct at_urc passthrough_urc;               /* AT device catch-all URC of socket passthrough */
+    rt_bool_t passthrough;                       /* AT device socket data streams in passthrough */
+    char passthrough_prompt[2];                  /* AT device data prompt URC prefix of entering passthrough */
+#endif
+#ifdef AT_DEVICE_USING_PULL
+    rt_uint32_t recv_pending;                    /* AT device sockets with data buffered in the module, one bit each */
+    char *pull_buf;                              /* AT device receive buffer of the read in progress */
+    rt_size_t pull_size;                         /* AT device receive buffer size of the read in progress */
+    rt_size_t pull_len;                          /* AT device bytes got by the read in progress */
+    rt_bool_t pull_queued;                       /* AT device is queued to the pull thread */
+    rt_uint8_t pull_retries;                     /* AT device failed reads retried in a row */
+    rt_slist_t pull_list;                        /* AT device pull thread queue */
+#endif
+#ifdef AT_DEVICE_USING_UPLINK
+    struct at_device_uplink *uplink;             /* AT device uplink scheduler, RT_NULL for not used */
+#endif
+#if defined(AT_DEVICE_USING_AGGR) || defined(AT_DEVICE_USING_FAILOVER)
+    netdev_callback_fn netdev_status_cb;         /* AT device network interface status callback set before the watch */
+#endif
+#ifdef AT_DEVICE_USING_AUTO_SLEEP
+    rt_uint16_t wake_refs;                       /* AT device commands and socket operations in flight */
+    rt_bool_t sleeping;                          /* AT device is put into sleep by auto sleep */
+    rt_uint32_t sleep_idle;                      /* AT device idle time in ms before sleep, 0 for disabled */
+    rt_tick_t active_tick;                       /* AT device tick of the last operation end */
+    rt_timer_t sleep_timer;                      /* AT device idle timer of auto sleep */
+#endif
+#endif
+#if AT_DEVICE_RESP_POOL_NUM > 0
+    at_response_t resp_pool[AT_DEVICE_RESP_POOL_NUM]; /* AT device response objects, small ones first */
+    rt_uint32_t resp_pool_busy;                  /* AT device response objects checked out mask */
+#endif
+#ifdef AT_DEVICE_USING_LINK
+    rt_int8_t link_stat[AT_DEVICE_LINK_DOMAIN_NUM]; /* AT device registration status reported, -1 for unknown */
+    rt_bool_t link_watch;                        /* AT device link status follows the registration reports */
+    rt_bool_t link_lost;                         /* AT device packet data context is lost, the link is down until recovered */
+    rt_bool_t link_dirty;                        /* AT device link status is to be updated by the link thread */
+    int (*link_poll)(struct at_device *device);  /* AT device class query at the signal interval */
+    int (*link_recover)(struct at_device *device); /* AT device class activation of the lost packet data context */
+    rt_tick_t link_recover_tick;                 /* AT device last packet data context loss or activation attempt */
+    rt_tick_t link_recover_delay;                /* AT device delay of the next activation attempt, doubled on failure */
+    rt_slist_t link_list;                        /* AT device link followed list */
 #endif
     rt_slist_t list;                             /* AT device list */
 
@@ -124,10 +356,142 @@ struct at_device
 /* Get AT device object */
 struct at_device *at_device_get_first_initialized(void);
 struct at_device *at_device_get_by_name(int type, const char *name);
+struct at_device *at_device_get_by_client(struct at_client *client);
+
+/* Check out and return the AT response object of AT device */
+at_response_t at_device_resp_get(struct at_device *device, rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout);
+void at_device_resp_put(struct at_device *device, at_response_t resp);
 #ifdef AT_USING_SOCKET
 struct at_device *at_device_get_by_socket(int at_socket);
+
+/* Send and receive the completion event of the specified AT device socket */
+int at_device_socket_event_send(struct at_device *device, int device_socket, uint32_t event);
+int at_device_socket_event_recv(struct at_device *device, int device_socket, uint32_t event,
+                                rt_int32_t timeout, rt_uint8_t option);
+
+/* Track the AT device sockets waiting for a send completion without socket number */
+int at_device_socket_send_push(struct at_device *device, int device_socket);
+int at_device_socket_send_pop(struct at_device *device);
+void at_device_socket_send_remove(struct at_device *device, int device_socket);
+void at_device_socket_send_cancel(struct at_device *device, int device_socket, rt_int32_t timeout);
+
+/* Keep the TCP bytes not acknowledged by peer within the send window of AT device class */
+int at_device_send_window_wait(struct at_device *device, int device_socket, size_t size, rt_int32_t timeout);
+void at_device_send_window_sent(struct at_device *device, int device_socket, size_t size);
+void at_device_send_window_reset(struct at_device *device, int device_socket);
+
+/* Hex string codec of the socket data carried in AT command line and URC */
+void at_device_hex_encode(char *hex, const void *data, rt_size_t size);
+rt_size_t at_device_hex_decode(void *data, const char *hex, rt_size_t size);
+rt_size_t at_device_hex_send(struct at_device *device, const void *data, rt_size_t size);
+int at_device_hex_abort(struct at_device *device, at_response_t resp);
+
+/* Allocate the socket receive buffer, the buffer is released by rt_free() */
+void *at_device_recv_buf_alloc(struct at_device *device, rt_size_t size);
+
+/* Update AT device statistics */
+#define AT_DEVICE_STATS_ADD(device, field, value)  ((device)->stats.field += (value))
+#define AT_DEVICE_STATS_INC(device, field)         AT_DEVICE_STATS_ADD(device, field, 1)
+
+int at_device_stats_cmd(struct at_device *device, int result);
+void at_device_stats_send(struct at_device *device, int device_socket, size_t size);
+void at_device_stats_recv(struct at_device *device, struct at_socket *socket, size_t size);
+
+#ifdef AT_DEVICE_USING_AUTO_SLEEP
+int at_device_cmd_end(struct at_device *device, int result);
+
+/* Execute AT command for AT device socket operations and count it in statistics, the module is kept awake */
+#define at_device_exec_cmd(device, resp, ...) \
+    at_device_cmd_end((device), (at_device_wake_get(device), at_obj_exec_cmd((device)->client, (resp), __VA_ARGS__)))
+#else
+/* Execute AT command for AT device socket operations and count it in statistics */
+#define at_device_exec_cmd(device, resp, ...) \
+    at_device_stats_cmd((device), at_obj_exec_cmd((device)->client, (resp), __VA_ARGS__))
+#endif /* AT_DEVICE_USING_AUTO_SLEEP */
+
+/* Domain resolve with all addresses reported by the AT device */
+int at_device_dns_addr_add(struct at_device *device, const char *ip);
+int at_device_domain_resolve_all(const char *name, char addrs[][AT_DEVICE_DNS_ADDR_LEN], int addr_num);
+
+/* Asynchronous domain resolve, the ip is RT_NULL when the resolve failed */
+typedef void (*at_device_resolve_cb_t)(int request_id, const char *name, int result, const char *ip, void *user_data);
+int at_device_domain_resolve_async(const char *name, at_device_resolve_cb_t cb, void *user_data);
+
+/* Get AT device statistics */
+int at_device_stats_get(struct at_device *device, struct at_device_stats *stats);
+int at_device_socket_stats_get(struct at_device *device, int device_socket, struct at_device_socket_stats *stats);
+
+/* Notice AT socket that the socket is closed by the lost link */
+void at_device_socket_closed_notice(struct at_socket *socket);
+/* Notice AT socket the received data, the receive buffer is taken over */
+void at_device_socket_recv_notice(struct at_device *device, struct at_socket *socket, char *buf, rt_size_t len);
+
+/* Pull-mode receive, the module buffers the socket data and it's read in the pull thread */
+#ifdef AT_DEVICE_USING_PULL
+int at_device_pull_init(struct at_device *device);
+int at_device_pull_notice(struct at_device *device, int device_socket);
+void at_device_pull_clear(struct at_device *device, int device_socket);
+rt_size_t at_device_pull_recv(struct at_device *device, rt_size_t size);
 #endif
 
+#ifdef AT_DEVICE_USING_UPLINK
+/* Uplink scheduler, the UDP datagrams wait for the active window of the power saving radio */
+int at_device_uplink_init(struct at_device *device);
+int at_device_uplink_send(struct at_device *device, struct at_socket *socket, const char *buff, size_t bfsz);
+void at_device_uplink_flush(struct at_device *device);
+void at_device_uplink_notice(struct at_device *device, rt_bool_t active);
+void at_device_uplink_closed(struct at_device *device, int device_socket);
+int at_device_uplink_stats_get(struct at_device *device, struct at_device_uplink_stats *stats);
+#endif
+
+#if defined(AT_DEVICE_USING_AGGR) || defined(AT_DEVICE_USING_FAILOVER)
+/* Follow the AT device network interface status */
+void at_device_netdev_watch(struct at_device *device);
+#endif
+
+#ifdef AT_DEVICE_USING_AGGR
+/* Link aggregation network interface backed by several AT devices */
+int at_device_aggr_create(const char *netdev_name);
+int at_device_aggr_add(const char *device_name);
+rt_bool_t at_device_aggr_match(const char *netdev_name);
+struct at_device *at_device_aggr_select(void);
+void at_device_aggr_update(void);
+#endif /* AT_DEVICE_USING_AGGR */
+
+#ifdef AT_DEVICE_USING_FAILOVER
+/* Reconnect callback of the client socket lost by failover */
+typedef void (*at_device_failover_cb_t)(struct at_device *standby, const char *ip, int32_t port,
+                                        enum at_socket_type type, void *user_data);
+
+/* Hot-standby failover from the primary AT device to the standby AT device */
+int at_device_failover_set(const char *primary_name, const char *standby_name);
+void at_device_failover_set_reconnect_cb(at_device_failover_cb_t cb, void *user_data);
+void at_device_failover_update(struct at_device *device);
+void at_device_failover_connected(struct at_device *device, struct at_socket *socket,
+                                  const char *ip, int32_t port, enum at_socket_type type);
+void at_device_failover_closed(struct at_device *device, struct at_socket *socket);
+#endif /* AT_DEVICE_USING_FAILOVER */
+#endif /* AT_USING_SOCKET */
+
+#ifdef AT_DEVICE_USING_LINK
+/* Follow the link status of AT device by the "+CGREG" and "+CEREG" reports */
+int at_device_link_init(struct at_device *device);
+int at_device_link_query(struct at_device *device, int domain);
+int at_device_link_watch(struct at_device *device, int (*poll)(struct at_device *device),
+                         int (*recover)(struct at_device *device));
+void at_device_link_lost(struct at_device *device);
+#endif
+/* Wait until the AT device answers after it's woken up */
+int at_device_ready_wait(struct at_device *device, rt_int32_t timeout);
+#if defined(AT_USING_SOCKET) && defined(AT_DEVICE_USING_AUTO_SLEEP)
+/* Count the AT commands and socket operations in flight, the module sleeps when none is for the idle time */
+int at_device_auto_sleep_set(struct at_device *device, rt_uint32_t idle_time);
+void at_device_wake_get(struct at_device *device);
+void at_device_wake_put(struct at_device *device);
+#else
+#define at_device_wake_get(device)     ((void) (device))
+#define at_device_wake_put(device)     ((void) (device))
+#endif
 /* Get the client lock (mutex) of the specified AT device. */
 rt_mutex_t at_device_get_client_lock(struct at_device *device);
 /* AT device control operaions */
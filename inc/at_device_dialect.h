@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __AT_DEVICE_DIALECT_H__
+#define __AT_DEVICE_DIALECT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <at_device.h>
+
+#ifdef AT_USING_SOCKET
+
+/* The send result is waited without AT client lock, so the next packet can be sent in the meantime */
+#define AT_DEVICE_DIALECT_SEND_UNLOCKED    (1U << 0)
+/* The close command is only sent when AT socket closes the socket, not for the socket closed by remote */
+#define AT_DEVICE_DIALECT_CLOSE_STATE      (1U << 1)
+
+/* AT device socket completion events used by the socket dialect engine */
+#define AT_DEVICE_DIALECT_EVENT_CONN_OK    (1L << 0)
+#define AT_DEVICE_DIALECT_EVENT_SEND_OK    (1L << 1)
+#define AT_DEVICE_DIALECT_EVENT_CONN_FAIL  (1L << 4)
+#define AT_DEVICE_DIALECT_EVENT_SEND_FAIL  (1L << 5)
+#define AT_DEVICE_DIALECT_EVENT_PROMPT     (1L << 6)
+
+/*
+ * AT device socket passthrough, the module runs one connection and the socket
+ * data streams over the AT client without send commands and receive URCs.
+ */
+struct at_device_passthrough
+{
+    const char *connect_tcp;                     /* TCP connect, arguments: IP address, port */
+    const char *connect_udp;                     /* UDP connect, arguments: IP address, port */
+    const char *mode;                            /* passthrough mode, argument: 1 for enter, 0 for exit */
+    const char *send;                            /* start streaming, it's answered by the data prompt */
+    const char *close;                           /* close the connection */
+    const char *escape;                          /* escape sequence back to command mode */
+    rt_uint32_t guard_time;                      /* silence before and after escape sequence in milliseconds */
+};
+
+/*
+ * AT device socket dialect, it describes the socket commands and URCs of the
+ * modules which share the same socket logic and differ in command strings.
+ */
+struct at_device_dialect
+{
+    /* command templates */
+    const char *connect_tcp;                     /* TCP connect, arguments: device socket, IP address, port */
+    const char *connect_udp;                     /* UDP connect, arguments: device socket, IP address, port */
+    const char *close;                           /* close, argument: device socket */
+    const char *close_server;                    /* close the listening server, RT_NULL for not supported */
+    const char *send;                            /* send, arguments: device socket, data size */
+
+    /* URC parse formats and results */
+    const char *recv_urc;                        /* receive data, parses device socket and data size */
+    const char *close_urc;                       /* closed by remote, parses device socket */
+    const char *connected_urc;                   /* server accepted, parses device socket, RT_NULL for not supported */
+    const char *send_ok;                         /* send success result */
+    const char *send_fail;                       /* send failed result */
+
+    /* send and completion semantics */
+    char prompt;                                 /* data prompt of send command, 0 for none */
+    rt_uint8_t flags;                            /* AT_DEVICE_DIALECT_xxx flags */
+    rt_uint16_t send_resp_lines;                 /* response lines of send command, 0 for OK or prompt */
+    size_t send_max_size;                        /* maximum size of one send packet */
+
+    /* timeouts in milliseconds */
+    rt_int32_t connect_timeout;
+    rt_int32_t close_timeout;
+    rt_int32_t send_timeout;                     /* wait the send and read command response */
+    rt_int32_t send_result_timeout;              /* wait the send result */
+
+    /* URC table of the socket dialect */
+    const struct at_urc *urc_table;
+    rt_size_t urc_table_size;
+
+    /* socket passthrough, RT_NULL for not used, the class has only one socket when used */
+    const struct at_device_passthrough *passthrough;
+
+    /* pull-mode receive, the data is buffered in the module and read by the host, RT_NULL for not used */
+    const char *pull;                            /* read command, arguments: device socket, maximum size */
+    const char *pull_urc;                        /* read response header, parses data size */
+    const char *notice_urc;                      /* data buffered notice, parses device socket */
+
+    /* connect result reported by URC after the connect command, RT_NULL for the command result */
+    const char *connect_urc;                     /* connect result, parses device socket and error code, 0 for success */
+    rt_int32_t connect_result_timeout;           /* wait the connect result in milliseconds */
+};
+
+/* Socket operations of the socket dialect engine */
+int at_device_dialect_socket_connect(struct at_socket *socket, char *ip, int32_t port,
+                                     enum at_socket_type type, rt_bool_t is_client);
+int at_device_dialect_socket_close(struct at_socket *socket);
+int at_device_dialect_socket_send(struct at_socket *socket, const char *buff, size_t bfsz,
+                                  enum at_socket_type type);
+void at_device_dialect_socket_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb);
+
+/* URC functions of the socket dialect engine */
+void at_device_dialect_urc_send_func(struct at_client *client, const char *data, rt_size_t size);
+void at_device_dialect_urc_close_func(struct at_client *client, const char *data, rt_size_t size);
+void at_device_dialect_urc_recv_func(struct at_client *client, const char *data, rt_size_t size);
+void at_device_dialect_urc_ignore_func(struct at_client *client, const char *data, rt_size_t size);
+void at_device_dialect_urc_connect_func(struct at_client *client, const char *data, rt_size_t size);
+#ifdef AT_USING_SOCKET_SERVER
+void at_device_dialect_urc_connected_func(struct at_client *client, const char *data, rt_size_t size);
+#endif
+#ifdef AT_DEVICE_USING_PULL
+void at_device_dialect_urc_notice_func(struct at_client *client, const char *data, rt_size_t size);
+void at_device_dialect_urc_pull_func(struct at_client *client, const char *data, rt_size_t size);
+#endif
+
+/* Register the socket dialect URC table of AT device */
+int at_device_dialect_socket_init(struct at_device *device);
+
+#endif /* AT_USING_SOCKET */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_DEVICE_DIALECT_H__ */
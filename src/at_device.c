@@ -17,10 +17,60 @@
 #define DBG_LVL              DBG_INFO
 #include <rtdbg.h>
 
+/*
+ * The global AT device and AT device class lists are append-only: a node is
+ * fully initialized before it is linked at the tail and is never removed, so
+ * lookups walk the lists without masking interrupts and only registration
+ * serializes writers. On SMP the writers on different cores are serialized
+ * by a spinlock, masking interrupts is local to one core, and the fields of
+ * a node are published by a barrier before the node is linked. The list
+ * readers load the fields through the linked pointer, which keeps them
+ * ordered after the link, the client binding readers have no such
+ * dependency and take the barrier before loading the device.
+ */
+#ifdef RT_USING_SMP
+static struct rt_spinlock at_device_list_lock;
+
+#define AT_DEVICE_LIST_LOCK()          rt_spin_lock_irqsave(&at_device_list_lock)
+#define AT_DEVICE_LIST_UNLOCK(level)   rt_spin_unlock_irqrestore(&at_device_list_lock, level)
+#define AT_DEVICE_LIST_BARRIER()       rt_hw_dmb()
+#else
+#define AT_DEVICE_LIST_LOCK()          rt_hw_interrupt_disable()
+#define AT_DEVICE_LIST_UNLOCK(level)   rt_hw_interrupt_enable(level)
+#define AT_DEVICE_LIST_BARRIER()
+#endif /* RT_USING_SMP */
+
 /* The global list of at device */
 static rt_slist_t at_device_list = RT_SLIST_OBJECT_INIT(at_device_list);
+#ifdef AT_DEVICE_USING_SINGLE_CLASS
+/* The only AT device class of the single class build */
+static struct at_device_class *at_device_single_class = RT_NULL;
+#else
 /* The global list of at device class */
 static rt_slist_t at_device_class_list = RT_SLIST_OBJECT_INIT(at_device_class_list);
+#endif
+
+/* The maximum number of AT client to AT device bindings, must be a power of 2 */
+#ifndef AT_DEVICE_CLIENT_BIND_NUM
+#define AT_DEVICE_CLIENT_BIND_NUM      8
+#endif
+
+#if (AT_DEVICE_CLIENT_BIND_NUM & (AT_DEVICE_CLIENT_BIND_NUM - 1)) != 0
+#error "AT_DEVICE_CLIENT_BIND_NUM must be a power of 2"
+#endif
+
+/* The clients are the elements of the AT client table, the index of the element is the hash */
+#define AT_DEVICE_CLIENT_HASH(client)  ((((rt_ubase_t) (client)) / sizeof(struct at_client)) & (AT_DEVICE_CLIENT_BIND_NUM - 1))
+
+/* AT client to AT device binding, used by URC handlers to find the device directly */
+struct at_device_client_bind
+{
+    struct at_client *client;
+    struct at_device *device;
+};
+
+/* The global AT client binding table, open addressing by the client object address */
+static struct at_device_client_bind at_device_client_bind_table[AT_DEVICE_CLIENT_BIND_NUM];
 
 /**
  * Get the client lock (mutex) of the specified AT device.
@@ -29,123 +79,1755 @@ static rt_slist_t at_device_class_list = RT_SLIST_OBJECT_INIT(at_device_class_li
  * @param device: Pointer to the AT device object.
  * @return The client lock (rt_mutex_t) of the AT device.
  */
-rt_mutex_t at_device_get_client_lock(struct at_device *device)
+rt_mutex_t at_device_get_client_lock(struct at_device *device)
+{
+#if defined(RT_VERSION_CHECK) && (RTTHREAD_VERSION > RT_VERSION_CHECK(5, 2, 1))
+    return &(device->client->lock);
+#else
+    return device->client->lock;
+#endif
+}
+
+/**
+ * This function will get the first initialized AT device.
+ *
+ * @return the AT device structure pointer
+ */
+struct at_device *at_device_get_first_initialized(void)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device *device = RT_NULL;
+
+    rt_slist_for_each(node, &at_device_list)
+    {
+        device = rt_slist_entry(node, struct at_device, list);
+        if (device && device->is_init == RT_TRUE)
+        {
+           return device;
+        }
+    }
+
+    return RT_NULL;
+}
+
+/**
+ * This function will get AT device by device name.
+ *
+ * @param type the name type
+ * @param name the device name or the client name
+ *
+ * @return the AT device structure pointer
+ */
+struct at_device *at_device_get_by_name(int type, const char *name)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device *device = RT_NULL;
+
+    RT_ASSERT(name);
+
+#if defined(AT_USING_SOCKET) && defined(AT_DEVICE_USING_AGGR)
+    /* the aggregation network interface places the new connection on a member device */
+    if (type == AT_DEVICE_NAMETYPE_NETDEV && at_device_aggr_match(name))
+    {
+        return at_device_aggr_select();
+    }
+#endif
+
+    rt_slist_for_each(node, &at_device_list)
+    {
+        device = rt_slist_entry(node, struct at_device, list);
+        if (device)
+        {
+            if (((type == AT_DEVICE_NAMETYPE_DEVICE) || (type == AT_DEVICE_NAMETYPE_NETDEV)) &&
+                (rt_strncmp(device->name, name, rt_strlen(name)) == 0))
+            {
+                return device;
+            }
+            else if ((type == AT_DEVICE_NAMETYPE_CLIENT) && device->client &&
+                (rt_strncmp(device->client->device->parent.name, name, rt_strlen(name)) == 0))
+            {
+                return device;
+            }
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* Bind the AT client of the device, the binding entry is never removed once published */
+static void at_device_client_bind(struct at_device *device)
+{
+    int i, index;
+    rt_base_t level;
+    struct at_device_client_bind *bind = RT_NULL;
+
+    if (device->client == RT_NULL)
+    {
+        return;
+    }
+
+    index = AT_DEVICE_CLIENT_HASH(device->client);
+
+    level = AT_DEVICE_LIST_LOCK();
+
+    for (i = 0; i < AT_DEVICE_CLIENT_BIND_NUM; i++)
+    {
+        bind = &at_device_client_bind_table[index];
+        if (bind->client == device->client)
+        {
+            break;
+        }
+        else if (bind->client == RT_NULL)
+        {
+            /* publish the device before the client, lookups are not locked */
+            bind->device = device;
+            AT_DEVICE_LIST_BARRIER();
+            bind->client = device->client;
+            break;
+        }
+        index = (index + 1) & (AT_DEVICE_CLIENT_BIND_NUM - 1);
+    }
+
+    AT_DEVICE_LIST_UNLOCK(level);
+
+    if (i == AT_DEVICE_CLIENT_BIND_NUM)
+    {
+        LOG_W("AT device(%s) client bind table is full.", device->name);
+    }
+}
+
+/**
+ * This function will get AT device by AT client object, it's used by URC handlers.
+ *
+ * @param client the AT client object
+ *
+ * @return the AT device structure pointer
+ */
+struct at_device *at_device_get_by_client(struct at_client *client)
+{
+    int i, index;
+    struct at_device *device = RT_NULL;
+    struct at_device_client_bind *bind = RT_NULL;
+
+    RT_ASSERT(client);
+
+    index = AT_DEVICE_CLIENT_HASH(client);
+
+    for (i = 0; i < AT_DEVICE_CLIENT_BIND_NUM; i++)
+    {
+        bind = &at_device_client_bind_table[index];
+        if (bind->client == client)
+        {
+            /* the device is published before the client */
+            AT_DEVICE_LIST_BARRIER();
+            return bind->device;
+        }
+        else if (bind->client == RT_NULL)
+        {
+            break;
+        }
+        index = (index + 1) & (AT_DEVICE_CLIENT_BIND_NUM - 1);
+    }
+
+    /* the client is not bound yet (URC received during device initialization) */
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client->device->parent.name);
+    if (device)
+    {
+        at_device_client_bind(device);
+    }
+
+    return device;
+}
+
+#if AT_DEVICE_RESP_POOL_NUM > 32
+#error "AT_DEVICE_RESP_POOL_NUM must not be greater than 32"
+#endif
+
+/* The buffer size of the response object in the AT device response pool, small ones first */
+#define AT_DEVICE_RESP_POOL_SIZE(index) \
+    (((index) < AT_DEVICE_RESP_POOL_SMALL_NUM) ? AT_DEVICE_RESP_POOL_SMALL_SIZE : AT_DEVICE_RESP_POOL_LARGE_SIZE)
+
+/**
+ * This function will check out an AT response object from the AT device
+ * response pool. The smallest free object whose buffer is large enough is
+ * used, a new object is created when the pool has none of them.
+ *
+ * @param device the pointer of AT device structure
+ * @param buf_size the required response buffer size
+ * @param line_num the response line number, 0 to end with "OK" or "ERROR"
+ * @param timeout the response timeout
+ *
+ * @return != RT_NULL: the AT response object
+ *            RT_NULL: no memory
+ */
+at_response_t at_device_resp_get(struct at_device *device, rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout)
+{
+#if AT_DEVICE_RESP_POOL_NUM > 0
+    rt_base_t level;
+    int i, index = -1;
+    at_response_t resp = RT_NULL;
+
+    if (device)
+    {
+        level = rt_hw_interrupt_disable();
+
+        for (i = 0; i < AT_DEVICE_RESP_POOL_NUM; i++)
+        {
+            resp = device->resp_pool[i];
+            if (resp && (device->resp_pool_busy & (1UL << i)) == 0 && resp->buf_size >= buf_size)
+            {
+                device->resp_pool_busy |= (1UL << i);
+                index = i;
+                break;
+            }
+        }
+
+        rt_hw_interrupt_enable(level);
+    }
+
+    if (index >= 0)
+    {
+        resp->buf_len = 0;
+        resp->line_num = line_num;
+        resp->line_counts = 0;
+        resp->timeout = timeout;
+        return resp;
+    }
+#endif /* AT_DEVICE_RESP_POOL_NUM > 0 */
+
+    return at_create_resp(buf_size, line_num, timeout);
+}
+
+/**
+ * This function will return the AT response object to the AT device
+ * response pool, or delete it when it is not a pool object. The buffer
+ * of the pool object resized by at_resp_set_info() is restored to the
+ * size of the pool object.
+ *
+ * @param device the pointer of AT device structure
+ * @param resp the AT response object
+ */
+void at_device_resp_put(struct at_device *device, at_response_t resp)
+{
+#if AT_DEVICE_RESP_POOL_NUM > 0
+    rt_base_t level;
+    int i;
+    char *buf = RT_NULL;
+
+    if (resp == RT_NULL)
+    {
+        return;
+    }
+
+    for (i = 0; device && i < AT_DEVICE_RESP_POOL_NUM; i++)
+    {
+        if (device->resp_pool[i] == resp)
+        {
+            /* at_resp_set_info() on the object reallocates the buffer and changes the buffer
+             * size before the reallocation, which is kept when the reallocation failed, so
+             * the buffer is reallocated to the pool size before the object is reused, it's
+             * done in place when the buffer size is not changed */
+            buf = rt_realloc(resp->buf, AT_DEVICE_RESP_POOL_SIZE(i));
+            if (buf)
+            {
+                resp->buf = buf;
+                resp->buf_size = AT_DEVICE_RESP_POOL_SIZE(i);
+            }
+            else
+            {
+                /* the object is replaced, its buffer size is unknown */
+                at_delete_resp(resp);
+                device->resp_pool[i] = at_create_resp(AT_DEVICE_RESP_POOL_SIZE(i), 0, RT_TICK_PER_SECOND);
+            }
+
+            level = rt_hw_interrupt_disable();
+            device->resp_pool_busy &= ~(1UL << i);
+            rt_hw_interrupt_enable(level);
+            return;
+        }
+    }
+#endif /* AT_DEVICE_RESP_POOL_NUM > 0 */
+
+    at_delete_resp(resp);
+}
+
+#if AT_DEVICE_RESP_POOL_NUM > 0
+/**
+ * This function will create the response objects of AT device response pool,
+ * the objects failed to create are left empty and skipped.
+ *
+ * @param device the pointer of AT device structure
+ */
+static void at_device_resp_pool_create(struct at_device *device)
+{
+    int i;
+
+    for (i = 0; i < AT_DEVICE_RESP_POOL_NUM; i++)
+    {
+        device->resp_pool[i] = at_create_resp(AT_DEVICE_RESP_POOL_SIZE(i), 0, RT_TICK_PER_SECOND);
+        if (device->resp_pool[i] == RT_NULL)
+        {
+            LOG_W("no memory for AT device(%s) response pool create.", device->name);
+        }
+    }
+    device->resp_pool_busy = 0;
+}
+#endif /* AT_DEVICE_RESP_POOL_NUM > 0 */
+
+#ifdef AT_USING_SOCKET
+/**
+ * This function will get AT device by ip address.
+ *
+ * @param ip_addr input ip address
+ * network
+ * @return != NULL: network interface device object
+ *            NULL: get failed
+ */
+struct at_device *at_device_get_by_ipaddr(ip_addr_t *ip_addr)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device *device = RT_NULL;
+
+    rt_slist_for_each(node, &at_device_list)
+    {
+        device = rt_slist_entry(node, struct at_device, list);
+        if (device && device->netdev && ip_addr_cmp(ip_addr, &(device->netdev->ip_addr)))
+        {
+           return device;
+        }
+    }
+
+    return RT_NULL;
+
+}
+
+/**
+ * This function will send the completion event to the specified AT device socket,
+ * every socket has its own event object so operations on different sockets
+ * never receive each other's completions.
+ *
+ * @param device the pointer of AT device structure
+ * @param device_socket the AT device socket number
+ * @param event the event set
+ *
+ * @return = 0: send successfully
+ *         < 0: send failed
+ */
+int at_device_socket_event_send(struct at_device *device, int device_socket, uint32_t event)
+{
+    RT_ASSERT(device);
+
+    if (device_socket < 0 || device_socket >= (int) device->class->socket_num)
+    {
+        LOG_E("AT device(%s) socket(%d) is invalid.", device->name, device_socket);
+        return -RT_EINVAL;
+    }
+
+    AT_DEVICE_STATS_INC(device, urcs);
+
+    return (int) rt_event_send(&(device->socket_events[device_socket]), event);
+}
+
+/**
+ * This function will receive the completion event of the specified AT device socket,
+ * the received events are cleared.
+ *
+ * @param device the pointer of AT device structure
+ * @param device_socket the AT device socket number
+ * @param event the interested event set
+ * @param timeout the waiting time
+ * @param option the receive option, RT_EVENT_FLAG_AND or RT_EVENT_FLAG_OR
+ *
+ * @return >= 0: the received event set
+ *         < 0: receive timeout or failed
+ */
+int at_device_socket_event_recv(struct at_device *device, int device_socket, uint32_t event,
+                                rt_int32_t timeout, rt_uint8_t option)
+{
+    rt_uint32_t recved = 0;
+
+    RT_ASSERT(device);
+
+    if (device_socket < 0 || device_socket >= (int) device->class->socket_num)
+    {
+        LOG_E("AT device(%s) socket(%d) is invalid.", device->name, device_socket);
+        return -RT_EINVAL;
+    }
+
+    if (rt_event_recv(&(device->socket_events[device_socket]), event,
+                      option | RT_EVENT_FLAG_CLEAR, timeout, &recved) != RT_EOK)
+    {
+        return -RT_ETIMEOUT;
+    }
+
+    return (int) recved;
+}
+
+/* The send completion queue keeps the cancelled sends besides one send of every socket */
+#define AT_DEVICE_SEND_QUEUE_NUM(device)   ((device)->class->socket_num * 2)
+
+/* Drop the cancelled sends at the queue head whose late result is no longer waited */
+static void at_device_socket_send_expire(struct at_device *device, rt_tick_t now)
+{
+    struct at_device_send_entry *entry = RT_NULL;
+
+    while (device->send_count > 0)
+    {
+        entry = &(device->send_sockets[device->send_head]);
+        if (entry->device_socket >= 0 || (rt_int32_t) (entry->expire - now) > 0)
+        {
+            break;
+        }
+
+        device->send_head = (device->send_head + 1) % AT_DEVICE_SEND_QUEUE_NUM(device);
+        device->send_count--;
+    }
+}
+
+/**
+ * This function will append the AT device socket to the send completion queue.
+ * The modules report "SEND OK" without socket number, so the completions are
+ * matched to the sending sockets in issue order.
+ *
+ * @param device the pointer of AT device structure
+ * @param device_socket the AT device socket number
+ *
+ * @return 0: append success
+ *        -3: the queue is full
+ */
+int at_device_socket_send_push(struct at_device *device, int device_socket)
+{
+    rt_base_t level;
+    int result = RT_EOK;
+    struct at_device_send_entry *entry = RT_NULL;
+
+    RT_ASSERT(device);
+
+    level = rt_hw_interrupt_disable();
+
+    at_device_socket_send_expire(device, rt_tick_get());
+
+    if (device->send_count < AT_DEVICE_SEND_QUEUE_NUM(device))
+    {
+        entry = &(device->send_sockets[(device->send_head + device->send_count) % AT_DEVICE_SEND_QUEUE_NUM(device)]);
+        entry->device_socket = device_socket;
+        entry->expire = 0;
+        device->send_count++;
+    }
+    else
+    {
+        result = -RT_EFULL;
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return result;
+}
+
+/**
+ * This function will take the oldest AT device socket out of the send
+ * completion queue. The late result of a cancelled send is taken by the
+ * cancelled entry and belongs to no socket.
+ *
+ * @param device the pointer of AT device structure
+ *
+ * @return >= 0: the AT device socket number
+ *          -1: no socket is waiting for send completion, or the send is cancelled
+ */
+int at_device_socket_send_pop(struct at_device *device)
+{
+    rt_base_t level;
+    int device_socket = -1;
+
+    RT_ASSERT(device);
+
+    level = rt_hw_interrupt_disable();
+
+    at_device_socket_send_expire(device, rt_tick_get());
+
+    if (device->send_count > 0)
+    {
+        device_socket = device->send_sockets[device->send_head].device_socket;
+        device->send_head = (device->send_head + 1) % AT_DEVICE_SEND_QUEUE_NUM(device);
+        device->send_count--;
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return device_socket;
+}
+
+/* Find the waiting send of the AT device socket in the send completion queue, -1 for none */
+static int at_device_socket_send_find(struct at_device *device, int device_socket)
+{
+    rt_uint16_t i;
+    int index;
+
+    for (i = 0; i < device->send_count; i++)
+    {
+        index = (device->send_head + i) % AT_DEVICE_SEND_QUEUE_NUM(device);
+        if (device->send_sockets[index].device_socket == device_socket)
+        {
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * This function will remove the AT device socket from the send completion queue,
+ * it is used when the send is given up and the module will not report its result,
+ * e.g. the send command is refused.
+ *
+ * @param device the pointer of AT device structure
+ * @param device_socket the AT device socket number
+ */
+void at_device_socket_send_remove(struct at_device *device, int device_socket)
+{
+    rt_base_t level;
+    uint32_t num;
+    int index;
+
+    RT_ASSERT(device);
+
+    num = AT_DEVICE_SEND_QUEUE_NUM(device);
+    level = rt_hw_interrupt_disable();
+
+    index = at_device_socket_send_find(device, device_socket);
+    if (index >= 0)
+    {
+        /* move the later entries forward */
+        while ((rt_uint16_t) ((index + num - device->send_head) % num) < device->send_count - 1)
+        {
+            device->send_sockets[index] = device->send_sockets[(index + 1) % num];
+            index = (index + 1) % num;
+        }
+        device->send_count--;
+    }
+
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will cancel the send of the AT device socket in the send
+ * completion queue, it is used when the send result is waited timeout. The
+ * module may still report the result later, so the entry is kept in its place
+ * to take the late result instead of the next send, and it is dropped when
+ * the result is not reported in the timeout.
+ *
+ * @param device the pointer of AT device structure
+ * @param device_socket the AT device socket number
+ * @param timeout the time the late result is waited
+ */
+void at_device_socket_send_cancel(struct at_device *device, int device_socket, rt_int32_t timeout)
+{
+    rt_base_t level;
+    int index;
+
+    RT_ASSERT(device);
+
+    level = rt_hw_interrupt_disable();
+
+    index = at_device_socket_send_find(device, device_socket);
+    if (index >= 0)
+    {
+        device->send_sockets[index].device_socket = -1;
+        device->send_sockets[index].expire = rt_tick_get() + timeout;
+    }
+
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will allocate a zeroed socket receive buffer of AT device.
+ * The buffer is taken from the device receive pool when it is available, or
+ * from the system heap when the pool is exhausted or the size is larger than
+ * the pool buffer, in both cases it is handed over to AT socket and released
+ * by rt_free().
+ *
+ * @param device the pointer of AT device structure
+ * @param size the receive buffer size
+ *
+ * @return != RT_NULL: the receive buffer
+ *            RT_NULL: no memory
+ */
+void *at_device_recv_buf_alloc(struct at_device *device, rt_size_t size)
+{
+    void *buf = RT_NULL;
+
+    RT_ASSERT(device);
+
+#ifdef AT_DEVICE_USING_RECV_POOL
+    if (device->recv_pool.start && size <= device->recv_pool.block_size)
+    {
+        /* every pool buffer takes a whole block, so the pool never fragments */
+        buf = rt_memheap_alloc(&(device->recv_pool.heap), device->recv_pool.block_size);
+        if (buf)
+        {
+            rt_memset(buf, 0x00, size);
+            AT_DEVICE_STATS_INC(device, recv_pool_hits);
+            return buf;
+        }
+    }
+#endif /* AT_DEVICE_USING_RECV_POOL */
+
+    AT_DEVICE_STATS_INC(device, recv_pool_misses);
+    buf = rt_calloc(1, size);
+    if (buf == RT_NULL)
+    {
+        /* the receive data is read and dropped by the caller */
+        AT_DEVICE_STATS_INC(device, recv_alloc_fails);
+        AT_DEVICE_STATS_ADD(device, recv_dropped, size);
+    }
+
+    return buf;
+}
+
+/**
+ * This function will count the AT command executed by AT device socket operations.
+ *
+ * @param device the pointer of AT device structure
+ * @param result the AT command execute result
+ *
+ * @return the AT command execute result
+ */
+int at_device_stats_cmd(struct at_device *device, int result)
+{
+    AT_DEVICE_STATS_INC(device, cmds);
+    if (result == -RT_ETIMEOUT)
+    {
+        AT_DEVICE_STATS_INC(device, cmd_timeouts);
+    }
+
+    return result;
+}
+
+/**
+ * This function will count the data chunk sent by AT device socket.
+ *
+ * @param device the pointer of AT device structure
+ * @param device_socket the AT device socket number
+ * @param size the data chunk size
+ */
+void at_device_stats_send(struct at_device *device, int device_socket, size_t size)
+{
+    AT_DEVICE_STATS_INC(device, chunks_sent);
+    AT_DEVICE_STATS_ADD(device, bytes_sent, size);
+
+    if (device_socket >= 0 && device_socket < (int) device->class->socket_num)
+    {
+        device->socket_stats[device_socket].bytes_sent += size;
+    }
+}
+
+/**
+ * This function will count the data received by AT device socket URC.
+ *
+ * @param device the pointer of AT device structure
+ * @param socket the AT socket object of the AT device
+ * @param size the received data size
+ */
+void at_device_stats_recv(struct at_device *device, struct at_socket *socket, size_t size)
+{
+    int device_socket = (int) (socket - device->sockets);
+
+    AT_DEVICE_STATS_INC(device, urcs);
+    AT_DEVICE_STATS_ADD(device, bytes_recv, size);
+
+    if (device_socket >= 0 && device_socket < (int) device->class->socket_num)
+    {
+        device->socket_stats[device_socket].bytes_recv += size;
+    }
+}
+
+/**
+ * This function will get the statistics of AT device.
+ *
+ * @param device the pointer of AT device structure
+ * @param stats the statistics copied out
+ *
+ * @return  0: get success
+ */
+int at_device_stats_get(struct at_device *device, struct at_device_stats *stats)
+{
+    RT_ASSERT(device);
+    RT_ASSERT(stats);
+
+    rt_memcpy(stats, &(device->stats), sizeof(struct at_device_stats));
+
+    return RT_EOK;
+}
+
+/**
+ * This function will get the statistics of the specified AT device socket.
+ *
+ * @param device the pointer of AT device structure
+ * @param device_socket the AT device socket number
+ * @param stats the statistics copied out
+ *
+ * @return  0: get success
+ *        -10: the socket is invalid
+ */
+int at_device_socket_stats_get(struct at_device *device, int device_socket, struct at_device_socket_stats *stats)
+{
+    RT_ASSERT(device);
+    RT_ASSERT(stats);
+
+    if (device_socket < 0 || device_socket >= (int) device->class->socket_num)
+    {
+        return -RT_EINVAL;
+    }
+
+    rt_memcpy(stats, &(device->socket_stats[device_socket]), sizeof(struct at_device_socket_stats));
+
+    return RT_EOK;
+}
+
+/* The number of domain names kept in the DNS cache, 0 to disable the cache */
+#ifndef AT_DEVICE_DNS_CACHE_NUM
+#define AT_DEVICE_DNS_CACHE_NUM        8
+#endif
+
+/* The maximum length of a cached domain name, longer names are not cached */
+#ifndef AT_DEVICE_DNS_NAME_LEN
+#define AT_DEVICE_DNS_NAME_LEN         64
+#endif
+
+/* The cache time in seconds of resolved names when the module reports no TTL */
+#ifndef AT_DEVICE_DNS_CACHE_TTL
+#define AT_DEVICE_DNS_CACHE_TTL        300
+#endif
+
+/* The maximum cache time in seconds, the TTL reported by the module is clamped to it */
+#ifndef AT_DEVICE_DNS_CACHE_MAX_TTL
+#define AT_DEVICE_DNS_CACHE_MAX_TTL    (24 * 60 * 60)
+#endif
+
+/* The cache time in seconds of failed resolves, 0 to disable negative caching */
+#ifndef AT_DEVICE_DNS_CACHE_NEG_TTL
+#define AT_DEVICE_DNS_CACHE_NEG_TTL    5
+#endif
+
+/* The maximum number of outstanding asynchronous domain resolve requests */
+#ifndef AT_DEVICE_DNS_REQ_NUM
+#define AT_DEVICE_DNS_REQ_NUM          8
+#endif
+
+/* The number of asynchronous domain resolve threads, a thread waiting for the
+ * module doesn't hold the cached names back, and more threads keep more
+ * devices resolving at the same time when AT_DEVICE_DNS_SPREAD is enabled */
+#ifndef AT_DEVICE_DNS_THREAD_NUM
+#define AT_DEVICE_DNS_THREAD_NUM       2
+#endif
+
+/* The stack size and priority of the asynchronous domain resolve thread */
+#ifndef AT_DEVICE_DNS_THREAD_STACK_SIZE
+#define AT_DEVICE_DNS_THREAD_STACK_SIZE 2048
+#endif
+
+#ifndef AT_DEVICE_DNS_THREAD_PRIORITY
+#define AT_DEVICE_DNS_THREAD_PRIORITY  (RT_THREAD_PRIORITY_MAX / 2)
+#endif
+
+/* AT device asynchronous domain resolve request */
+struct at_device_dns_req
+{
+    int id;
+    char name[AT_DEVICE_DNS_NAME_LEN];
+    at_device_resolve_cb_t cb;
+    void *user_data;
+};
+
+static struct rt_mutex at_device_dns_lock;
+static rt_bool_t at_device_dns_lock_ready = RT_FALSE;
+static rt_mq_t at_device_dns_mq = RT_NULL;
+
+/**
+ * This function will initialize the DNS lock on first use, the domain resolve
+ * can be started before any AT device class is registered.
+ */
+static void at_device_dns_lock_init(void)
+{
+    if (at_device_dns_lock_ready)
+    {
+        return;
+    }
+
+    rt_enter_critical();
+    if (at_device_dns_lock_ready == RT_FALSE)
+    {
+        rt_mutex_init(&at_device_dns_lock, "at_dns", RT_IPC_FLAG_PRIO);
+        at_device_dns_lock_ready = RT_TRUE;
+    }
+    rt_exit_critical();
+}
+
+#if AT_DEVICE_DNS_CACHE_NUM > 0
+/* AT device DNS cache entry */
+struct at_device_dns_entry
+{
+    char name[AT_DEVICE_DNS_NAME_LEN];
+    char addrs[AT_DEVICE_DNS_ADDR_NUM][AT_DEVICE_DNS_ADDR_LEN];
+    int result;                                  /* > 0: address count, < 0: negative entry */
+    rt_tick_t expire;
+    rt_tick_t used;
+};
+
+static struct at_device_dns_entry at_device_dns_cache[AT_DEVICE_DNS_CACHE_NUM];
+
+/**
+ * This function will look up the domain name in the DNS cache.
+ *
+ * @param name domain name
+ * @param addrs the cached addresses
+ * @param addr_num the maximum number of addresses
+ * @param result the cached resolve result
+ *
+ * @return RT_TRUE: the name is cached and not expired
+ *        RT_FALSE: the name is not cached
+ */
+static rt_bool_t at_device_dns_cache_lookup(const char *name, char addrs[][AT_DEVICE_DNS_ADDR_LEN],
+        int addr_num, int *result)
+{
+    int i;
+    rt_bool_t found = RT_FALSE;
+    rt_tick_t now = rt_tick_get();
+
+    rt_mutex_take(&at_device_dns_lock, RT_WAITING_FOREVER);
+
+    for (i = 0; i < AT_DEVICE_DNS_CACHE_NUM; i++)
+    {
+        struct at_device_dns_entry *entry = &at_device_dns_cache[i];
+
+        if (entry->name[0] == '\0' || rt_strcmp(entry->name, name) != 0)
+        {
+            continue;
+        }
+
+        if ((rt_int32_t) (entry->expire - now) > 0)
+        {
+            *result = entry->result;
+            if (*result > addr_num)
+            {
+                *result = addr_num;
+            }
+            if (*result > 0)
+            {
+                rt_memcpy(addrs, entry->addrs, *result * AT_DEVICE_DNS_ADDR_LEN);
+            }
+            entry->used = now;
+            found = RT_TRUE;
+        }
+        else
+        {
+            /* expired, drop it */
+            entry->name[0] = '\0';
+        }
+        break;
+    }
+
+    rt_mutex_release(&at_device_dns_lock);
+
+    return found;
+}
+
+/**
+ * This function will add or refresh the domain name in the DNS cache, the
+ * least recently used entry is replaced when the cache is full.
+ *
+ * @param name domain name
+ * @param addrs the resolved addresses, RT_NULL for negative entry
+ * @param result the address count or the resolve failed result
+ * @param ttl the cache time in seconds, clamped to AT_DEVICE_DNS_CACHE_MAX_TTL
+ */
+static void at_device_dns_cache_update(const char *name, char addrs[][AT_DEVICE_DNS_ADDR_LEN],
+        int result, rt_uint32_t ttl)
+{
+    int i;
+    rt_tick_t now = rt_tick_get();
+    struct at_device_dns_entry *entry = RT_NULL;
+
+    if (ttl == 0 || rt_strlen(name) >= AT_DEVICE_DNS_NAME_LEN)
+    {
+        return;
+    }
+
+    /* the tick conversion overflows with large TTL */
+    if (ttl > AT_DEVICE_DNS_CACHE_MAX_TTL)
+    {
+        ttl = AT_DEVICE_DNS_CACHE_MAX_TTL;
+    }
+
+    rt_mutex_take(&at_device_dns_lock, RT_WAITING_FOREVER);
+
+    for (i = 0; i < AT_DEVICE_DNS_CACHE_NUM; i++)
+    {
+        struct at_device_dns_entry *cur = &at_device_dns_cache[i];
+
+        if (cur->name[0] != '\0' && rt_strcmp(cur->name, name) == 0)
+        {
+            entry = cur;
+            break;
+        }
+
+        if (entry == RT_NULL || cur->name[0] == '\0' ||
+                (entry->name[0] != '\0' && (rt_int32_t) (cur->used - entry->used) < 0))
+        {
+            entry = cur;
+        }
+    }
+
+    rt_strncpy(entry->name, name, AT_DEVICE_DNS_NAME_LEN - 1);
+    rt_memset(entry->addrs, 0x00, sizeof(entry->addrs));
+    if (addrs && result > 0)
+    {
+        rt_memcpy(entry->addrs, addrs, result * AT_DEVICE_DNS_ADDR_LEN);
+    }
+    entry->result = result;
+    entry->expire = now + (rt_tick_t) ttl * RT_TICK_PER_SECOND;
+    entry->used = now;
+
+    rt_mutex_release(&at_device_dns_lock);
+}
+
+/**
+ * This function will move the address behind the other addresses of all
+ * cached domain names, so the next resolve answers with another address
+ * after connect to this one failed.
+ *
+ * @param ip the failed address
+ */
+static void at_device_dns_cache_demote(const char *ip)
+{
+    int i, j;
+    char addr[AT_DEVICE_DNS_ADDR_LEN];
+
+    rt_mutex_take(&at_device_dns_lock, RT_WAITING_FOREVER);
+
+    for (i = 0; i < AT_DEVICE_DNS_CACHE_NUM; i++)
+    {
+        struct at_device_dns_entry *entry = &at_device_dns_cache[i];
+
+        if (entry->name[0] == '\0' || entry->result <= 1)
+        {
+            continue;
+        }
+
+        for (j = 0; j < entry->result - 1; j++)
+        {
+            if (rt_strcmp(entry->addrs[j], ip) == 0)
+            {
+                rt_memcpy(addr, entry->addrs[j], sizeof(addr));
+                rt_memmove(entry->addrs[j], entry->addrs[j + 1], (entry->result - j - 1) * sizeof(addr));
+                rt_memcpy(entry->addrs[entry->result - 1], addr, sizeof(addr));
+                break;
+            }
+        }
+    }
+
+    rt_mutex_release(&at_device_dns_lock);
+}
+
+#endif /* AT_DEVICE_DNS_CACHE_NUM > 0 */
+
+/**
+ * The socket connect operation installed on all AT device classes, it keeps
+ * the average connect time of AT device and demotes the address in DNS cache
+ * when connect to it failed.
+ */
+static int at_device_socket_connect(struct at_socket *socket, char *ip, int32_t port,
+        enum at_socket_type type, rt_bool_t is_client)
+{
+    int result = 0;
+    rt_tick_t start = rt_tick_get();
+    rt_uint32_t connect_time = 0;
+    struct at_device *device = (struct at_device *) socket->device;
+
+#ifdef AT_DEVICE_USING_PASSTHROUGH
+    if (device->passthrough)
+    {
+        /* the connect commands are taken as the socket data in passthrough */
+        LOG_E("%s device socket is in passthrough.", device->name);
+        return -RT_EBUSY;
+    }
+#endif
+
+    at_device_wake_get(device);
+    result = device->class->connect(socket, ip, port, type, is_client);
+    at_device_wake_put(device);
+    if (result == RT_EOK)
+    {
+        at_device_send_window_reset(device, (int) socket->user_data);
+
+#ifdef AT_DEVICE_USING_FAILOVER
+        if (is_client && ip)
+        {
+            at_device_failover_connected(device, socket, ip, port, type);
+        }
+#endif
+
+        connect_time = (rt_tick_get() - start) * 1000 / RT_TICK_PER_SECOND;
+        /* moving average of the last several connects */
+        if (device->connect_time == 0)
+        {
+            device->connect_time = connect_time;
+        }
+        else
+        {
+            device->connect_time = (device->connect_time * 3 + connect_time) / 4;
+        }
+    }
+#if AT_DEVICE_DNS_CACHE_NUM > 0
+    else if (is_client && ip)
+    {
+        at_device_dns_cache_demote(ip);
+    }
+#endif
+
+    return result;
+}
+
+#if defined(AT_DEVICE_USING_UPLINK) || defined(AT_DEVICE_USING_AUTO_SLEEP) || defined(AT_DEVICE_USING_FAILOVER) || \
+        defined(AT_DEVICE_USING_SINGLE_CLASS)
+/**
+ * The socket send operation installed on all AT device classes, the UDP
+ * datagrams of the device with uplink scheduler wait for the active window,
+ * and the module is kept awake during the send.
+ */
+static int at_device_socket_send(struct at_socket *socket, const char *buff, size_t bfsz,
+        enum at_socket_type type)
+{
+    int result = 0;
+    struct at_device *device = (struct at_device *) socket->device;
+
+#ifdef AT_DEVICE_USING_UPLINK
+    if (device->uplink && type == AT_SOCKET_UDP)
+    {
+        return at_device_uplink_send(device, socket, buff, bfsz);
+    }
+#endif
+
+    at_device_wake_get(device);
+    result = device->class->send(socket, buff, bfsz, type);
+    at_device_wake_put(device);
+
+    return result;
+}
+
+/**
+ * The socket close operation installed on all AT device classes, the queued
+ * datagrams are sent before the socket is closed, and the socket is no more
+ * followed by failover.
+ */
+static int at_device_socket_close(struct at_socket *socket)
+{
+    int result = 0;
+    struct at_device *device = (struct at_device *) socket->device;
+
+#ifdef AT_DEVICE_USING_FAILOVER
+    at_device_failover_closed(device, socket);
+#endif
+    at_device_wake_get(device);
+#ifdef AT_DEVICE_USING_UPLINK
+    at_device_uplink_flush(device);
+#endif
+    result = device->class->close(socket);
+    at_device_wake_put(device);
+
+    return result;
+}
+#endif /* AT_DEVICE_USING_UPLINK || AT_DEVICE_USING_AUTO_SLEEP || AT_DEVICE_USING_FAILOVER || AT_DEVICE_USING_SINGLE_CLASS */
+
+/**
+ * This function will add an address reported by the AT device for the domain
+ * name being resolved, it's called by the domain resolve URC of device class.
+ * The address is written to the buffer of the resolve caller, the addresses
+ * more than the buffer are only counted.
+ *
+ * @param device AT device object
+ * @param ip the reported IPv4 or IPv6 address
+ *
+ * @return the number of addresses reported for this domain name
+ */
+int at_device_dns_addr_add(struct at_device *device, const char *ip)
+{
+    rt_base_t level;
+
+    RT_ASSERT(device);
+    RT_ASSERT(ip);
+
+    /* the caller buffer is dropped when the resolve times out */
+    level = rt_hw_interrupt_disable();
+    if (device->dns_addrs && device->dns_addr_num < device->dns_addr_max)
+    {
+        rt_memset(device->dns_addrs[device->dns_addr_num], 0x00, AT_DEVICE_DNS_ADDR_LEN);
+        rt_strncpy(device->dns_addrs[device->dns_addr_num], ip, AT_DEVICE_DNS_ADDR_LEN - 1);
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (device->dns_addr_num < 0xFF)
+    {
+        device->dns_addr_num++;
+    }
+
+    return device->dns_addr_num;
+}
+
+/**
+ * This function will check whether the AT device is ready for domain resolve.
+ *
+ * @param device AT device object
+ *
+ * @return RT_TRUE: the device is ready
+ *        RT_FALSE: the device is not ready
+ */
+static rt_bool_t at_device_dns_ready(struct at_device *device)
+{
+    if (device->is_init == RT_FALSE || device->class->domain_resolve == RT_NULL)
+    {
+        return RT_FALSE;
+    }
+
+    if (device->netdev && netdev_is_link_up(device->netdev) == 0)
+    {
+        return RT_FALSE;
+    }
+
+    return RT_TRUE;
+}
+
+/**
+ * This function will select the AT device for domain resolve. The device
+ * owning the default network interface is selected by default, and the ready
+ * device with the fewest outstanding resolves is selected when
+ * AT_DEVICE_DNS_SPREAD is enabled. The outstanding resolve count of the
+ * selected device is increased.
+ *
+ * @return != RT_NULL: the selected AT device
+ *          = RT_NULL: no AT device is ready
+ */
+static struct at_device *at_device_dns_select(void)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device *device = RT_NULL;
+    struct at_device *select = RT_NULL;
+
+    rt_mutex_take(&at_device_dns_lock, RT_WAITING_FOREVER);
+
+#ifdef AT_DEVICE_DNS_SPREAD
+    rt_slist_for_each(node, &at_device_list)
+    {
+        device = rt_slist_entry(node, struct at_device, list);
+        if (at_device_dns_ready(device) &&
+                (select == RT_NULL || device->dns_busy < select->dns_busy))
+        {
+            select = device;
+        }
+    }
+#else
+    if (netdev_default)
+    {
+        device = at_device_get_by_name(AT_DEVICE_NAMETYPE_NETDEV, netdev_default->name);
+        if (device && at_device_dns_ready(device))
+        {
+            select = device;
+        }
+    }
+
+    if (select == RT_NULL)
+    {
+        rt_slist_for_each(node, &at_device_list)
+        {
+            device = rt_slist_entry(node, struct at_device, list);
+            if (at_device_dns_ready(device))
+            {
+                select = device;
+                break;
+            }
+        }
+    }
+#endif /* AT_DEVICE_DNS_SPREAD */
+
+    if (select)
+    {
+        select->dns_busy++;
+    }
+
+    rt_mutex_release(&at_device_dns_lock);
+
+    return select;
+}
+
+/**
+ * This function will resolve the domain name and get all addresses reported
+ * by the AT device. The addresses are answered from the DNS cache when the
+ * name is cached, and the address failed to connect is answered last. The
+ * addresses are reported into the buffer of the caller, no more than
+ * AT_DEVICE_DNS_ADDR_NUM are kept, and the DNS cache keeps the same.
+ *
+ * @param name domain name
+ * @param addrs the resolved IPv4 or IPv6 addresses
+ * @param addr_num the maximum number of addresses
+ *
+ * @return > 0: the number of resolved addresses
+ *         < 0: domain resolve failed
+ */
+int at_device_domain_resolve_all(const char *name, char addrs[][AT_DEVICE_DNS_ADDR_LEN], int addr_num)
+{
+    rt_base_t level;
+    int result = 0;
+    char ip[16] = {0};
+    struct at_device *device = RT_NULL;
+
+    RT_ASSERT(name);
+    RT_ASSERT(addrs);
+    RT_ASSERT(addr_num > 0);
+
+    at_device_dns_lock_init();
+
+#if AT_DEVICE_DNS_CACHE_NUM > 0
+    if (at_device_dns_cache_lookup(name, addrs, addr_num, &result))
+    {
+        return result;
+    }
+#endif
+
+    device = at_device_dns_select();
+    if (device == RT_NULL)
+    {
+        LOG_E("get domain resolve device failed.");
+        return -RT_ERROR;
+    }
+
+#ifdef AT_DEVICE_USING_PASSTHROUGH
+    if (device->passthrough)
+    {
+        /* the resolve commands are taken as the socket data in passthrough */
+        LOG_E("%s device socket is in passthrough.", device->name);
+        rt_mutex_take(&at_device_dns_lock, RT_WAITING_FOREVER);
+        device->dns_busy--;
+        rt_mutex_release(&at_device_dns_lock);
+        return -RT_EBUSY;
+    }
+#endif
+
+    /* the device addresses are shared by all resolves on this device */
+    rt_mutex_take(&(device->dns_lock), RT_WAITING_FOREVER);
+
+#if AT_DEVICE_DNS_CACHE_NUM > 0
+    /* the same name resolved by the resolve this one waited for */
+    if (at_device_dns_cache_lookup(name, addrs, addr_num, &result))
+    {
+        goto __exit;
+    }
+#endif
+
+    /* the reported addresses are written to the caller buffer directly */
+    device->dns_ttl = 0;
+    device->dns_addr_expect = 0;
+    device->dns_addr_num = 0;
+    device->dns_addr_max = addr_num < AT_DEVICE_DNS_ADDR_NUM ? (rt_uint8_t) addr_num : AT_DEVICE_DNS_ADDR_NUM;
+    device->dns_addrs = addrs;
+    result = device->class->domain_resolve(device, name, ip);
+    if (device->dns_addr_num == 0 && result == RT_EOK)
+    {
+        /* the device class reports the resolved address only */
+        at_device_dns_addr_add(device, ip);
+    }
+
+    level = rt_hw_interrupt_disable();
+    device->dns_addrs = RT_NULL;
+    rt_hw_interrupt_enable(level);
+
+    if (device->dns_addr_num > 0)
+    {
+        result = device->dns_addr_num < device->dns_addr_max ? device->dns_addr_num : device->dns_addr_max;
+    }
+    else if (result >= 0)
+    {
+        result = -RT_ERROR;
+    }
+
+#if AT_DEVICE_DNS_CACHE_NUM > 0
+    if (result > 0)
+    {
+        at_device_dns_cache_update(name, addrs, result,
+                device->dns_ttl ? device->dns_ttl : AT_DEVICE_DNS_CACHE_TTL);
+    }
+    else
+    {
+        at_device_dns_cache_update(name, RT_NULL, result, AT_DEVICE_DNS_CACHE_NEG_TTL);
+    }
+
+__exit:
+#endif
+    rt_mutex_release(&(device->dns_lock));
+
+    rt_mutex_take(&at_device_dns_lock, RT_WAITING_FOREVER);
+    device->dns_busy--;
+    rt_mutex_release(&at_device_dns_lock);
+
+    return result;
+}
+
+/**
+ * This function will pick the first IPv4 address of the resolved addresses.
+ *
+ * @param addrs the resolved addresses
+ * @param result the number of resolved addresses or the resolve failed result
+ * @param ip the picked IP address, it's length must be 16
+ *
+ * @return  0: pick success
+ *         < 0: no IPv4 address resolved
+ */
+static int at_device_dns_addr_pick(char addrs[][AT_DEVICE_DNS_ADDR_LEN], int result, char ip[16])
+{
+    int i;
+
+    for (i = 0; i < result; i++)
+    {
+        if (rt_strlen(addrs[i]) < 16 && strchr(addrs[i], ':') == RT_NULL)
+        {
+            rt_memcpy(ip, addrs[i], 16);
+            ip[15] = '\0';
+            return RT_EOK;
+        }
+    }
+
+    return result < 0 ? result : -RT_ERROR;
+}
+
+/**
+ * The domain resolve operation installed on all AT device classes, it answers
+ * with the first IPv4 address of all resolved addresses.
+ *
+ * @param name domain name
+ * @param ip parsed IP address, it's length must be 16
+ *
+ * @return  0: domain resolve success
+ *         < 0: domain resolve failed
+ */
+static int at_device_domain_resolve(const char *name, char ip[16])
+{
+    int result = 0;
+    char addrs[AT_DEVICE_DNS_ADDR_NUM][AT_DEVICE_DNS_ADDR_LEN];
+
+    RT_ASSERT(name);
+    RT_ASSERT(ip);
+
+    result = at_device_domain_resolve_all(name, addrs, AT_DEVICE_DNS_ADDR_NUM);
+
+    return at_device_dns_addr_pick(addrs, result, ip);
+}
+
+static void at_device_dns_thread_entry(void *parameter)
+{
+    int result = 0;
+    char ip[16] = {0};
+    struct at_device_dns_req req;
+
+    while (1)
+    {
+        if (rt_mq_recv(at_device_dns_mq, &req, sizeof(req), RT_WAITING_FOREVER) < 0)
+        {
+            continue;
+        }
+
+        rt_memset(ip, 0x00, sizeof(ip));
+        result = at_device_domain_resolve(req.name, ip);
+
+        req.cb(req.id, req.name, result, result == RT_EOK ? ip : RT_NULL, req.user_data);
+    }
+}
+
+/**
+ * This function will start an asynchronous domain resolve. The request is
+ * queued to the domain resolve threads and the callback is always invoked
+ * there, a name in DNS cache included, so the callback never runs in the
+ * caller context. The resolves of different names overlap on the threads,
+ * and the resolves of the same name share one module resolve.
+ *
+ * @param name domain name
+ * @param cb the completion callback
+ * @param user_data the user data passed to the callback
+ *
+ * @return > 0: the request id
+ *          -1: create the domain resolve thread failed
+ *          -3: too many outstanding requests
+ *          -5: no memory
+ *         -10: invalid domain name
+ */
+int at_device_domain_resolve_async(const char *name, at_device_resolve_cb_t cb, void *user_data)
+{
+    static int request_id = 0;
+    int i;
+    rt_base_t level;
+    struct at_device_dns_req req;
+    rt_thread_t tid = RT_NULL;
+
+    RT_ASSERT(name);
+    RT_ASSERT(cb);
+
+    if (rt_strlen(name) == 0 || rt_strlen(name) >= AT_DEVICE_DNS_NAME_LEN)
+    {
+        return -RT_EINVAL;
+    }
+
+    at_device_dns_lock_init();
+
+    level = rt_hw_interrupt_disable();
+    if (++request_id <= 0)
+    {
+        request_id = 1;
+    }
+    req.id = request_id;
+    rt_hw_interrupt_enable(level);
+
+    /* create the domain resolve thread on first use */
+    rt_mutex_take(&at_device_dns_lock, RT_WAITING_FOREVER);
+    if (at_device_dns_mq == RT_NULL)
+    {
+        at_device_dns_mq = rt_mq_create("at_dns", sizeof(struct at_device_dns_req),
+                                        AT_DEVICE_DNS_REQ_NUM, RT_IPC_FLAG_FIFO);
+        if (at_device_dns_mq == RT_NULL)
+        {
+            rt_mutex_release(&at_device_dns_lock);
+            LOG_E("no memory for AT device domain resolve queue create.");
+            return -RT_ENOMEM;
+        }
+
+        for (i = 0; i < AT_DEVICE_DNS_THREAD_NUM; i++)
+        {
+            tid = rt_thread_create("at_dns", at_device_dns_thread_entry, RT_NULL,
+                    AT_DEVICE_DNS_THREAD_STACK_SIZE, AT_DEVICE_DNS_THREAD_PRIORITY, 20);
+            if (tid == RT_NULL)
+            {
+                break;
+            }
+            rt_thread_startup(tid);
+        }
+
+        if (i == 0)
+        {
+            rt_mq_delete(at_device_dns_mq);
+            at_device_dns_mq = RT_NULL;
+            rt_mutex_release(&at_device_dns_lock);
+            LOG_E("create AT device domain resolve thread failed.");
+            return -RT_ERROR;
+        }
+    }
+    rt_mutex_release(&at_device_dns_lock);
+
+    rt_memset(req.name, 0x00, sizeof(req.name));
+    rt_strncpy(req.name, name, sizeof(req.name) - 1);
+    req.cb = cb;
+    req.user_data = user_data;
+
+    if (rt_mq_send(at_device_dns_mq, &req, sizeof(req)) != RT_EOK)
+    {
+        LOG_W("too many outstanding domain resolve requests.");
+        return -RT_EFULL;
+    }
+
+    return req.id;
+}
+
+/* The socket event callbacks of AT socket, they are the same for all AT device classes */
+static at_evt_cb_t at_device_evt_cb_set[] = {
+        [AT_SOCKET_EVT_RECV] = NULL,
+        [AT_SOCKET_EVT_CLOSED] = NULL,
+};
+
+#ifdef AT_DEVICE_USING_UPLINK
+/**
+ * The socket closed event callback passed to all AT device classes, the
+ * uplink datagrams queued for the socket are dropped before AT socket takes
+ * the event, the socket may be reused by a new connection.
+ */
+static void at_device_socket_closed_cb(struct at_socket *socket, at_socket_evt_t event, const char *buff, size_t bfsz)
 {
-#if defined(RT_VERSION_CHECK) && (RTTHREAD_VERSION > RT_VERSION_CHECK(5, 2, 1))
-    return &(device->client->lock);
-#else
-    return device->client->lock;
-#endif
+    struct at_device *device = (struct at_device *) socket->device;
+
+    if (device && device->uplink)
+    {
+        at_device_uplink_closed(device, (int) socket->user_data);
+    }
+
+    if (at_device_evt_cb_set[AT_SOCKET_EVT_CLOSED])
+    {
+        at_device_evt_cb_set[AT_SOCKET_EVT_CLOSED](socket, event, buff, bfsz);
+    }
 }
+#endif /* AT_DEVICE_USING_UPLINK */
 
 /**
- * This function will get the first initialized AT device.
- *
- * @return the AT device structure pointer
+ * The socket event callback set operation installed on all AT device classes,
+ * it keeps the callbacks for the core and passes them to all device classes.
  */
-struct at_device *at_device_get_first_initialized(void)
+static void at_device_socket_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
 {
-    rt_base_t level;
+#ifndef AT_DEVICE_USING_SINGLE_CLASS
     rt_slist_t *node = RT_NULL;
-    struct at_device *device = RT_NULL;
+#endif
+    struct at_device_class *class = RT_NULL;
 
-    level = rt_hw_interrupt_disable();
+    if (event < sizeof(at_device_evt_cb_set) / sizeof(at_device_evt_cb_set[0]))
+    {
+        at_device_evt_cb_set[event] = cb;
+    }
 
-    rt_slist_for_each(node, &at_device_list)
+#ifdef AT_DEVICE_USING_UPLINK
+    if (event == AT_SOCKET_EVT_CLOSED && cb)
     {
-        device = rt_slist_entry(node, struct at_device, list);
-        if (device && device->is_init == RT_TRUE)
+        cb = at_device_socket_closed_cb;
+    }
+#endif
+
+#ifdef AT_DEVICE_USING_SINGLE_CLASS
+    class = at_device_single_class;
+    if (class && class->set_event_cb)
+    {
+        class->set_event_cb(event, cb);
+    }
+#else
+    rt_slist_for_each(node, &at_device_class_list)
+    {
+        class = rt_slist_entry(node, struct at_device_class, list);
+        if (class->set_event_cb)
         {
-           rt_hw_interrupt_enable(level);
-           return device;
+            class->set_event_cb(event, cb);
         }
     }
+#endif /* AT_DEVICE_USING_SINGLE_CLASS */
+}
 
-    rt_hw_interrupt_enable(level);
+/**
+ * This function will notice AT socket that the socket is closed, it's used
+ * when the link of AT device is lost and the device will not report it.
+ *
+ * @param socket AT socket object
+ */
+void at_device_socket_closed_notice(struct at_socket *socket)
+{
+    RT_ASSERT(socket);
 
-    return RT_NULL;
+#ifdef AT_DEVICE_USING_UPLINK
+    at_device_socket_closed_cb(socket, AT_SOCKET_EVT_CLOSED, RT_NULL, 0);
+#else
+    if (at_device_evt_cb_set[AT_SOCKET_EVT_CLOSED])
+    {
+        at_device_evt_cb_set[AT_SOCKET_EVT_CLOSED](socket, AT_SOCKET_EVT_CLOSED, RT_NULL, 0);
+    }
+#endif
 }
 
 /**
- * This function will get AT device by device name.
+ * This function will notice AT socket the data received by AT device, it's
+ * used when the data is not received in the class URC.
  *
- * @param type the name type
- * @param name the device name or the client name
- *
- * @return the AT device structure pointer
+ * @param device AT device object
+ * @param socket AT socket object
+ * @param buf the receive buffer, it's taken over by AT socket or released
+ * @param len the received data size
  */
-struct at_device *at_device_get_by_name(int type, const char *name)
+void at_device_socket_recv_notice(struct at_device *device, struct at_socket *socket, char *buf, rt_size_t len)
+{
+    RT_ASSERT(device);
+    RT_ASSERT(socket);
+
+    /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, len);
+
+    if (at_device_evt_cb_set[AT_SOCKET_EVT_RECV])
+    {
+        at_device_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, buf, len);
+    }
+    else
+    {
+        rt_free(buf);
+    }
+}
+
+#if defined(AT_DEVICE_USING_AGGR) || defined(AT_DEVICE_USING_FAILOVER)
+static void at_device_netdev_status_cb(struct netdev *netdev, enum netdev_cb_type type)
 {
-    rt_base_t level;
-    rt_slist_t *node = RT_NULL;
     struct at_device *device = RT_NULL;
 
-    RT_ASSERT(name);
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_NETDEV, netdev->name);
+    if (device == RT_NULL)
+    {
+        return;
+    }
 
-    level = rt_hw_interrupt_disable();
+    if (device->netdev_status_cb)
+    {
+        device->netdev_status_cb(netdev, type);
+    }
 
-    rt_slist_for_each(node, &at_device_list)
+#ifdef AT_DEVICE_USING_AGGR
+    at_device_aggr_update();
+#endif
+#ifdef AT_DEVICE_USING_FAILOVER
+    at_device_failover_update(device);
+#endif
+}
+
+/**
+ * This function will follow the status of AT device network interface for
+ * link aggregation and failover. The network interface has only one status
+ * callback, so the callback set before is kept and called first, and a
+ * callback set after this function replaces both of them.
+ *
+ * @param device AT device object
+ */
+void at_device_netdev_watch(struct at_device *device)
+{
+    RT_ASSERT(device);
+
+    if (device->netdev && device->netdev->status_callback != at_device_netdev_status_cb)
     {
-        device = rt_slist_entry(node, struct at_device, list);
-        if (device)
-        {
-            if (((type == AT_DEVICE_NAMETYPE_DEVICE) || (type == AT_DEVICE_NAMETYPE_NETDEV)) &&
-                (rt_strncmp(device->name, name, rt_strlen(name)) == 0))
-            {
-                rt_hw_interrupt_enable(level);
-                return device;
-            }
-            else if ((type == AT_DEVICE_NAMETYPE_CLIENT) &&
-                (rt_strncmp(device->client->device->parent.name, name, rt_strlen(name)) == 0))
-            {
-                rt_hw_interrupt_enable(level);
-                return device;
-            }
-        }
+        device->netdev_status_cb = device->netdev->status_callback;
+        netdev_set_status_callback(device->netdev, at_device_netdev_status_cb);
     }
+}
+#endif /* AT_DEVICE_USING_AGGR || AT_DEVICE_USING_FAILOVER */
 
-    rt_hw_interrupt_enable(level);
+#ifdef AT_DEVICE_USING_SINGLE_CLASS
+#ifdef AT_USING_SOCKET_SERVER
+static int at_device_socket_listen(struct at_socket *socket, int backlog)
+{
+    struct at_device *device = (struct at_device *) socket->device;
 
-    return RT_NULL;
+    return device->class->listen ? device->class->listen(socket, backlog) : -RT_ENOSYS;
 }
+#endif /* AT_USING_SOCKET_SERVER */
+
+/* The socket operations of the only AT device class, kept in flash instead of a copy in the class */
+static const struct at_socket_ops at_device_dns_socket_ops =
+{
+    at_device_socket_connect,
+    at_device_socket_close,
+    at_device_socket_send,
+    at_device_domain_resolve,
+    at_device_socket_set_event_cb,
+#if defined(AT_SW_VERSION_NUM) && AT_SW_VERSION_NUM > 0x10300
+    RT_NULL,                                     /* no AT device class has the socket create */
+#ifdef AT_USING_SOCKET_SERVER
+    at_device_socket_listen,
+#endif
+#endif
+};
+#endif /* AT_DEVICE_USING_SINGLE_CLASS */
 
-#ifdef AT_USING_SOCKET
 /**
- * This function will get AT device by ip address.
+ * This function will install the DNS cache on the socket operations of AT device class.
  *
- * @param ip_addr input ip address
- * network
- * @return != NULL: network interface device object
- *            NULL: get failed
+ * @param class AT device class object
  */
-struct at_device *at_device_get_by_ipaddr(ip_addr_t *ip_addr)
+static void at_device_dns_install(struct at_device_class *class)
 {
-    rt_base_t level;
-    rt_slist_t *node = RT_NULL;
-    struct at_device *device = RT_NULL;
+    at_device_dns_lock_init();
 
-    level = rt_hw_interrupt_disable();
+    if (class->socket_ops == RT_NULL || class->domain_resolve == RT_NULL)
+    {
+        return;
+    }
 
-    rt_slist_for_each(node, &at_device_list)
+#ifdef AT_DEVICE_USING_SINGLE_CLASS
+    class->connect = class->socket_ops->at_connect;
+    class->set_event_cb = class->socket_ops->at_set_event_cb;
+    class->send = class->socket_ops->at_send;
+    class->close = class->socket_ops->at_closesocket;
+#ifdef AT_USING_SOCKET_SERVER
+    class->listen = class->socket_ops->at_listen;
+#endif
+    class->socket_ops = &at_device_dns_socket_ops;
+#else
+    rt_memcpy(&(class->dns_socket_ops), class->socket_ops, sizeof(struct at_socket_ops));
+    class->dns_socket_ops.at_domain_resolve = at_device_domain_resolve;
+    if (class->socket_ops->at_connect)
     {
-        device = rt_slist_entry(node, struct at_device, list);
-        if (device && ip_addr_cmp(ip_addr, &(device->netdev->ip_addr)))
-        {
-           rt_hw_interrupt_enable(level);
-           return device;
-        }
+        class->connect = class->socket_ops->at_connect;
+        class->dns_socket_ops.at_connect = at_device_socket_connect;
+    }
+    if (class->socket_ops->at_set_event_cb)
+    {
+        class->set_event_cb = class->socket_ops->at_set_event_cb;
+        class->dns_socket_ops.at_set_event_cb = at_device_socket_set_event_cb;
+    }
+#if defined(AT_DEVICE_USING_UPLINK) || defined(AT_DEVICE_USING_AUTO_SLEEP) || defined(AT_DEVICE_USING_FAILOVER)
+    if (class->socket_ops->at_send && class->socket_ops->at_closesocket)
+    {
+        class->send = class->socket_ops->at_send;
+        class->close = class->socket_ops->at_closesocket;
+        class->dns_socket_ops.at_send = at_device_socket_send;
+        class->dns_socket_ops.at_closesocket = at_device_socket_close;
     }
+#endif
+    class->socket_ops = &(class->dns_socket_ops);
+#endif /* AT_DEVICE_USING_SINGLE_CLASS */
+}
 
-    rt_hw_interrupt_enable(level);
+#ifdef AT_DEVICE_USING_RECV_POOL
+/**
+ * This function will create the socket receive pool of AT device, the pool
+ * holds AT_DEVICE_RECV_POOL_NUM buffers of the device class MTU, and every
+ * buffer allocated from it takes a whole MTU block. The pool is not found by
+ * the system heap allocations.
+ *
+ * @param device the pointer of AT device structure
+ * @param name the pool name
+ * @param mtu the device class MTU, 0 for default
+ *
+ * @return  0: create success
+ *         -1: pool initialize failed
+ *         -5: no memory
+ */
+static int at_device_recv_pool_create(struct at_device *device, const char *name, rt_size_t mtu)
+{
+    rt_size_t block_size = 0, pool_size = 0;
 
-    return RT_NULL;
+    if (mtu == 0)
+    {
+        mtu = AT_DEVICE_RECV_POOL_MTU;
+    }
+
+    device->recv_pool.block_size = RT_ALIGN(mtu, RT_ALIGN_SIZE);
+    block_size = device->recv_pool.block_size + sizeof(struct rt_memheap_item);
+    /* the memheap keeps a header and a tail item besides the buffers */
+    pool_size = (AT_DEVICE_RECV_POOL_NUM + 2) * block_size;
+
+    device->recv_pool.start = rt_malloc(pool_size);
+    if (device->recv_pool.start == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
 
+    if (rt_memheap_init(&(device->recv_pool.heap), name, device->recv_pool.start, pool_size) != RT_EOK)
+    {
+        rt_free(device->recv_pool.start);
+        device->recv_pool.start = RT_NULL;
+        return -RT_ERROR;
+    }
+
+    /* rt_malloc() falls back to all memheaps in the object container when the
+     * system heap is exhausted, the pool is taken out of the container so that
+     * only the receive buffers are allocated from it. rt_memheap_free() checks
+     * the object type of the pool, it's kept after the detach. */
+    rt_object_detach(&(device->recv_pool.heap.parent));
+    device->recv_pool.heap.parent.type = RT_Object_Class_MemHeap | RT_Object_Class_Static;
+
+    return RT_EOK;
 }
+#endif /* AT_DEVICE_USING_RECV_POOL */
 #endif /* AT_USING_SOCKET */
 
 
 /**
  * This function will perform a variety of control functions on AT devices.
+ * With auto sleep the sleep state is kept by the core for the sleep and
+ * wakeup commands, no matter they are sent by auto sleep or by the user.
  *
  * @param device the pointer of AT device structure
  * @param cmd the command sent to AT device
@@ -156,15 +1838,38 @@ struct at_device *at_device_get_by_ipaddr(ip_addr_t *ip_addr)
  */
 int at_device_control(struct at_device *device, int cmd, void *arg)
 {
-    if (device->class->device_ops->control)
-    {
-        return device->class->device_ops->control(device, cmd, arg);
-    }
-    else
+    int result = RT_EOK;
+#if defined(AT_USING_SOCKET) && defined(AT_DEVICE_USING_AUTO_SLEEP)
+    rt_mutex_t lock = RT_NULL;
+#endif
+
+    if (device->class->device_ops->control == RT_NULL)
     {
         LOG_W("AT device(%s) not support control operations.", device->name);
         return RT_EOK;
     }
+
+#if defined(AT_USING_SOCKET) && defined(AT_DEVICE_USING_AUTO_SLEEP)
+    if (cmd == AT_DEVICE_CTRL_SLEEP || cmd == AT_DEVICE_CTRL_WAKEUP)
+    {
+        /* no command is sent while the sleep state changes */
+        lock = at_device_get_client_lock(device);
+        rt_mutex_take(lock, RT_WAITING_FOREVER);
+
+        result = device->class->device_ops->control(device, cmd, arg);
+        if (result == RT_EOK)
+        {
+            device->sleeping = (cmd == AT_DEVICE_CTRL_SLEEP) ? RT_TRUE : RT_FALSE;
+        }
+
+        rt_mutex_release(lock);
+        return result;
+    }
+#endif
+
+    result = device->class->device_ops->control(device, cmd, arg);
+
+    return result;
 }
 
 /**
@@ -173,26 +1878,49 @@ int at_device_control(struct at_device *device, int cmd, void *arg)
  * @param class the pointer of AT device class structure
  * @param class_id AT device class ID
  *
- * @return 0: register successfully
+ * @return  0: register successfully
+ *         -1: another class is registered in the single class build
  */
 int at_device_class_register(struct at_device_class *class, uint16_t class_id)
 {
+#ifndef AT_DEVICE_USING_SINGLE_CLASS
     rt_base_t level;
+#endif
 
     RT_ASSERT(class);
 
+#ifdef AT_DEVICE_USING_SINGLE_CLASS
+    if (at_device_single_class && at_device_single_class != class)
+    {
+        LOG_E("AT device class(%d) is registered in single class build.", at_device_single_class->class_id);
+        return -RT_ERROR;
+    }
+#endif
+
     /* Fill AT device class */
     class->class_id = class_id;
 
+#ifdef AT_USING_SOCKET
+    /* Answer the domain resolves of AT device class from DNS cache */
+    at_device_dns_install(class);
+#endif
+
+#ifdef AT_DEVICE_USING_SINGLE_CLASS
+    /* publish the class after its fields are visible */
+    AT_DEVICE_LIST_BARRIER();
+    at_device_single_class = class;
+#else
     /* Initialize current AT device class single list */
     rt_slist_init(&(class->list));
 
-    level = rt_hw_interrupt_disable();
+    level = AT_DEVICE_LIST_LOCK();
 
-    /* Add current AT device class to list */
+    /* Add current AT device class to list after its fields are visible */
+    AT_DEVICE_LIST_BARRIER();
     rt_slist_append(&at_device_class_list, &(class->list));
 
-    rt_hw_interrupt_enable(level);
+    AT_DEVICE_LIST_UNLOCK(level);
+#endif /* AT_DEVICE_USING_SINGLE_CLASS */
 
     return RT_EOK;
 }
@@ -200,26 +1928,26 @@ int at_device_class_register(struct at_device_class *class, uint16_t class_id)
 /* Get AT device class by client ID */
 static struct at_device_class *at_device_class_get(uint16_t class_id)
 {
-    rt_base_t level;
+#ifdef AT_DEVICE_USING_SINGLE_CLASS
+    struct at_device_class *class = at_device_single_class;
+
+    return (class && class->class_id == class_id) ? class : RT_NULL;
+#else
     rt_slist_t *node = RT_NULL;
     struct at_device_class *class = RT_NULL;
 
-    level = rt_hw_interrupt_disable();
-
     /* Get AT device class by class ID */
     rt_slist_for_each(node, &at_device_class_list)
     {
         class = rt_slist_entry(node, struct at_device_class, list);
         if (class && class->class_id == class_id)
         {
-            rt_hw_interrupt_enable(level);
             return class;
         }
     }
 
-    rt_hw_interrupt_enable(level);
-
     return RT_NULL;
+#endif /* AT_DEVICE_USING_SINGLE_CLASS */
 }
 
 /**
@@ -238,7 +1966,7 @@ int at_device_register(struct at_device *device, const char *device_name,
                         const char *at_client_name, uint16_t class_id, void *user_data)
 {
     rt_base_t level;
-    int result = 0;
+    int result = 0, i;
     static int device_counts = 0;
     char name[RT_NAME_MAX] = {0};
     struct at_device_class *class = RT_NULL;
@@ -274,24 +2002,99 @@ int at_device_register(struct at_device *device, const char *device_name,
         result = -RT_ENOMEM;
         goto __exit;
     }
+
+    /* create AT device per-socket completion events */
+    device->socket_events = (struct rt_event *) rt_calloc(class->socket_num, sizeof(struct rt_event));
+    if (device->socket_events == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) socket events create.", device_name);
+        result = -RT_ENOMEM;
+        goto __exit;
+    }
+
+    for (i = 0; i < (int) class->socket_num; i++)
+    {
+        rt_event_init(&(device->socket_events[i]), name, RT_IPC_FLAG_FIFO);
+    }
+
+    /* create AT device send completion queue */
+    device->send_sockets = (struct at_device_send_entry *) rt_calloc(class->socket_num * 2,
+                                                                   sizeof(struct at_device_send_entry));
+    if (device->send_sockets == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) send queue create.", device_name);
+        result = -RT_ENOMEM;
+        goto __exit;
+    }
+    device->send_head = 0;
+    device->send_count = 0;
+
+    /* create AT device statistics */
+    rt_memset(&(device->stats), 0x00, sizeof(struct at_device_stats));
+    device->socket_stats = (struct at_device_socket_stats *) rt_calloc(class->socket_num,
+                                                                       sizeof(struct at_device_socket_stats));
+    if (device->socket_stats == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) socket statistics create.", device_name);
+        result = -RT_ENOMEM;
+        goto __exit;
+    }
+
+    /* create AT device TCP send windows */
+    if (class->send_ack)
+    {
+        device->send_windows = (struct at_device_send_window *) rt_calloc(class->socket_num,
+                                                                         sizeof(struct at_device_send_window));
+        if (device->send_windows == RT_NULL)
+        {
+            LOG_E("no memory for AT device(%s) send windows create.", device_name);
+            result = -RT_ENOMEM;
+            goto __exit;
+        }
+    }
+
+    /* initialize AT device domain resolve lock */
+    rt_snprintf(name, RT_NAME_MAX, "at_dn%d", device_counts - 1);
+    rt_mutex_init(&(device->dns_lock), name, RT_IPC_FLAG_PRIO);
+    device->dns_busy = 0;
+    device->connect_time = 0;
+
+#ifdef AT_DEVICE_USING_RECV_POOL
+    /* create AT device socket receive pool, the system heap is used if failed */
+    rt_snprintf(name, RT_NAME_MAX, "at_rp%d", device_counts - 1);
+    if (at_device_recv_pool_create(device, name, class->recv_mtu) != RT_EOK)
+    {
+        LOG_W("no memory for AT device(%s) receive pool create.", device_name);
+    }
+#endif
 #endif /* AT_USING_SOCKET */
 
     rt_memcpy(device->name, device_name, rt_strlen(device_name));
     device->class = class;
     device->user_data = user_data;
 
+#if AT_DEVICE_RESP_POOL_NUM > 0
+    /* create AT device response pool */
+    at_device_resp_pool_create(device);
+#endif
+
     /* Initialize current AT device single list */
     rt_slist_init(&(device->list));
 
-    level = rt_hw_interrupt_disable();
+    level = AT_DEVICE_LIST_LOCK();
 
-    /* Add current AT device to device list */
+    /* Add current AT device to device list after its fields are visible */
+    AT_DEVICE_LIST_BARRIER();
     rt_slist_append(&at_device_list, &(device->list));
 
-    rt_hw_interrupt_enable(level);
+    AT_DEVICE_LIST_UNLOCK(level);
 
     /* Initialize AT device */
     result = class->device_ops->init(device);
+
+    /* Bind the AT client initialized by device class to current AT device */
+    at_device_client_bind(device);
+
     if (result < 0)
     {
         goto __exit;
@@ -309,3 +2112,84 @@ __exit:
 
     return result;
 }
+
+#if defined(AT_USING_SOCKET) && defined(FINSH_USING_MSH)
+#include <finsh.h>
+
+static void at_device_stats_dump(struct at_device *device)
+{
+    int i;
+    struct at_device_stats stats;
+    struct at_device_socket_stats socket_stats;
+#ifdef AT_DEVICE_USING_UPLINK
+    struct at_device_uplink_stats uplink_stats;
+#endif
+
+    at_device_stats_get(device, &stats);
+
+    rt_kprintf("%s:\n", device->name);
+    rt_kprintf("  cmds %u, cmd timeouts %u, retries %u, urcs %u\n",
+               stats.cmds, stats.cmd_timeouts, stats.retries, stats.urcs);
+    rt_kprintf("  sent %u bytes in %u chunks, received %u bytes\n",
+               stats.bytes_sent, stats.chunks_sent, stats.bytes_recv);
+    rt_kprintf("  recv pool hits %u, misses %u, alloc fails %u, dropped %u bytes\n",
+               stats.recv_pool_hits, stats.recv_pool_misses, stats.recv_alloc_fails, stats.recv_dropped);
+    rt_kprintf("  send window polls %u, stalls %u\n", stats.window_polls, stats.window_stalls);
+#ifdef AT_DEVICE_USING_AUTO_SLEEP
+    rt_kprintf("  auto sleeps %u, wakeups %u, average wake time %u ms\n", stats.sleeps, stats.wakeups,
+               stats.wakeups ? stats.wake_time / stats.wakeups : 0);
+#endif
+#ifdef AT_DEVICE_USING_UPLINK
+    if (at_device_uplink_stats_get(device, &uplink_stats) == RT_EOK)
+    {
+        rt_kprintf("  uplink wakeups %u (%u forced), %u per hour, %u bytes per wake, %u bytes queued\n",
+                   uplink_stats.wakeups, uplink_stats.forced_wakeups, uplink_stats.wakeups_per_hour,
+                   uplink_stats.bytes_per_wake, uplink_stats.queued);
+        rt_kprintf("  uplink dropped %u datagrams, %u bytes\n", uplink_stats.dropped, uplink_stats.dropped_bytes);
+    }
+#endif
+
+    for (i = 0; i < (int) device->class->socket_num; i++)
+    {
+        at_device_socket_stats_get(device, i, &socket_stats);
+        if (socket_stats.bytes_sent || socket_stats.bytes_recv)
+        {
+            rt_kprintf("  socket %d: sent %u bytes, received %u bytes\n",
+                       i, socket_stats.bytes_sent, socket_stats.bytes_recv);
+        }
+    }
+}
+
+static int at_device_stats(int argc, char **argv)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device *device = RT_NULL;
+
+    if (argc > 2)
+    {
+        rt_kprintf("at_device_stats [device_name]   -- show AT device statistics.\n");
+        return -RT_ERROR;
+    }
+
+    if (argc == 2)
+    {
+        device = at_device_get_by_name(AT_DEVICE_NAMETYPE_DEVICE, argv[1]);
+        if (device == RT_NULL)
+        {
+            rt_kprintf("AT device(%s) not found.\n", argv[1]);
+            return -RT_ERROR;
+        }
+
+        at_device_stats_dump(device);
+        return RT_EOK;
+    }
+
+    rt_slist_for_each(node, &at_device_list)
+    {
+        at_device_stats_dump(rt_slist_entry(node, struct at_device, list));
+    }
+
+    return RT_EOK;
+}
+MSH_CMD_EXPORT(at_device_stats, show AT device statistics);
+#endif /* AT_USING_SOCKET && FINSH_USING_MSH */
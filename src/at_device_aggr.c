@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.aggr"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#if defined(AT_USING_SOCKET) && defined(AT_DEVICE_USING_AGGR)
+
+/*
+ * The aggregation network interface has no AT device of its own. AT socket
+ * gets the device of a new socket by the default network interface name, so
+ * when the aggregation interface is default every new socket is placed on the
+ * least loaded member device and stays on it until closed.
+ */
+
+/* The maximum number of AT devices in the aggregation network interface */
+#ifndef AT_DEVICE_AGGR_MEMBER_NUM
+#define AT_DEVICE_AGGR_MEMBER_NUM      4
+#endif
+
+struct at_device_aggr
+{
+    struct netdev netdev;
+    struct at_device *members[AT_DEVICE_AGGR_MEMBER_NUM];
+    int member_num;
+};
+
+static struct at_device_aggr *at_device_aggr = RT_NULL;
+
+/**
+ * This function will check whether the member device can take a new socket.
+ *
+ * @param device AT device object
+ *
+ * @return RT_TRUE: the device is ready
+ *        RT_FALSE: the device is not ready
+ */
+static rt_bool_t at_device_aggr_ready(struct at_device *device)
+{
+    return (device->is_init == RT_TRUE && device->netdev &&
+            netdev_is_up(device->netdev) && netdev_is_link_up(device->netdev)) ? RT_TRUE : RT_FALSE;
+}
+
+/**
+ * This function will get the load of the member device, the number of sockets
+ * in use and the sends waiting for completion.
+ *
+ * @param device AT device object
+ *
+ * @return the load of AT device
+ */
+static rt_uint32_t at_device_aggr_load(struct at_device *device)
+{
+    int i;
+    rt_uint32_t load = device->send_count;
+
+    for (i = 0; i < (int) device->class->socket_num; i++)
+    {
+        if (device->sockets[i].state != AT_SOCKET_NONE)
+        {
+            load++;
+        }
+    }
+
+    return load;
+}
+
+/**
+ * This function will update the link status and address of the aggregation
+ * network interface from the first ready member device.
+ */
+void at_device_aggr_update(void)
+{
+    int i;
+    struct netdev *netdev = RT_NULL;
+    struct netdev *member = RT_NULL;
+
+    if (at_device_aggr == RT_NULL)
+    {
+        return;
+    }
+
+    netdev = &(at_device_aggr->netdev);
+
+    for (i = 0; i < at_device_aggr->member_num; i++)
+    {
+        if (at_device_aggr_ready(at_device_aggr->members[i]))
+        {
+            member = at_device_aggr->members[i]->netdev;
+            break;
+        }
+    }
+
+    if (member)
+    {
+        netdev_low_level_set_ipaddr(netdev, &(member->ip_addr));
+        netdev_low_level_set_gw(netdev, &(member->gw));
+        netdev_low_level_set_netmask(netdev, &(member->netmask));
+        for (i = 0; i < NETDEV_DNS_SERVERS_NUM; i++)
+        {
+            netdev_low_level_set_dns_server(netdev, i, &(member->dns_servers[i]));
+        }
+    }
+
+    if ((member != RT_NULL) != netdev_is_link_up(netdev))
+    {
+        netdev_low_level_set_link_status(netdev, member ? RT_TRUE : RT_FALSE);
+    }
+}
+
+static int at_device_aggr_set_up(struct netdev *netdev)
+{
+    netdev_low_level_set_status(netdev, RT_TRUE);
+    at_device_aggr_update();
+
+    return RT_EOK;
+}
+
+static int at_device_aggr_set_down(struct netdev *netdev)
+{
+    netdev_low_level_set_status(netdev, RT_FALSE);
+
+    return RT_EOK;
+}
+
+#ifdef NETDEV_USING_PING
+static int at_device_aggr_ping(struct netdev *netdev, const char *host, size_t data_len,
+                               uint32_t timeout, struct netdev_ping_resp *ping_resp
+#if RT_VER_NUM >= 0x50100
+                               , rt_bool_t is_bind
+#endif
+                               )
+{
+    struct at_device *device = RT_NULL;
+
+    device = at_device_aggr_select();
+    if (device == RT_NULL || device->netdev->ops->ping == RT_NULL)
+    {
+        LOG_E("no member device of %s is ready.", netdev->name);
+        return -RT_ERROR;
+    }
+
+    return device->netdev->ops->ping(device->netdev, host, data_len, timeout, ping_resp
+#if RT_VER_NUM >= 0x50100
+                                     , is_bind
+#endif
+                                     );
+}
+#endif /* NETDEV_USING_PING */
+
+#ifdef NETDEV_USING_NETSTAT
+static void at_device_aggr_netstat(struct netdev *netdev)
+{
+    int i;
+    struct at_device *device = RT_NULL;
+
+    for (i = 0; i < at_device_aggr->member_num; i++)
+    {
+        device = at_device_aggr->members[i];
+        rt_kprintf("%-10s %-8s load %-4d connect %dms\n", device->name,
+                at_device_aggr_ready(device) ? "ready" : "down",
+                at_device_aggr_load(device), device->connect_time);
+    }
+}
+#endif /* NETDEV_USING_NETSTAT */
+
+static const struct netdev_ops at_device_aggr_netdev_ops =
+{
+    at_device_aggr_set_up,
+    at_device_aggr_set_down,
+
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+
+#ifdef NETDEV_USING_PING
+    at_device_aggr_ping,
+#endif
+#ifdef NETDEV_USING_NETSTAT
+    at_device_aggr_netstat,
+#endif
+};
+
+/**
+ * This function will create the aggregation network interface.
+ *
+ * @param netdev_name the aggregation network interface name
+ *
+ * @return  0: create success
+ *         -1: the aggregation network interface is created
+ *         -5: no memory
+ */
+int at_device_aggr_create(const char *netdev_name)
+{
+    struct at_device_aggr *aggr = RT_NULL;
+
+    RT_ASSERT(netdev_name);
+
+    if (at_device_aggr)
+    {
+        LOG_E("aggregation network interface(%s) is created.", at_device_aggr->netdev.name);
+        return -RT_ERROR;
+    }
+
+    aggr = (struct at_device_aggr *) rt_calloc(1, sizeof(struct at_device_aggr));
+    if (aggr == RT_NULL)
+    {
+        LOG_E("no memory for aggregation network interface create.");
+        return -RT_ENOMEM;
+    }
+
+    aggr->netdev.mtu = 1500;
+    aggr->netdev.ops = &at_device_aggr_netdev_ops;
+
+#ifdef SAL_USING_AT
+    extern int sal_at_netdev_set_pf_info(struct netdev *netdev);
+    /* set the network interface socket/netdb operations */
+    sal_at_netdev_set_pf_info(&(aggr->netdev));
+#endif
+
+    at_device_aggr = aggr;
+    netdev_register(&(aggr->netdev), netdev_name, RT_NULL);
+    netdev_low_level_set_status(&(aggr->netdev), RT_TRUE);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will add the AT device to the aggregation network interface.
+ *
+ * @param device_name AT device name
+ *
+ * @return  0: add success
+ *         -1: the device is not found or the aggregation interface is full
+ */
+int at_device_aggr_add(const char *device_name)
+{
+    rt_base_t level;
+    struct at_device *device = RT_NULL;
+
+    RT_ASSERT(device_name);
+
+    if (at_device_aggr == RT_NULL)
+    {
+        LOG_E("aggregation network interface is not created.");
+        return -RT_ERROR;
+    }
+
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_DEVICE, device_name);
+    if (device == RT_NULL || device->netdev == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", device_name);
+        return -RT_ERROR;
+    }
+
+    level = rt_hw_interrupt_disable();
+    if (at_device_aggr->member_num >= AT_DEVICE_AGGR_MEMBER_NUM)
+    {
+        rt_hw_interrupt_enable(level);
+        LOG_E("aggregation network interface is full.");
+        return -RT_ERROR;
+    }
+    at_device_aggr->members[at_device_aggr->member_num++] = device;
+    rt_hw_interrupt_enable(level);
+
+    at_device_netdev_watch(device);
+    at_device_aggr_update();
+
+    return RT_EOK;
+}
+
+/**
+ * This function will check whether the name is the aggregation network interface.
+ *
+ * @param netdev_name network interface name
+ *
+ * @return RT_TRUE: it's the aggregation network interface
+ *        RT_FALSE: it's not
+ */
+rt_bool_t at_device_aggr_match(const char *netdev_name)
+{
+    if (at_device_aggr == RT_NULL)
+    {
+        return RT_FALSE;
+    }
+
+    return rt_strncmp(at_device_aggr->netdev.name, netdev_name, RT_NAME_MAX) == 0 ? RT_TRUE : RT_FALSE;
+}
+
+/**
+ * This function will select the member device for a new connection, the
+ * ready device with the lowest load is selected and the one with the shorter
+ * average connect time wins between the same load.
+ *
+ * @return != RT_NULL: the selected AT device
+ *          = RT_NULL: no member device is ready
+ */
+struct at_device *at_device_aggr_select(void)
+{
+    int i;
+    rt_uint32_t load, select_load = 0;
+    struct at_device *device = RT_NULL;
+    struct at_device *select = RT_NULL;
+
+    if (at_device_aggr == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    for (i = 0; i < at_device_aggr->member_num; i++)
+    {
+        device = at_device_aggr->members[i];
+        if (at_device_aggr_ready(device) == RT_FALSE)
+        {
+            continue;
+        }
+
+        load = at_device_aggr_load(device);
+        if (select == RT_NULL || load < select_load ||
+                (load == select_load && device->connect_time < select->connect_time))
+        {
+            select = device;
+            select_load = load;
+        }
+    }
+
+    return select;
+}
+
+#endif /* AT_USING_SOCKET && AT_DEVICE_USING_AGGR */
@@ -0,0 +1,1049 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <at_device_dialect.h>
+
+#define DBG_TAG              "at.dialect"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#ifdef AT_USING_SOCKET
+
+/*
+ * The socket dialect engine carries the socket logic shared by the modules
+ * whose sockets are numbered by the module and whose data is pushed by URC,
+ * the class describes the command strings and URCs by the dialect and keeps
+ * only its own domain resolve and listen. The connect result may be answered
+ * by the command or reported by URC later, and the TCP send keeps the send
+ * window of the class.
+ */
+
+#ifdef AT_DEVICE_USING_PASSTHROUGH
+/* The silence in milliseconds which ends one passthrough receive burst */
+#ifndef AT_DEVICE_PASSTHROUGH_RECV_GAP
+#define AT_DEVICE_PASSTHROUGH_RECV_GAP 20
+#endif
+#endif /* AT_DEVICE_USING_PASSTHROUGH */
+
+static at_evt_cb_t at_evt_cb_set[] = {
+        [AT_SOCKET_EVT_RECV] = NULL,
+        [AT_SOCKET_EVT_CLOSED] = NULL,
+#ifdef AT_USING_SOCKET_SERVER
+        [AT_SOCKET_EVT_CONNECTED] = NULL,
+#endif
+};
+
+/**
+ * This function will get AT socket object by device socket descriptor.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ *
+ * @return != RT_NULL: AT socket object
+ *          = RT_NULL: the device socket descriptor is invalid
+ */
+static struct at_socket *at_device_dialect_socket_get(struct at_device *device, int device_socket)
+{
+    if (device_socket < 0 || device_socket >= (int) device->class->socket_num)
+    {
+        return RT_NULL;
+    }
+
+#ifdef AT_USING_SOCKET_SERVER
+    /* the accepted sockets of server are not in the device socket array */
+    if (device->class->dialect->connected_urc)
+    {
+        return at_get_base_socket(device_socket);
+    }
+#endif
+
+    return &(device->sockets[device_socket]);
+}
+
+#ifdef AT_DEVICE_USING_PULL
+/**
+ * This function will send the read command of pull-mode receive, the data is
+ * taken by the read response URC.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ * @param size receive buffer size
+ *
+ * @return  0: read success
+ *         -1: send AT commands error
+ *         -5: no memory
+ */
+static int at_device_dialect_pull_read(struct at_device *device, int device_socket, rt_size_t size)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    const struct at_device_dialect *dialect = device->class->dialect;
+
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(dialect->send_timeout));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    result = at_device_exec_cmd(device, resp, dialect->pull, device_socket, (int) size);
+
+    at_device_resp_put(device, resp);
+
+    return result;
+}
+#endif /* AT_DEVICE_USING_PULL */
+
+#ifdef AT_DEVICE_USING_PASSTHROUGH
+/**
+ * This function will switch the catch-all URC of socket passthrough, it takes
+ * every received byte in passthrough. In command mode it waits for the escape
+ * sequence, which is never sent by the module.
+ *
+ * @param device AT device object
+ * @param active RT_TRUE: the socket data streams in passthrough
+ */
+static void at_device_passthrough_urc_set(struct at_device *device, rt_bool_t active)
+{
+    rt_base_t level;
+    const struct at_device_passthrough *passthrough = device->class->dialect->passthrough;
+
+    level = rt_hw_interrupt_disable();
+    device->passthrough_urc.cmd_prefix = active ? "" : passthrough->escape;
+    device->passthrough_urc.cmd_suffix = active ? "" : "\r\n";
+    device->passthrough = active;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will switch the catch-all URC of socket passthrough to the
+ * data prompt. The prompt may follow the response of the send command after
+ * the response is finished, so it's taken by the URC instead of the socket
+ * data, and the URC sends the prompt event.
+ *
+ * @param device AT device object
+ */
+static void at_device_passthrough_urc_prompt(struct at_device *device)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    device->passthrough_prompt[0] = device->class->dialect->prompt;
+    device->passthrough_prompt[1] = '\0';
+    device->passthrough_urc.cmd_prefix = device->passthrough_prompt;
+    device->passthrough_urc.cmd_suffix = "";
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * create TCP/UDP connect and enter passthrough by AT commands.
+ *
+ * @param socket current socket
+ * @param ip server IP address
+ * @param port server port
+ * @param type connect socket type(tcp, udp)
+ *
+ * @return   0: connect success
+ *          -1: connect failed, send commands error or type error
+ *          -5: no memory
+ */
+static int at_device_passthrough_connect(struct at_socket *socket, char *ip, int32_t port, enum at_socket_type type)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    struct at_device *device = (struct at_device *) socket->device;
+    const struct at_device_dialect *dialect = device->class->dialect;
+    const struct at_device_passthrough *passthrough = dialect->passthrough;
+    rt_mutex_t lock = at_device_get_client_lock(device);
+
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(dialect->connect_timeout));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    rt_mutex_take(lock, RT_WAITING_FOREVER);
+
+    switch (type)
+    {
+    case AT_SOCKET_TCP:
+        result = at_device_exec_cmd(device, resp, passthrough->connect_tcp, ip, port);
+        break;
+
+    case AT_SOCKET_UDP:
+        result = at_device_exec_cmd(device, resp, passthrough->connect_udp, ip, port);
+        break;
+
+    default:
+        LOG_E("not supported connect type %d.", type);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    if (result < 0 || at_device_exec_cmd(device, resp, passthrough->mode, 1) < 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* the data streams after the data prompt, the prompt may follow the "OK" line
+     * after a blank line, so it's waited by URC, otherwise it's taken as socket data */
+    at_device_socket_event_recv(device, 0, AT_DEVICE_DIALECT_EVENT_PROMPT, 0, RT_EVENT_FLAG_OR);
+    at_device_passthrough_urc_prompt(device);
+    resp->line_num = 2;
+    at_obj_set_end_sign(device->client, dialect->prompt);
+    result = at_device_exec_cmd(device, resp, "%s", passthrough->send);
+    if (result == RT_EOK && at_device_socket_event_recv(device, 0, AT_DEVICE_DIALECT_EVENT_PROMPT,
+            rt_tick_from_millisecond(dialect->connect_timeout), RT_EVENT_FLAG_OR) < 0)
+    {
+        result = -RT_ETIMEOUT;
+    }
+    at_obj_set_end_sign(device->client, 0);
+    if (result < 0)
+    {
+        LOG_E("%s device enter passthrough failed.", device->name);
+        at_device_passthrough_urc_set(device, RT_FALSE);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    at_device_passthrough_urc_set(device, RT_TRUE);
+
+__exit:
+    rt_mutex_release(lock);
+
+    if (resp)
+    {
+        at_device_resp_put(device, resp);
+    }
+
+    return result;
+}
+
+/**
+ * exit passthrough and close the connection by AT commands.
+ *
+ * @param socket current socket
+ *
+ * @return  0: close socket success
+ *         -1: send AT commands error
+ *         -5: no memory
+ */
+static int at_device_passthrough_close(struct at_socket *socket)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    struct at_device *device = (struct at_device *) socket->device;
+    const struct at_device_dialect *dialect = device->class->dialect;
+    const struct at_device_passthrough *passthrough = dialect->passthrough;
+    rt_mutex_t lock = at_device_get_client_lock(device);
+
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(dialect->close_timeout));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    rt_mutex_take(lock, RT_WAITING_FOREVER);
+
+    if (device->passthrough)
+    {
+        /* the escape sequence is only taken with silence before and after it */
+        rt_thread_mdelay(passthrough->guard_time);
+        at_client_obj_send(device->client, passthrough->escape, rt_strlen(passthrough->escape));
+        rt_thread_mdelay(passthrough->guard_time);
+
+        at_device_passthrough_urc_set(device, RT_FALSE);
+        at_device_exec_cmd(device, resp, passthrough->mode, 0);
+    }
+
+    result = at_device_exec_cmd(device, resp, "%s", passthrough->close);
+
+    rt_mutex_release(lock);
+
+    if (resp)
+    {
+        at_device_resp_put(device, resp);
+    }
+
+    return result;
+}
+
+/**
+ * send data to server in passthrough, the data is written to the AT client
+ * directly without send commands and send results.
+ *
+ * @param socket current socket
+ * @param buff send buffer
+ * @param bfsz send buffer size
+ *
+ * @return >=0: the size of send success
+ *          -1: not in passthrough or send data error
+ */
+static int at_device_passthrough_send(struct at_socket *socket, const char *buff, size_t bfsz)
+{
+    int result = RT_EOK;
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
+    rt_mutex_t lock = at_device_get_client_lock(device);
+
+    rt_mutex_take(lock, RT_WAITING_FOREVER);
+
+    if (device->passthrough == RT_FALSE)
+    {
+        LOG_E("%s device socket(%d) is not in passthrough.", device->name, device_socket);
+        result = -RT_ERROR;
+    }
+    else if (at_client_obj_send(device->client, buff, bfsz) != bfsz)
+    {
+        result = -RT_ERROR;
+    }
+    else
+    {
+        at_device_stats_send(device, device_socket, bfsz);
+    }
+
+    rt_mutex_release(lock);
+
+    return result < 0 ? result : (int) bfsz;
+}
+#endif /* AT_DEVICE_USING_PASSTHROUGH */
+
+/**
+ * close socket by AT commands.
+ *
+ * @param socket current socket
+ *
+ * @return  0: close socket success
+ *         -1: send AT commands error
+ *         -2: wait socket event timeout
+ *         -5: no memory
+ */
+int at_device_dialect_socket_close(struct at_socket *socket)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
+    const struct at_device_dialect *dialect = device->class->dialect;
+
+#ifdef AT_DEVICE_USING_PASSTHROUGH
+    if (dialect->passthrough)
+    {
+        return at_device_passthrough_close(socket);
+    }
+#endif
+
+#ifdef AT_DEVICE_USING_PULL
+    if (dialect->pull)
+    {
+        /* the data buffered in the module is dropped with the connection */
+        at_device_pull_clear(device, device_socket);
+    }
+#endif
+
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(dialect->close_timeout));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+#ifdef AT_USING_SOCKET_SERVER
+    if (dialect->close_server && socket->listen.is_listen)
+    {
+        result = at_device_exec_cmd(device, resp, "%s", dialect->close_server);
+    }
+    else
+#endif
+    /* at_closesocket sets the state to AT_SOCKET_CLOSED before the socket is closed */
+    if ((dialect->flags & AT_DEVICE_DIALECT_CLOSE_STATE) == 0 || socket->state == AT_SOCKET_CLOSED)
+    {
+        result = at_device_exec_cmd(device, resp, dialect->close, device_socket);
+    }
+
+    if (resp)
+    {
+        at_device_resp_put(device, resp);
+    }
+
+    return result;
+}
+
+/**
+ * create TCP/UDP client or server connect by AT commands.
+ *
+ * @param socket current socket
+ * @param ip server or client IP address
+ * @param port server or client port
+ * @param type connect socket type(tcp, udp)
+ * @param is_client connection is client
+ *
+ * @return   0: connect success
+ *          -1: connect failed, send commands error or type error
+ *          -2: wait socket event timeout
+ *          -5: no memory
+ */
+int at_device_dialect_socket_connect(struct at_socket *socket, char *ip, int32_t port,
+                                     enum at_socket_type type, rt_bool_t is_client)
+{
+    int result = RT_EOK, event_result = 0;
+    rt_bool_t retryed = RT_FALSE;
+    at_response_t resp = RT_NULL;
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
+    const struct at_device_dialect *dialect = device->class->dialect;
+
+    RT_ASSERT(ip);
+    RT_ASSERT(port >= 0);
+
+#ifdef AT_DEVICE_USING_PASSTHROUGH
+    if (dialect->passthrough)
+    {
+        return is_client ? at_device_passthrough_connect(socket, ip, port, type) : -RT_ERROR;
+    }
+#endif
+
+    resp = at_device_resp_get(device, 128, 0, rt_tick_from_millisecond(dialect->connect_timeout));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+__retry:
+    if (dialect->connect_urc)
+    {
+        /* clear socket connect event */
+        at_device_socket_event_recv(device, device_socket,
+                AT_DEVICE_DIALECT_EVENT_CONN_OK | AT_DEVICE_DIALECT_EVENT_CONN_FAIL, 0, RT_EVENT_FLAG_OR);
+    }
+
+    if (is_client)
+    {
+        switch (type)
+        {
+        case AT_SOCKET_TCP:
+            /* send AT commands to connect TCP server */
+            if (at_device_exec_cmd(device, resp, dialect->connect_tcp, device_socket, ip, port) < 0)
+            {
+                result = -RT_ERROR;
+            }
+            break;
+
+        case AT_SOCKET_UDP:
+            if (at_device_exec_cmd(device, resp, dialect->connect_udp, device_socket, ip, port) < 0)
+            {
+                result = -RT_ERROR;
+            }
+            break;
+
+        default:
+            LOG_E("not supported connect type %d.", type);
+            result = -RT_ERROR;
+            goto __exit;
+        }
+    }
+
+    if (result == RT_EOK && dialect->connect_urc)
+    {
+        /* waiting result event from AT URC */
+        event_result = at_device_socket_event_recv(device, device_socket,
+                AT_DEVICE_DIALECT_EVENT_CONN_OK | AT_DEVICE_DIALECT_EVENT_CONN_FAIL,
+                rt_tick_from_millisecond(dialect->connect_result_timeout), RT_EVENT_FLAG_OR);
+        if (event_result < 0)
+        {
+            LOG_E("%s device socket(%d) wait connect OK|FAIL timeout.", device->name, device_socket);
+            result = -RT_ETIMEOUT;
+            goto __exit;
+        }
+        if (event_result & AT_DEVICE_DIALECT_EVENT_CONN_FAIL)
+        {
+            result = -RT_ERROR;
+        }
+    }
+
+    if (result != RT_EOK && retryed == RT_FALSE)
+    {
+        LOG_D("%s device socket (%d) connect failed, the socket was not be closed and now will connect retry.",
+                device->name, device_socket);
+        if (at_device_dialect_socket_close(socket) < 0)
+        {
+            goto __exit;
+        }
+        retryed = RT_TRUE;
+        AT_DEVICE_STATS_INC(device, retries);
+        result = RT_EOK;
+        goto __retry;
+    }
+
+__exit:
+    if (resp)
+    {
+        at_device_resp_put(device, resp);
+    }
+
+    return result;
+}
+
+/**
+ * send one packet to server or client by AT commands, the AT client is only
+ * locked for this packet so that the packets of other sockets can interleave.
+ *
+ * @param device current AT device
+ * @param resp AT response object
+ * @param device_socket current device socket
+ * @param buff packet buffer
+ * @param size packet size
+ *
+ * @return  0: send success
+ *         -1: send AT commands error or send data error
+ *         -2: waited socket event timeout
+ *         -3: the send completion queue is full
+ */
+static int at_device_dialect_send_packet(struct at_device *device, at_response_t resp, int device_socket,
+                                         const char *buff, size_t size)
+{
+    int result = RT_EOK;
+    int event_result = 0;
+    rt_bool_t locked = RT_TRUE;
+    rt_mutex_t lock = at_device_get_client_lock(device);
+    const struct at_device_dialect *dialect = device->class->dialect;
+
+    rt_mutex_take(lock, RT_WAITING_FOREVER);
+
+    /* queue current socket for send URC event */
+    if (at_device_socket_send_push(device, device_socket) < 0)
+    {
+        LOG_E("%s device socket(%d) send queue is full.", device->name, device_socket);
+        rt_mutex_release(lock);
+        return -RT_EFULL;
+    }
+
+    /* set AT client end sign to deal with data prompt sign */
+    if (dialect->prompt)
+    {
+        at_obj_set_end_sign(device->client, dialect->prompt);
+    }
+
+    /* send the send command to AT server than receive the data prompt */
+    if (at_device_exec_cmd(device, resp, dialect->send, device_socket, (int) size) < 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    /* send the real data to server or client */
+    if (at_client_obj_send(device->client, buff, size) == 0)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    if (dialect->flags & AT_DEVICE_DIALECT_SEND_UNLOCKED)
+    {
+        /* the send result is waited without lock, the next packet can be sent in the meantime */
+        at_obj_set_end_sign(device->client, 0);
+        rt_mutex_release(lock);
+        locked = RT_FALSE;
+    }
+
+    /* waiting OK or failed result event from AT URC */
+    event_result = at_device_socket_event_recv(device, device_socket,
+            AT_DEVICE_DIALECT_EVENT_SEND_OK | AT_DEVICE_DIALECT_EVENT_SEND_FAIL,
+            rt_tick_from_millisecond(dialect->send_result_timeout), RT_EVENT_FLAG_OR);
+    if (event_result < 0)
+    {
+        LOG_E("%s device socket(%d) wait send OK|FAIL timeout.", device->name, device_socket);
+        result = -RT_ETIMEOUT;
+        goto __exit;
+    }
+    /* check result */
+    if (event_result & AT_DEVICE_DIALECT_EVENT_SEND_FAIL)
+    {
+        LOG_E("%s device socket(%d) send failed.", device->name, device_socket);
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+__exit:
+    if (result == -RT_ETIMEOUT)
+    {
+        /* the late send result is taken by the cancelled send instead of the next one */
+        at_device_socket_send_cancel(device, device_socket, rt_tick_from_millisecond(dialect->send_result_timeout));
+    }
+    else if (result < 0)
+    {
+        /* the send result is no longer waited */
+        at_device_socket_send_remove(device, device_socket);
+    }
+
+    if (locked)
+    {
+        /* reset the end sign for data */
+        at_obj_set_end_sign(device->client, 0);
+        rt_mutex_release(lock);
+    }
+
+    return result;
+}
+
+/**
+ * send data to server or client by AT commands.
+ *
+ * @param socket current socket
+ * @param buff send buffer
+ * @param bfsz send buffer size
+ * @param type connect socket type(tcp, udp)
+ *
+ * @return >=0: the size of send success
+ *          -1: send AT commands error or send data error
+ *          -2: waited socket event timeout
+ *          -5: no memory
+ */
+int at_device_dialect_socket_send(struct at_socket *socket, const char *buff, size_t bfsz,
+                                  enum at_socket_type type)
+{
+    int result = RT_EOK;
+    size_t cur_pkt_size = 0, sent_size = 0;
+    at_response_t resp = RT_NULL;
+    int device_socket = (int) socket->user_data;
+    struct at_device *device = (struct at_device *) socket->device;
+    const struct at_device_dialect *dialect = device->class->dialect;
+
+    RT_ASSERT(buff);
+    RT_ASSERT(bfsz > 0);
+
+#ifdef AT_DEVICE_USING_PASSTHROUGH
+    if (dialect->passthrough)
+    {
+        return at_device_passthrough_send(socket, buff, bfsz);
+    }
+#endif
+
+    resp = at_device_resp_get(device, 128, dialect->send_resp_lines, rt_tick_from_millisecond(dialect->send_timeout));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    while (sent_size < bfsz)
+    {
+        if (bfsz - sent_size < dialect->send_max_size)
+        {
+            cur_pkt_size = bfsz - sent_size;
+        }
+        else
+        {
+            cur_pkt_size = dialect->send_max_size;
+        }
+
+        if (type == AT_SOCKET_TCP)
+        {
+            /* the module buffer is kept full, the peer is only asked when the send window is exhausted */
+            result = at_device_send_window_wait(device, device_socket, cur_pkt_size,
+                    rt_tick_from_millisecond(dialect->send_result_timeout));
+            if (result < 0)
+            {
+                goto __exit;
+            }
+        }
+
+        result = at_device_dialect_send_packet(device, resp, device_socket, buff + sent_size, cur_pkt_size);
+        if (result < 0)
+        {
+            goto __exit;
+        }
+
+        if (type == AT_SOCKET_TCP)
+        {
+            at_device_send_window_sent(device, device_socket, cur_pkt_size);
+        }
+
+        at_device_stats_send(device, device_socket, cur_pkt_size);
+        sent_size += cur_pkt_size;
+    }
+
+__exit:
+    if (resp)
+    {
+        at_device_resp_put(device, resp);
+    }
+
+    return result < 0 ? result : (int) sent_size;
+}
+
+/**
+ * set AT socket event notice callback
+ *
+ * @param event notice event
+ * @param cb notice callback
+ */
+void at_device_dialect_socket_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
+{
+    if (event < sizeof(at_evt_cb_set) / sizeof(at_evt_cb_set[1]))
+    {
+        at_evt_cb_set[event] = cb;
+    }
+}
+
+void at_device_dialect_urc_send_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int device_socket = 0;
+    struct at_device *device = RT_NULL;
+    const struct at_device_dialect *dialect = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_client(client);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return;
+    }
+    dialect = device->class->dialect;
+
+    /* the send result has no socket number, it belongs to the oldest waiting send */
+    device_socket = at_device_socket_send_pop(device);
+    if (device_socket < 0)
+    {
+        return;
+    }
+
+    if (rt_strstr(data, dialect->send_ok))
+    {
+        at_device_socket_event_send(device, device_socket, AT_DEVICE_DIALECT_EVENT_SEND_OK);
+    }
+    else if (rt_strstr(data, dialect->send_fail))
+    {
+        at_device_socket_event_send(device, device_socket, AT_DEVICE_DIALECT_EVENT_SEND_FAIL);
+    }
+}
+
+void at_device_dialect_urc_connect_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int device_socket = 0, result = 0;
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_client(client);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return;
+    }
+
+    rt_sscanf(data, device->class->dialect->connect_urc, &device_socket, &result);
+    if (result)
+    {
+        LOG_D("%s device socket(%d) connect failed(%d).", device->name, device_socket, result);
+    }
+
+    at_device_socket_event_send(device, device_socket,
+            result == 0 ? AT_DEVICE_DIALECT_EVENT_CONN_OK : AT_DEVICE_DIALECT_EVENT_CONN_FAIL);
+}
+
+void at_device_dialect_urc_ignore_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    RT_ASSERT(data && size);
+
+    /* the URC carries nothing the socket needs, it's only taken out of the response */
+}
+
+void at_device_dialect_urc_close_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int device_socket = 0;
+    struct at_socket *socket = RT_NULL;
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_client(client);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return;
+    }
+
+    rt_sscanf(data, device->class->dialect->close_urc, &device_socket);
+    socket = at_device_dialect_socket_get(device, device_socket);
+    if (socket == RT_NULL)
+    {
+        return;
+    }
+
+    /* notice the socket is disconnect by remote */
+    if (at_evt_cb_set[AT_SOCKET_EVT_CLOSED])
+    {
+        at_evt_cb_set[AT_SOCKET_EVT_CLOSED](socket, AT_SOCKET_EVT_CLOSED, RT_NULL, 0);
+    }
+}
+
+#ifdef AT_USING_SOCKET_SERVER
+void at_device_dialect_urc_connected_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int socket;
+    struct at_device *device = RT_NULL;
+    char socket_info[AT_SOCKET_INFO_LEN] = {0};
+    char *client_name = client->device->parent.name;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_client(client);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return;
+    }
+
+    rt_sscanf(data, device->class->dialect->connected_urc, &socket);
+    rt_memset(&socket_info[0], 0, AT_SOCKET_INFO_LEN);
+    rt_sprintf(&socket_info[0], "SOCKET:%d", socket);
+
+    /* notice at socket to alloc a new socket */
+    if (at_evt_cb_set[AT_SOCKET_EVT_CONNECTED])
+    {
+        at_evt_cb_set[AT_SOCKET_EVT_CONNECTED](RT_NULL, AT_SOCKET_EVT_CONNECTED, &socket_info[0], AT_SOCKET_INFO_LEN);
+    }
+}
+#endif /* AT_USING_SOCKET_SERVER */
+
+void at_device_dialect_urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int device_socket = 0;
+    rt_int32_t timeout = 0;
+    rt_size_t bfsz = 0, temp_size = 0;
+    char *recv_buf = RT_NULL, temp[8] = {0};
+    struct at_socket *socket = RT_NULL;
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_client(client);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return;
+    }
+
+    /* get the at deveice socket and receive buffer size by receive data */
+    rt_sscanf(data, device->class->dialect->recv_urc, &device_socket, (int *) &bfsz);
+
+    /* set receive timeout by receive buffer length, not less than 10ms */
+    timeout = bfsz > 10 ? bfsz : 10;
+
+    if (device_socket < 0 || bfsz == 0)
+    {
+        return;
+    }
+
+    recv_buf = (char *) at_device_recv_buf_alloc(device, bfsz);
+    if (recv_buf == RT_NULL)
+    {
+        LOG_E("no memory receive buffer(%d).", (int) bfsz);
+        /* read and clean the coming data */
+        while (temp_size < bfsz)
+        {
+            if (bfsz - temp_size > sizeof(temp))
+            {
+                at_client_obj_recv(client, temp, sizeof(temp), timeout);
+            }
+            else
+            {
+                at_client_obj_recv(client, temp, bfsz - temp_size, timeout);
+            }
+            temp_size += sizeof(temp);
+        }
+        return;
+    }
+
+    /* sync receive data */
+    if (at_client_obj_recv(client, recv_buf, bfsz, timeout) != bfsz)
+    {
+        LOG_E("%s device receive size(%d) data failed.", device->name, (int) bfsz);
+        rt_free(recv_buf);
+        return;
+    }
+
+    /* get at socket object by device socket descriptor */
+    socket = at_device_dialect_socket_get(device, device_socket);
+    if (socket == RT_NULL)
+    {
+        rt_free(recv_buf);
+        return;
+    }
+
+    /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
+    if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
+    {
+        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
+    }
+}
+
+#ifdef AT_DEVICE_USING_PULL
+void at_device_dialect_urc_notice_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int device_socket = -1;
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_client(client);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return;
+    }
+
+    /* the data is read in the pull thread, AT commands can't be sent in URC */
+    rt_sscanf(data, device->class->dialect->notice_urc, &device_socket);
+    at_device_pull_notice(device, device_socket);
+}
+
+void at_device_dialect_urc_pull_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    rt_size_t bfsz = 0;
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_client(client);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return;
+    }
+
+    rt_sscanf(data, device->class->dialect->pull_urc, (int *) &bfsz);
+    at_device_pull_recv(device, bfsz);
+}
+#endif /* AT_DEVICE_USING_PULL */
+
+#ifdef AT_DEVICE_USING_PASSTHROUGH
+static void at_device_dialect_urc_passthrough_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    rt_size_t bfsz = 0, mtu = 0;
+    char *recv_buf = RT_NULL;
+    struct at_socket *socket = RT_NULL;
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_client(client);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return;
+    }
+
+    if (device->passthrough == RT_FALSE)
+    {
+        if (device->passthrough_urc.cmd_prefix == device->passthrough_prompt)
+        {
+            /* the data prompt of entering passthrough */
+            at_device_socket_event_send(device, 0, AT_DEVICE_DIALECT_EVENT_PROMPT);
+        }
+        return;
+    }
+
+    mtu = device->class->recv_mtu ? device->class->recv_mtu : AT_DEVICE_RECV_POOL_MTU;
+    recv_buf = (char *) at_device_recv_buf_alloc(device, mtu);
+    if (recv_buf == RT_NULL)
+    {
+        LOG_E("no memory receive buffer(%d).", (int) mtu);
+        return;
+    }
+
+    /* the first bytes are taken by URC match, the rest of the burst is read until silence */
+    bfsz = size < mtu ? size : mtu;
+    rt_memcpy(recv_buf, data, bfsz);
+    bfsz += at_client_obj_recv(client, recv_buf + bfsz, mtu - bfsz, AT_DEVICE_PASSTHROUGH_RECV_GAP);
+
+    socket = at_device_dialect_socket_get(device, 0);
+
+    /* notice the receive buffer and buffer size */
+    at_device_stats_recv(device, socket, bfsz);
+
+    if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
+    {
+        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
+    }
+    else
+    {
+        rt_free(recv_buf);
+    }
+}
+#endif /* AT_DEVICE_USING_PASSTHROUGH */
+
+/**
+ * This function will register the socket dialect URC table of AT device.
+ *
+ * @param device AT device object
+ *
+ * @return  0: register success
+ *         -1: the device class has no socket dialect or create the pull thread failed
+ */
+int at_device_dialect_socket_init(struct at_device *device)
+{
+    const struct at_device_dialect *dialect = RT_NULL;
+
+    RT_ASSERT(device);
+
+    dialect = device->class->dialect;
+    if (dialect == RT_NULL)
+    {
+        LOG_E("device(%s) has no socket dialect.", device->name);
+        return -RT_ERROR;
+    }
+
+#ifdef AT_DEVICE_USING_PASSTHROUGH
+    if (dialect->passthrough)
+    {
+        /* the catch-all URC is checked before the dialect URCs */
+        device->passthrough_urc.func = at_device_dialect_urc_passthrough_func;
+        at_device_passthrough_urc_set(device, RT_FALSE);
+        at_obj_set_urc_table(device->client, &(device->passthrough_urc), 1);
+    }
+#endif
+
+#ifdef AT_DEVICE_USING_PULL
+    if (dialect->pull)
+    {
+        device->class->pull_read = at_device_dialect_pull_read;
+        if (at_device_pull_init(device) != RT_EOK)
+        {
+            return -RT_ERROR;
+        }
+    }
+#endif
+
+    /* register URC data execution function  */
+    at_obj_set_urc_table(device->client, dialect->urc_table, dialect->urc_table_size);
+
+    return RT_EOK;
+}
+
+#endif /* AT_USING_SOCKET */
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.fo"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#if defined(AT_USING_SOCKET) && defined(AT_DEVICE_USING_FAILOVER)
+
+/*
+ * New sockets follow the default network interface, so the failover switches
+ * the default network interface to the standby device as soon as the primary
+ * device link is lost, and back when the primary device link is up again. The
+ * client sockets on the primary device are closed to AT socket at once, and
+ * their endpoints are passed to the reconnect callback in the failover thread.
+ * AT socket doesn't close a socket in the device once it's noticed closed, so
+ * the failover thread closes them in the primary device as well.
+ */
+
+#ifndef AT_DEVICE_FAILOVER_THREAD_STACK_SIZE
+#define AT_DEVICE_FAILOVER_THREAD_STACK_SIZE 2048
+#endif
+
+#ifndef AT_DEVICE_FAILOVER_THREAD_PRIORITY
+#define AT_DEVICE_FAILOVER_THREAD_PRIORITY   (RT_THREAD_PRIORITY_MAX / 2)
+#endif
+
+#define AT_DEVICE_FAILOVER_EVENT_LOST        (1 << 0)
+
+/* The client socket endpoint on the primary device */
+struct at_device_failover_peer
+{
+    struct at_socket *socket;                    /* the connected AT socket, RT_NULL once closed or lost */
+    char ip[16];
+    int32_t port;
+    enum at_socket_type type;
+    rt_bool_t lost;                              /* the socket waits for the reconnect callback */
+    rt_bool_t closing;                           /* the socket waits for close in the primary device */
+};
+
+struct at_device_failover
+{
+    struct at_device *primary;
+    struct at_device *standby;
+    rt_bool_t active;                            /* the standby device is in use */
+    rt_tick_t lost_tick;                         /* the tick the primary device link is lost */
+    struct at_device_failover_peer *peers;       /* indexed by the primary device socket */
+    struct rt_event event;
+    at_device_failover_cb_t cb;
+    void *user_data;
+};
+
+static struct at_device_failover *at_device_failover = RT_NULL;
+
+/**
+ * This function will close the client socket lost by failover in the primary
+ * device, so the connection can be opened again after fall back. The AT
+ * socket object may be reused already, the device socket is closed by a copy.
+ *
+ * @param device the primary AT device object
+ * @param device_socket the primary device socket
+ * @param type the socket type
+ */
+static void at_device_failover_close(struct at_device *device, int device_socket, enum at_socket_type type)
+{
+    struct at_socket socket;
+
+    rt_memset(&socket, 0x00, sizeof(socket));
+    socket.device = device;
+    socket.type = type;
+    socket.user_data = (void *) device_socket;
+
+    if (device->class->socket_ops->at_closesocket(&socket) != RT_EOK)
+    {
+        LOG_W("device(%s) socket(%d) lost by failover close failed.", device->name, device_socket);
+    }
+}
+
+static void at_device_failover_thread_entry(void *parameter)
+{
+    int i;
+    rt_base_t level;
+    rt_uint32_t event = 0;
+    struct at_device_failover_peer peer;
+    struct at_device_failover *failover = (struct at_device_failover *) parameter;
+
+    while (1)
+    {
+        if (rt_event_recv(&(failover->event), AT_DEVICE_FAILOVER_EVENT_LOST,
+                RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, RT_WAITING_FOREVER, &event) != RT_EOK)
+        {
+            continue;
+        }
+
+        for (i = 0; i < (int) failover->primary->class->socket_num; i++)
+        {
+            level = rt_hw_interrupt_disable();
+            peer = failover->peers[i];
+            failover->peers[i].lost = RT_FALSE;
+            rt_hw_interrupt_enable(level);
+
+            if (peer.lost == RT_FALSE || failover->cb == RT_NULL)
+            {
+                continue;
+            }
+
+            failover->cb(failover->standby, peer.ip, peer.port, peer.type, failover->user_data);
+        }
+
+        LOG_I("failover from %s to %s is completed in %d ms.", failover->primary->name, failover->standby->name,
+                (rt_tick_get() - failover->lost_tick) * 1000 / RT_TICK_PER_SECOND);
+
+        /* the sockets are reconnected first, the primary device may answer slowly without link */
+        for (i = 0; i < (int) failover->primary->class->socket_num; i++)
+        {
+            level = rt_hw_interrupt_disable();
+            peer = failover->peers[i];
+            failover->peers[i].closing = RT_FALSE;
+            rt_hw_interrupt_enable(level);
+
+            if (peer.closing)
+            {
+                at_device_failover_close(failover->primary, i, peer.type);
+            }
+        }
+    }
+}
+
+/**
+ * This function will set the hot-standby failover from the primary AT device
+ * to the standby AT device.
+ *
+ * @param primary_name the primary AT device name
+ * @param standby_name the standby AT device name
+ *
+ * @return  0: set success
+ *         -1: get device failed or create failover thread failed
+ *         -5: no memory
+ */
+int at_device_failover_set(const char *primary_name, const char *standby_name)
+{
+    rt_thread_t tid = RT_NULL;
+    struct at_device *primary = RT_NULL;
+    struct at_device *standby = RT_NULL;
+    struct at_device_failover *failover = RT_NULL;
+
+    RT_ASSERT(primary_name);
+    RT_ASSERT(standby_name);
+
+    if (at_device_failover)
+    {
+        LOG_E("failover of %s is set.", at_device_failover->primary->name);
+        return -RT_ERROR;
+    }
+
+    primary = at_device_get_by_name(AT_DEVICE_NAMETYPE_DEVICE, primary_name);
+    standby = at_device_get_by_name(AT_DEVICE_NAMETYPE_DEVICE, standby_name);
+    if (primary == RT_NULL || standby == RT_NULL || primary == standby ||
+            primary->netdev == RT_NULL || standby->netdev == RT_NULL)
+    {
+        LOG_E("get device(%s, %s) failed.", primary_name, standby_name);
+        return -RT_ERROR;
+    }
+
+    failover = (struct at_device_failover *) rt_calloc(1, sizeof(struct at_device_failover));
+    if (failover == RT_NULL)
+    {
+        LOG_E("no memory for failover create.");
+        return -RT_ENOMEM;
+    }
+
+    failover->peers = (struct at_device_failover_peer *) rt_calloc(primary->class->socket_num,
+                                                                   sizeof(struct at_device_failover_peer));
+    if (failover->peers == RT_NULL)
+    {
+        LOG_E("no memory for failover create.");
+        rt_free(failover);
+        return -RT_ENOMEM;
+    }
+
+    failover->primary = primary;
+    failover->standby = standby;
+    rt_event_init(&(failover->event), "at_fo", RT_IPC_FLAG_FIFO);
+
+    tid = rt_thread_create("at_fo", at_device_failover_thread_entry, failover,
+            AT_DEVICE_FAILOVER_THREAD_STACK_SIZE, AT_DEVICE_FAILOVER_THREAD_PRIORITY, 20);
+    if (tid == RT_NULL)
+    {
+        LOG_E("create failover thread failed.");
+        rt_event_detach(&(failover->event));
+        rt_free(failover->peers);
+        rt_free(failover);
+        return -RT_ERROR;
+    }
+
+    at_device_failover = failover;
+    rt_thread_startup(tid);
+
+    at_device_netdev_watch(primary);
+    at_device_netdev_watch(standby);
+    at_device_failover_update(primary);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will set the callback to reconnect the client sockets lost
+ * by failover, it's called in the failover thread for every lost socket.
+ *
+ * @param cb the reconnect callback
+ * @param user_data the user data passed to the callback
+ */
+void at_device_failover_set_reconnect_cb(at_device_failover_cb_t cb, void *user_data)
+{
+    if (at_device_failover == RT_NULL)
+    {
+        return;
+    }
+
+    at_device_failover->user_data = user_data;
+    at_device_failover->cb = cb;
+}
+
+/**
+ * This function will record the client socket endpoint connected on the
+ * primary device, it's called by the socket connect of the core.
+ *
+ * @param device AT device object
+ * @param socket AT socket object
+ * @param ip the remote IP address
+ * @param port the remote port
+ * @param type the socket type
+ */
+void at_device_failover_connected(struct at_device *device, struct at_socket *socket,
+                                  const char *ip, int32_t port, enum at_socket_type type)
+{
+    int device_socket = (int) socket->user_data;
+    struct at_device_failover_peer *peer = RT_NULL;
+
+    if (at_device_failover == RT_NULL || device != at_device_failover->primary ||
+            device_socket < 0 || device_socket >= (int) device->class->socket_num)
+    {
+        return;
+    }
+
+    peer = &(at_device_failover->peers[device_socket]);
+    peer->socket = socket;
+    rt_memset(peer->ip, 0x00, sizeof(peer->ip));
+    rt_strncpy(peer->ip, ip, sizeof(peer->ip) - 1);
+    peer->port = port;
+    peer->type = type;
+    peer->lost = RT_FALSE;
+    peer->closing = RT_FALSE;
+}
+
+/**
+ * This function will stop following the client socket on the primary device,
+ * it's called by the socket close of the core. The AT socket object is reused
+ * for other connections once closed.
+ *
+ * @param device AT device object
+ * @param socket AT socket object
+ */
+void at_device_failover_closed(struct at_device *device, struct at_socket *socket)
+{
+    int device_socket = (int) socket->user_data;
+    rt_base_t level;
+
+    if (at_device_failover == RT_NULL || device != at_device_failover->primary ||
+            device_socket < 0 || device_socket >= (int) device->class->socket_num)
+    {
+        return;
+    }
+
+    level = rt_hw_interrupt_disable();
+    if (at_device_failover->peers[device_socket].socket == socket)
+    {
+        at_device_failover->peers[device_socket].socket = RT_NULL;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will switch the default network interface by the link status
+ * of the primary device, it's called when the network interface status of
+ * the primary or standby device changes.
+ *
+ * @param device AT device object which network interface status changes
+ */
+void at_device_failover_update(struct at_device *device)
+{
+    int i;
+    rt_bool_t lost = RT_FALSE;
+    struct at_device_failover *failover = at_device_failover;
+
+    if (failover == RT_NULL || (device != failover->primary && device != failover->standby))
+    {
+        return;
+    }
+
+    if (netdev_is_link_up(failover->primary->netdev))
+    {
+        if (failover->active)
+        {
+            LOG_I("device(%s) link is up, fall back from %s.", failover->primary->name, failover->standby->name);
+            failover->active = RT_FALSE;
+            netdev_set_default(failover->primary->netdev);
+        }
+        return;
+    }
+
+    if (failover->active || netdev_is_link_up(failover->standby->netdev) == 0)
+    {
+        return;
+    }
+
+    LOG_I("device(%s) link is lost, fail over to %s.", failover->primary->name, failover->standby->name);
+    failover->active = RT_TRUE;
+    failover->lost_tick = rt_tick_get();
+    netdev_set_default(failover->standby->netdev);
+
+    /* the client sockets on the primary device will not be closed by the device */
+    for (i = 0; i < (int) failover->primary->class->socket_num; i++)
+    {
+        struct at_device_failover_peer *peer = &(failover->peers[i]);
+
+        /* the AT socket object may be reused by another connection */
+        if (peer->socket == RT_NULL || peer->socket->device != failover->primary ||
+                (int) peer->socket->user_data != i || peer->socket->state != AT_SOCKET_CONNECT)
+        {
+            continue;
+        }
+
+        peer->lost = RT_TRUE;
+        peer->closing = RT_TRUE;
+        at_device_socket_closed_notice(peer->socket);
+        /* the AT socket object is given back, only the endpoint is kept for the reconnect */
+        peer->socket = RT_NULL;
+        lost = RT_TRUE;
+    }
+
+    if (lost)
+    {
+        rt_event_send(&(failover->event), AT_DEVICE_FAILOVER_EVENT_LOST);
+    }
+}
+
+#endif /* AT_USING_SOCKET && AT_DEVICE_USING_FAILOVER */
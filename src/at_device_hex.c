@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.hex"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#ifdef AT_USING_SOCKET
+
+/*
+ * The socket data of some NB-IoT modules is carried as hex string in the AT
+ * command line and the receive URC. The data is encoded in a small buffer and
+ * streamed to the AT client, and decoded from the URC line into the receive
+ * buffer, so the hex string is never built in memory.
+ */
+
+/* The data bytes encoded at a time when the hex string is streamed */
+#ifndef AT_DEVICE_HEX_SEND_CHUNK
+#define AT_DEVICE_HEX_SEND_CHUNK       32
+#endif
+
+static const char at_device_hex_digits[] = "0123456789ABCDEF";
+
+/* The value of the hex digit by its character, the other characters are 0 */
+static const rt_uint8_t at_device_hex_values[256] =
+{
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  0,  0,  0,  0,  0,  0,
+     0, 10, 11, 12, 13, 14, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0, 10, 11, 12, 13, 14, 15,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+/**
+ * This function will encode the data to upper case hex string, the hex string
+ * is not terminated.
+ *
+ * @param hex the hex string buffer, its size must be 2 * size
+ * @param data the data to encode
+ * @param size the data size
+ */
+void at_device_hex_encode(char *hex, const void *data, rt_size_t size)
+{
+    rt_size_t i;
+    const rt_uint8_t *src = (const rt_uint8_t *) data;
+
+    for (i = 0; i < size; i++)
+    {
+        hex[2 * i] = at_device_hex_digits[src[i] >> 4];
+        hex[2 * i + 1] = at_device_hex_digits[src[i] & 0x0F];
+    }
+}
+
+/**
+ * This function will decode the hex string to data, upper and lower case
+ * digits are accepted. The data can be decoded in place of the hex string.
+ *
+ * @param data the data buffer, its size must be size
+ * @param hex the hex string, its length must be 2 * size
+ * @param size the data size to decode
+ *
+ * @return the data size decoded
+ */
+rt_size_t at_device_hex_decode(void *data, const char *hex, rt_size_t size)
+{
+    rt_size_t i;
+    rt_uint8_t *dst = (rt_uint8_t *) data;
+    const rt_uint8_t *src = (const rt_uint8_t *) hex;
+
+    for (i = 0; i < size; i++)
+    {
+        dst[i] = (rt_uint8_t) ((at_device_hex_values[src[2 * i]] << 4) | at_device_hex_values[src[2 * i + 1]]);
+    }
+
+    return size;
+}
+
+/**
+ * This function will send the data as hex string to the AT client of AT
+ * device, it's used between the head and the tail of an AT command, so the
+ * caller must hold the AT client lock over the whole command.
+ *
+ * @param device AT device object
+ * @param data the data to send
+ * @param size the data size
+ *
+ * @return the data size sent
+ */
+rt_size_t at_device_hex_send(struct at_device *device, const void *data, rt_size_t size)
+{
+    rt_size_t len = 0, sent = 0;
+    char hex[AT_DEVICE_HEX_SEND_CHUNK * 2];
+    const rt_uint8_t *src = (const rt_uint8_t *) data;
+
+    RT_ASSERT(device);
+
+    while (sent < size)
+    {
+        len = size - sent < AT_DEVICE_HEX_SEND_CHUNK ? size - sent : AT_DEVICE_HEX_SEND_CHUNK;
+
+        at_device_hex_encode(hex, src + sent, len);
+        if (at_client_obj_send(device->client, hex, len * 2) != len * 2)
+        {
+            LOG_E("%s device send hex data failed.", device->name);
+            break;
+        }
+
+        sent += len;
+    }
+
+    return sent;
+}
+
+/**
+ * This function will terminate the AT command line when its hex data was not
+ * sent completely, the modem rejects the broken line by ERROR and the ERROR is
+ * drained to the response object, so it isn't taken by the next command.
+ *
+ * @param device AT device object
+ * @param resp the response object of the broken command
+ *
+ * @return 0: the modem accepted the line
+ *        -1: the modem rejected the line or didn't answer
+ */
+int at_device_hex_abort(struct at_device *device, at_response_t resp)
+{
+    RT_ASSERT(device);
+
+    return at_device_exec_cmd(device, resp, "") < 0 ? -1 : 0;
+}
+
+#endif /* AT_USING_SOCKET */
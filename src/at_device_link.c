@@ -0,0 +1,508 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.link"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#ifdef AT_DEVICE_USING_LINK
+
+/*
+ * The network registration of the cellular modules is reported by the
+ * "+CGREG" and "+CEREG" URCs, and the link status of the network interface
+ * follows the reports. The registration is only queried by the link thread
+ * as a slow fallback, one thread serves all AT devices. The query answer has
+ * the same prefix as the report, so it's also taken by the URC and the
+ * registration is always read from the AT device. The signal is not
+ * reported, so the class query runs at a shorter interval of its own.
+ *
+ * The packet data context lost by the module takes the link down whatever the
+ * registration, the sockets of the device are noticed closed and the class
+ * activates the context again from the link thread, backing off on failure.
+ */
+
+/* The interval in milliseconds of the registration query fallback */
+#ifndef AT_DEVICE_LINK_POLL_TIME
+#define AT_DEVICE_LINK_POLL_TIME       (10 * 60 * 1000)
+#endif
+
+/* The interval in milliseconds of the class query, it reads the signal */
+#ifndef AT_DEVICE_LINK_SIGNAL_TIME
+#define AT_DEVICE_LINK_SIGNAL_TIME     (60 * 1000)
+#endif
+
+/* The delay in milliseconds of the first context activation after the loss, doubled on failure */
+#ifndef AT_DEVICE_LINK_RECOVER_TIME
+#define AT_DEVICE_LINK_RECOVER_TIME    1000
+#endif
+
+/* The maximum delay in milliseconds between the context activation attempts */
+#ifndef AT_DEVICE_LINK_RECOVER_MAX
+#define AT_DEVICE_LINK_RECOVER_MAX     (60 * 1000)
+#endif
+
+/* The network interface callbacks of aggregation and failover run in the link thread */
+#ifndef AT_DEVICE_LINK_THREAD_STACK_SIZE
+#define AT_DEVICE_LINK_THREAD_STACK_SIZE 2048
+#endif
+
+#ifndef AT_DEVICE_LINK_THREAD_PRIORITY
+#define AT_DEVICE_LINK_THREAD_PRIORITY (RT_THREAD_PRIORITY_MAX - 2)
+#endif
+
+/* The AT devices with the link status followed, append-only */
+static rt_slist_t at_device_link_list = RT_SLIST_OBJECT_INIT(at_device_link_list);
+/* The link thread is woken up when the registration of any AT device is reported */
+static rt_sem_t at_device_link_sem = RT_NULL;
+
+/**
+ * This function will mark the link status of AT device to be updated by the
+ * link thread. The mark is kept in the device, so no change is lost when the
+ * thread is busy. It's called in URC, the network interface callbacks may
+ * send AT commands, so they are not called here.
+ *
+ * @param device AT device object
+ */
+static void at_device_link_notice(struct at_device *device)
+{
+    if (device->link_watch && at_device_link_sem)
+    {
+        device->link_dirty = RT_TRUE;
+        rt_sem_release(at_device_link_sem);
+    }
+}
+
+static void at_device_link_urc_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int n = 0, stat = 0;
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_client(client);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return;
+    }
+
+    /* "+CxREG: <stat>[,...]" reports the change, "+CxREG: <n>,<stat>[,...]" answers the query */
+    if (rt_sscanf(data + sizeof("+CGREG:") - 1, "%d,%d", &n, &stat) == 1)
+    {
+        stat = n;
+    }
+
+    device->link_stat[data[2] == 'E' ? AT_DEVICE_LINK_EPS : AT_DEVICE_LINK_GPRS] = (rt_int8_t) stat;
+
+    at_device_link_notice(device);
+}
+
+static const struct at_urc at_device_link_urc_table[] =
+{
+    {"+CGREG:",     "\r\n",                 at_device_link_urc_func},
+    {"+CEREG:",     "\r\n",                 at_device_link_urc_func},
+};
+
+/**
+ * This function will set the link status of the AT device network interface
+ * by the registration reported, the device is linked when it's registered in
+ * either domain and the packet data context is not lost.
+ *
+ * @param device AT device object
+ */
+static void at_device_link_update(struct at_device *device)
+{
+    int i;
+    rt_bool_t is_link_up = RT_FALSE;
+
+    for (i = 0; i < AT_DEVICE_LINK_DOMAIN_NUM && device->link_lost == RT_FALSE; i++)
+    {
+        /* 1 registered, home network, 5 registered, roaming */
+        if (device->link_stat[i] == 1 || device->link_stat[i] == 5)
+        {
+            is_link_up = RT_TRUE;
+        }
+    }
+
+    if (device->netdev && netdev_is_link_up(device->netdev) != is_link_up)
+    {
+        LOG_D("%s device link %s.", device->name, is_link_up ? "up" : "down");
+        netdev_low_level_set_link_status(device->netdev, is_link_up);
+    }
+}
+
+/**
+ * This function will query the registration of AT device in the network
+ * domain, it's used in the class initialization and the fallback.
+ *
+ * @param device AT device object
+ * @param domain AT_DEVICE_LINK_GPRS or AT_DEVICE_LINK_EPS
+ *
+ * @return >=0: the registration status
+ *          -1: send AT commands error or the registration is not answered
+ *          -5: no memory
+ */
+int at_device_link_query(struct at_device *device, int domain)
+{
+    int result = RT_EOK;
+    at_response_t resp = RT_NULL;
+
+    RT_ASSERT(device);
+    RT_ASSERT(domain >= 0 && domain < AT_DEVICE_LINK_DOMAIN_NUM);
+
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    at_device_wake_get(device);
+
+    /* the answer is taken by the URC before the command returns */
+    device->link_stat[domain] = -1;
+    if (at_obj_exec_cmd(device->client, resp, domain == AT_DEVICE_LINK_EPS ? "AT+CEREG?" : "AT+CGREG?") != RT_EOK)
+    {
+        result = -RT_ERROR;
+    }
+    else
+    {
+        result = device->link_stat[domain] < 0 ? -RT_ERROR : device->link_stat[domain];
+    }
+
+    at_device_wake_put(device);
+    at_device_resp_put(device, resp);
+
+    return result;
+}
+
+/**
+ * This function will query the registration of the AT device when nothing
+ * is reported for the fallback interval, the last reported registration is
+ * kept if the module doesn't answer.
+ *
+ * @param device AT device object
+ */
+static void at_device_link_poll(struct at_device *device)
+{
+    int i;
+    rt_int8_t link_stat[AT_DEVICE_LINK_DOMAIN_NUM];
+
+    rt_memcpy(link_stat, device->link_stat, sizeof(link_stat));
+
+    for (i = 0; i < AT_DEVICE_LINK_DOMAIN_NUM; i++)
+    {
+        if (at_device_link_query(device, i) < 0)
+        {
+            device->link_stat[i] = link_stat[i];
+        }
+    }
+
+    at_device_link_update(device);
+}
+
+/**
+ * This function will get the ticks left of the interval.
+ *
+ * @param start the tick of the interval start
+ * @param interval the interval in ticks
+ *
+ * @return the ticks left, 0 for the interval is over
+ */
+static rt_tick_t at_device_link_left(rt_tick_t start, rt_tick_t interval)
+{
+    rt_tick_t elapsed = rt_tick_get() - start;
+
+    return elapsed < interval ? interval - elapsed : 0;
+}
+
+/**
+ * This function will notice the sockets of AT device closed when its packet
+ * data context is lost, the module drops them without any report. It's called
+ * after the link status update, so the failover takes its sockets first.
+ *
+ * @param device AT device object
+ */
+static void at_device_link_close(struct at_device *device)
+{
+#ifdef AT_USING_SOCKET
+    int i;
+
+    for (i = 0; i < (int) device->class->socket_num; i++)
+    {
+        if (device->sockets[i].state == AT_SOCKET_CONNECT)
+        {
+            at_device_socket_closed_notice(&(device->sockets[i]));
+        }
+    }
+#endif
+}
+
+/**
+ * This function will activate the lost packet data context of AT device by
+ * the class, the link status follows the registration again on success and
+ * the delay of the next attempt is doubled on failure.
+ *
+ * @param device AT device object
+ */
+static void at_device_link_recover(struct at_device *device)
+{
+    int result = RT_EOK;
+    rt_tick_t recover_max = rt_tick_from_millisecond(AT_DEVICE_LINK_RECOVER_MAX);
+
+    at_device_wake_get(device);
+    result = device->link_recover(device);
+    at_device_wake_put(device);
+
+    if (result == RT_EOK)
+    {
+        LOG_I("%s device packet data context is activated again.", device->name);
+        device->link_lost = RT_FALSE;
+        device->link_recover_delay = rt_tick_from_millisecond(AT_DEVICE_LINK_RECOVER_TIME);
+        at_device_link_update(device);
+        return;
+    }
+
+    device->link_recover_delay = device->link_recover_delay < recover_max / 2 ?
+            device->link_recover_delay * 2 : recover_max;
+    device->link_recover_tick = rt_tick_get();
+
+    LOG_W("%s device packet data context activation failed(%d), retry in %d ms.",
+            device->name, result, device->link_recover_delay * 1000 / RT_TICK_PER_SECOND);
+}
+
+static void at_device_link_thread_entry(void *parameter)
+{
+    rt_base_t level;
+    rt_bool_t dirty = RT_FALSE;
+    rt_slist_t *node = RT_NULL;
+    rt_tick_t poll_tick = rt_tick_get();
+    rt_tick_t signal_tick = poll_tick;
+    rt_tick_t poll_interval = rt_tick_from_millisecond(AT_DEVICE_LINK_POLL_TIME);
+    rt_tick_t signal_interval = rt_tick_from_millisecond(AT_DEVICE_LINK_SIGNAL_TIME);
+    rt_tick_t poll_left = 0, signal_left = 0, wait = 0;
+    struct at_device *device = RT_NULL;
+
+    while (1)
+    {
+        poll_left = at_device_link_left(poll_tick, poll_interval);
+        signal_left = at_device_link_left(signal_tick, signal_interval);
+        wait = poll_left < signal_left ? poll_left : signal_left;
+
+        /* the lost devices wake the thread up for the next activation attempt */
+        rt_slist_for_each(node, &at_device_link_list)
+        {
+            device = rt_slist_entry(node, struct at_device, link_list);
+            if (device->link_lost && device->link_recover &&
+                    at_device_link_left(device->link_recover_tick, device->link_recover_delay) < wait)
+            {
+                wait = at_device_link_left(device->link_recover_tick, device->link_recover_delay);
+            }
+        }
+
+        if (wait)
+        {
+            rt_sem_take(at_device_link_sem, wait);
+        }
+
+        /* the reported devices, the marks are taken before the update so a report in the meantime is kept */
+        rt_slist_for_each(node, &at_device_link_list)
+        {
+            device = rt_slist_entry(node, struct at_device, link_list);
+
+            level = rt_hw_interrupt_disable();
+            dirty = device->link_dirty;
+            device->link_dirty = RT_FALSE;
+            rt_hw_interrupt_enable(level);
+
+            if (dirty)
+            {
+                at_device_link_update(device);
+                if (device->link_lost)
+                {
+                    at_device_link_close(device);
+                }
+            }
+
+            if (device->link_lost && device->link_recover &&
+                    at_device_link_left(device->link_recover_tick, device->link_recover_delay) == 0)
+            {
+                at_device_link_recover(device);
+            }
+        }
+
+        if (at_device_link_left(poll_tick, poll_interval) == 0)
+        {
+            rt_slist_for_each(node, &at_device_link_list)
+            {
+                at_device_link_poll(rt_slist_entry(node, struct at_device, link_list));
+            }
+            poll_tick = rt_tick_get();
+        }
+
+        if (at_device_link_left(signal_tick, signal_interval) == 0)
+        {
+            rt_slist_for_each(node, &at_device_link_list)
+            {
+                device = rt_slist_entry(node, struct at_device, link_list);
+                if (device->link_poll)
+                {
+                    device->link_poll(device);
+                }
+            }
+            signal_tick = rt_tick_get();
+        }
+    }
+}
+
+/**
+ * This function will register the registration URCs on the AT client of AT
+ * device, the registration queries are answered to the URCs from then on.
+ * It's called by the class initialization.
+ *
+ * @param device AT device object
+ *
+ * @return 0: register success
+ */
+int at_device_link_init(struct at_device *device)
+{
+    int i;
+
+    RT_ASSERT(device);
+
+    for (i = 0; i < AT_DEVICE_LINK_DOMAIN_NUM; i++)
+    {
+        device->link_stat[i] = -1;
+    }
+
+    at_obj_set_urc_table(device->client, at_device_link_urc_table,
+            sizeof(at_device_link_urc_table) / sizeof(at_device_link_urc_table[0]));
+
+    return RT_EOK;
+}
+
+/**
+ * This function will start following the link status of AT device by the
+ * registration reports, it's called when the class network initialization
+ * succeeds. The link thread is created on first use.
+ *
+ * @param device AT device object
+ * @param poll the class query at the signal interval, RT_NULL for none
+ * @param recover the class activation of the lost packet data context, RT_NULL for none
+ *
+ * @return  0: start success
+ *         -1: create the link thread failed
+ *         -5: no memory
+ */
+int at_device_link_watch(struct at_device *device, int (*poll)(struct at_device *device),
+                         int (*recover)(struct at_device *device))
+{
+    int i;
+    rt_base_t level;
+    rt_thread_t tid = RT_NULL;
+    at_response_t resp = RT_NULL;
+
+    RT_ASSERT(device);
+
+    if (at_device_link_sem == RT_NULL)
+    {
+        at_device_link_sem = rt_sem_create("at_link", 0, RT_IPC_FLAG_FIFO);
+        if (at_device_link_sem == RT_NULL)
+        {
+            LOG_E("no memory for AT device link semaphore create.");
+            return -RT_ENOMEM;
+        }
+
+        tid = rt_thread_create("at_link", at_device_link_thread_entry, RT_NULL,
+                AT_DEVICE_LINK_THREAD_STACK_SIZE, AT_DEVICE_LINK_THREAD_PRIORITY, 20);
+        if (tid == RT_NULL)
+        {
+            rt_sem_delete(at_device_link_sem);
+            at_device_link_sem = RT_NULL;
+            LOG_E("create AT device link thread failed.");
+            return -RT_ERROR;
+        }
+        rt_thread_startup(tid);
+    }
+
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    /* enable the registration reports, the module may support only one domain */
+    at_device_wake_get(device);
+    if (at_obj_exec_cmd(device->client, resp, "AT+CGREG=1") != RT_EOK)
+    {
+        LOG_D("%s device GPRS registration report is not supported.", device->name);
+    }
+    if (at_obj_exec_cmd(device->client, resp, "AT+CEREG=1") != RT_EOK)
+    {
+        LOG_D("%s device EPS registration report is not supported.", device->name);
+    }
+    at_device_wake_put(device);
+    at_device_resp_put(device, resp);
+
+    for (i = 0; i < AT_DEVICE_LINK_DOMAIN_NUM; i++)
+    {
+        at_device_link_query(device, i);
+    }
+
+    device->link_poll = poll;
+    device->link_recover = recover;
+    /* the packet data context is activated by the class before the watch */
+    device->link_lost = RT_FALSE;
+    if (device->link_watch == RT_FALSE)
+    {
+        rt_slist_init(&(device->link_list));
+
+        level = rt_hw_interrupt_disable();
+        rt_slist_append(&at_device_link_list, &(device->link_list));
+        device->link_watch = RT_TRUE;
+        rt_hw_interrupt_enable(level);
+    }
+
+    at_device_link_notice(device);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will notice that the packet data context of AT device is
+ * lost, it's called by the class URC. All sockets are lost with the context,
+ * so the link is down whatever the registration reports until the class
+ * activates the context again, by the recovery of the link thread or by
+ * watching the device again.
+ *
+ * @param device AT device object
+ */
+void at_device_link_lost(struct at_device *device)
+{
+    RT_ASSERT(device);
+
+    if (device->link_lost == RT_FALSE)
+    {
+        device->link_recover_tick = rt_tick_get();
+        device->link_recover_delay = rt_tick_from_millisecond(AT_DEVICE_LINK_RECOVER_TIME);
+    }
+    device->link_lost = RT_TRUE;
+
+    at_device_link_notice(device);
+}
+
+#endif /* AT_DEVICE_USING_LINK */
@@ -0,0 +1,444 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <at_device_dialect.h>
+
+#define DBG_TAG              "at.pull"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#ifdef AT_DEVICE_USING_PULL
+
+/*
+ * In pull-mode receive the module keeps the socket data in its buffer and only
+ * notices that the socket is readable. The URC handler marks the socket and the
+ * pull thread reads the data by the class read command, one receive buffer at
+ * a time, when a receive buffer is free. The read response is taken by the
+ * class URC with at_device_pull_recv().
+ */
+
+#ifndef AT_DEVICE_PULL_THREAD_STACK_SIZE
+#define AT_DEVICE_PULL_THREAD_STACK_SIZE 2048
+#endif
+
+#ifndef AT_DEVICE_PULL_THREAD_PRIORITY
+#define AT_DEVICE_PULL_THREAD_PRIORITY (RT_THREAD_PRIORITY_MAX / 2)
+#endif
+
+/* The delay in milliseconds before the pull is retried when no receive buffer is free,
+ * it's doubled for every failed read in a row */
+#ifndef AT_DEVICE_PULL_RETRY_DELAY
+#define AT_DEVICE_PULL_RETRY_DELAY     100
+#endif
+
+/* The number of failed reads in a row before the socket data is left in the module */
+#ifndef AT_DEVICE_PULL_RETRY_NUM
+#define AT_DEVICE_PULL_RETRY_NUM       5
+#endif
+
+/* The AT devices waiting for pull-mode receive, served by the pull thread */
+static rt_slist_t at_device_pull_list = RT_SLIST_OBJECT_INIT(at_device_pull_list);
+static rt_sem_t at_device_pull_sem = RT_NULL;
+
+/**
+ * This function will mark or clear the data buffered in the module for the
+ * device socket.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ * @param pending RT_TRUE: data is buffered
+ *
+ * @return the sockets with data buffered before the change
+ */
+static rt_uint32_t at_device_pull_pending_set(struct at_device *device, int device_socket, rt_bool_t pending)
+{
+    rt_base_t level;
+    rt_uint32_t recv_pending = 0;
+
+    level = rt_hw_interrupt_disable();
+    recv_pending = device->recv_pending;
+    if (pending)
+    {
+        device->recv_pending |= (1UL << device_socket);
+    }
+    else
+    {
+        device->recv_pending &= ~(1UL << device_socket);
+    }
+    rt_hw_interrupt_enable(level);
+
+    return recv_pending;
+}
+
+/**
+ * This function will queue the AT device to the pull thread. Every device is
+ * linked in the queue at most once, so the queue is never full and the marks
+ * are never dropped.
+ *
+ * @param device AT device object
+ */
+static void at_device_pull_queue(struct at_device *device)
+{
+    rt_base_t level;
+    rt_bool_t queued = RT_FALSE;
+
+    level = rt_hw_interrupt_disable();
+    if (device->pull_queued == RT_FALSE)
+    {
+        rt_slist_init(&(device->pull_list));
+        rt_slist_append(&at_device_pull_list, &(device->pull_list));
+        device->pull_queued = RT_TRUE;
+        queued = RT_TRUE;
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (queued)
+    {
+        rt_sem_release(at_device_pull_sem);
+    }
+}
+
+/* Take the first AT device out of the pull thread queue */
+static struct at_device *at_device_pull_dequeue(void)
+{
+    rt_base_t level;
+    rt_slist_t *node = RT_NULL;
+    struct at_device *device = RT_NULL;
+
+    level = rt_hw_interrupt_disable();
+    node = rt_slist_first(&at_device_pull_list);
+    if (node)
+    {
+        rt_slist_remove(&at_device_pull_list, node);
+        device = rt_slist_entry(node, struct at_device, pull_list);
+        device->pull_queued = RT_FALSE;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return device;
+}
+
+/**
+ * This function will get AT socket object by device socket descriptor.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ *
+ * @return AT socket object
+ */
+static struct at_socket *at_device_pull_socket_get(struct at_device *device, int device_socket)
+{
+#ifdef AT_USING_SOCKET_SERVER
+    /* the accepted sockets of server are not in the device socket array */
+    if (device->class->dialect && device->class->dialect->connected_urc)
+    {
+        return at_get_base_socket(device_socket);
+    }
+#endif
+
+    return &(device->sockets[device_socket]);
+}
+
+/**
+ * This function will notice the pull-mode receive that the module has data
+ * buffered for the device socket, the data is read in the pull thread. It's
+ * called by the class URC, which must not send AT commands itself.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ *
+ * @return  0: notice success
+ *         -1: the device socket is invalid or the pull thread is not created
+ */
+int at_device_pull_notice(struct at_device *device, int device_socket)
+{
+    if (at_device_pull_sem == RT_NULL || device_socket < 0 ||
+            device_socket >= (int) device->class->socket_num || device_socket >= 32)
+    {
+        return -RT_ERROR;
+    }
+
+    at_device_pull_pending_set(device, device_socket, RT_TRUE);
+    at_device_pull_queue(device);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will drop the pull-mode receive mark of the device socket,
+ * the data buffered in the module is dropped with the connection.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ */
+void at_device_pull_clear(struct at_device *device, int device_socket)
+{
+    if (device_socket < 0 || device_socket >= 32)
+    {
+        return;
+    }
+
+    at_device_pull_pending_set(device, device_socket, RT_FALSE);
+}
+
+/**
+ * This function will take the data of the read response into the receive
+ * buffer of the read in progress, it's called by the class read response URC
+ * after the response header. The data more than the receive buffer or not
+ * asked by a read is dropped.
+ *
+ * @param device AT device object
+ * @param size the data size of the read response
+ *
+ * @return the size of data taken
+ */
+rt_size_t at_device_pull_recv(struct at_device *device, rt_size_t size)
+{
+    rt_int32_t timeout = 0;
+    rt_size_t read_size = 0, temp_size = 0;
+    char temp[8] = {0};
+    struct at_client *client = device->client;
+
+    /* set receive timeout by receive buffer length, not less than 10ms */
+    timeout = size > 10 ? size : 10;
+
+    if (device->pull_buf)
+    {
+        read_size = size < device->pull_size ? size : device->pull_size;
+        device->pull_len = at_client_obj_recv(client, device->pull_buf, read_size, timeout);
+    }
+
+    /* read and clean the data not asked by the read in progress */
+    temp_size = read_size;
+    while (temp_size < size)
+    {
+        if (size - temp_size > sizeof(temp))
+        {
+            at_client_obj_recv(client, temp, sizeof(temp), timeout);
+        }
+        else
+        {
+            at_client_obj_recv(client, temp, size - temp_size, timeout);
+        }
+        temp_size += sizeof(temp);
+    }
+
+    return device->pull_buf ? device->pull_len : 0;
+}
+
+/**
+ * This function will read the data buffered in the module for the device
+ * socket by the class read command.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ * @param buf receive buffer
+ * @param size receive buffer size
+ *
+ * @return >=0: the size of data read
+ *          -1: send AT commands error
+ *          -5: no memory
+ */
+static int at_device_pull_read(struct at_device *device, int device_socket, char *buf, rt_size_t size)
+{
+    int result = RT_EOK;
+    rt_mutex_t lock = at_device_get_client_lock(device);
+
+    /* the read response URC can only come while the read command holds the client */
+    rt_mutex_take(lock, RT_WAITING_FOREVER);
+
+    device->pull_buf = buf;
+    device->pull_size = size;
+    device->pull_len = 0;
+
+    result = device->class->pull_read(device, device_socket, size);
+    if (result == RT_EOK)
+    {
+        result = (int) device->pull_len;
+    }
+
+    device->pull_buf = RT_NULL;
+
+    rt_mutex_release(lock);
+
+    return result;
+}
+
+/**
+ * This function will read the data buffered in the module for all sockets of
+ * AT device, one receive buffer is read at a time so the memory is bounded.
+ * The socket whose read failed is marked again and the pull is retried, the
+ * module keeps the data until it's read.
+ *
+ * @param device AT device object
+ *
+ * @return  0: all sockets are drained
+ *         -2: the read failed, the pull should be retried
+ *         -5: no receive buffer, the pull should be retried
+ */
+static int at_device_pull(struct at_device *device)
+{
+    int i, len = 0;
+    rt_size_t mtu = 0;
+    rt_bool_t more = RT_FALSE;
+    char *recv_buf = RT_NULL;
+    struct at_socket *socket = RT_NULL;
+
+    mtu = device->class->recv_mtu ? device->class->recv_mtu : AT_DEVICE_RECV_POOL_MTU;
+
+    /* the notices during the pull are taken by the scan again until no mark is left */
+    while (device->recv_pending)
+    {
+        for (i = 0; i < (int) device->class->socket_num && i < 32; i++)
+        {
+            /* the pending mark is cleared first so a notice during the read is not lost,
+             * after a full buffer the socket is read again for the data may be left */
+            more = RT_FALSE;
+            while ((at_device_pull_pending_set(device, i, RT_FALSE) & (1UL << i)) || more)
+            {
+                recv_buf = (char *) at_device_recv_buf_alloc(device, mtu);
+                if (recv_buf == RT_NULL)
+                {
+                    at_device_pull_pending_set(device, i, RT_TRUE);
+                    return -RT_ENOMEM;
+                }
+
+                len = at_device_pull_read(device, i, recv_buf, mtu);
+                if (len < 0 && more)
+                {
+                    /* some modules refuse the read of an empty buffer */
+                    rt_free(recv_buf);
+                    more = RT_FALSE;
+                    continue;
+                }
+                else if (len < 0)
+                {
+                    rt_free(recv_buf);
+
+                    if (++device->pull_retries > AT_DEVICE_PULL_RETRY_NUM)
+                    {
+                        LOG_W("device(%s) socket(%d) read failed %d times, the data is left in the module.",
+                                device->name, i, AT_DEVICE_PULL_RETRY_NUM);
+                        device->pull_retries = 0;
+                        continue;
+                    }
+
+                    /* the data is still buffered in the module, the read is retried */
+                    at_device_pull_pending_set(device, i, RT_TRUE);
+                    return -RT_ETIMEOUT;
+                }
+
+                device->pull_retries = 0;
+                more = (len == (int) mtu) ? RT_TRUE : RT_FALSE;
+                if (len == 0)
+                {
+                    rt_free(recv_buf);
+                    continue;
+                }
+
+                socket = at_device_pull_socket_get(device, i);
+                at_device_socket_recv_notice(device, socket, recv_buf, len);
+            }
+        }
+    }
+
+    return RT_EOK;
+}
+
+static void at_device_pull_thread_entry(void *parameter)
+{
+    int result = 0;
+    struct at_device *device = RT_NULL;
+
+    while (1)
+    {
+        if (rt_sem_take(at_device_pull_sem, RT_WAITING_FOREVER) != RT_EOK)
+        {
+            continue;
+        }
+
+        device = at_device_pull_dequeue();
+        if (device == RT_NULL)
+        {
+            continue;
+        }
+
+        result = at_device_pull(device);
+        if (result == -RT_ENOMEM)
+        {
+            /* wait for the application to take the received data */
+            rt_thread_mdelay(AT_DEVICE_PULL_RETRY_DELAY);
+            at_device_pull_queue(device);
+        }
+        else if (result == -RT_ETIMEOUT)
+        {
+            /* back off while the module doesn't answer the read */
+            rt_thread_mdelay(AT_DEVICE_PULL_RETRY_DELAY << (device->pull_retries - 1));
+            at_device_pull_queue(device);
+        }
+    }
+}
+
+/**
+ * This function will start the pull-mode receive of AT device, the pull
+ * thread is created on first use.
+ *
+ * @param device AT device object
+ *
+ * @return  0: start success
+ *         -1: the device class has no read command or create the pull thread failed
+ *         -5: no memory
+ */
+int at_device_pull_init(struct at_device *device)
+{
+    rt_thread_t tid = RT_NULL;
+
+    RT_ASSERT(device);
+
+    if (device->class->pull_read == RT_NULL)
+    {
+        LOG_E("device(%s) has no pull-mode read.", device->name);
+        return -RT_ERROR;
+    }
+
+    device->pull_queued = RT_FALSE;
+    device->pull_retries = 0;
+    rt_slist_init(&(device->pull_list));
+
+    if (at_device_pull_sem)
+    {
+        return RT_EOK;
+    }
+
+    at_device_pull_sem = rt_sem_create("at_pull", 0, RT_IPC_FLAG_FIFO);
+    if (at_device_pull_sem == RT_NULL)
+    {
+        LOG_E("no memory for AT device pull queue create.");
+        return -RT_ENOMEM;
+    }
+
+    tid = rt_thread_create("at_pull", at_device_pull_thread_entry, RT_NULL,
+            AT_DEVICE_PULL_THREAD_STACK_SIZE, AT_DEVICE_PULL_THREAD_PRIORITY, 20);
+    if (tid == RT_NULL)
+    {
+        rt_sem_delete(at_device_pull_sem);
+        at_device_pull_sem = RT_NULL;
+        LOG_E("create AT device pull thread failed.");
+        return -RT_ERROR;
+    }
+    rt_thread_startup(tid);
+
+    return RT_EOK;
+}
+
+#endif /* AT_DEVICE_USING_PULL */
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.slp"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+/* The response timeout in milliseconds of one readiness probe */
+#ifndef AT_DEVICE_READY_PROBE_TIME
+#define AT_DEVICE_READY_PROBE_TIME     50
+#endif
+
+/**
+ * This function will wait until the AT device answers, it's used after the
+ * module is woken up. The "AT" probe is repeated with a short response
+ * timeout, so the wait ends as soon as the module is ready.
+ *
+ * @param device AT device object
+ * @param timeout the maximum time in milliseconds to wait
+ *
+ * @return  0: the device is ready
+ *         -2: the device doesn't answer in time
+ *         -5: no memory
+ */
+int at_device_ready_wait(struct at_device *device, rt_int32_t timeout)
+{
+    int result = -RT_ETIMEOUT;
+    rt_tick_t start = rt_tick_get();
+    at_response_t resp = RT_NULL;
+
+    RT_ASSERT(device);
+
+    resp = at_device_resp_get(device, 64, 0, rt_tick_from_millisecond(AT_DEVICE_READY_PROBE_TIME));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return -RT_ENOMEM;
+    }
+
+    do
+    {
+        if (at_obj_exec_cmd(device->client, resp, "AT") == RT_EOK)
+        {
+            result = RT_EOK;
+            break;
+        }
+    } while (rt_tick_get() - start < rt_tick_from_millisecond(timeout));
+
+    at_device_resp_put(device, resp);
+
+    return result;
+}
+
+#if defined(AT_USING_SOCKET) && defined(AT_DEVICE_USING_AUTO_SLEEP)
+
+/*
+ * The auto sleep counts the AT commands and socket operations in flight on
+ * the AT device. The module is woken up by the class wakeup control before
+ * the first one, and put into sleep by the class sleep control when none is
+ * in flight for the idle time. The sleep state is changed with the AT client
+ * lock held, so no command is sent while the module goes to sleep.
+ */
+
+/* The number of AT devices waiting for sleep */
+#ifndef AT_DEVICE_SLEEP_REQ_NUM
+#define AT_DEVICE_SLEEP_REQ_NUM        4
+#endif
+
+#ifndef AT_DEVICE_SLEEP_THREAD_STACK_SIZE
+#define AT_DEVICE_SLEEP_THREAD_STACK_SIZE 1024
+#endif
+
+#ifndef AT_DEVICE_SLEEP_THREAD_PRIORITY
+#define AT_DEVICE_SLEEP_THREAD_PRIORITY (RT_THREAD_PRIORITY_MAX / 2)
+#endif
+
+/* The AT devices idle for the idle time, served by the sleep thread */
+static rt_mq_t at_device_sleep_mq = RT_NULL;
+
+/**
+ * This function will put the AT device into sleep when nothing is in flight
+ * for the idle time.
+ *
+ * @param device AT device object
+ */
+static void at_device_sleep_enter(struct at_device *device)
+{
+    rt_mutex_t lock = at_device_get_client_lock(device);
+
+    rt_mutex_take(lock, RT_WAITING_FOREVER);
+
+    if (device->sleep_idle && device->wake_refs == 0 && device->sleeping == RT_FALSE &&
+            rt_tick_get() - device->active_tick >= rt_tick_from_millisecond(device->sleep_idle))
+    {
+        /* the sleep state is kept by at_device_control() */
+        if (at_device_control(device, AT_DEVICE_CTRL_SLEEP, RT_NULL) == RT_EOK)
+        {
+            AT_DEVICE_STATS_INC(device, sleeps);
+        }
+    }
+
+    rt_mutex_release(lock);
+}
+
+static void at_device_sleep_timeout(void *parameter)
+{
+    struct at_device *device = (struct at_device *) parameter;
+
+    rt_mq_send(at_device_sleep_mq, &device, sizeof(device));
+}
+
+static void at_device_sleep_thread_entry(void *parameter)
+{
+    struct at_device *device = RT_NULL;
+
+    while (1)
+    {
+        if (rt_mq_recv(at_device_sleep_mq, &device, sizeof(device), RT_WAITING_FOREVER) < 0)
+        {
+            continue;
+        }
+
+        at_device_sleep_enter(device);
+    }
+}
+
+/**
+ * This function will count an AT command or socket operation in flight on
+ * the AT device, the module is woken up if it's put into sleep.
+ *
+ * @param device AT device object
+ */
+void at_device_wake_get(struct at_device *device)
+{
+    rt_tick_t start = 0;
+    rt_mutex_t lock = at_device_get_client_lock(device);
+
+    rt_mutex_take(lock, RT_WAITING_FOREVER);
+
+    device->wake_refs++;
+    if (device->sleeping)
+    {
+        start = rt_tick_get();
+        if (at_device_control(device, AT_DEVICE_CTRL_WAKEUP, RT_NULL) != RT_EOK)
+        {
+            /* the device is still taken as sleeping, the wake up is tried again by the next operation */
+            LOG_W("%s device wake up failed.", device->name);
+        }
+        else
+        {
+            AT_DEVICE_STATS_INC(device, wakeups);
+            AT_DEVICE_STATS_ADD(device, wake_time, (rt_tick_get() - start) * 1000 / RT_TICK_PER_SECOND);
+        }
+    }
+
+    rt_mutex_release(lock);
+}
+
+/**
+ * This function will end an AT command or socket operation in flight on the
+ * AT device, the idle time starts when the last one ends.
+ *
+ * @param device AT device object
+ */
+void at_device_wake_put(struct at_device *device)
+{
+    rt_mutex_t lock = at_device_get_client_lock(device);
+
+    rt_mutex_take(lock, RT_WAITING_FOREVER);
+
+    if (device->wake_refs > 0 && --device->wake_refs == 0)
+    {
+        device->active_tick = rt_tick_get();
+        if (device->sleep_idle && device->sleep_timer)
+        {
+            rt_timer_start(device->sleep_timer);
+        }
+    }
+
+    rt_mutex_release(lock);
+}
+
+/**
+ * This function will end an AT command executed by at_device_exec_cmd().
+ *
+ * @param device AT device object
+ * @param result the AT command execute result
+ *
+ * @return the AT command execute result
+ */
+int at_device_cmd_end(struct at_device *device, int result)
+{
+    at_device_wake_put(device);
+
+    return at_device_stats_cmd(device, result);
+}
+
+/**
+ * This function will set the auto sleep idle time of AT device, the class
+ * must support the sleep and wakeup controls. The sleep thread is created on
+ * first use.
+ *
+ * @param device AT device object
+ * @param idle_time the idle time in milliseconds before sleep, 0 to disable auto sleep
+ *
+ * @return  0: set success
+ *         -1: create the sleep thread or timer failed
+ *         -5: no memory
+ */
+int at_device_auto_sleep_set(struct at_device *device, rt_uint32_t idle_time)
+{
+    rt_thread_t tid = RT_NULL;
+    rt_tick_t tick = rt_tick_from_millisecond(idle_time);
+    rt_mutex_t lock = RT_NULL;
+
+    RT_ASSERT(device);
+
+    if (at_device_sleep_mq == RT_NULL)
+    {
+        at_device_sleep_mq = rt_mq_create("at_slp", sizeof(struct at_device *), AT_DEVICE_SLEEP_REQ_NUM, RT_IPC_FLAG_FIFO);
+        if (at_device_sleep_mq == RT_NULL)
+        {
+            LOG_E("no memory for AT device sleep queue create.");
+            return -RT_ENOMEM;
+        }
+
+        tid = rt_thread_create("at_slp", at_device_sleep_thread_entry, RT_NULL,
+                AT_DEVICE_SLEEP_THREAD_STACK_SIZE, AT_DEVICE_SLEEP_THREAD_PRIORITY, 20);
+        if (tid == RT_NULL)
+        {
+            rt_mq_delete(at_device_sleep_mq);
+            at_device_sleep_mq = RT_NULL;
+            LOG_E("create AT device sleep thread failed.");
+            return -RT_ERROR;
+        }
+        rt_thread_startup(tid);
+    }
+
+    lock = at_device_get_client_lock(device);
+    rt_mutex_take(lock, RT_WAITING_FOREVER);
+
+    if (device->sleep_timer == RT_NULL)
+    {
+        device->sleep_timer = rt_timer_create("at_slp", at_device_sleep_timeout, device,
+                tick ? tick : 1, RT_TIMER_FLAG_ONE_SHOT);
+        if (device->sleep_timer == RT_NULL)
+        {
+            rt_mutex_release(lock);
+            LOG_E("create AT device(%s) sleep timer failed.", device->name);
+            return -RT_ERROR;
+        }
+    }
+
+    rt_timer_stop(device->sleep_timer);
+    device->sleep_idle = idle_time;
+
+    if (idle_time == 0)
+    {
+        /* the module is left awake when auto sleep is disabled */
+        if (device->sleeping && at_device_control(device, AT_DEVICE_CTRL_WAKEUP, RT_NULL) == RT_EOK)
+        {
+            device->sleeping = RT_FALSE;
+        }
+    }
+    else
+    {
+        rt_timer_control(device->sleep_timer, RT_TIMER_CTRL_SET_TIME, &tick);
+        if (device->wake_refs == 0)
+        {
+            device->active_tick = rt_tick_get();
+            rt_timer_start(device->sleep_timer);
+        }
+    }
+
+    rt_mutex_release(lock);
+
+    return RT_EOK;
+}
+
+#endif /* AT_USING_SOCKET && AT_DEVICE_USING_AUTO_SLEEP */
@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.upl"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#if defined(AT_USING_SOCKET) && defined(AT_DEVICE_USING_UPLINK)
+
+/*
+ * The radio of the power saving modules sleeps between the active windows, and
+ * every datagram sent in sleep wakes it up. The uplink scheduler queues the UDP
+ * datagrams while the radio sleeps and sends them together when the module
+ * reports the radio is active, or when the oldest datagram waited the maximum
+ * delay. The class reports the radio state from its URC by
+ * at_device_uplink_notice().
+ */
+
+/* The maximum bytes of the datagrams waiting for the active window */
+#ifndef AT_DEVICE_UPLINK_QUEUE_SIZE
+#define AT_DEVICE_UPLINK_QUEUE_SIZE    1024
+#endif
+
+/* The maximum delay in milliseconds of a datagram waiting for the active window */
+#ifndef AT_DEVICE_UPLINK_MAX_DELAY
+#define AT_DEVICE_UPLINK_MAX_DELAY     60000
+#endif
+
+/* The number of AT devices waiting for the uplink flush */
+#ifndef AT_DEVICE_UPLINK_REQ_NUM
+#define AT_DEVICE_UPLINK_REQ_NUM       4
+#endif
+
+#ifndef AT_DEVICE_UPLINK_THREAD_STACK_SIZE
+#define AT_DEVICE_UPLINK_THREAD_STACK_SIZE 2048
+#endif
+
+#ifndef AT_DEVICE_UPLINK_THREAD_PRIORITY
+#define AT_DEVICE_UPLINK_THREAD_PRIORITY (RT_THREAD_PRIORITY_MAX / 2)
+#endif
+
+/* AT device uplink datagram, the data follows the header */
+struct at_device_uplink_pkt
+{
+    rt_slist_t list;
+    struct at_socket *socket;
+    int device_socket;
+    rt_size_t len;
+};
+
+/* AT device uplink scheduler */
+struct at_device_uplink
+{
+    struct rt_mutex lock;                        /* The lock of queue and datagram sends */
+    struct rt_timer timer;                       /* The maximum delay of the oldest datagram */
+    rt_slist_t queue;                            /* The datagrams waiting for the active window */
+    rt_size_t queued;                            /* The bytes waiting for the active window */
+    rt_bool_t active;                            /* The radio is active */
+    rt_uint32_t closed;                          /* The sockets closed by remote, their datagrams are dropped */
+    rt_tick_t start;                             /* The tick of scheduler start */
+    struct at_device_uplink_stats stats;
+};
+
+/* The AT devices waiting for the uplink flush, served by the uplink thread */
+static rt_mq_t at_device_uplink_mq = RT_NULL;
+
+/**
+ * This function will send the datagram by the class send operation.
+ *
+ * @param device AT device object
+ * @param socket AT socket object
+ * @param buff datagram buffer
+ * @param bfsz datagram size
+ *
+ * @return the result of the class send operation
+ */
+static int at_device_uplink_xmit(struct at_device *device, struct at_socket *socket, const char *buff, size_t bfsz)
+{
+    int result = 0;
+    struct at_device_uplink *uplink = device->uplink;
+
+    result = device->class->send(socket, buff, bfsz, AT_SOCKET_UDP);
+    if (result > 0)
+    {
+        uplink->stats.datagrams++;
+        uplink->stats.bytes += result;
+    }
+
+    return result;
+}
+
+/**
+ * This function will check whether the device socket of the datagram is
+ * closed by remote, the socket object may be taken by a new connection.
+ *
+ * @param uplink AT device uplink scheduler
+ * @param device_socket device socket descriptor
+ *
+ * @return RT_TRUE: the socket is closed
+ */
+static rt_bool_t at_device_uplink_is_closed(struct at_device_uplink *uplink, int device_socket)
+{
+    return device_socket < 32 && (uplink->closed & (1UL << device_socket)) ? RT_TRUE : RT_FALSE;
+}
+
+/**
+ * This function will drop the queued datagrams of the device socket closed by
+ * remote, it's done before the socket sends a new datagram. The uplink lock
+ * must be held.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ */
+static void at_device_uplink_drop(struct at_device *device, int device_socket)
+{
+    rt_base_t level;
+    rt_slist_t *node = RT_NULL, *next = RT_NULL;
+    struct at_device_uplink_pkt *pkt = RT_NULL;
+    struct at_device_uplink *uplink = device->uplink;
+
+    if (at_device_uplink_is_closed(uplink, device_socket) == RT_FALSE)
+    {
+        return;
+    }
+
+    for (node = rt_slist_first(&(uplink->queue)); node; node = next)
+    {
+        next = rt_slist_next(node);
+        pkt = rt_slist_entry(node, struct at_device_uplink_pkt, list);
+        if (pkt->device_socket == device_socket)
+        {
+            rt_slist_remove(&(uplink->queue), node);
+            uplink->queued -= pkt->len;
+            uplink->stats.dropped++;
+            uplink->stats.dropped_bytes += pkt->len;
+            rt_free(pkt);
+        }
+    }
+
+    if (rt_slist_isempty(&(uplink->queue)))
+    {
+        rt_timer_stop(&(uplink->timer));
+    }
+
+    level = rt_hw_interrupt_disable();
+    uplink->closed &= ~(1UL << device_socket);
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will send the queued datagrams in queued order, the uplink
+ * lock must be held.
+ *
+ * @param device AT device object
+ */
+static void at_device_uplink_drain(struct at_device *device)
+{
+    rt_slist_t *node = RT_NULL;
+    struct at_device_uplink_pkt *pkt = RT_NULL;
+    struct at_device_uplink *uplink = device->uplink;
+
+    rt_timer_stop(&(uplink->timer));
+
+    if (uplink->active == RT_FALSE && rt_slist_isempty(&(uplink->queue)) == RT_FALSE)
+    {
+        /* the datagrams can't wait for the active window, the radio is woken up by them */
+        uplink->stats.forced_wakeups++;
+    }
+
+    while ((node = rt_slist_first(&(uplink->queue))) != RT_NULL)
+    {
+        rt_slist_remove(&(uplink->queue), node);
+        pkt = rt_slist_entry(node, struct at_device_uplink_pkt, list);
+        uplink->queued -= pkt->len;
+
+        if (at_device_uplink_is_closed(uplink, pkt->device_socket))
+        {
+            LOG_W("%s device socket(%d) is closed, %d queued bytes dropped.",
+                    device->name, pkt->device_socket, (int) pkt->len);
+            uplink->stats.dropped++;
+            uplink->stats.dropped_bytes += pkt->len;
+        }
+        else if (at_device_uplink_xmit(device, pkt->socket, (const char *) (pkt + 1), pkt->len) < 0)
+        {
+            LOG_W("%s device socket(%d) queued datagram send failed, %d bytes dropped.",
+                    device->name, pkt->device_socket, (int) pkt->len);
+            uplink->stats.dropped++;
+            uplink->stats.dropped_bytes += pkt->len;
+        }
+
+        rt_free(pkt);
+    }
+}
+
+static void at_device_uplink_timeout(void *parameter)
+{
+    struct at_device *device = (struct at_device *) parameter;
+
+    rt_mq_send(at_device_uplink_mq, &device, sizeof(device));
+}
+
+static void at_device_uplink_thread_entry(void *parameter)
+{
+    struct at_device *device = RT_NULL;
+
+    while (1)
+    {
+        if (rt_mq_recv(at_device_uplink_mq, &device, sizeof(device), RT_WAITING_FOREVER) < 0)
+        {
+            continue;
+        }
+
+        at_device_uplink_flush(device);
+    }
+}
+
+/**
+ * This function will send the UDP datagram by the uplink scheduler. The
+ * datagram is sent at once in the active window, and queued while the radio
+ * sleeps. The queue is sent ahead of the datagram when it's full.
+ *
+ * @param device AT device object
+ * @param socket AT socket object
+ * @param buff datagram buffer
+ * @param bfsz datagram size
+ *
+ * @return >=0: the size of send or queued success
+ *          <0: the result of the class send operation
+ */
+int at_device_uplink_send(struct at_device *device, struct at_socket *socket, const char *buff, size_t bfsz)
+{
+    int result = 0;
+    int device_socket = (int) socket->user_data;
+    struct at_device_uplink_pkt *pkt = RT_NULL;
+    struct at_device_uplink *uplink = RT_NULL;
+
+    RT_ASSERT(device);
+    RT_ASSERT(socket);
+
+    uplink = device->uplink;
+
+    rt_mutex_take(&(uplink->lock), RT_WAITING_FOREVER);
+
+    /* the datagrams left by the last connection of this socket are not sent on the new one */
+    at_device_uplink_drop(device, device_socket);
+
+    if (uplink->active == RT_FALSE && uplink->queued + bfsz <= AT_DEVICE_UPLINK_QUEUE_SIZE)
+    {
+        pkt = (struct at_device_uplink_pkt *) rt_malloc(sizeof(struct at_device_uplink_pkt) + bfsz);
+    }
+
+    if (pkt == RT_NULL)
+    {
+        if (uplink->active == RT_FALSE && rt_slist_isempty(&(uplink->queue)))
+        {
+            uplink->stats.forced_wakeups++;
+        }
+
+        /* the queued datagrams go first to keep the order */
+        at_device_uplink_drain(device);
+        result = at_device_uplink_xmit(device, socket, buff, bfsz);
+        goto __exit;
+    }
+
+    pkt->socket = socket;
+    pkt->device_socket = device_socket;
+    pkt->len = bfsz;
+    rt_memcpy(pkt + 1, buff, bfsz);
+
+    /* the oldest datagram waits the maximum delay */
+    if (rt_slist_isempty(&(uplink->queue)))
+    {
+        rt_timer_start(&(uplink->timer));
+    }
+
+    rt_slist_append(&(uplink->queue), &(pkt->list));
+    uplink->queued += bfsz;
+    result = (int) bfsz;
+
+__exit:
+    uplink->stats.queued = uplink->queued;
+    rt_mutex_release(&(uplink->lock));
+
+    return result;
+}
+
+/**
+ * This function will send all datagrams queued in the uplink scheduler, it's
+ * used before the socket is closed and when the datagrams waited the active
+ * window too long.
+ *
+ * @param device AT device object
+ */
+void at_device_uplink_flush(struct at_device *device)
+{
+    struct at_device_uplink *uplink = RT_NULL;
+
+    RT_ASSERT(device);
+
+    uplink = device->uplink;
+    if (uplink == RT_NULL)
+    {
+        return;
+    }
+
+    rt_mutex_take(&(uplink->lock), RT_WAITING_FOREVER);
+    at_device_uplink_drain(device);
+    uplink->stats.queued = uplink->queued;
+    rt_mutex_release(&(uplink->lock));
+}
+
+/**
+ * This function will notice the uplink scheduler the radio state reported by
+ * the module, the queued datagrams are sent in the uplink thread when the
+ * radio becomes active. It's called by the class URC, which must not send AT
+ * commands itself.
+ *
+ * @param device AT device object
+ * @param active RT_TRUE: the radio is active
+ */
+void at_device_uplink_notice(struct at_device *device, rt_bool_t active)
+{
+    struct at_device_uplink *uplink = RT_NULL;
+
+    RT_ASSERT(device);
+
+    uplink = device->uplink;
+    if (uplink == RT_NULL)
+    {
+        return;
+    }
+
+    if (active && uplink->active == RT_FALSE)
+    {
+        uplink->stats.wakeups++;
+    }
+    uplink->active = active;
+
+    if (active && uplink->queued > 0)
+    {
+        rt_mq_send(at_device_uplink_mq, &device, sizeof(device));
+    }
+}
+
+/**
+ * This function will notice the uplink scheduler that the socket is closed by
+ * remote, its queued datagrams are dropped instead of sent. It's called by the
+ * socket closed event in URC, so the queue is not touched here.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ */
+void at_device_uplink_closed(struct at_device *device, int device_socket)
+{
+    rt_base_t level;
+    struct at_device_uplink *uplink = RT_NULL;
+
+    RT_ASSERT(device);
+
+    uplink = device->uplink;
+    if (uplink == RT_NULL || device_socket < 0 || device_socket >= 32)
+    {
+        return;
+    }
+
+    level = rt_hw_interrupt_disable();
+    uplink->closed |= (1UL << device_socket);
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will get the uplink statistics of AT device, the rates are
+ * calculated from the scheduler start.
+ *
+ * @param device AT device object
+ * @param stats the statistics copy
+ *
+ * @return  0: get success
+ *         -1: the uplink scheduler is not used
+ */
+int at_device_uplink_stats_get(struct at_device *device, struct at_device_uplink_stats *stats)
+{
+    struct at_device_uplink *uplink = RT_NULL;
+
+    RT_ASSERT(device);
+    RT_ASSERT(stats);
+
+    uplink = device->uplink;
+    if (uplink == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    rt_memcpy(stats, &(uplink->stats), sizeof(struct at_device_uplink_stats));
+    stats->uptime = (rt_tick_get() - uplink->start) / RT_TICK_PER_SECOND;
+    stats->wakeups_per_hour = stats->uptime ? (rt_uint32_t) ((rt_uint64_t) stats->wakeups * 3600 / stats->uptime) : 0;
+    stats->bytes_per_wake = stats->wakeups ? stats->bytes / stats->wakeups : stats->bytes;
+
+    return RT_EOK;
+}
+
+/**
+ * This function will start the uplink scheduler of AT device, the uplink
+ * thread is created on first use. The radio is taken as sleeping until the
+ * class reports it.
+ *
+ * @param device AT device object
+ *
+ * @return  0: start success
+ *         -1: create the uplink thread failed
+ *         -5: no memory
+ */
+int at_device_uplink_init(struct at_device *device)
+{
+    rt_thread_t tid = RT_NULL;
+    struct at_device_uplink *uplink = RT_NULL;
+
+    RT_ASSERT(device);
+
+    if (device->uplink)
+    {
+        return RT_EOK;
+    }
+
+    if (at_device_uplink_mq == RT_NULL)
+    {
+        at_device_uplink_mq = rt_mq_create("at_upl", sizeof(struct at_device *), AT_DEVICE_UPLINK_REQ_NUM, RT_IPC_FLAG_FIFO);
+        if (at_device_uplink_mq == RT_NULL)
+        {
+            LOG_E("no memory for AT device uplink queue create.");
+            return -RT_ENOMEM;
+        }
+
+        tid = rt_thread_create("at_upl", at_device_uplink_thread_entry, RT_NULL,
+                AT_DEVICE_UPLINK_THREAD_STACK_SIZE, AT_DEVICE_UPLINK_THREAD_PRIORITY, 20);
+        if (tid == RT_NULL)
+        {
+            rt_mq_delete(at_device_uplink_mq);
+            at_device_uplink_mq = RT_NULL;
+            LOG_E("create AT device uplink thread failed.");
+            return -RT_ERROR;
+        }
+        rt_thread_startup(tid);
+    }
+
+    uplink = (struct at_device_uplink *) rt_calloc(1, sizeof(struct at_device_uplink));
+    if (uplink == RT_NULL)
+    {
+        LOG_E("no memory for AT device(%s) uplink create.", device->name);
+        return -RT_ENOMEM;
+    }
+
+    rt_mutex_init(&(uplink->lock), "at_upl", RT_IPC_FLAG_PRIO);
+    rt_timer_init(&(uplink->timer), "at_upl", at_device_uplink_timeout, device,
+            rt_tick_from_millisecond(AT_DEVICE_UPLINK_MAX_DELAY), RT_TIMER_FLAG_ONE_SHOT);
+    rt_slist_init(&(uplink->queue));
+    uplink->start = rt_tick_get();
+
+    device->uplink = uplink;
+
+    return RT_EOK;
+}
+
+#endif /* AT_USING_SOCKET && AT_DEVICE_USING_UPLINK */
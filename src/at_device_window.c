@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.win"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#ifdef AT_USING_SOCKET
+
+/*
+ * The TCP send window keeps the bytes handed to the module and not yet
+ * acknowledged by the peer below the class send window. The unacknowledged
+ * bytes are counted on the host as the packets are sent, so the module is
+ * only asked for the acknowledged bytes when the next packet doesn't fit.
+ */
+
+/* The poll interval range in milliseconds while the send window is exhausted */
+#ifndef AT_DEVICE_SEND_WINDOW_POLL_MIN
+#define AT_DEVICE_SEND_WINDOW_POLL_MIN 10
+#endif
+
+#ifndef AT_DEVICE_SEND_WINDOW_POLL_MAX
+#define AT_DEVICE_SEND_WINDOW_POLL_MAX 200
+#endif
+
+/**
+ * This function will get the send window of the AT device socket.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ *
+ * @return != RT_NULL: the send window
+ *          = RT_NULL: the device class has no send window
+ */
+static struct at_device_send_window *at_device_send_window_get(struct at_device *device, int device_socket)
+{
+    if (device->send_windows == RT_NULL || device->class->send_ack == RT_NULL ||
+            device_socket < 0 || device_socket >= (int) device->class->socket_num)
+    {
+        return RT_NULL;
+    }
+
+    return &(device->send_windows[device_socket]);
+}
+
+/**
+ * This function will wait until the packet fits into the send window of the
+ * AT device socket. The acknowledged bytes are queried from the module only
+ * when the window counted on the host is exhausted, and the query interval
+ * grows while the peer doesn't acknowledge.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ * @param size the packet size to be sent
+ * @param timeout the maximum time to wait for the window
+ *
+ * @return  0: the packet can be sent
+ *         -2: wait the send window timeout
+ */
+int at_device_send_window_wait(struct at_device *device, int device_socket, size_t size, rt_int32_t timeout)
+{
+    size_t acked = 0, unacked = 0;
+    rt_int32_t interval = AT_DEVICE_SEND_WINDOW_POLL_MIN;
+    rt_tick_t start = rt_tick_get();
+    rt_bool_t stalled = RT_FALSE;
+    struct at_device_send_window *window = RT_NULL;
+
+    RT_ASSERT(device);
+
+    window = at_device_send_window_get(device, device_socket);
+    if (window == RT_NULL)
+    {
+        return RT_EOK;
+    }
+
+    while (window->sent - window->acked + size > device->class->send_window)
+    {
+        AT_DEVICE_STATS_INC(device, window_polls);
+        if (device->class->send_ack(device, device_socket, &acked, &unacked) != RT_EOK)
+        {
+            /* the module doesn't report, the window is not kept */
+            window->acked = window->sent;
+            break;
+        }
+
+        /* follow the module counters, they include the packets sent before the window is kept */
+        window->acked = acked;
+        window->sent = acked + unacked;
+        if (window->sent - window->acked + size <= device->class->send_window)
+        {
+            break;
+        }
+
+        if (stalled == RT_FALSE)
+        {
+            AT_DEVICE_STATS_INC(device, window_stalls);
+            stalled = RT_TRUE;
+        }
+
+        if (rt_tick_get() - start > (rt_tick_t) timeout)
+        {
+            LOG_W("%s device socket(%d) send window is not acknowledged, %d bytes unacked.",
+                    device->name, device_socket, (int) unacked);
+            return -RT_ETIMEOUT;
+        }
+
+        rt_thread_mdelay(interval);
+        interval = interval * 2 < AT_DEVICE_SEND_WINDOW_POLL_MAX ? interval * 2 : AT_DEVICE_SEND_WINDOW_POLL_MAX;
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * This function will count the packet handed to the module in the send window
+ * of the AT device socket.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ * @param size the packet size
+ */
+void at_device_send_window_sent(struct at_device *device, int device_socket, size_t size)
+{
+    struct at_device_send_window *window = RT_NULL;
+
+    RT_ASSERT(device);
+
+    window = at_device_send_window_get(device, device_socket);
+    if (window)
+    {
+        window->sent += size;
+    }
+}
+
+/**
+ * This function will reset the send window of the AT device socket, the
+ * module counters start from zero on every connection.
+ *
+ * @param device AT device object
+ * @param device_socket device socket descriptor
+ */
+void at_device_send_window_reset(struct at_device *device, int device_socket)
+{
+    struct at_device_send_window *window = RT_NULL;
+
+    RT_ASSERT(device);
+
+    window = at_device_send_window_get(device, device_socket);
+    if (window)
+    {
+        window->sent = 0;
+        window->acked = 0;
+    }
+}
+
+#endif /* AT_USING_SOCKET */
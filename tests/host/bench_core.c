@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_USING_TSC
+#endif
+
+#include <at_device.h>
+
+#include "host.h"
+
+/*
+ * Micro benchmarks of the package core on a fake device class answering
+ * without module, the devices are added one by one up to BENCH_DEVICE_NUM.
+ * One JSON line is printed for every record:
+ *
+ *   urc_lookup          the device lookup of a URC handler for the client of the
+ *                       device registered last, by the client binding and by the
+ *                       device list scan it replaced, nanoseconds and cycles
+ *   dns                 domain resolves completed per second, BENCH_DNS_THREAD_NUM
+ *                       threads resolve new names, every resolve takes the module
+ *                       BENCH_DNS_MS. "spread" is AT_DEVICE_DNS_SPREAD of the build.
+ *   hex                 the hex codec of the NB-IoT classes on BENCH_HEX_SIZE bytes,
+ *                       and the per byte rt_sprintf() and hex_to_string() it replaced
+ *
+ * Cycles are counted by the TSC rate, -1 when it's unknown.
+ */
+
+#define BENCH_CLASS_ID                 0x7D
+#define BENCH_SOCKET_NUM               4
+/* the client binding table holds 8 devices by default */
+#define BENCH_DEVICE_NUM               8
+
+#define BENCH_LOOKUP_NUM               1000000
+#define BENCH_DNS_THREAD_NUM           8
+#define BENCH_DNS_NAME_NUM             8
+#define BENCH_DNS_MS                   20
+/* the largest send packet of the BC28 */
+#define BENCH_HEX_SIZE                 1358
+#define BENCH_HEX_NUM                  20000
+
+static struct at_device_class bench_class;
+static struct at_device bench_devices[BENCH_DEVICE_NUM];
+static struct at_client bench_clients[BENCH_DEVICE_NUM];
+static struct rt_device bench_serials[BENCH_DEVICE_NUM];
+static int bench_device_num = 0;
+
+static double bench_tsc_hz = -1;
+
+static uint64_t bench_clock_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static void bench_tsc_calibrate(void)
+{
+#ifdef BENCH_USING_TSC
+    uint64_t tsc = 0, ns = 0;
+
+    ns = bench_clock_ns();
+    tsc = __rdtsc();
+    usleep(100 * 1000);
+    tsc = __rdtsc() - tsc;
+    ns = bench_clock_ns() - ns;
+
+    bench_tsc_hz = ns ? (double) tsc * 1e9 / (double) ns : -1;
+#endif
+}
+
+static double bench_cycles(double ns)
+{
+    return bench_tsc_hz > 0 ? ns * bench_tsc_hz / 1e9 : -1;
+}
+
+/* the client of the device is set up by the class init like at_client_init() does */
+static int bench_init(struct at_device *device)
+{
+    int index = (int) (rt_ubase_t) device->user_data;
+
+    rt_snprintf(bench_serials[index].parent.name, RT_NAME_MAX, "bc%d", index);
+    bench_clients[index].device = &bench_serials[index];
+    device->client = &bench_clients[index];
+
+    return RT_EOK;
+}
+
+static const struct at_device_ops bench_device_ops =
+{
+    bench_init,
+    RT_NULL,
+    RT_NULL,
+};
+
+static int bench_connect(struct at_socket *socket, char *ip, int32_t port,
+        enum at_socket_type type, rt_bool_t is_client)
+{
+    return RT_EOK;
+}
+
+static int bench_closesocket(struct at_socket *socket)
+{
+    return RT_EOK;
+}
+
+static int bench_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+{
+    return (int) bfsz;
+}
+
+static void bench_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
+{
+}
+
+static const struct at_socket_ops bench_socket_ops =
+{
+    bench_connect,
+    bench_closesocket,
+    bench_send,
+    RT_NULL,
+    bench_set_event_cb,
+    RT_NULL,
+};
+
+/* the module takes BENCH_DNS_MS to answer */
+static int bench_domain_resolve(struct at_device *device, const char *name, char ip[16])
+{
+    rt_thread_mdelay(BENCH_DNS_MS);
+    rt_snprintf(ip, 16, "10.1.0.%d", (int) (rt_ubase_t) device->user_data + 1);
+
+    return RT_EOK;
+}
+
+/* add the devices up to the number */
+static int bench_devices_add(int num)
+{
+    char name[RT_NAME_MAX] = {0}, client_name[RT_NAME_MAX] = {0};
+
+    for (; bench_device_num < num; bench_device_num++)
+    {
+        rt_snprintf(name, RT_NAME_MAX, "bench%d", bench_device_num);
+        rt_snprintf(client_name, RT_NAME_MAX, "bc%d", bench_device_num);
+        if (at_device_register(&bench_devices[bench_device_num], name, client_name, BENCH_CLASS_ID,
+                               (void *) (rt_ubase_t) bench_device_num) != RT_EOK)
+        {
+            fprintf(stderr, "bench: register device(%s) failed.\n", name);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static void bench_urc_lookup(int num)
+{
+    int i;
+    uint64_t start = 0;
+    double by_client = 0, by_name = 0;
+    struct at_client *client = &bench_clients[num - 1];
+    struct at_device *volatile found = RT_NULL;
+
+    start = bench_clock_ns();
+    for (i = 0; i < BENCH_LOOKUP_NUM; i++)
+    {
+        found = at_device_get_by_client(client);
+    }
+    by_client = (double) (bench_clock_ns() - start) / BENCH_LOOKUP_NUM;
+
+    start = bench_clock_ns();
+    for (i = 0; i < BENCH_LOOKUP_NUM; i++)
+    {
+        found = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client->device->parent.name);
+    }
+    by_name = (double) (bench_clock_ns() - start) / BENCH_LOOKUP_NUM;
+
+    if (found != &bench_devices[num - 1])
+    {
+        fprintf(stderr, "bench: the URC lookup found the wrong device.\n");
+    }
+
+    printf("{\"bench\":\"urc_lookup\",\"devices\":%d,\"by_client_ns\":%.1f,\"by_client_cycles\":%.0f,"
+           "\"by_name_ns\":%.1f,\"by_name_cycles\":%.0f}\n",
+           num, by_client, bench_cycles(by_client), by_name, bench_cycles(by_name));
+}
+
+static rt_sem_t bench_dns_sem = RT_NULL;
+static int bench_dns_round = 0;
+static int bench_dns_failed = 0;
+
+static void bench_dns_entry(void *parameter)
+{
+    int i;
+    char name[32] = {0};
+    char addrs[1][AT_DEVICE_DNS_ADDR_LEN];
+
+    /* the new names miss the DNS cache */
+    for (i = 0; i < BENCH_DNS_NAME_NUM; i++)
+    {
+        rt_snprintf(name, sizeof(name), "d%d-%d-%d.bench", bench_dns_round, (int) (rt_ubase_t) parameter, i);
+        if (at_device_domain_resolve_all(name, addrs, 1) != 1)
+        {
+            bench_dns_failed = 1;
+        }
+    }
+
+    rt_sem_release(bench_dns_sem);
+}
+
+static void bench_dns(int num)
+{
+    int i;
+    char name[RT_NAME_MAX] = {0};
+    uint64_t start = 0;
+    double elapsed = 0;
+    rt_thread_t thread = RT_NULL;
+
+    if (bench_dns_sem == RT_NULL)
+    {
+        bench_dns_sem = rt_sem_create("bench", 0, RT_IPC_FLAG_FIFO);
+    }
+    bench_dns_round = num;
+    bench_dns_failed = 0;
+
+    start = bench_clock_ns();
+    for (i = 0; i < BENCH_DNS_THREAD_NUM; i++)
+    {
+        rt_snprintf(name, RT_NAME_MAX, "bench_d%d", i);
+        thread = rt_thread_create(name, bench_dns_entry, (void *) (rt_ubase_t) i, 2048, 10, 5);
+        if (thread == RT_NULL)
+        {
+            bench_dns_failed = 1;
+            break;
+        }
+        rt_thread_startup(thread);
+    }
+    for (; i > 0; i--)
+    {
+        rt_sem_take(bench_dns_sem, RT_WAITING_FOREVER);
+    }
+    elapsed = (double) (bench_clock_ns() - start) / 1e9;
+
+    if (bench_dns_failed)
+    {
+        fprintf(stderr, "bench: domain resolve on %d devices failed.\n", num);
+        return;
+    }
+
+#ifdef AT_DEVICE_DNS_SPREAD
+    printf("{\"bench\":\"dns\",\"spread\":1,");
+#else
+    printf("{\"bench\":\"dns\",\"spread\":0,");
+#endif
+    printf("\"devices\":%d,\"threads\":%d,\"resolve_ms\":%d,\"lookups_per_s\":%.1f}\n",
+           num, BENCH_DNS_THREAD_NUM, BENCH_DNS_MS, BENCH_DNS_THREAD_NUM * BENCH_DNS_NAME_NUM / elapsed);
+}
+
+/* the per byte encode of the BC28 send before the hex codec */
+static void bench_hex_encode_sprintf(char *hex, const rt_uint8_t *data, rt_size_t size)
+{
+    rt_size_t i, ind;
+
+    for (i = 0, ind = 0; i < size; i++, ind += 2)
+    {
+        rt_sprintf(&hex[ind], "%02X", data[i]);
+    }
+}
+
+/* the decode of the BC28 receive URC before the hex codec */
+static int bench_hex_to_string(const char *hex, char *str, const rt_size_t len)
+{
+    int hex_len = rt_strlen(hex);
+    int pos = 0, left, right, i;
+
+    if (len < 1 || hex_len / 2 < len)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < len * 2; i++, pos++)
+    {
+        left = hex[i++];
+        right = hex[i];
+
+        left  = (left  < 58) ? (left  - 48) : (left  - 55);
+        right = (right < 58) ? (right - 48) : (right - 55);
+
+        str[pos] = (left << 4) | right;
+    }
+
+    return pos;
+}
+
+static void bench_hex_print(const char *op, uint64_t elapsed)
+{
+    double ns = (double) elapsed / ((double) BENCH_HEX_SIZE * BENCH_HEX_NUM);
+    double cycles = bench_cycles(ns);
+
+    printf("{\"bench\":\"hex\",\"op\":\"%s\",\"size\":%d,\"ns_per_byte\":%.3f,\"bytes_per_cycle\":%.3f}\n",
+           op, BENCH_HEX_SIZE, ns, cycles > 0 ? 1.0 / cycles : -1);
+}
+
+static int bench_hex(void)
+{
+    int i;
+    uint64_t start = 0;
+    static rt_uint8_t data[BENCH_HEX_SIZE], decoded[BENCH_HEX_SIZE];
+    static char hex[BENCH_HEX_SIZE * 2 + 1];
+
+    for (i = 0; i < BENCH_HEX_SIZE; i++)
+    {
+        data[i] = (rt_uint8_t) (i * 31 + 7);
+    }
+
+    start = bench_clock_ns();
+    for (i = 0; i < BENCH_HEX_NUM; i++)
+    {
+        at_device_hex_encode(hex, data, BENCH_HEX_SIZE);
+    }
+    bench_hex_print("encode", bench_clock_ns() - start);
+
+    start = bench_clock_ns();
+    for (i = 0; i < BENCH_HEX_NUM; i++)
+    {
+        bench_hex_encode_sprintf(hex, data, BENCH_HEX_SIZE);
+    }
+    bench_hex_print("encode_sprintf", bench_clock_ns() - start);
+
+    start = bench_clock_ns();
+    for (i = 0; i < BENCH_HEX_NUM; i++)
+    {
+        at_device_hex_decode(decoded, hex, BENCH_HEX_SIZE);
+    }
+    bench_hex_print("decode", bench_clock_ns() - start);
+    if (memcmp(data, decoded, sizeof(data)) != 0)
+    {
+        return -1;
+    }
+
+    memset(decoded, 0x00, sizeof(decoded));
+    start = bench_clock_ns();
+    for (i = 0; i < BENCH_HEX_NUM; i++)
+    {
+        bench_hex_to_string(hex, (char *) decoded, BENCH_HEX_SIZE);
+    }
+    bench_hex_print("decode_hex_to_string", bench_clock_ns() - start);
+    if (memcmp(data, decoded, sizeof(data)) != 0)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int num;
+
+    bench_tsc_calibrate();
+
+    bench_class.device_ops = &bench_device_ops;
+    bench_class.socket_num = BENCH_SOCKET_NUM;
+    bench_class.socket_ops = &bench_socket_ops;
+    bench_class.domain_resolve = bench_domain_resolve;
+    if (at_device_class_register(&bench_class, BENCH_CLASS_ID) != RT_EOK)
+    {
+        fprintf(stderr, "bench: register device class failed.\n");
+        return 1;
+    }
+
+    for (num = 1; num <= BENCH_DEVICE_NUM; num *= 2)
+    {
+        if (bench_devices_add(num) < 0)
+        {
+            return 1;
+        }
+        bench_urc_lookup(num);
+        bench_dns(num);
+        fflush(stdout);
+    }
+
+    if (bench_hex() < 0)
+    {
+        fprintf(stderr, "bench: hex decode failed.\n");
+        return 1;
+    }
+
+    return 0;
+}
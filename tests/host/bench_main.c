@@ -0,0 +1,790 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_USING_TSC
+#endif
+
+#if defined(AT_DEVICE_USING_EC20)
+#include <at_device_ec20.h>
+#elif defined(AT_DEVICE_USING_ML307)
+#include <at_device_ml307.h>
+#else
+#include <at_device_esp8266.h>
+#endif
+
+#include "host.h"
+#if defined(AT_DEVICE_USING_EC20)
+#include "emu/modem_ec20.h"
+#elif defined(AT_DEVICE_USING_ML307)
+#include "emu/modem_ml307.h"
+#else
+#include "emu/modem_esp8266.h"
+#endif
+
+/*
+ * Socket benchmark of one device class against its profile of the modem
+ * emulator, the line is paced at every given baud rate. The class is the one
+ * AT_DEVICE_USING_xxx of the build, ESP8266, EC20 or ML307. One result record is
+ * printed for every baud rate, as JSON lines by default or as CSV with "-c":
+ *
+ *   connect_ms          average "AT+CIPSTART" connect latency
+ *   resolve_ms          average domain resolve latency, not answered by cache
+ *   lookups_per_s       asynchronous resolves completed per second, BENCH_LOOKUP_NUM
+ *                       new names outstanding at once
+ *   cached_lookups_per_s
+ *                       asynchronous resolves of cached names completed per second
+ *   tcp_send_Bps        sustained TCP send throughput, bytes per second
+ *   tcp_recv_Bps        sustained TCP receive throughput, bytes per second
+ *   udp_dgram_per_s     UDP datagrams of BENCH_UDP_SIZE bytes sent per second
+ *   tcp_*_cpu_ns_per_byte, tcp_*_cycles_per_byte
+ *                       CPU time of the package and AT client per payload
+ *                       byte, the emulator threads are not counted. Cycles
+ *                       are counted by the TSC rate, -1 when it's unknown.
+ *   send_window         TCP bytes kept unacknowledged in the module, 0 for none
+ *   tcp_send_window_polls
+ *                       acknowledged bytes queried in the TCP send
+ *
+ * The send packet size is the xxx_MODULE_SEND_MAX_SIZE of the build, the
+ * receive mode is push or pull by AT_DEVICE_ESP8266_RECV_PASSIVE or
+ * AT_DEVICE_EC20_RECV_PULL. With AT_DEVICE_ESP8266_PASSTHROUGH the sockets
+ * stream in passthrough, the mode is "passthrough" and the sends are timed
+ * until the module took the data. The EC20 peer acknowledges the data
+ * BENCH_ACK_DELAY milliseconds after it's sent, the round trip of a cellular
+ * network, which the send window waits for. The ML307 sends 4096 bytes
+ * packets and waits for the "+MIPSEND" result of every one.
+ */
+
+#define BENCH_SERVER_IP                "192.168.1.10"
+
+#define BENCH_CONNECT_NUM              5
+#define BENCH_RESOLVE_NUM              5
+#define BENCH_LOOKUP_NUM               8
+#define BENCH_UDP_SIZE                 64
+/* the transfers take about this time at the line rate */
+#define BENCH_TRANSFER_SECONDS         1
+
+#if defined(AT_DEVICE_USING_EC20)
+#define BENCH_CLASS_NAME               "ec20"
+#define BENCH_CLASS_ID                 AT_DEVICE_CLASS_EC20
+#define BENCH_DEVICE_NAME              "ec0"
+#define BENCH_CLIENT_NAME              "uart_q"
+#define BENCH_SEGMENT_SIZE             MODEM_EC20_SEGMENT_SIZE
+#define BENCH_MODULE_BUF_SIZE          MODEM_EC20_BUF_SIZE
+
+#ifndef BENCH_SEND_MAX_SIZE
+#define BENCH_SEND_MAX_SIZE            1460
+#endif
+#ifndef BENCH_ACK_DELAY
+#define BENCH_ACK_DELAY                100
+#endif
+
+#ifdef AT_DEVICE_EC20_RECV_PULL
+#define BENCH_RECV_MODE                "pull"
+#else
+#define BENCH_RECV_MODE                "push"
+#endif
+
+static struct modem_ec20 modem;
+
+static struct at_device_ec20 bench_dev =
+{
+    BENCH_DEVICE_NAME,
+    BENCH_CLIENT_NAME,
+
+    -1,
+    -1,
+    512,
+};
+
+static int bench_modem_open(void)
+{
+    if (modem_ec20_open(&modem, 0) != 0)
+    {
+        return -1;
+    }
+    modem.ack_delay = BENCH_ACK_DELAY;
+    snprintf(modem.domain_any, sizeof(modem.domain_any), "%s", BENCH_SERVER_IP);
+
+    return 0;
+}
+
+/* the bytes buffered in the module for the pull-mode read */
+#define bench_modem_buffered(link)     (modem.push[link] ? 0 : modem.recv_len[link])
+#define bench_modem_push(link, data, len) modem_ec20_push(&modem, link, data, len)
+#elif defined(AT_DEVICE_USING_ML307)
+#define BENCH_CLASS_NAME               "ml307"
+#define BENCH_CLASS_ID                 AT_DEVICE_CLASS_ML307
+#define BENCH_DEVICE_NAME              "ml0"
+#define BENCH_CLIENT_NAME              "uart_m"
+#define BENCH_SEGMENT_SIZE             MODEM_ML307_SEGMENT_SIZE
+#define BENCH_MODULE_BUF_SIZE          MODEM_ML307_SEGMENT_SIZE
+#define BENCH_SEND_MAX_SIZE            MODEM_ML307_SEND_MAX_SIZE
+#define BENCH_RECV_MODE                "push"
+
+static struct modem_ml307 modem;
+
+/* the received data is inline in the URC line, the line buffer holds a segment */
+static struct at_device_ml307 bench_dev =
+{
+    BENCH_DEVICE_NAME,
+    BENCH_CLIENT_NAME,
+
+    -1,
+    -1,
+    MODEM_ML307_SEGMENT_SIZE + 64,
+};
+
+static int bench_modem_open(void)
+{
+    if (modem_ml307_open(&modem, 0) != 0)
+    {
+        return -1;
+    }
+    snprintf(modem.domain_any, sizeof(modem.domain_any), "%s", BENCH_SERVER_IP);
+
+    return 0;
+}
+
+#define bench_modem_buffered(link)     0
+#define bench_modem_push(link, data, len) modem_ml307_push(&modem, link, data, len)
+#else
+#define BENCH_CLASS_NAME               "esp8266"
+#define BENCH_CLASS_ID                 AT_DEVICE_CLASS_ESP8266
+#define BENCH_DEVICE_NAME              "esp0"
+#define BENCH_CLIENT_NAME              "uart_e"
+#define BENCH_SEGMENT_SIZE             MODEM_ESP8266_SEGMENT_SIZE
+#define BENCH_MODULE_BUF_SIZE          MODEM_ESP8266_BUF_SIZE
+
+#ifndef BENCH_SEND_MAX_SIZE
+#define BENCH_SEND_MAX_SIZE            2048
+#endif
+
+#if defined(AT_DEVICE_ESP8266_PASSTHROUGH)
+#define BENCH_RECV_MODE                "passthrough"
+#elif defined(AT_DEVICE_ESP8266_RECV_PASSIVE)
+#define BENCH_RECV_MODE                "pull"
+#else
+#define BENCH_RECV_MODE                "push"
+#endif
+
+static struct modem_esp8266 modem;
+
+static struct at_device_esp8266 bench_dev =
+{
+    BENCH_DEVICE_NAME,
+    BENCH_CLIENT_NAME,
+
+    "bench_ssid",
+    "bench_password",
+    512,
+};
+
+static int bench_modem_open(void)
+{
+    if (modem_esp8266_open(&modem, 0) != 0)
+    {
+        return -1;
+    }
+    modem.send_max = BENCH_SEND_MAX_SIZE;
+    snprintf(modem.domain_any, sizeof(modem.domain_any), "%s", BENCH_SERVER_IP);
+
+    return 0;
+}
+
+#define bench_modem_buffered(link)     (modem.passive ? modem.recv_len[link] : 0)
+#define bench_modem_push(link, data, len) modem_esp8266_push(&modem, link, data, len)
+#endif /* AT_DEVICE_USING_EC20 */
+
+#define bench_device                   (bench_dev.device)
+
+struct bench_result
+{
+    uint32_t baud;
+    double connect_ms;
+    double resolve_ms;
+    double lookups_per_s;
+    double cached_lookups_per_s;
+    double tcp_send_bps;
+    double tcp_recv_bps;
+    double udp_dgram_per_s;
+    double tcp_send_cpu_ns;
+    double tcp_recv_cpu_ns;
+    uint32_t tcp_send_window_polls;
+};
+
+struct bench_cpu
+{
+    uint64_t process;
+    uint64_t excluded;
+};
+
+/* the peer sending to the module in the receive benchmark */
+static pthread_t bench_peer;
+static int bench_peer_link = -1;
+static size_t bench_peer_size = 0;
+
+static double bench_tsc_hz = -1;
+
+static uint64_t bench_clock_ns(clockid_t clock)
+{
+    struct timespec ts;
+
+    if (clock_gettime(clock, &ts) != 0)
+    {
+        return 0;
+    }
+
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static uint64_t bench_thread_ns(pthread_t thread)
+{
+    clockid_t clock;
+
+    if (pthread_getcpuclockid(thread, &clock) != 0)
+    {
+        return 0;
+    }
+
+    return bench_clock_ns(clock);
+}
+
+/* the CPU time of the process, the emulator and the peer are counted apart */
+static void bench_cpu_get(struct bench_cpu *cpu, rt_bool_t peer)
+{
+    cpu->process = bench_clock_ns(CLOCK_PROCESS_CPUTIME_ID);
+    cpu->excluded = bench_thread_ns(modem.emu.thread);
+    if (peer)
+    {
+        cpu->excluded += bench_thread_ns(bench_peer);
+    }
+}
+
+static uint64_t bench_cpu_used(const struct bench_cpu *start, const struct bench_cpu *end)
+{
+    uint64_t used = end->process - start->process;
+    uint64_t excluded = end->excluded - start->excluded;
+
+    return used > excluded ? used - excluded : 0;
+}
+
+static void bench_tsc_calibrate(void)
+{
+#ifdef BENCH_USING_TSC
+    uint64_t tsc = 0, ns = 0;
+
+    ns = bench_clock_ns(CLOCK_MONOTONIC);
+    tsc = __rdtsc();
+    usleep(100 * 1000);
+    tsc = __rdtsc() - tsc;
+    ns = bench_clock_ns(CLOCK_MONOTONIC) - ns;
+
+    bench_tsc_hz = ns ? (double) tsc * 1e9 / (double) ns : -1;
+#endif
+}
+
+static double bench_cycles(double cpu_ns)
+{
+    return bench_tsc_hz > 0 ? cpu_ns * bench_tsc_hz / 1e9 : -1;
+}
+
+static int bench_register(void)
+{
+    if (bench_modem_open() != 0)
+    {
+        return -1;
+    }
+
+    if (host_serial_register(BENCH_CLIENT_NAME, modem.emu.slave) != RT_EOK ||
+            at_device_register(&bench_device, bench_dev.device_name, bench_dev.client_name,
+                               BENCH_CLASS_ID, (void *) &bench_dev) != RT_EOK)
+    {
+        fprintf(stderr, "bench: register %s device failed.\n", BENCH_DEVICE_NAME);
+        return -1;
+    }
+    netdev_set_default(bench_device.netdev);
+
+    /* the network information is queried by the device work after the init */
+    rt_thread_mdelay(1500);
+
+    return 0;
+}
+
+static int bench_connect(enum at_socket_type type)
+{
+    int socket = host_socket_open(&bench_device, type);
+
+    if (socket < 0)
+    {
+        return -1;
+    }
+
+    if (host_socket_connect(socket, BENCH_SERVER_IP, 5000) != RT_EOK)
+    {
+        at_closesocket(socket);
+        return -1;
+    }
+
+    return socket;
+}
+
+static int bench_connect_latency(struct bench_result *result)
+{
+    int i, socket = -1;
+    uint64_t start = 0, total = 0;
+
+    for (i = 0; i < BENCH_CONNECT_NUM; i++)
+    {
+        socket = host_socket_open(&bench_device, AT_SOCKET_TCP);
+        if (socket < 0)
+        {
+            return -1;
+        }
+
+        start = host_time_us();
+        if (host_socket_connect(socket, BENCH_SERVER_IP, 5000) != RT_EOK)
+        {
+            at_closesocket(socket);
+            return -1;
+        }
+        total += host_time_us() - start;
+
+        at_closesocket(socket);
+    }
+
+    result->connect_ms = (double) total / BENCH_CONNECT_NUM / 1000.0;
+
+    return 0;
+}
+
+static int bench_resolve_latency(struct bench_result *result)
+{
+    int i;
+    char name[32] = {0}, ip[16] = {0};
+    uint64_t start = 0, total = 0;
+
+    for (i = 0; i < BENCH_RESOLVE_NUM; i++)
+    {
+        /* a new name for every resolve, the DNS cache doesn't answer */
+        snprintf(name, sizeof(name), "b%u-%d.bench", (unsigned) result->baud, i);
+
+        start = host_time_us();
+        if (host_domain_resolve(&bench_device, name, ip) != RT_EOK)
+        {
+            return -1;
+        }
+        total += host_time_us() - start;
+    }
+
+    result->resolve_ms = (double) total / BENCH_RESOLVE_NUM / 1000.0;
+
+    return 0;
+}
+
+static rt_sem_t bench_lookup_sem = RT_NULL;
+static int bench_lookup_failed = 0;
+
+static void bench_lookup_cb(int id, const char *name, int result, const char *ip, void *user_data)
+{
+    if (result != RT_EOK)
+    {
+        bench_lookup_failed = 1;
+    }
+    rt_sem_release(bench_lookup_sem);
+}
+
+/* issue BENCH_LOOKUP_NUM asynchronous resolves and wait for all, the elapsed time in microseconds */
+static uint64_t bench_lookup_round(uint32_t baud, const char *prefix)
+{
+    int i;
+    char name[32] = {0};
+    uint64_t start = host_time_us();
+
+    bench_lookup_failed = 0;
+    for (i = 0; i < BENCH_LOOKUP_NUM; i++)
+    {
+        snprintf(name, sizeof(name), "%s%u-%d.bench", prefix, (unsigned) baud, i);
+        if (at_device_domain_resolve_async(name, bench_lookup_cb, RT_NULL) <= 0)
+        {
+            return 0;
+        }
+    }
+
+    for (i = 0; i < BENCH_LOOKUP_NUM; i++)
+    {
+        if (rt_sem_take(bench_lookup_sem, 30 * RT_TICK_PER_SECOND) != RT_EOK)
+        {
+            return 0;
+        }
+    }
+
+    return bench_lookup_failed ? 0 : host_time_us() - start;
+}
+
+static int bench_lookup_rate(struct bench_result *result)
+{
+    uint64_t elapsed = 0;
+
+    if (bench_lookup_sem == RT_NULL)
+    {
+        bench_lookup_sem = rt_sem_create("bench", 0, RT_IPC_FLAG_FIFO);
+    }
+
+    /* new names go to the module, the second round of them is answered by the cache */
+    if ((elapsed = bench_lookup_round(result->baud, "l")) == 0)
+    {
+        return -1;
+    }
+    result->lookups_per_s = (double) BENCH_LOOKUP_NUM * 1e6 / (double) elapsed;
+
+    if ((elapsed = bench_lookup_round(result->baud, "l")) == 0)
+    {
+        return -1;
+    }
+    result->cached_lookups_per_s = (double) BENCH_LOOKUP_NUM * 1e6 / (double) elapsed;
+
+    return 0;
+}
+
+#ifdef AT_DEVICE_ESP8266_PASSTHROUGH
+#define bench_streamed()               (modem.stream_bytes)
+#else
+#define bench_streamed()               ((size_t) 0)
+#endif
+
+/* wait for the module to take the bytes streamed in passthrough, they are still on the line when the send returns */
+static int bench_stream_wait(size_t bytes)
+{
+#ifdef AT_DEVICE_ESP8266_PASSTHROUGH
+    uint64_t start = host_time_us();
+
+    while (bench_streamed() < bytes)
+    {
+        if (host_time_us() - start > 10 * 1000000ULL)
+        {
+            return -1;
+        }
+        usleep(100);
+    }
+#endif
+
+    return 0;
+}
+
+static int bench_tcp_send(struct bench_result *result, size_t size)
+{
+    int socket = -1, sent = 0;
+    size_t i, streamed = 0;
+    uint32_t polls = 0;
+    char *buf = NULL;
+    uint64_t start = 0, elapsed = 0;
+    struct bench_cpu cpu_start, cpu_end;
+
+    buf = (char *) malloc(size);
+    if (buf == NULL || (socket = bench_connect(AT_SOCKET_TCP)) < 0)
+    {
+        free(buf);
+        return -1;
+    }
+    for (i = 0; i < size; i++)
+    {
+        buf[i] = (char) i;
+    }
+
+    streamed = bench_streamed();
+    polls = bench_device.stats.window_polls;
+    bench_cpu_get(&cpu_start, RT_FALSE);
+    start = host_time_us();
+    sent = host_socket_send(socket, buf, size);
+    /* the package is done with the data, the wait for the line is not counted */
+    bench_cpu_get(&cpu_end, RT_FALSE);
+    if (bench_stream_wait(streamed + size) < 0)
+    {
+        sent = -1;
+    }
+    elapsed = host_time_us() - start;
+    polls = bench_device.stats.window_polls - polls;
+
+    at_closesocket(socket);
+    free(buf);
+
+    if (sent != (int) size || elapsed == 0)
+    {
+        return -1;
+    }
+
+    result->tcp_send_bps = (double) size * 1e6 / (double) elapsed;
+    result->tcp_send_cpu_ns = (double) bench_cpu_used(&cpu_start, &cpu_end) / (double) size;
+    result->tcp_send_window_polls = polls;
+
+    return 0;
+}
+
+static void *bench_peer_entry(void *parameter)
+{
+    size_t pushed = 0, len = 0;
+    char buf[BENCH_SEGMENT_SIZE];
+
+    memset(buf, 0x5A, sizeof(buf));
+
+    while (pushed < bench_peer_size)
+    {
+        /* the module buffer is not overrun in pull mode */
+        if (bench_modem_buffered(bench_peer_link) + sizeof(buf) > BENCH_MODULE_BUF_SIZE)
+        {
+            usleep(1000);
+            continue;
+        }
+
+        len = bench_peer_size - pushed < sizeof(buf) ? bench_peer_size - pushed : sizeof(buf);
+        bench_modem_push(bench_peer_link, buf, len);
+        pushed += len;
+    }
+
+    return NULL;
+}
+
+static int bench_tcp_recv(struct bench_result *result, size_t size)
+{
+    int socket = -1, recved = 0;
+    size_t total = 0;
+    char buf[BENCH_SEGMENT_SIZE];
+    uint64_t start = 0, elapsed = 0;
+    struct bench_cpu cpu_start, cpu_end;
+
+    socket = bench_connect(AT_SOCKET_TCP);
+    if (socket < 0)
+    {
+        return -1;
+    }
+
+    bench_peer_link = (int) (rt_ubase_t) host_socket_get(socket)->user_data;
+    bench_peer_size = size;
+
+    start = host_time_us();
+    if (pthread_create(&bench_peer, NULL, bench_peer_entry, NULL) != 0)
+    {
+        at_closesocket(socket);
+        return -1;
+    }
+    bench_cpu_get(&cpu_start, RT_TRUE);
+
+    while (total < size)
+    {
+        recved = host_socket_recv(socket, buf, sizeof(buf), 5 * RT_TICK_PER_SECOND);
+        if (recved <= 0)
+        {
+            break;
+        }
+        total += (size_t) recved;
+    }
+    elapsed = host_time_us() - start;
+    bench_cpu_get(&cpu_end, RT_TRUE);
+
+    pthread_join(bench_peer, NULL);
+    at_closesocket(socket);
+
+    if (total != size || elapsed == 0)
+    {
+        return -1;
+    }
+
+    result->tcp_recv_bps = (double) size * 1e6 / (double) elapsed;
+    result->tcp_recv_cpu_ns = (double) bench_cpu_used(&cpu_start, &cpu_end) / (double) size;
+
+    return 0;
+}
+
+static int bench_udp_rate(struct bench_result *result, size_t size)
+{
+    int socket = -1;
+    size_t i, streamed = 0, num = size / BENCH_UDP_SIZE;
+    char buf[BENCH_UDP_SIZE];
+    uint64_t start = 0, elapsed = 0;
+
+    socket = bench_connect(AT_SOCKET_UDP);
+    if (socket < 0)
+    {
+        return -1;
+    }
+    memset(buf, 0xA5, sizeof(buf));
+
+    streamed = bench_streamed();
+    start = host_time_us();
+    for (i = 0; i < num; i++)
+    {
+        if (host_socket_send(socket, buf, sizeof(buf)) != (int) sizeof(buf))
+        {
+            break;
+        }
+    }
+    if (bench_stream_wait(streamed + i * sizeof(buf)) < 0)
+    {
+        i = 0;
+    }
+    elapsed = host_time_us() - start;
+
+    at_closesocket(socket);
+
+    if (i != num || elapsed == 0)
+    {
+        return -1;
+    }
+
+    result->udp_dgram_per_s = (double) num * 1e6 / (double) elapsed;
+
+    return 0;
+}
+
+static int bench_run(struct bench_result *result, uint32_t baud)
+{
+    /* the bytes the line carries in the transfer time, 10 bits per byte */
+    size_t size = (size_t) baud / 10 * BENCH_TRANSFER_SECONDS;
+
+    memset(result, 0x00, sizeof(struct bench_result));
+    result->baud = baud;
+    modem.emu.baud = baud;
+
+    if (bench_connect_latency(result) < 0)
+    {
+        fprintf(stderr, "bench: connect at %u baud failed.\n", (unsigned) baud);
+        return -1;
+    }
+
+    if (bench_resolve_latency(result) < 0)
+    {
+        fprintf(stderr, "bench: domain resolve at %u baud failed.\n", (unsigned) baud);
+        return -1;
+    }
+
+    if (bench_lookup_rate(result) < 0)
+    {
+        fprintf(stderr, "bench: asynchronous domain resolve at %u baud failed.\n", (unsigned) baud);
+        return -1;
+    }
+
+    /* the peer doesn't echo, the directions are measured apart */
+    modem.echo = 0;
+
+    if (bench_tcp_send(result, size) < 0)
+    {
+        fprintf(stderr, "bench: TCP send at %u baud failed.\n", (unsigned) baud);
+        return -1;
+    }
+
+    if (bench_tcp_recv(result, size) < 0)
+    {
+        fprintf(stderr, "bench: TCP receive at %u baud failed.\n", (unsigned) baud);
+        return -1;
+    }
+
+    if (bench_udp_rate(result, size / 4) < 0)
+    {
+        fprintf(stderr, "bench: UDP send at %u baud failed.\n", (unsigned) baud);
+        return -1;
+    }
+
+    modem.echo = 1;
+
+    return 0;
+}
+
+static const char *bench_fields =
+    "class,recv,send_max,baud,connect_ms,resolve_ms,lookups_per_s,cached_lookups_per_s,tcp_send_Bps,tcp_recv_Bps,udp_dgram_per_s,"
+    "tcp_send_cpu_ns_per_byte,tcp_recv_cpu_ns_per_byte,tcp_send_cycles_per_byte,tcp_recv_cycles_per_byte,"
+    "send_window,tcp_send_window_polls";
+
+static void bench_print(const struct bench_result *result, rt_bool_t csv)
+{
+    const char *fmt = csv ?
+        "%s,%s,%d,%u,%.3f,%.3f,%.1f,%.1f,%.0f,%.0f,%.1f,%.1f,%.1f,%.0f,%.0f,%u,%u\n" :
+        "{\"class\":\"%s\",\"recv\":\"%s\",\"send_max\":%d,\"baud\":%u,"
+        "\"connect_ms\":%.3f,\"resolve_ms\":%.3f,\"lookups_per_s\":%.1f,\"cached_lookups_per_s\":%.1f,"
+        "\"tcp_send_Bps\":%.0f,\"tcp_recv_Bps\":%.0f,"
+        "\"udp_dgram_per_s\":%.1f,\"tcp_send_cpu_ns_per_byte\":%.1f,\"tcp_recv_cpu_ns_per_byte\":%.1f,"
+        "\"tcp_send_cycles_per_byte\":%.0f,\"tcp_recv_cycles_per_byte\":%.0f,"
+        "\"send_window\":%u,\"tcp_send_window_polls\":%u}\n";
+
+    printf(fmt, BENCH_CLASS_NAME, BENCH_RECV_MODE, BENCH_SEND_MAX_SIZE, (unsigned) result->baud,
+           result->connect_ms, result->resolve_ms, result->lookups_per_s, result->cached_lookups_per_s,
+           result->tcp_send_bps, result->tcp_recv_bps,
+           result->udp_dgram_per_s, result->tcp_send_cpu_ns, result->tcp_recv_cpu_ns,
+           bench_cycles(result->tcp_send_cpu_ns), bench_cycles(result->tcp_recv_cpu_ns),
+           (unsigned) bench_device.class->send_window, (unsigned) result->tcp_send_window_polls);
+    fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+    int i, failed = 0;
+    rt_bool_t csv = RT_FALSE, header = RT_TRUE;
+    uint32_t bauds[8] = {115200, 921600};
+    int baud_num = 2, arg_bauds = 0;
+    struct bench_result result;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-c") == 0)
+        {
+            csv = RT_TRUE;
+        }
+        else if (strcmp(argv[i], "-n") == 0)
+        {
+            /* no CSV header, the records are appended to another run */
+            header = RT_FALSE;
+        }
+        else if (arg_bauds < (int) (sizeof(bauds) / sizeof(bauds[0])) && atoi(argv[i]) > 0)
+        {
+            bauds[arg_bauds++] = (uint32_t) atoi(argv[i]);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-c] [-n] [baud ...]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (arg_bauds > 0)
+    {
+        baud_num = arg_bauds;
+    }
+
+    bench_tsc_calibrate();
+
+    if (bench_register() < 0)
+    {
+        return 1;
+    }
+
+    if (csv && header)
+    {
+        printf("%s\n", bench_fields);
+    }
+
+    for (i = 0; i < baud_num; i++)
+    {
+        if (bench_run(&result, bauds[i]) < 0)
+        {
+            failed = 1;
+            continue;
+        }
+        bench_print(&result, csv);
+    }
+
+    return failed;
+}
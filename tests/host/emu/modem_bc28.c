@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "modem_bc28.h"
+
+#define MODEM(emu)                     ((struct modem_bc28 *) (emu)->user_data)
+
+/* decode the hex data ended by ',' or the end of line, returns the bytes or -1 for broken data */
+static int bc28_hex_decode(const char *hex, char *data, size_t size)
+{
+    size_t i, len = 0;
+    char byte[3] = {0};
+
+    while (hex[len] && hex[len] != ',')
+    {
+        if (!isxdigit((unsigned char) hex[len]))
+        {
+            return -1;
+        }
+        len++;
+    }
+
+    if (len % 2 || len / 2 > size)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < len / 2; i++)
+    {
+        byte[0] = hex[i * 2];
+        byte[1] = hex[i * 2 + 1];
+        data[i] = (char) strtol(byte, NULL, 16);
+    }
+
+    return (int) (len / 2);
+}
+
+static void bc28_ok(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+static void bc28_cgsn(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+CGSN:867123456789012\r\n\r\nOK\r\n");
+}
+
+static void bc28_cimi(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n460111234567890\r\n\r\nOK\r\n");
+}
+
+static void bc28_natspeed(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+NATSPEED:9600,3,1,2,1,0,0\r\n\r\nOK\r\n");
+}
+
+static void bc28_ati(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\nQuectel\r\nBC28\r\nRevision:BC28JBR01A10\r\n\r\nOK\r\n");
+}
+
+static void bc28_cpin(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+CPIN:READY\r\n\r\nOK\r\n");
+}
+
+static void bc28_csq(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+CSQ:24,99\r\n\r\nOK\r\n");
+}
+
+static void bc28_cgatt(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+CGATT:%d\r\n\r\nOK\r\n", MODEM(emu)->attached);
+}
+
+static void bc28_cgpaddr(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+CGPADDR:0,10.64.2.3\r\n\r\nOK\r\n");
+}
+
+static void bc28_qidnscfg(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\nPrimaryDns: 114.114.114.114\r\nSecondaryDns: 8.8.8.8\r\n\r\nOK\r\n");
+}
+
+static void bc28_cscon(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+CSCON:1,%d\r\n\r\nOK\r\n", MODEM(emu)->cscon);
+}
+
+static void bc28_nsocr(struct modem_emu *emu, const char *cmd)
+{
+    int i;
+    struct modem_bc28 *modem = MODEM(emu);
+
+    if (strncmp(cmd, "AT+NSOCR=STREAM,6,", 18) != 0 && strncmp(cmd, "AT+NSOCR=DGRAM,17,", 18) != 0)
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    pthread_mutex_lock(&modem->lock);
+    for (i = 0; i < MODEM_BC28_SOCKET_NUM && modem->created[i]; i++);
+    if (i < MODEM_BC28_SOCKET_NUM)
+    {
+        modem->created[i] = 1;
+        modem->connected[i] = 0;
+    }
+    pthread_mutex_unlock(&modem->lock);
+
+    if (i == MODEM_BC28_SOCKET_NUM)
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    modem_emu_printf(emu, "\r\n%d\r\n\r\nOK\r\n", i);
+}
+
+static void bc28_nsoco(struct modem_emu *emu, const char *cmd)
+{
+    int socket = -1, port = 0;
+    char ip[16] = {0};
+    struct modem_bc28 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+NSOCO=%d,%15[^,],%d", &socket, ip, &port) != 3 || socket < 0 ||
+            socket >= MODEM_BC28_SOCKET_NUM || !modem->created[socket] || strcmp(ip, modem->fail_ip) == 0)
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    pthread_mutex_lock(&modem->lock);
+    modem->connected[socket] = 1;
+    snprintf(modem->remote_ip[socket], sizeof(modem->remote_ip[0]), "%s", ip);
+    modem->remote_port[socket] = port;
+    pthread_mutex_unlock(&modem->lock);
+
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+/* the decoded data is acknowledged and echoed by the peer */
+static void bc28_send_done(struct modem_emu *emu, int socket, const char *data, int len)
+{
+    struct modem_bc28 *modem = MODEM(emu);
+
+    modem->sent_bytes += (uint32_t) len;
+    modem_emu_printf(emu, "\r\n%d,%d\r\n\r\nOK\r\n", socket, len);
+    modem_emu_printf(emu, "\r\n+NSOSTR:%d,1,1\r\n", socket);
+
+    if (modem->echo)
+    {
+        modem_bc28_push(modem, socket, data, (size_t) len);
+    }
+}
+
+static void bc28_nsosd(struct modem_emu *emu, const char *cmd)
+{
+    int socket = -1, len = 0, offset = 0, size = -1;
+    static char data[MODEM_EMU_LINE_MAX / 2];
+    struct modem_bc28 *modem = MODEM(emu);
+
+    /* AT+NSOSD=<socket>,<length>,<data>[,<flag>[,<sequence>]] */
+    if (sscanf(cmd, "AT+NSOSD=%d,%d,%n", &socket, &len, &offset) == 2 && offset > 0)
+    {
+        size = bc28_hex_decode(cmd + offset, data, sizeof(data));
+    }
+
+    if (socket < 0 || socket >= MODEM_BC28_SOCKET_NUM || !modem->connected[socket] || size != len)
+    {
+        modem->bad_sends++;
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    bc28_send_done(emu, socket, data, size);
+}
+
+static void bc28_nsost(struct modem_emu *emu, const char *cmd)
+{
+    int socket = -1, port = 0, len = 0, offset = 0, size = -1;
+    char ip[16] = {0};
+    static char data[MODEM_EMU_LINE_MAX / 2];
+    struct modem_bc28 *modem = MODEM(emu);
+
+    /* AT+NSOST=<socket>,<remote_addr>,<remote_port>,<length>,<data>[,<sequence>] */
+    if (sscanf(cmd, "AT+NSOST=%d,%15[^,],%d,%d,%n", &socket, ip, &port, &len, &offset) == 4 && offset > 0)
+    {
+        size = bc28_hex_decode(cmd + offset, data, sizeof(data));
+    }
+
+    if (socket < 0 || socket >= MODEM_BC28_SOCKET_NUM || !modem->created[socket] || size != len)
+    {
+        modem->bad_sends++;
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    pthread_mutex_lock(&modem->lock);
+    snprintf(modem->remote_ip[socket], sizeof(modem->remote_ip[0]), "%s", ip);
+    modem->remote_port[socket] = port;
+    pthread_mutex_unlock(&modem->lock);
+
+    bc28_send_done(emu, socket, data, size);
+}
+
+static void bc28_nsocl(struct modem_emu *emu, const char *cmd)
+{
+    int socket = -1;
+    struct modem_bc28 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+NSOCL=%d", &socket) != 1 || socket < 0 || socket >= MODEM_BC28_SOCKET_NUM ||
+            !modem->created[socket])
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    pthread_mutex_lock(&modem->lock);
+    modem->created[socket] = 0;
+    modem->connected[socket] = 0;
+    pthread_mutex_unlock(&modem->lock);
+
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+static void bc28_qdns(struct modem_emu *emu, const char *cmd)
+{
+    int i;
+    char name[64] = {0};
+    struct modem_bc28 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+QDNS=0,%63s", name) != 1)
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    /* the address follows the response */
+    modem_emu_printf(emu, "\r\nOK\r\n");
+    for (i = 0; i < modem->domain_num; i++)
+    {
+        if (strcmp(modem->domains[i].name, name) == 0)
+        {
+            modem_emu_printf(emu, "\r\n+QDNS:%s\r\n", modem->domains[i].ip);
+            return;
+        }
+    }
+
+    modem_emu_printf(emu, "\r\n+QDNS:FAIL\r\n");
+}
+
+/* the specific prefixes are placed before the shorter ones they start with */
+static const struct modem_emu_rule bc28_rules[] =
+{
+    {"ATE0",              bc28_ok},
+    {"ATI",               bc28_ati},
+    {"AT+QREGSWT=",       bc28_ok},
+    {"AT+NCONFIG=",       bc28_ok},
+    {"AT+NRB",            bc28_ok},
+    {"AT+CGSN=",          bc28_cgsn},
+    {"AT+NBAND=",         bc28_ok},
+    {"AT+CFUN=",          bc28_ok},
+    {"AT+NSONMI=",        bc28_ok},
+    {"AT+CEDRXS=",        bc28_ok},
+    {"AT+CPSMS=",         bc28_ok},
+    {"AT+CIMI",           bc28_cimi},
+    {"AT+CGATT?",         bc28_cgatt},
+    {"AT+CGATT=",         bc28_ok},
+    {"AT+NATSPEED?",      bc28_natspeed},
+    {"AT+CPIN?",          bc28_cpin},
+    {"AT+CSQ",            bc28_csq},
+    {"AT+CGPADDR",        bc28_cgpaddr},
+    {"AT+QIDNSCFG?",      bc28_qidnscfg},
+    {"AT+QIDNSCFG=",      bc28_ok},
+    {"AT+CSCON?",         bc28_cscon},
+    {"AT+CSCON=",         bc28_ok},
+    {"AT+NSOCR=",         bc28_nsocr},
+    {"AT+NSOCO=",         bc28_nsoco},
+    {"AT+NSOSD=",         bc28_nsosd},
+    {"AT+NSOST=",         bc28_nsost},
+    {"AT+NSOCL=",         bc28_nsocl},
+    {"AT+QDNS=",          bc28_qdns},
+    {"AT",                bc28_ok},
+};
+
+int modem_bc28_open(struct modem_bc28 *modem, uint32_t baud)
+{
+    memset(modem, 0x00, sizeof(struct modem_bc28));
+    pthread_mutex_init(&modem->lock, NULL);
+    modem->echo = 1;
+    modem->attached = 1;
+    modem->cscon = 1;
+
+    return modem_emu_open(&modem->emu, bc28_rules, sizeof(bc28_rules) / sizeof(bc28_rules[0]), baud, modem);
+}
+
+void modem_bc28_close(struct modem_bc28 *modem)
+{
+    modem_emu_close(&modem->emu);
+}
+
+void modem_bc28_domain_add(struct modem_bc28 *modem, const char *name, const char *ip)
+{
+    if (modem->domain_num < MODEM_BC28_DOMAIN_NUM)
+    {
+        snprintf(modem->domains[modem->domain_num].name, sizeof(modem->domains[0].name), "%s", name);
+        snprintf(modem->domains[modem->domain_num].ip, sizeof(modem->domains[0].ip), "%s", ip);
+        modem->domain_num++;
+    }
+}
+
+void modem_bc28_connect_fail(struct modem_bc28 *modem, const char *ip)
+{
+    snprintf(modem->fail_ip, sizeof(modem->fail_ip), "%s", ip);
+}
+
+void modem_bc28_push(struct modem_bc28 *modem, int socket, const char *data, size_t len)
+{
+    size_t i, seg = 0, size = 0;
+    char hex[MODEM_BC28_SEGMENT_SIZE * 2 + 1];
+
+    if (socket < 0 || socket >= MODEM_BC28_SOCKET_NUM)
+    {
+        return;
+    }
+
+    /* +NSONMI:<socket>,<remote_addr>,<remote_port>,<length>,<data> */
+    while (seg < len)
+    {
+        size = len - seg < MODEM_BC28_SEGMENT_SIZE ? len - seg : MODEM_BC28_SEGMENT_SIZE;
+        for (i = 0; i < size; i++)
+        {
+            snprintf(hex + i * 2, 3, "%02X", (unsigned char) data[seg + i]);
+        }
+        modem_emu_printf(&modem->emu, "\r\n+NSONMI:%d,%s,%d,%u,%s\r\n", socket, modem->remote_ip[socket],
+                         modem->remote_port[socket], (unsigned) size, hex);
+        seg += size;
+    }
+}
+
+void modem_bc28_remote_close(struct modem_bc28 *modem, int socket)
+{
+    pthread_mutex_lock(&modem->lock);
+    modem->connected[socket] = 0;
+    pthread_mutex_unlock(&modem->lock);
+
+    modem_emu_printf(&modem->emu, "\r\n+NSOCLI: %d\r\n", socket);
+}
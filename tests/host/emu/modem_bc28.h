@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __MODEM_BC28_H__
+#define __MODEM_BC28_H__
+
+#include "modem_emu.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * BC28 profile of the modem emulator, it speaks the NB-IoT NSO* socket
+ * commands with the data hex encoded on the command line. The peer of every
+ * socket echoes the data sent to it by "+NSONMI:<socket>,<addr>,<port>,<len>,<hex>"
+ * of "AT+NSONMI=2", the send is acknowledged by "+NSOSTR:<socket>,<seq>,1".
+ * A send command whose hex data doesn't match the length is answered by "ERROR".
+ */
+
+#define MODEM_BC28_SOCKET_NUM          7
+#define MODEM_BC28_DOMAIN_NUM          8
+/* the bytes of data in one "+NSONMI" URC */
+#define MODEM_BC28_SEGMENT_SIZE        512
+
+struct modem_bc28
+{
+    struct modem_emu emu;
+    pthread_mutex_t lock;                        /* protects the socket state */
+
+    int echo;                                    /* the peer echoes the data sent to it */
+    int attached;                                /* the packet domain is attached, "AT+CGATT?" */
+    int cscon;                                   /* the RRC connection state, "AT+CSCON?" */
+    int created[MODEM_BC28_SOCKET_NUM];
+    int connected[MODEM_BC28_SOCKET_NUM];
+    char remote_ip[MODEM_BC28_SOCKET_NUM][16];   /* the peer of the socket */
+    int remote_port[MODEM_BC28_SOCKET_NUM];
+    char fail_ip[16];                            /* the connect to this address fails */
+
+    uint32_t sent_bytes;                         /* the data bytes decoded from the send commands */
+    uint32_t bad_sends;                          /* the send commands with broken hex data */
+
+    struct
+    {
+        char name[64];
+        char ip[16];
+    } domains[MODEM_BC28_DOMAIN_NUM];
+    int domain_num;
+};
+
+int modem_bc28_open(struct modem_bc28 *modem, uint32_t baud);
+void modem_bc28_close(struct modem_bc28 *modem);
+
+/* the domain name answered by "AT+QDNS", the other names fail */
+void modem_bc28_domain_add(struct modem_bc28 *modem, const char *name, const char *ip);
+/* the connect to the address fails */
+void modem_bc28_connect_fail(struct modem_bc28 *modem, const char *ip);
+/* the peer sends the data on the socket */
+void modem_bc28_push(struct modem_bc28 *modem, int socket, const char *data, size_t len);
+/* the peer closes the socket */
+void modem_bc28_remote_close(struct modem_bc28 *modem, int socket);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MODEM_BC28_H__ */
@@ -0,0 +1,491 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "modem_ec20.h"
+
+#define MODEM(emu)                     ((struct modem_ec20 *) (emu)->user_data)
+
+/* the TCP/IP error codes of "+QIOPEN" */
+#define EC20_ERR_SOCKET_IDENTITY       552
+#define EC20_ERR_PDP_NOT_ACTIVE        561
+#define EC20_ERR_CONNECT_FAIL          566
+
+static uint64_t ec20_time_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000ULL + (uint64_t) ts.tv_nsec / 1000;
+}
+
+/* the bytes acknowledged by the peer now, the sends older than the acknowledge time */
+static uint32_t ec20_acked(struct modem_ec20 *modem, int id)
+{
+    int i;
+    uint64_t now = ec20_time_us();
+
+    if (modem->ack_delay == 0)
+    {
+        return modem->sent[id];
+    }
+
+    for (i = 0; i < MODEM_EC20_ACK_LOG_NUM; i++)
+    {
+        if (modem->ack_log[id][i].sent > modem->acked[id] &&
+                modem->ack_log[id][i].time + (uint64_t) modem->ack_delay * 1000 <= now)
+        {
+            modem->acked[id] = modem->ack_log[id][i].sent;
+        }
+    }
+
+    return modem->acked[id];
+}
+
+static void ec20_ok(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+static void ec20_ipr(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+IPR: 115200\r\n\r\nOK\r\n");
+}
+
+static void ec20_ati(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\nQuectel\r\nEC20F\r\nRevision: EC20CEFAGR06A05M4G\r\n\r\nOK\r\n");
+}
+
+static void ec20_gsn(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n866123456789012\r\n\r\nOK\r\n");
+}
+
+static void ec20_cpin(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+CPIN: READY\r\n\r\nOK\r\n");
+}
+
+static void ec20_cimi(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n460001234567890\r\n\r\nOK\r\n");
+}
+
+static void ec20_qccid(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+QCCID: 89860012345678901234\r\n\r\nOK\r\n");
+}
+
+static void ec20_csq(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+CSQ: 24,99\r\n\r\nOK\r\n");
+}
+
+static void ec20_creg(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+CREG: 0,1\r\n\r\nOK\r\n");
+}
+
+static void ec20_cxreg_query(struct modem_emu *emu, const char *cmd)
+{
+    /* "AT+CGREG?" or "AT+CEREG?" */
+    modem_emu_printf(emu, "\r\n+C%cREG: %d,%d\r\n\r\nOK\r\n", cmd[4], MODEM(emu)->reg_report,
+                     MODEM(emu)->reg_stat);
+}
+
+static void ec20_cxreg_set(struct modem_emu *emu, const char *cmd)
+{
+    MODEM(emu)->reg_report = atoi(cmd + sizeof("AT+CGREG=") - 1);
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+static void ec20_cops(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+COPS: 0,0,\"CHINA MOBILE\",7\r\n\r\nOK\r\n");
+}
+
+static void ec20_cclk(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+CCLK: \"26/10/17,08:00:00+32\"\r\n\r\nOK\r\n");
+}
+
+static void ec20_qideact(struct modem_emu *emu, const char *cmd)
+{
+    struct modem_ec20 *modem = MODEM(emu);
+
+    pthread_mutex_lock(&modem->lock);
+    modem->context = 0;
+    memset(modem->connected, 0x00, sizeof(modem->connected));
+    memset(modem->recv_len, 0x00, sizeof(modem->recv_len));
+    pthread_mutex_unlock(&modem->lock);
+
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+static void ec20_qiact(struct modem_emu *emu, const char *cmd)
+{
+    struct modem_ec20 *modem = MODEM(emu);
+
+    pthread_mutex_lock(&modem->lock);
+    if (modem->act_fail > 0)
+    {
+        modem->act_fail--;
+        pthread_mutex_unlock(&modem->lock);
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+    modem->context = 1;
+    pthread_mutex_unlock(&modem->lock);
+
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+static void ec20_qiact_query(struct modem_emu *emu, const char *cmd)
+{
+    if (MODEM(emu)->context)
+    {
+        modem_emu_printf(emu, "\r\n+QIACT: 1,1,1,\"10.64.1.2\"\r\n\r\nOK\r\n");
+    }
+    else
+    {
+        modem_emu_printf(emu, "\r\nOK\r\n");
+    }
+}
+
+static void ec20_qidnscfg(struct modem_emu *emu, const char *cmd)
+{
+    if (strcmp(cmd, "AT+QIDNSCFG=1") == 0)
+    {
+        modem_emu_printf(emu, "\r\n+QIDNSCFG: 1,\"8.8.8.8\",\"114.114.114.114\"\r\n\r\nOK\r\n");
+    }
+    else
+    {
+        modem_emu_printf(emu, "\r\nOK\r\n");
+    }
+}
+
+static void ec20_qiopen(struct modem_emu *emu, const char *cmd)
+{
+    int context = 0, id = -1, port = 0, local_port = 0, mode = -1, err = 0;
+    char type[8] = {0}, ip[64] = {0};
+    struct modem_ec20 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+QIOPEN=%d,%d,\"%7[^\"]\",\"%63[^\"]\",%d,%d,%d", &context, &id, type, ip,
+               &port, &local_port, &mode) != 7 || context != 1 || id < 0 || id >= MODEM_EC20_SOCKET_NUM ||
+            (mode != 0 && mode != 1))
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    pthread_mutex_lock(&modem->lock);
+    if (modem->connected[id])
+    {
+        err = EC20_ERR_SOCKET_IDENTITY;
+    }
+    else if (modem->context == 0)
+    {
+        err = EC20_ERR_PDP_NOT_ACTIVE;
+    }
+    else if (strcmp(ip, modem->fail_ip) == 0)
+    {
+        err = EC20_ERR_CONNECT_FAIL;
+    }
+    else
+    {
+        modem->connected[id] = 1;
+        modem->push[id] = mode;
+        modem->sent[id] = 0;
+        modem->acked[id] = 0;
+        memset(modem->ack_log[id], 0x00, sizeof(modem->ack_log[id]));
+        modem->recv_len[id] = 0;
+    }
+    pthread_mutex_unlock(&modem->lock);
+
+    /* the result follows the response when the connection is set up */
+    modem_emu_printf(emu, "\r\nOK\r\n\r\n+QIOPEN: %d,%d\r\n", id, err);
+}
+
+static void ec20_qiclose(struct modem_emu *emu, const char *cmd)
+{
+    int id = -1;
+    struct modem_ec20 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+QICLOSE=%d", &id) != 1 || id < 0 || id >= MODEM_EC20_SOCKET_NUM)
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    pthread_mutex_lock(&modem->lock);
+    modem->connected[id] = 0;
+    modem->recv_len[id] = 0;
+    pthread_mutex_unlock(&modem->lock);
+
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+static void ec20_send_data(struct modem_emu *emu, const char *data, size_t len)
+{
+    struct modem_ec20 *modem = MODEM(emu);
+    int id = modem->send_socket;
+
+    modem->sent[id] += (uint32_t) len;
+    /* the oldest send is dropped, the data before it is acknowledged by then */
+    if (modem->ack_delay && modem->ack_log[id][0].sent > ec20_acked(modem, id))
+    {
+        modem->acked[id] = modem->ack_log[id][0].sent;
+    }
+    memmove(&(modem->ack_log[id][0]), &(modem->ack_log[id][1]), sizeof(modem->ack_log[id][0]) * (MODEM_EC20_ACK_LOG_NUM - 1));
+    modem->ack_log[id][MODEM_EC20_ACK_LOG_NUM - 1].time = ec20_time_us();
+    modem->ack_log[id][MODEM_EC20_ACK_LOG_NUM - 1].sent = modem->sent[id];
+    modem_emu_printf(emu, "\r\nSEND OK\r\n");
+
+    if (modem->echo)
+    {
+        modem_ec20_push(modem, id, data, len);
+    }
+}
+
+static void ec20_qisend(struct modem_emu *emu, const char *cmd)
+{
+    int id = -1, len = -1;
+    uint32_t acked = 0;
+    struct modem_ec20 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+QISEND=%d,%d", &id, &len) != 2 || id < 0 || id >= MODEM_EC20_SOCKET_NUM ||
+            len < 0 || len > MODEM_EC20_SEND_MAX_SIZE || !modem->connected[id])
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    /* the length 0 queries the bytes sent, acknowledged and not acknowledged */
+    if (len == 0)
+    {
+        acked = ec20_acked(modem, id);
+        modem_emu_printf(emu, "\r\n+QISEND: %u,%u,%u\r\n\r\nOK\r\n", modem->sent[id], acked, modem->sent[id] - acked);
+        return;
+    }
+
+    modem->send_socket = id;
+    modem_emu_expect_data(emu, (size_t) len, ec20_send_data);
+    modem_emu_printf(emu, "\r\n> ");
+}
+
+static void ec20_qird(struct modem_emu *emu, const char *cmd)
+{
+    int id = -1, len = 0;
+    size_t size = 0;
+    char *data = NULL;
+    struct modem_ec20 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+QIRD=%d,%d", &id, &len) != 2 || id < 0 || id >= MODEM_EC20_SOCKET_NUM || len <= 0 ||
+            modem->push[id])
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    pthread_mutex_lock(&modem->lock);
+    if (modem->read_fail > 0)
+    {
+        modem->read_fail--;
+        pthread_mutex_unlock(&modem->lock);
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+    size = modem->recv_len[id] < (size_t) len ? modem->recv_len[id] : (size_t) len;
+    if (size > 0)
+    {
+        data = (char *) malloc(size);
+        memcpy(data, modem->recv_buf[id], size);
+        memmove(modem->recv_buf[id], modem->recv_buf[id] + size, modem->recv_len[id] - size);
+        modem->recv_len[id] -= size;
+    }
+    pthread_mutex_unlock(&modem->lock);
+
+    /* the empty buffer is read as "+QIRD: 0" */
+    modem_emu_printf(emu, "\r\n+QIRD: %u\r\n", (unsigned) size);
+    if (data)
+    {
+        modem_emu_write(emu, data, size);
+        free(data);
+        modem_emu_printf(emu, "\r\n");
+    }
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+static void ec20_qidnsgip(struct modem_emu *emu, const char *cmd)
+{
+    int i, context = 0;
+    char name[64] = {0};
+    struct modem_ec20 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+QIDNSGIP=%d,\"%63[^\"]\"", &context, name) != 2 || context != 1)
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    /* the addresses follow the response after the result header */
+    modem_emu_printf(emu, "\r\nOK\r\n");
+    for (i = 0; i < modem->domain_num; i++)
+    {
+        if (strcmp(modem->domains[i].name, name) == 0)
+        {
+            modem_emu_printf(emu, "\r\n+QIURC: \"dnsgip\",0,1,600\r\n"
+                             "\r\n+QIURC: \"dnsgip\",\"%s\"\r\n", modem->domains[i].ip);
+            return;
+        }
+    }
+    if (modem->domain_any[0])
+    {
+        modem_emu_printf(emu, "\r\n+QIURC: \"dnsgip\",0,1,600\r\n"
+                         "\r\n+QIURC: \"dnsgip\",\"%s\"\r\n", modem->domain_any);
+        return;
+    }
+
+    /* 565: DNS parse failed */
+    modem_emu_printf(emu, "\r\n+QIURC: \"dnsgip\",565\r\n");
+}
+
+/* the specific prefixes are placed before the shorter ones they start with */
+static const struct modem_emu_rule ec20_rules[] =
+{
+    {"ATV1",              ec20_ok},
+    {"ATE0",              ec20_ok},
+    {"ATI",               ec20_ati},
+    {"AT+CMEE=",          ec20_ok},
+    {"AT+IPR?",           ec20_ipr},
+    {"AT+GSN",            ec20_gsn},
+    {"AT+CPIN?",          ec20_cpin},
+    {"AT+CIMI",           ec20_cimi},
+    {"AT+QCCID",          ec20_qccid},
+    {"AT+CSQ",            ec20_csq},
+    {"AT+CREG?",          ec20_creg},
+    {"AT+CGREG?",         ec20_cxreg_query},
+    {"AT+CEREG?",         ec20_cxreg_query},
+    {"AT+CGREG=",         ec20_cxreg_set},
+    {"AT+CEREG=",         ec20_cxreg_set},
+    {"AT+COPS?",          ec20_cops},
+    {"AT+QICSGP=",        ec20_ok},
+    {"AT+CTZU=",          ec20_ok},
+    {"AT+CCLK?",          ec20_cclk},
+    {"AT+QIDEACT=",       ec20_qideact},
+    {"AT+QIACT?",         ec20_qiact_query},
+    {"AT+QIACT=",         ec20_qiact},
+    {"AT+QIDNSCFG=",      ec20_qidnscfg},
+    {"AT+QIOPEN=",        ec20_qiopen},
+    {"AT+QICLOSE=",       ec20_qiclose},
+    {"AT+QISEND=",        ec20_qisend},
+    {"AT+QIRD=",          ec20_qird},
+    {"AT+QIDNSGIP=",      ec20_qidnsgip},
+    {"AT",                ec20_ok},
+};
+
+int modem_ec20_open(struct modem_ec20 *modem, uint32_t baud)
+{
+    memset(modem, 0x00, sizeof(struct modem_ec20));
+    pthread_mutex_init(&modem->lock, NULL);
+    modem->echo = 1;
+    modem->reg_stat = 1;
+
+    return modem_emu_open(&modem->emu, ec20_rules, sizeof(ec20_rules) / sizeof(ec20_rules[0]), baud, modem);
+}
+
+void modem_ec20_close(struct modem_ec20 *modem)
+{
+    modem_emu_close(&modem->emu);
+}
+
+void modem_ec20_domain_add(struct modem_ec20 *modem, const char *name, const char *ip)
+{
+    if (modem->domain_num < MODEM_EC20_DOMAIN_NUM)
+    {
+        snprintf(modem->domains[modem->domain_num].name, sizeof(modem->domains[0].name), "%s", name);
+        snprintf(modem->domains[modem->domain_num].ip, sizeof(modem->domains[0].ip), "%s", ip);
+        modem->domain_num++;
+    }
+}
+
+void modem_ec20_connect_fail(struct modem_ec20 *modem, const char *ip)
+{
+    snprintf(modem->fail_ip, sizeof(modem->fail_ip), "%s", ip);
+}
+
+void modem_ec20_push(struct modem_ec20 *modem, int id, const char *data, size_t len)
+{
+    size_t seg = 0, size = 0;
+
+    if (id < 0 || id >= MODEM_EC20_SOCKET_NUM)
+    {
+        return;
+    }
+
+    if (modem->push[id] == 0)
+    {
+        pthread_mutex_lock(&modem->lock);
+        size = MODEM_EC20_BUF_SIZE - modem->recv_len[id];
+        size = len < size ? len : size;
+        memcpy(modem->recv_buf[id] + modem->recv_len[id], data, size);
+        modem->recv_len[id] += size;
+        pthread_mutex_unlock(&modem->lock);
+
+        modem_emu_printf(&modem->emu, "\r\n+QIURC: \"recv\",%d\r\n", id);
+        return;
+    }
+
+    /* the data is pushed in TCP segments */
+    while (seg < len)
+    {
+        size = len - seg < MODEM_EC20_SEGMENT_SIZE ? len - seg : MODEM_EC20_SEGMENT_SIZE;
+        modem_emu_printf(&modem->emu, "\r\n+QIURC: \"recv\",%d,%u\r\n", id, (unsigned) size);
+        modem_emu_write(&modem->emu, data + seg, size);
+        seg += size;
+    }
+}
+
+void modem_ec20_remote_close(struct modem_ec20 *modem, int id)
+{
+    pthread_mutex_lock(&modem->lock);
+    modem->connected[id] = 0;
+    modem->recv_len[id] = 0;
+    pthread_mutex_unlock(&modem->lock);
+
+    modem_emu_printf(&modem->emu, "\r\n+QIURC: \"closed\",%d\r\n", id);
+}
+
+void modem_ec20_pdp_deact(struct modem_ec20 *modem)
+{
+    pthread_mutex_lock(&modem->lock);
+    modem->context = 0;
+    memset(modem->connected, 0x00, sizeof(modem->connected));
+    memset(modem->recv_len, 0x00, sizeof(modem->recv_len));
+    pthread_mutex_unlock(&modem->lock);
+
+    modem_emu_printf(&modem->emu, "\r\n+QIURC: \"pdpdeact\",1\r\n");
+}
+
+void modem_ec20_reg_set(struct modem_ec20 *modem, int stat)
+{
+    modem->reg_stat = stat;
+
+    if (modem->reg_report)
+    {
+        modem_emu_printf(&modem->emu, "\r\n+CGREG: %d\r\n\r\n+CEREG: %d\r\n", stat, stat);
+    }
+}
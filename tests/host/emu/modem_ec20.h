@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __MODEM_EC20_H__
+#define __MODEM_EC20_H__
+
+#include "modem_emu.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * EC20 profile of the modem emulator, it speaks the Quectel QIOPEN/QISEND
+ * socket commands on packet data context 1. The peer of every connection
+ * echoes the data sent to it, pushed by "+QIURC: "recv",<id>,<len>" in
+ * direct push mode or buffered in the module, noticed by "+QIURC: "recv",<id>"
+ * and read by "AT+QIRD" in buffer access mode. The access mode is taken from
+ * "AT+QIOPEN" for every connection. The registration is answered for the
+ * "+CGREG" and "+CEREG" queries and reported after "AT+CxREG=1". The peer
+ * acknowledges the data ack_delay milliseconds after it's sent, it's seen by
+ * the "AT+QISEND=<id>,0" query.
+ */
+
+#define MODEM_EC20_SOCKET_NUM          12
+#define MODEM_EC20_BUF_SIZE            (16 * 1024)
+#define MODEM_EC20_DOMAIN_NUM          8
+#define MODEM_EC20_SEGMENT_SIZE        1460
+#define MODEM_EC20_SEND_MAX_SIZE       1460
+/* the sends kept for the acknowledge of the peer */
+#define MODEM_EC20_ACK_LOG_NUM         32
+
+struct modem_ec20
+{
+    struct modem_emu emu;
+    pthread_mutex_t lock;                        /* protects the connection state and module buffers */
+
+    int echo;                                    /* the peer echoes the data sent to it */
+    int context;                                 /* packet data context 1 is active, "AT+QIACT" */
+    int reg_stat;                                /* the registration answered and reported */
+    int reg_report;                              /* the registration changes are reported, "AT+CxREG=1" */
+    int connected[MODEM_EC20_SOCKET_NUM];
+    int push[MODEM_EC20_SOCKET_NUM];             /* direct push access mode of the connection */
+    char fail_ip[16];                            /* the connect to this address fails */
+
+    int send_socket;                             /* the connection of the send in progress */
+    uint32_t sent[MODEM_EC20_SOCKET_NUM];        /* the bytes sent */
+    uint32_t ack_delay;                          /* the peer acknowledge time in milliseconds, 0 for at once */
+    struct
+    {
+        uint64_t time;                           /* the time of the send in microseconds */
+        uint32_t sent;                           /* the bytes sent up to this send */
+    } ack_log[MODEM_EC20_SOCKET_NUM][MODEM_EC20_ACK_LOG_NUM];
+    uint32_t acked[MODEM_EC20_SOCKET_NUM];       /* the bytes acknowledged by the peer */
+    char recv_buf[MODEM_EC20_SOCKET_NUM][MODEM_EC20_BUF_SIZE];
+    size_t recv_len[MODEM_EC20_SOCKET_NUM];
+
+    int read_fail;                               /* the next reads are answered by "ERROR" */
+    int act_fail;                                /* the next context activations are answered by "ERROR" */
+
+    struct
+    {
+        char name[64];
+        char ip[16];
+    } domains[MODEM_EC20_DOMAIN_NUM];
+    int domain_num;
+    char domain_any[16];                         /* the address of the names not added, empty for none */
+};
+
+int modem_ec20_open(struct modem_ec20 *modem, uint32_t baud);
+void modem_ec20_close(struct modem_ec20 *modem);
+
+/* the domain name answered by "AT+QIDNSGIP", the other names fail unless domain_any is set */
+void modem_ec20_domain_add(struct modem_ec20 *modem, const char *name, const char *ip);
+/* the connect to the address fails */
+void modem_ec20_connect_fail(struct modem_ec20 *modem, const char *ip);
+/* the peer sends the data on the connection */
+void modem_ec20_push(struct modem_ec20 *modem, int id, const char *data, size_t len);
+/* the peer closes the connection */
+void modem_ec20_remote_close(struct modem_ec20 *modem, int id);
+/* the network deactivates the packet data context, all connections are lost */
+void modem_ec20_pdp_deact(struct modem_ec20 *modem);
+/* the registration changes, it's reported when the reports are enabled */
+void modem_ec20_reg_set(struct modem_ec20 *modem, int stat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MODEM_EC20_H__ */
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "modem_emu.h"
+
+/* the time in microseconds the bytes take on the line, 10 bits per byte */
+static uint64_t modem_emu_wire_time(struct modem_emu *emu, size_t len)
+{
+    return emu->baud ? (uint64_t) len * 10 * 1000000 / emu->baud : 0;
+}
+
+/* the bytes on the line are printed with AT_HOST_TRACE set */
+static void modem_emu_trace(const char *dir, const char *buf, size_t len)
+{
+    static int trace = -1;
+    size_t i;
+
+    if (trace < 0)
+    {
+        trace = getenv("AT_HOST_TRACE") != NULL;
+    }
+    if (trace == 0)
+    {
+        return;
+    }
+
+    fprintf(stderr, "%s ", dir);
+    for (i = 0; i < len && i < 128; i++)
+    {
+        if (buf[i] == '\r')
+        {
+            fprintf(stderr, "\\r");
+        }
+        else if (buf[i] == '\n')
+        {
+            fprintf(stderr, "\\n");
+        }
+        else if (buf[i] >= 0x20 && buf[i] < 0x7F)
+        {
+            fputc(buf[i], stderr);
+        }
+        else
+        {
+            fprintf(stderr, "\\x%02x", (unsigned char) buf[i]);
+        }
+    }
+    fprintf(stderr, "%s\n", len > 128 ? "..." : "");
+}
+
+static void modem_emu_sleep(uint64_t us)
+{
+    struct timespec ts;
+
+    ts.tv_sec = (time_t) (us / 1000000);
+    ts.tv_nsec = (long) (us % 1000000) * 1000;
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR);
+}
+
+void modem_emu_write(struct modem_emu *emu, const void *buf, size_t len)
+{
+    size_t sent = 0;
+    ssize_t ret = 0;
+
+    pthread_mutex_lock(&emu->lock);
+
+    /* the bytes reach the AT client when they are through the line */
+    modem_emu_sleep(modem_emu_wire_time(emu, len));
+    modem_emu_trace("<<", (const char *) buf, len);
+
+    while (sent < len)
+    {
+        ret = write(emu->master, (const char *) buf + sent, len - sent);
+        if (ret < 0 && (errno == EINTR || errno == EAGAIN))
+        {
+            modem_emu_sleep(1000);
+            continue;
+        }
+        if (ret <= 0)
+        {
+            break;
+        }
+        sent += (size_t) ret;
+    }
+    emu->tx_bytes += sent;
+
+    pthread_mutex_unlock(&emu->lock);
+}
+
+void modem_emu_printf(struct modem_emu *emu, const char *fmt, ...)
+{
+    char buf[MODEM_EMU_LINE_MAX * 2];
+    va_list args;
+    int len;
+
+    va_start(args, fmt);
+    len = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+
+    if (len > 0)
+    {
+        modem_emu_write(emu, buf, (size_t) len < sizeof(buf) ? (size_t) len : sizeof(buf) - 1);
+    }
+}
+
+void modem_emu_expect_data(struct modem_emu *emu, size_t len, modem_emu_data_handler_t handler)
+{
+    free(emu->data);
+    emu->data = (char *) malloc(len ? len : 1);
+    emu->data_len = 0;
+    emu->data_need = len;
+    emu->data_handler = handler;
+}
+
+void modem_emu_stream(struct modem_emu *emu, modem_emu_data_handler_t handler)
+{
+    emu->stream_handler = handler;
+}
+
+uint32_t modem_emu_count(struct modem_emu *emu, const char *prefix)
+{
+    size_t i;
+
+    for (i = 0; i < emu->rule_num && i < MODEM_EMU_RULE_MAX; i++)
+    {
+        if (strcmp(emu->rules[i].prefix, prefix) == 0)
+        {
+            return emu->counts[i];
+        }
+    }
+
+    return 0;
+}
+
+static void modem_emu_dispatch(struct modem_emu *emu)
+{
+    size_t i;
+
+    emu->line[emu->line_len] = '\0';
+
+    for (i = 0; i < emu->rule_num && i < MODEM_EMU_RULE_MAX; i++)
+    {
+        if (strncmp(emu->line, emu->rules[i].prefix, strlen(emu->rules[i].prefix)) == 0)
+        {
+            emu->counts[i]++;
+            emu->rules[i].handler(emu, emu->line);
+            return;
+        }
+    }
+
+    emu->unknown++;
+    modem_emu_printf(emu, "\r\nERROR\r\n");
+}
+
+static void modem_emu_input(struct modem_emu *emu, char ch)
+{
+    modem_emu_data_handler_t handler;
+
+    /* the "\n" ending the command line isn't taken as the data */
+    if (emu->line_end && ch == '\n')
+    {
+        emu->line_end = 0;
+        return;
+    }
+    emu->line_end = 0;
+
+    if (emu->data_need > 0)
+    {
+        emu->data[emu->data_len++] = ch;
+        if (emu->data_len == emu->data_need)
+        {
+            handler = emu->data_handler;
+            emu->data_need = 0;
+            handler(emu, emu->data, emu->data_len);
+        }
+        return;
+    }
+
+    if (ch == '\n')
+    {
+        return;
+    }
+
+    if (ch == '\r')
+    {
+        emu->line_end = 1;
+        if (emu->line_len > 0)
+        {
+            modem_emu_dispatch(emu);
+        }
+        emu->line_len = 0;
+        return;
+    }
+
+    if (emu->line_len < MODEM_EMU_LINE_MAX - 1)
+    {
+        emu->line[emu->line_len++] = ch;
+    }
+}
+
+static void *modem_emu_thread_entry(void *parameter)
+{
+    struct modem_emu *emu = (struct modem_emu *) parameter;
+    struct pollfd pfd;
+    char buf[256];
+    ssize_t len, i;
+
+    while (emu->running)
+    {
+        pfd.fd = emu->master;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        if (poll(&pfd, 1, 50) <= 0)
+        {
+            continue;
+        }
+
+        len = read(emu->master, buf, sizeof(buf));
+        if (len <= 0)
+        {
+            continue;
+        }
+
+        /* the command is taken when its bytes are through the line */
+        modem_emu_sleep(modem_emu_wire_time(emu, (size_t) len));
+        emu->rx_bytes += (uint64_t) len;
+        modem_emu_trace(">>", buf, (size_t) len);
+
+        for (i = 0; i < len; i++)
+        {
+            /* the rest of the read is streamed, except the "\n" ending the command line */
+            if (emu->stream_handler && (emu->line_end == 0 || buf[i] != '\n'))
+            {
+                emu->line_end = 0;
+                emu->stream_handler(emu, buf + i, (size_t) (len - i));
+                break;
+            }
+            modem_emu_input(emu, buf[i]);
+        }
+    }
+
+    return NULL;
+}
+
+int modem_emu_open(struct modem_emu *emu, const struct modem_emu_rule *rules, size_t rule_num,
+                   uint32_t baud, void *user_data)
+{
+    struct termios tio;
+
+    memset(emu, 0x00, sizeof(struct modem_emu));
+    emu->rules = rules;
+    emu->rule_num = rule_num;
+    emu->baud = baud;
+    emu->user_data = user_data;
+    emu->slave = -1;
+
+    emu->master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (emu->master < 0 || grantpt(emu->master) != 0 || unlockpt(emu->master) != 0)
+    {
+        perror("modem emulator pseudo-terminal");
+        return -1;
+    }
+
+    emu->slave = open(ptsname(emu->master), O_RDWR | O_NOCTTY);
+    if (emu->slave < 0)
+    {
+        perror("modem emulator pseudo-terminal slave");
+        close(emu->master);
+        return -1;
+    }
+
+    /* the AT client reads and writes raw bytes */
+    tcgetattr(emu->slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(emu->slave, TCSANOW, &tio);
+    tcgetattr(emu->master, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(emu->master, TCSANOW, &tio);
+
+    pthread_mutex_init(&emu->lock, NULL);
+    emu->running = 1;
+    if (pthread_create(&emu->thread, NULL, modem_emu_thread_entry, emu) != 0)
+    {
+        emu->running = 0;
+        close(emu->slave);
+        close(emu->master);
+        return -1;
+    }
+
+    return 0;
+}
+
+void modem_emu_close(struct modem_emu *emu)
+{
+    if (emu->running)
+    {
+        emu->running = 0;
+        pthread_join(emu->thread, NULL);
+    }
+
+    free(emu->data);
+    emu->data = NULL;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __MODEM_EMU_H__
+#define __MODEM_EMU_H__
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Scriptable modem emulator on a pseudo-terminal. The AT client opens the
+ * slave side, the emulator thread reads the command lines on the master side
+ * and answers them by the rules of the module profile. The bytes are paced at
+ * the baud rate in both directions, 0 for no pacing.
+ */
+
+/* the hex encoded data of the NB-IoT send commands is on the command line */
+#define MODEM_EMU_LINE_MAX             4096
+#define MODEM_EMU_RULE_MAX             32
+
+struct modem_emu;
+
+/* command handler, the command line is given without "\r\n" */
+typedef void (*modem_emu_handler_t)(struct modem_emu *emu, const char *cmd);
+/* raw data handler, it's called when the expected data bytes are read */
+typedef void (*modem_emu_data_handler_t)(struct modem_emu *emu, const char *data, size_t len);
+
+struct modem_emu_rule
+{
+    const char *prefix;                          /* command prefix, the first matched rule answers */
+    modem_emu_handler_t handler;
+};
+
+struct modem_emu
+{
+    int master;                                  /* master side of the pseudo-terminal */
+    int slave;                                   /* slave side, opened for the AT client */
+    uint32_t baud;                               /* line rate in bit/s, 0 for no pacing */
+
+    const struct modem_emu_rule *rules;
+    size_t rule_num;
+    uint32_t counts[MODEM_EMU_RULE_MAX];         /* commands answered by every rule */
+    uint32_t unknown;                            /* commands answered by "ERROR" for no rule */
+
+    char line[MODEM_EMU_LINE_MAX];
+    size_t line_len;
+    int line_end;                                /* the last byte ended a command line */
+
+    /* raw data mode, the bytes after a send command */
+    char *data;
+    size_t data_len;
+    size_t data_need;
+    modem_emu_data_handler_t data_handler;
+
+    /* stream mode, all bytes go to the handler until it's stopped */
+    modem_emu_data_handler_t stream_handler;
+
+    uint64_t rx_bytes;                           /* bytes read from the AT client */
+    uint64_t tx_bytes;                           /* bytes written to the AT client */
+
+    pthread_t thread;
+    pthread_mutex_t lock;                        /* serializes the writes of emulator and test */
+    volatile int running;
+
+    void *user_data;                             /* module profile state */
+};
+
+/* open the pseudo-terminal and start the emulator thread */
+int modem_emu_open(struct modem_emu *emu, const struct modem_emu_rule *rules, size_t rule_num,
+                   uint32_t baud, void *user_data);
+/* stop the emulator thread and close the pseudo-terminal */
+void modem_emu_close(struct modem_emu *emu);
+
+/* write to the AT client, paced at the baud rate */
+void modem_emu_write(struct modem_emu *emu, const void *buf, size_t len);
+void modem_emu_printf(struct modem_emu *emu, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/* read the next len raw bytes and hand them to the handler, it's called in a command handler */
+void modem_emu_expect_data(struct modem_emu *emu, size_t len, modem_emu_data_handler_t handler);
+
+/* hand all bytes read to the handler, NULL to go back to the command lines */
+void modem_emu_stream(struct modem_emu *emu, modem_emu_data_handler_t handler);
+
+/* the number of commands answered by the rule of the prefix */
+uint32_t modem_emu_count(struct modem_emu *emu, const char *prefix);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MODEM_EMU_H__ */
@@ -0,0 +1,439 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "modem_esp8266.h"
+
+#define MODEM(emu)                     ((struct modem_esp8266 *) (emu)->user_data)
+
+static void esp8266_ok(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+static void esp8266_gmr(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "AT version:1.7.4.0(May 11 2020 19:13:04)\r\n"
+                     "SDK version:3.0.4(9532ceb)\r\n"
+                     "compile time:May 27 2020 10:12:17\r\n"
+                     "\r\nOK\r\n");
+}
+
+static void esp8266_cipmux(struct modem_emu *emu, const char *cmd)
+{
+    int mux = -1;
+
+    if (sscanf(cmd, "AT+CIPMUX=%d", &mux) != 1 || (mux != 0 && mux != 1))
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    MODEM(emu)->mux = mux;
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+static void esp8266_cipmode(struct modem_emu *emu, const char *cmd)
+{
+    int mode = -1;
+
+    if (sscanf(cmd, "AT+CIPMODE=%d", &mode) != 1 || (mode != 0 && mode != 1) || (mode && MODEM(emu)->mux))
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    MODEM(emu)->mode = mode;
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+static void esp8266_ciprecvmode(struct modem_emu *emu, const char *cmd)
+{
+    MODEM(emu)->passive = (strcmp(cmd, "AT+CIPRECVMODE=1") == 0);
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+static void esp8266_cwjap(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "WIFI CONNECTED\r\nWIFI GOT IP\r\n\r\nOK\r\n");
+}
+
+static void esp8266_cifsr(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "+CIFSR:STAIP,\"192.168.1.10\"\r\n"
+                     "+CIFSR:STAMAC,\"5c:cf:7f:00:00:01\"\r\n"
+                     "\r\nOK\r\n");
+}
+
+static void esp8266_cipsta(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "+CIPSTA:ip:\"192.168.1.10\"\r\n"
+                     "+CIPSTA:gateway:\"192.168.1.1\"\r\n"
+                     "+CIPSTA:netmask:\"255.255.255.0\"\r\n"
+                     "\r\nOK\r\n");
+}
+
+static void esp8266_cipdns(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "+CIPDNS:1,\"8.8.8.8\",\"114.114.114.114\"\r\n\r\nOK\r\n");
+}
+
+static void esp8266_cwdhcp(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "+CWDHCP:3\r\n\r\nOK\r\n");
+}
+
+static void esp8266_cipstart(struct modem_emu *emu, const char *cmd)
+{
+    int link = -1;
+    char type[8] = {0}, ip[64] = {0};
+    struct modem_esp8266 *modem = MODEM(emu);
+
+    if (modem->mux == 0 && sscanf(cmd, "AT+CIPSTART=\"%7[^\"]\",\"%63[^\"]\"", type, ip) == 2)
+    {
+        link = 0;
+    }
+    else if (modem->mux == 0 || sscanf(cmd, "AT+CIPSTART=%d,\"%7[^\"]\",\"%63[^\"]\"", &link, type, ip) != 3 ||
+            link < 0 || link >= MODEM_ESP8266_SOCKET_NUM)
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    pthread_mutex_lock(&modem->lock);
+    if (modem->connected[link])
+    {
+        pthread_mutex_unlock(&modem->lock);
+        modem_emu_printf(emu, "ALREADY CONNECTED\r\n\r\nERROR\r\n");
+        return;
+    }
+    if (strcmp(ip, modem->fail_ip) == 0)
+    {
+        pthread_mutex_unlock(&modem->lock);
+        if (modem->mux)
+        {
+            modem_emu_printf(emu, "\r\nERROR\r\n%d,CLOSED\r\n", link);
+        }
+        else
+        {
+            modem_emu_printf(emu, "\r\nERROR\r\nCLOSED\r\n");
+        }
+        return;
+    }
+    modem->connected[link] = 1;
+    modem->recv_len[link] = 0;
+    pthread_mutex_unlock(&modem->lock);
+
+    if (modem->mux)
+    {
+        modem_emu_printf(emu, "%d,CONNECT\r\n\r\nOK\r\n", link);
+    }
+    else
+    {
+        modem_emu_printf(emu, "CONNECT\r\n\r\nOK\r\n");
+    }
+}
+
+static void esp8266_cipclose(struct modem_emu *emu, const char *cmd)
+{
+    int link = -1, connected = 0;
+    struct modem_esp8266 *modem = MODEM(emu);
+
+    if (modem->mux == 0 && strcmp(cmd, "AT+CIPCLOSE") == 0)
+    {
+        link = 0;
+    }
+    else if (sscanf(cmd, "AT+CIPCLOSE=%d", &link) != 1 || link < 0 || link >= MODEM_ESP8266_SOCKET_NUM)
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    pthread_mutex_lock(&modem->lock);
+    connected = modem->connected[link];
+    modem->connected[link] = 0;
+    modem->recv_len[link] = 0;
+    pthread_mutex_unlock(&modem->lock);
+
+    if (connected && modem->mux == 0)
+    {
+        modem_emu_printf(emu, "CLOSED\r\n\r\nOK\r\n");
+    }
+    else if (connected)
+    {
+        modem_emu_printf(emu, "%d,CLOSED\r\n\r\nOK\r\n", link);
+    }
+    else
+    {
+        modem_emu_printf(emu, "UNLINK\r\n\r\nERROR\r\n");
+    }
+}
+
+static void esp8266_send_data(struct modem_emu *emu, const char *data, size_t len)
+{
+    struct modem_esp8266 *modem = MODEM(emu);
+    int link = modem->send_socket;
+
+    modem_emu_printf(emu, "\r\nRecv %u bytes\r\n", (unsigned) len);
+    modem_emu_printf(emu, "\r\nSEND OK\r\n");
+
+    if (modem->echo)
+    {
+        modem_esp8266_push(modem, link, data, len);
+    }
+}
+
+static void esp8266_cipsend(struct modem_emu *emu, const char *cmd)
+{
+    int link = -1, len = 0;
+    struct modem_esp8266 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+CIPSEND=%d,%d", &link, &len) != 2 || link < 0 ||
+            link >= MODEM_ESP8266_SOCKET_NUM || len <= 0 || (size_t) len > modem->send_max ||
+            !modem->connected[link])
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    modem->send_socket = link;
+    modem_emu_expect_data(emu, (size_t) len, esp8266_send_data);
+    modem_emu_printf(emu, "\r\nOK\r\n> ");
+}
+
+static void esp8266_stream_data(struct modem_emu *emu, const char *data, size_t len)
+{
+    struct modem_esp8266 *modem = MODEM(emu);
+
+    /* the escape sequence comes alone with silence around it */
+    if (len == 3 && memcmp(data, "+++", 3) == 0)
+    {
+        modem_emu_stream(emu, NULL);
+        return;
+    }
+
+    modem->stream_bytes += len;
+    if (modem->echo)
+    {
+        modem_emu_write(emu, data, len);
+    }
+}
+
+static void esp8266_cipsend_stream(struct modem_emu *emu, const char *cmd)
+{
+    struct modem_esp8266 *modem = MODEM(emu);
+
+    if (strcmp(cmd, "AT+CIPSEND") != 0 || modem->mode != 1 || !modem->connected[0])
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    modem_emu_stream(emu, esp8266_stream_data);
+
+    /* the prompt follows the response after a blank line and a short gap */
+    modem_emu_printf(emu, "\r\nOK\r\n");
+    usleep(MODEM_ESP8266_PROMPT_GAP * 1000);
+    modem_emu_printf(emu, "\r\n>");
+}
+
+static void esp8266_ciprecvdata(struct modem_emu *emu, const char *cmd)
+{
+    int link = -1, len = 0, inject = -1;
+    size_t size = 0;
+    char *data = NULL;
+    struct modem_esp8266 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+CIPRECVDATA=%d,%d", &link, &len) != 2 || link < 0 ||
+            link >= MODEM_ESP8266_SOCKET_NUM || len <= 0)
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    pthread_mutex_lock(&modem->lock);
+    if (modem->read_fail > 0)
+    {
+        modem->read_fail--;
+        pthread_mutex_unlock(&modem->lock);
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+    size = modem->recv_len[link] < (size_t) len ? modem->recv_len[link] : (size_t) len;
+    if (size > 0)
+    {
+        data = (char *) malloc(size);
+        memcpy(data, modem->recv_buf[link], size);
+        memmove(modem->recv_buf[link], modem->recv_buf[link] + size, modem->recv_len[link] - size);
+        modem->recv_len[link] -= size;
+    }
+    if (modem->read_inject_socket >= 0 && modem->read_inject_socket != link)
+    {
+        inject = modem->read_inject_socket;
+        modem->read_inject_socket = -1;
+    }
+    pthread_mutex_unlock(&modem->lock);
+
+    if (data == NULL)
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    modem_emu_printf(emu, "+CIPRECVDATA:%u,", (unsigned) size);
+    modem_emu_write(emu, data, size);
+    free(data);
+
+    /* the data of another connection arrives before the read is finished */
+    if (inject >= 0)
+    {
+        modem_esp8266_push(modem, inject, modem->read_inject_data, strlen(modem->read_inject_data));
+    }
+
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+static void esp8266_cipdomain(struct modem_emu *emu, const char *cmd)
+{
+    int i;
+    char name[64] = {0};
+    struct modem_esp8266 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+CIPDOMAIN=\"%63[^\"]\"", name) == 1)
+    {
+        for (i = 0; i < modem->domain_num; i++)
+        {
+            if (strcmp(modem->domains[i].name, name) == 0)
+            {
+                modem_emu_printf(emu, "+CIPDOMAIN:\"%s\"\r\n\r\nOK\r\n", modem->domains[i].ip);
+                return;
+            }
+        }
+    }
+
+    if (modem->domain_any[0])
+    {
+        modem_emu_printf(emu, "+CIPDOMAIN:\"%s\"\r\n\r\nOK\r\n", modem->domain_any);
+        return;
+    }
+
+    modem_emu_printf(emu, "DNS Fail\r\n\r\nERROR\r\n");
+}
+
+/* the specific prefixes are placed before the shorter ones they start with */
+static const struct modem_emu_rule esp8266_rules[] =
+{
+    {"AT+RST",            esp8266_ok},
+    {"ATE0",              esp8266_ok},
+    {"AT+CWMODE=",        esp8266_ok},
+    {"AT+GMR",            esp8266_gmr},
+    {"AT+CIPMUX=",        esp8266_cipmux},
+    {"AT+CIPRECVMODE=",   esp8266_ciprecvmode},
+    {"AT+CIPRECVDATA=",   esp8266_ciprecvdata},
+    {"AT+CWJAP=",         esp8266_cwjap},
+    {"AT+CIFSR",          esp8266_cifsr},
+    {"AT+CIPSTA?",        esp8266_cipsta},
+    {"AT+CIPDNS?",        esp8266_cipdns},
+    {"AT+CWDHCP?",        esp8266_cwdhcp},
+    {"AT+CIPMODE=",       esp8266_cipmode},
+    {"AT+CIPSTART=",      esp8266_cipstart},
+    {"AT+CIPCLOSE",       esp8266_cipclose},
+    {"AT+CIPSEND=",       esp8266_cipsend},
+    {"AT+CIPSEND",        esp8266_cipsend_stream},
+    {"AT+CIPDOMAIN=",     esp8266_cipdomain},
+    {"AT",                esp8266_ok},
+};
+
+int modem_esp8266_open(struct modem_esp8266 *modem, uint32_t baud)
+{
+    memset(modem, 0x00, sizeof(struct modem_esp8266));
+    pthread_mutex_init(&modem->lock, NULL);
+    modem->echo = 1;
+    modem->mux = 1;
+    modem->send_max = MODEM_ESP8266_SEND_MAX_SIZE;
+    modem->read_inject_socket = -1;
+
+    return modem_emu_open(&modem->emu, esp8266_rules, sizeof(esp8266_rules) / sizeof(esp8266_rules[0]),
+                          baud, modem);
+}
+
+void modem_esp8266_close(struct modem_esp8266 *modem)
+{
+    modem_emu_close(&modem->emu);
+}
+
+void modem_esp8266_domain_add(struct modem_esp8266 *modem, const char *name, const char *ip)
+{
+    if (modem->domain_num < MODEM_ESP8266_DOMAIN_NUM)
+    {
+        snprintf(modem->domains[modem->domain_num].name, sizeof(modem->domains[0].name), "%s", name);
+        snprintf(modem->domains[modem->domain_num].ip, sizeof(modem->domains[0].ip), "%s", ip);
+        modem->domain_num++;
+    }
+}
+
+void modem_esp8266_connect_fail(struct modem_esp8266 *modem, const char *ip)
+{
+    snprintf(modem->fail_ip, sizeof(modem->fail_ip), "%s", ip);
+}
+
+void modem_esp8266_push(struct modem_esp8266 *modem, int link, const char *data, size_t len)
+{
+    size_t seg = 0, size = 0;
+
+    if (link < 0 || link >= MODEM_ESP8266_SOCKET_NUM)
+    {
+        return;
+    }
+
+    if (modem->mode == 1)
+    {
+        /* the data streams as it is in passthrough */
+        modem_emu_write(&modem->emu, data, len);
+        return;
+    }
+
+    if (modem->passive)
+    {
+        pthread_mutex_lock(&modem->lock);
+        size = MODEM_ESP8266_BUF_SIZE - modem->recv_len[link];
+        size = len < size ? len : size;
+        memcpy(modem->recv_buf[link] + modem->recv_len[link], data, size);
+        modem->recv_len[link] += size;
+        size = modem->recv_len[link];
+        pthread_mutex_unlock(&modem->lock);
+
+        modem_emu_printf(&modem->emu, "+IPD,%d,%u\r\n", link, (unsigned) size);
+        return;
+    }
+
+    /* the data is pushed in TCP segments */
+    while (seg < len)
+    {
+        size = len - seg < MODEM_ESP8266_SEGMENT_SIZE ? len - seg : MODEM_ESP8266_SEGMENT_SIZE;
+        modem_emu_printf(&modem->emu, "\r\n+IPD,%d,%u:", link, (unsigned) size);
+        modem_emu_write(&modem->emu, data + seg, size);
+        seg += size;
+    }
+}
+
+void modem_esp8266_remote_close(struct modem_esp8266 *modem, int link)
+{
+    pthread_mutex_lock(&modem->lock);
+    modem->connected[link] = 0;
+    modem->recv_len[link] = 0;
+    pthread_mutex_unlock(&modem->lock);
+
+    modem_emu_printf(&modem->emu, "%d,CLOSED\r\n", link);
+}
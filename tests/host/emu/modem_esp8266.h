@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __MODEM_ESP8266_H__
+#define __MODEM_ESP8266_H__
+
+#include "modem_emu.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * ESP8266 profile of the modem emulator, it speaks the CIP socket commands in
+ * multiple connection mode. The peer of every connection echoes the data sent
+ * to it, pushed by "+IPD,<link>,<len>:" or buffered in the module and noticed
+ * by "+IPD,<link>,<len>" after "AT+CIPRECVMODE=1". In single connection mode
+ * "AT+CIPMODE=1" and "AT+CIPSEND" stream the data until "+++".
+ */
+
+#define MODEM_ESP8266_SOCKET_NUM       5
+#define MODEM_ESP8266_BUF_SIZE         (16 * 1024)
+#define MODEM_ESP8266_DOMAIN_NUM       8
+#define MODEM_ESP8266_SEGMENT_SIZE     1460
+#define MODEM_ESP8266_SEND_MAX_SIZE    2048
+/* the milliseconds between the response and the prompt of passthrough */
+#define MODEM_ESP8266_PROMPT_GAP       20
+
+struct modem_esp8266
+{
+    struct modem_emu emu;
+    pthread_mutex_t lock;                        /* protects the connection state and module buffers */
+
+    int mux;                                     /* multiple connection mode, "AT+CIPMUX" */
+    int mode;                                    /* passthrough mode, "AT+CIPMODE" */
+    int passive;                                 /* received data is buffered in the module */
+    int echo;                                    /* the peer echoes the data sent to it */
+    size_t send_max;                             /* the maximum size of one "AT+CIPSEND" */
+    int connected[MODEM_ESP8266_SOCKET_NUM];
+    char fail_ip[16];                            /* the connect to this address fails */
+
+    int send_socket;                             /* the connection of the send in progress */
+    size_t stream_bytes;                         /* the bytes streamed in passthrough */
+    char recv_buf[MODEM_ESP8266_SOCKET_NUM][MODEM_ESP8266_BUF_SIZE];
+    size_t recv_len[MODEM_ESP8266_SOCKET_NUM];
+
+    int read_fail;                               /* the next reads are answered by "ERROR" */
+
+    /* the data arrives on this connection while a read of another one is answered, -1 for none */
+    int read_inject_socket;
+    const char *read_inject_data;
+
+    struct
+    {
+        char name[64];
+        char ip[16];
+    } domains[MODEM_ESP8266_DOMAIN_NUM];
+    int domain_num;
+    char domain_any[16];                         /* the address of the names not added, empty for none */
+};
+
+int modem_esp8266_open(struct modem_esp8266 *modem, uint32_t baud);
+void modem_esp8266_close(struct modem_esp8266 *modem);
+
+/* the domain name answered by "AT+CIPDOMAIN", the other names fail unless domain_any is set */
+void modem_esp8266_domain_add(struct modem_esp8266 *modem, const char *name, const char *ip);
+/* the connect to the address fails */
+void modem_esp8266_connect_fail(struct modem_esp8266 *modem, const char *ip);
+/* the peer sends the data on the connection */
+void modem_esp8266_push(struct modem_esp8266 *modem, int link, const char *data, size_t len);
+/* the peer closes the connection */
+void modem_esp8266_remote_close(struct modem_esp8266 *modem, int link);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MODEM_ESP8266_H__ */
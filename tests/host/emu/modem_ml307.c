@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "modem_ml307.h"
+
+#define MODEM(emu)                     ((struct modem_ml307 *) (emu)->user_data)
+
+/* the results of "+MIPOPEN", 0 for the connection set up */
+#define ML307_CONNECT_OK               0
+#define ML307_CONNECT_FAIL             1
+
+static void ml307_ok(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\nOK\r\n");
+}
+
+static void ml307_ati(struct modem_emu *emu, const char *cmd)
+{
+    /* the version is read as the first 4 lines */
+    modem_emu_printf(emu, "\r\nML307R\r\nRevision: ML307R-DC_V1.0\r\nOK\r\n");
+}
+
+/*
+ * The driver reads 2 lines of the "AT+CPIN?", "AT+ICCID" and "AT+CGPADDR=1"
+ * responses, the "OK" isn't sent not to end the response of the next command.
+ */
+static void ml307_cpin(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+CPIN: READY\r\n");
+}
+
+static void ml307_iccid(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+ICCID: 89860012345678901234\r\n");
+}
+
+static void ml307_csq(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+CSQ: 24,99\r\n\r\nOK\r\n");
+}
+
+static void ml307_gsn(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+GSN: 866123456789012\r\n\r\nOK\r\n");
+}
+
+static void ml307_cgpaddr(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+CGPADDR: 1,\"10.64.1.3\"\r\n");
+}
+
+static void ml307_mdnscfg(struct modem_emu *emu, const char *cmd)
+{
+    if (strcmp(cmd, "AT+MDNSCFG=\"ip\"") == 0)
+    {
+        modem_emu_printf(emu, "\r\n+MDNSCFG: \"ip\",\"183.230.126.224\",\"183.230.126.225\"\r\n\r\nOK\r\n");
+    }
+    else
+    {
+        modem_emu_printf(emu, "\r\nOK\r\n");
+    }
+}
+
+static void ml307_mipcall(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+MIPCALL: 1,1,\"10.64.1.3\"\r\n\r\nOK\r\n");
+}
+
+static void ml307_cgact(struct modem_emu *emu, const char *cmd)
+{
+    modem_emu_printf(emu, "\r\n+CGACT: 1,1\r\n\r\nOK\r\n");
+}
+
+static void ml307_mipopen(struct modem_emu *emu, const char *cmd)
+{
+    int id = -1, port = 0, result = ML307_CONNECT_OK;
+    char type[8] = {0}, ip[64] = {0};
+    struct modem_ml307 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+MIPOPEN=%d,\"%7[^\"]\",\"%63[^\"]\",%d", &id, type, ip, &port) != 4 ||
+            id < 0 || id >= MODEM_ML307_SOCKET_NUM || (strcmp(type, "TCP") && strcmp(type, "UDP")))
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    pthread_mutex_lock(&modem->lock);
+    if (modem->connected[id] || strcmp(ip, modem->fail_ip) == 0)
+    {
+        result = ML307_CONNECT_FAIL;
+    }
+    else
+    {
+        modem->connected[id] = 1;
+        modem->udp[id] = (strcmp(type, "UDP") == 0);
+        modem->sent[id] = 0;
+    }
+    pthread_mutex_unlock(&modem->lock);
+
+    /* the result follows the response when the connection is set up */
+    modem_emu_printf(emu, "\r\nOK\r\n\r\n+MIPOPEN: %d,%d\r\n", id, result);
+}
+
+static void ml307_mipclose(struct modem_emu *emu, const char *cmd)
+{
+    int id = -1;
+    struct modem_ml307 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+MIPCLOSE=%d", &id) != 1 || id < 0 || id >= MODEM_ML307_SOCKET_NUM)
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    pthread_mutex_lock(&modem->lock);
+    modem->connected[id] = 0;
+    pthread_mutex_unlock(&modem->lock);
+
+    modem_emu_printf(emu, "\r\nOK\r\n\r\n+MIPCLOSE: %d\r\n", id);
+}
+
+static void ml307_send_data(struct modem_emu *emu, const char *data, size_t len)
+{
+    struct modem_ml307 *modem = MODEM(emu);
+    int id = modem->send_socket;
+
+    modem->sent[id] += (uint32_t) len;
+    modem_emu_printf(emu, "\r\nOK\r\n\r\n+MIPSEND: %d,%u\r\n", id, (unsigned) len);
+
+    if (modem->echo)
+    {
+        modem_ml307_push(modem, id, data, len);
+    }
+}
+
+static void ml307_mipsend(struct modem_emu *emu, const char *cmd)
+{
+    int id = -1, len = -1;
+    struct modem_ml307 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+MIPSEND=%d,%d", &id, &len) != 2 || id < 0 || id >= MODEM_ML307_SOCKET_NUM ||
+            len <= 0 || len > MODEM_ML307_SEND_MAX_SIZE || !modem->connected[id])
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    /* the prompt is the second line of the response, no space follows it */
+    modem->send_socket = id;
+    modem_emu_expect_data(emu, (size_t) len, ml307_send_data);
+    modem_emu_printf(emu, "\r\n>");
+}
+
+static void ml307_mdnsgip(struct modem_emu *emu, const char *cmd)
+{
+    int i;
+    char name[64] = {0};
+    const char *ip = NULL;
+    struct modem_ml307 *modem = MODEM(emu);
+
+    if (sscanf(cmd, "AT+MDNSGIP=\"%63[^\"]\"", name) != 1)
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    for (i = 0; i < modem->domain_num; i++)
+    {
+        if (strcmp(modem->domains[i].name, name) == 0)
+        {
+            ip = modem->domains[i].ip;
+            break;
+        }
+    }
+    if (ip == NULL && modem->domain_any[0])
+    {
+        ip = modem->domain_any;
+    }
+
+    if (ip == NULL)
+    {
+        modem_emu_printf(emu, "\r\nERROR\r\n");
+        return;
+    }
+
+    /* the address follows the response */
+    modem_emu_printf(emu, "\r\nOK\r\n\r\n+MDNSGIP: \"%s\",\"%s\"\r\n", name, ip);
+}
+
+/* the specific prefixes are placed before the shorter ones they start with */
+static const struct modem_emu_rule ml307_rules[] =
+{
+    {"ATE0",              ml307_ok},
+    {"ATI",               ml307_ati},
+    {"AT+CPIN?",          ml307_cpin},
+    {"AT+ICCID",          ml307_iccid},
+    {"AT+CSQ",            ml307_csq},
+    {"AT+GSN=",           ml307_gsn},
+    {"AT+CGPADDR=",       ml307_cgpaddr},
+    {"AT+MDNSCFG=",       ml307_mdnscfg},
+    {"AT+MIPCALL?",       ml307_mipcall},
+    {"AT+CGACT?",         ml307_cgact},
+    {"AT+MIPOPEN=",       ml307_mipopen},
+    {"AT+MIPCLOSE=",      ml307_mipclose},
+    {"AT+MIPSEND=",       ml307_mipsend},
+    {"AT+MDNSGIP=",       ml307_mdnsgip},
+    {"AT",                ml307_ok},
+};
+
+int modem_ml307_open(struct modem_ml307 *modem, uint32_t baud)
+{
+    memset(modem, 0x00, sizeof(struct modem_ml307));
+    pthread_mutex_init(&modem->lock, NULL);
+    modem->echo = 1;
+
+    return modem_emu_open(&modem->emu, ml307_rules, sizeof(ml307_rules) / sizeof(ml307_rules[0]), baud, modem);
+}
+
+void modem_ml307_close(struct modem_ml307 *modem)
+{
+    modem_emu_close(&modem->emu);
+}
+
+void modem_ml307_domain_add(struct modem_ml307 *modem, const char *name, const char *ip)
+{
+    if (modem->domain_num < MODEM_ML307_DOMAIN_NUM)
+    {
+        snprintf(modem->domains[modem->domain_num].name, sizeof(modem->domains[0].name), "%s", name);
+        snprintf(modem->domains[modem->domain_num].ip, sizeof(modem->domains[0].ip), "%s", ip);
+        modem->domain_num++;
+    }
+}
+
+void modem_ml307_connect_fail(struct modem_ml307 *modem, const char *ip)
+{
+    snprintf(modem->fail_ip, sizeof(modem->fail_ip), "%s", ip);
+}
+
+void modem_ml307_push(struct modem_ml307 *modem, int id, const char *data, size_t len)
+{
+    size_t seg = 0, size = 0;
+    int head = 0;
+    char urc[MODEM_ML307_SEGMENT_SIZE + 64];
+
+    if (id < 0 || id >= MODEM_ML307_SOCKET_NUM)
+    {
+        return;
+    }
+
+    /* the data is pushed inline in TCP segments, every URC is written at once */
+    while (seg < len)
+    {
+        size = len - seg < MODEM_ML307_SEGMENT_SIZE ? len - seg : MODEM_ML307_SEGMENT_SIZE;
+        head = snprintf(urc, sizeof(urc), "\r\n+MIPURC: \"%s\",%d,%u,", modem->udp[id] ? "rudp" : "rtcp", id,
+                        (unsigned) size);
+        memcpy(urc + head, data + seg, size);
+        memcpy(urc + head + size, "\r\n", 2);
+        modem_emu_write(&modem->emu, urc, head + size + 2);
+        seg += size;
+    }
+}
+
+void modem_ml307_remote_close(struct modem_ml307 *modem, int id)
+{
+    pthread_mutex_lock(&modem->lock);
+    modem->connected[id] = 0;
+    pthread_mutex_unlock(&modem->lock);
+
+    /* the connect state 1: the server closed the connection */
+    modem_emu_printf(&modem->emu, "\r\n+MIPURC: \"disconn\",%d,1\r\n", id);
+}
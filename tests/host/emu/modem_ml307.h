@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __MODEM_ML307_H__
+#define __MODEM_ML307_H__
+
+#include "modem_emu.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * ML307 profile of the modem emulator, it speaks the China Mobile MIPOPEN/MIPSEND
+ * socket commands. The results of the connect, send and close follow the "OK"
+ * as "+MIPOPEN", "+MIPSEND" and "+MIPCLOSE" URCs. The peer of every connection
+ * echoes the data sent to it, pushed inline by "+MIPURC: "rtcp",<id>,<len>,<data>"
+ * in TCP segments.
+ */
+
+#define MODEM_ML307_SOCKET_NUM         6
+#define MODEM_ML307_DOMAIN_NUM         8
+#define MODEM_ML307_SEGMENT_SIZE       1460
+#define MODEM_ML307_SEND_MAX_SIZE      4096
+
+struct modem_ml307
+{
+    struct modem_emu emu;
+    pthread_mutex_t lock;                        /* protects the connection state */
+
+    int echo;                                    /* the peer echoes the data sent to it */
+    int connected[MODEM_ML307_SOCKET_NUM];
+    int udp[MODEM_ML307_SOCKET_NUM];             /* the connection is UDP, pushed by "rudp" */
+    char fail_ip[16];                            /* the connect to this address fails */
+
+    int send_socket;                             /* the connection of the send in progress */
+    uint32_t sent[MODEM_ML307_SOCKET_NUM];       /* the bytes sent */
+
+    struct
+    {
+        char name[64];
+        char ip[16];
+    } domains[MODEM_ML307_DOMAIN_NUM];
+    int domain_num;
+    char domain_any[16];                         /* the address of the names not added, empty for none */
+};
+
+int modem_ml307_open(struct modem_ml307 *modem, uint32_t baud);
+void modem_ml307_close(struct modem_ml307 *modem);
+
+/* the domain name answered by "AT+MDNSGIP", the other names fail unless domain_any is set */
+void modem_ml307_domain_add(struct modem_ml307 *modem, const char *name, const char *ip);
+/* the connect to the address fails */
+void modem_ml307_connect_fail(struct modem_ml307 *modem, const char *ip);
+/* the peer sends the data on the connection */
+void modem_ml307_push(struct modem_ml307 *modem, int id, const char *data, size_t len);
+/* the peer closes the connection */
+void modem_ml307_remote_close(struct modem_ml307 *modem, int id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MODEM_ML307_H__ */
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __HOST_ARPA_INET_H__
+#define __HOST_ARPA_INET_H__
+
+#include <netdev.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct in_addr
+{
+    uint32_t s_addr;
+};
+
+/* The IPv4 address conversion on ip_addr_t like the one of lwIP, it takes struct in_addr too */
+int host_inet_aton(const char *cp, ip_addr_t *addr);
+char *host_inet_ntoa(const ip_addr_t *addr);
+
+#define inet_aton(cp, addr)            host_inet_aton(cp, (ip_addr_t *) (addr))
+#define inet_ntoa(addr)                host_inet_ntoa(&(addr))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HOST_ARPA_INET_H__ */
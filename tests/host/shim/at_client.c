@@ -0,0 +1,742 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <at.h>
+
+#define DBG_TAG              "at.clnt"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#include "host.h"
+
+/*
+ * The AT client of the host test build. The line and URC parse follows the AT
+ * component of RT-Thread: every received line is checked against the URC
+ * tables first, the other lines are kept in the response in progress, the
+ * blank lines included, and the response ends with "OK", "ERROR", the end
+ * sign or the expected number of lines.
+ */
+
+#define AT_RESP_END_OK                 "OK"
+#define AT_RESP_END_ERROR              "ERROR"
+#define AT_RESP_END_FAIL               "FAIL"
+#define AT_END_CR_LF                   "\r\n"
+
+static struct at_client at_client_table[AT_CLIENT_NUM_MAX] = { 0 };
+
+/**
+ * Create response object.
+ *
+ * @param buf_size the maximum response buffer size
+ * @param line_num the number of setting response lines
+ *         = 0: the response data will auto return when received 'OK' or 'ERROR'
+ *        != 0: the response data will return when received setting lines number data
+ * @param timeout the maximum response time
+ *
+ * @return != RT_NULL: response object
+ *          = RT_NULL: no memory
+ */
+at_response_t at_create_resp(rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout)
+{
+    at_response_t resp = RT_NULL;
+
+    resp = (at_response_t) rt_calloc(1, sizeof(struct at_response));
+    if (resp == RT_NULL)
+    {
+        LOG_E("AT create response object failed! No memory for response object!");
+        return RT_NULL;
+    }
+
+    resp->buf = (char *) rt_calloc(1, buf_size);
+    if (resp->buf == RT_NULL)
+    {
+        LOG_E("AT create response object failed! No memory for response buffer!");
+        rt_free(resp);
+        return RT_NULL;
+    }
+
+    resp->buf_size = buf_size;
+    resp->line_num = line_num;
+    resp->line_counts = 0;
+    resp->timeout = timeout;
+
+    return resp;
+}
+
+void at_delete_resp(at_response_t resp)
+{
+    if (resp && resp->buf)
+    {
+        rt_free(resp->buf);
+    }
+
+    if (resp)
+    {
+        rt_free(resp);
+    }
+}
+
+at_response_t at_resp_set_info(at_response_t resp, rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout)
+{
+    char *p_temp;
+
+    RT_ASSERT(resp);
+
+    if (resp->buf_size != buf_size)
+    {
+        resp->buf_size = buf_size;
+
+        p_temp = (char *) rt_realloc(resp->buf, buf_size);
+        if (p_temp == RT_NULL)
+        {
+            LOG_D("No memory for realloc response buffer size(%d).", (int) buf_size);
+            return RT_NULL;
+        }
+        else
+        {
+            resp->buf = p_temp;
+        }
+    }
+
+    resp->line_num = line_num;
+    resp->timeout = timeout;
+
+    return resp;
+}
+
+const char *at_resp_get_line(at_response_t resp, rt_size_t resp_line)
+{
+    char *resp_buf = resp->buf;
+    rt_size_t line_num = 1;
+
+    RT_ASSERT(resp);
+
+    if (resp_line > resp->line_counts || resp_line <= 0)
+    {
+        LOG_E("AT response get line failed! Input response line(%d) error!", (int) resp_line);
+        return RT_NULL;
+    }
+
+    for (line_num = 1; line_num <= resp->line_counts; line_num++)
+    {
+        if (resp_line == line_num)
+        {
+            return resp_buf;
+        }
+
+        resp_buf += strlen(resp_buf) + 1;
+    }
+
+    return RT_NULL;
+}
+
+const char *at_resp_get_line_by_kw(at_response_t resp, const char *keyword)
+{
+    char *resp_buf = resp->buf;
+    rt_size_t line_num = 1;
+
+    RT_ASSERT(resp);
+    RT_ASSERT(keyword);
+
+    for (line_num = 1; line_num <= resp->line_counts; line_num++)
+    {
+        if (strstr(resp_buf, keyword))
+        {
+            return resp_buf;
+        }
+
+        resp_buf += strlen(resp_buf) + 1;
+    }
+
+    return RT_NULL;
+}
+
+int at_resp_parse_line_args(at_response_t resp, rt_size_t resp_line, const char *resp_expr, ...)
+{
+    va_list args;
+    int resp_args_num = 0;
+    const char *resp_line_buf = RT_NULL;
+
+    RT_ASSERT(resp);
+    RT_ASSERT(resp_expr);
+
+    if ((resp_line_buf = at_resp_get_line(resp, resp_line)) == RT_NULL)
+    {
+        return -1;
+    }
+
+    va_start(args, resp_expr);
+    resp_args_num = vsscanf(resp_line_buf, resp_expr, args);
+    va_end(args);
+
+    return resp_args_num;
+}
+
+int at_resp_parse_line_args_by_kw(at_response_t resp, const char *keyword, const char *resp_expr, ...)
+{
+    va_list args;
+    int resp_args_num = 0;
+    const char *resp_line_buf = RT_NULL;
+
+    RT_ASSERT(resp);
+    RT_ASSERT(resp_expr);
+
+    if ((resp_line_buf = at_resp_get_line_by_kw(resp, keyword)) == RT_NULL)
+    {
+        return -1;
+    }
+
+    va_start(args, resp_expr);
+    resp_args_num = vsscanf(resp_line_buf, resp_expr, args);
+    va_end(args);
+
+    return resp_args_num;
+}
+
+/* write all bytes to the serial device */
+static rt_size_t at_client_write(at_client_t client, const char *buf, rt_size_t size)
+{
+    rt_size_t sent = 0;
+    ssize_t len = 0;
+
+    while (sent < size)
+    {
+        len = write(client->fd, buf + sent, size - sent);
+        if (len < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (len <= 0)
+        {
+            break;
+        }
+        sent += (rt_size_t) len;
+    }
+
+    return sent;
+}
+
+int at_obj_exec_cmd(at_client_t client, at_response_t resp, const char *cmd_expr, ...)
+{
+    va_list args;
+    rt_err_t result = RT_EOK;
+    int len = 0;
+
+    RT_ASSERT(cmd_expr);
+
+    if (client == RT_NULL)
+    {
+        LOG_E("input AT Client object is NULL, please create or get AT Client object!");
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(&client->lock, RT_WAITING_FOREVER);
+
+    client->resp_status = AT_RESP_OK;
+
+    if (resp != RT_NULL)
+    {
+        resp->buf_len = 0;
+        resp->line_counts = 0;
+    }
+
+    /* the semaphore released by a response given up before is dropped */
+    while (rt_sem_trytake(&client->resp_notice) == RT_EOK);
+
+    va_start(args, cmd_expr);
+    len = vsnprintf(client->send_buf, client->send_bufsz - 2, cmd_expr, args);
+    va_end(args);
+    if (len < 0)
+    {
+        len = 0;
+    }
+    if (len > (int) client->send_bufsz - 3)
+    {
+        len = (int) client->send_bufsz - 3;
+    }
+    client->last_cmd_len = (rt_size_t) len;
+    rt_memcpy(client->send_buf + len, AT_END_CR_LF, 2);
+
+    /* the response is published before the command so the answer is never missed */
+    rt_enter_critical();
+    client->resp = resp;
+    rt_exit_critical();
+
+    if (at_client_write(client, client->send_buf, (rt_size_t) len + 2) != (rt_size_t) len + 2)
+    {
+        result = -RT_ERROR;
+        goto __exit;
+    }
+
+    if (resp != RT_NULL)
+    {
+        if (rt_sem_take(&client->resp_notice, resp->timeout) != RT_EOK)
+        {
+            LOG_W("execute command (%.*s) timeout (%d ticks)!", (int) client->last_cmd_len, client->send_buf,
+                  (int) resp->timeout);
+            client->resp_status = AT_RESP_TIMEOUT;
+            result = -RT_ETIMEOUT;
+        }
+        else if (client->resp_status != AT_RESP_OK)
+        {
+            LOG_E("execute command (%.*s) failed!", (int) client->last_cmd_len, client->send_buf);
+            result = -RT_ERROR;
+        }
+    }
+
+__exit:
+    rt_enter_critical();
+    client->resp = RT_NULL;
+    rt_exit_critical();
+
+    rt_mutex_release(&client->lock);
+
+    return (int) result;
+}
+
+int at_client_obj_wait_connect(at_client_t client, rt_uint32_t timeout)
+{
+    rt_err_t result = RT_EOK;
+    at_response_t resp = RT_NULL;
+    rt_tick_t start_time = 0;
+
+    if (client == RT_NULL)
+    {
+        LOG_E("input AT client object is NULL, please create or get AT Client object!");
+        return -RT_ERROR;
+    }
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(300));
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for AT client response object.");
+        return -RT_ENOMEM;
+    }
+
+    rt_mutex_take(&client->lock, RT_WAITING_FOREVER);
+
+    start_time = rt_tick_get();
+    while (1)
+    {
+        /* Check whether it is timeout */
+        if (rt_tick_get() - start_time > rt_tick_from_millisecond(timeout))
+        {
+            LOG_E("wait AT client connect timeout(%d tick).", (int) timeout);
+            result = -RT_ETIMEOUT;
+            break;
+        }
+
+        if (at_obj_exec_cmd(client, resp, "AT") == RT_EOK)
+        {
+            break;
+        }
+    }
+
+    rt_mutex_release(&client->lock);
+
+    at_delete_resp(resp);
+
+    return (int) result;
+}
+
+rt_size_t at_client_obj_send(at_client_t client, const char *buf, rt_size_t size)
+{
+    rt_size_t len;
+
+    RT_ASSERT(buf);
+
+    if (client == RT_NULL)
+    {
+        LOG_E("input AT Client object is NULL, please create or get AT Client object!");
+        return 0;
+    }
+
+    rt_mutex_take(&client->lock, RT_WAITING_FOREVER);
+
+    len = at_client_write(client, buf, size);
+
+    rt_mutex_release(&client->lock);
+
+    return len;
+}
+
+/* read one byte from the serial device, it's only called in the parser thread */
+static rt_err_t at_client_getchar(at_client_t client, char *ch, rt_int32_t timeout)
+{
+    ssize_t len = 0;
+    struct pollfd pfd;
+
+    while (client->rx_pos >= client->rx_len)
+    {
+        pfd.fd = client->fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        if (poll(&pfd, 1, timeout < 0 ? -1 : (int) timeout) <= 0)
+        {
+            return -RT_ETIMEOUT;
+        }
+
+        len = read(client->fd, client->rx_buf, sizeof(client->rx_buf));
+        if (len < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (len <= 0)
+        {
+            /* the modem side is closed */
+            rt_thread_mdelay(timeout < 0 ? 100 : timeout);
+            return -RT_ERROR;
+        }
+
+        client->rx_pos = 0;
+        client->rx_len = (rt_size_t) len;
+    }
+
+    *ch = client->rx_buf[client->rx_pos++];
+
+    return RT_EOK;
+}
+
+rt_size_t at_client_obj_recv(at_client_t client, char *buf, rt_size_t size, rt_int32_t timeout)
+{
+    rt_size_t len = 0;
+
+    RT_ASSERT(buf);
+
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    if (client == RT_NULL)
+    {
+        LOG_E("input AT Client object is NULL, please create or get AT Client object!");
+        return 0;
+    }
+
+    while (len < size)
+    {
+        if (at_client_getchar(client, buf + len, rt_tick_from_millisecond(timeout)) != RT_EOK)
+        {
+            break;
+        }
+        len++;
+    }
+
+    return len;
+}
+
+void at_obj_set_end_sign(at_client_t client, char ch)
+{
+    if (client == RT_NULL)
+    {
+        LOG_E("input AT Client object is NULL, please create or get AT Client object!");
+        return;
+    }
+
+    client->end_sign = ch;
+}
+
+int at_obj_set_urc_table(at_client_t client, const struct at_urc *urc_table, rt_size_t table_sz)
+{
+    rt_size_t idx;
+
+    if (client == RT_NULL)
+    {
+        LOG_E("input AT Client object is NULL, please create or get AT Client object!");
+        return -RT_ERROR;
+    }
+
+    for (idx = 0; idx < table_sz; idx++)
+    {
+        RT_ASSERT(urc_table[idx].cmd_prefix);
+        RT_ASSERT(urc_table[idx].cmd_suffix);
+    }
+
+    if (client->urc_table_size >= AT_CLIENT_URC_TABLE_NUM)
+    {
+        LOG_E("AT client URC table is full.");
+        return -RT_EFULL;
+    }
+
+    client->urc_table[client->urc_table_size].urc = urc_table;
+    client->urc_table[client->urc_table_size].urc_size = table_sz;
+    client->urc_table_size++;
+
+    return RT_EOK;
+}
+
+at_client_t at_client_get(const char *dev_name)
+{
+    int idx = 0;
+
+    RT_ASSERT(dev_name);
+
+    for (idx = 0; idx < AT_CLIENT_NUM_MAX; idx++)
+    {
+        if (at_client_table[idx].device &&
+                rt_strcmp(at_client_table[idx].device->parent.name, dev_name) == 0)
+        {
+            return &at_client_table[idx];
+        }
+    }
+
+    return RT_NULL;
+}
+
+at_client_t at_client_get_first(void)
+{
+    if (at_client_table[0].device == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    return &at_client_table[0];
+}
+
+static const struct at_urc *get_urc_obj(at_client_t client)
+{
+    rt_size_t i, j, prefix_len, suffix_len;
+    rt_size_t bufsz;
+    char *buffer = RT_NULL;
+    const struct at_urc *urc = RT_NULL;
+    struct at_urc_table *urc_table = RT_NULL;
+
+    if (client->urc_table == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    buffer = client->recv_line_buf;
+    bufsz = client->recv_line_len;
+
+    for (i = 0; i < client->urc_table_size; i++)
+    {
+        for (j = 0; j < client->urc_table[i].urc_size; j++)
+        {
+            urc_table = client->urc_table + i;
+            urc = urc_table->urc + j;
+
+            prefix_len = rt_strlen(urc->cmd_prefix);
+            suffix_len = rt_strlen(urc->cmd_suffix);
+            if (bufsz < prefix_len + suffix_len)
+            {
+                continue;
+            }
+            if ((prefix_len ? !rt_strncmp(buffer, urc->cmd_prefix, prefix_len) : 1)
+                    && (suffix_len ? !rt_strncmp(buffer + bufsz - suffix_len, urc->cmd_suffix, suffix_len) : 1))
+            {
+                return urc;
+            }
+        }
+    }
+
+    return RT_NULL;
+}
+
+static int at_recv_readline(at_client_t client)
+{
+    rt_size_t read_len = 0;
+    char ch = 0, last_ch = 0;
+    rt_bool_t is_full = RT_FALSE;
+
+    rt_memset(client->recv_line_buf, 0x00, client->recv_bufsz);
+    client->recv_line_len = 0;
+
+    while (1)
+    {
+        if (at_client_getchar(client, &ch, RT_WAITING_FOREVER) != RT_EOK)
+        {
+            return -RT_ERROR;
+        }
+
+        if (read_len < client->recv_bufsz)
+        {
+            client->recv_line_buf[read_len++] = ch;
+            client->recv_line_len = read_len;
+        }
+        else
+        {
+            is_full = RT_TRUE;
+        }
+
+        /* is newline or URC data */
+        if ((client->urc = get_urc_obj(client)) != RT_NULL || (ch == '\n' && last_ch == '\r')
+                || (client->end_sign != 0 && ch == client->end_sign))
+        {
+            if (is_full)
+            {
+                LOG_E("read line failed. The line data length is out of buffer size(%d)!", (int) client->recv_bufsz);
+                rt_memset(client->recv_line_buf, 0x00, client->recv_bufsz);
+                client->recv_line_len = 0;
+                return -RT_EFULL;
+            }
+            break;
+        }
+        last_ch = ch;
+    }
+
+    return (int) read_len;
+}
+
+static void client_parser(void *parameter)
+{
+    at_client_t client = (at_client_t) parameter;
+
+    while (1)
+    {
+        if (at_recv_readline(client) > 0)
+        {
+            if (client->urc != RT_NULL)
+            {
+                /* current receive is request, try to execute related operations */
+                if (client->urc->func != RT_NULL)
+                {
+                    client->urc->func(client, client->recv_line_buf, client->recv_line_len);
+                }
+                client->urc = RT_NULL;
+            }
+            else
+            {
+                at_response_t resp = RT_NULL;
+
+                rt_enter_critical();
+                resp = client->resp;
+                if (resp == RT_NULL)
+                {
+                    rt_exit_critical();
+                    LOG_D("unrecognized line: %.*s", (int) client->recv_line_len, client->recv_line_buf);
+                    continue;
+                }
+
+                char end_ch = client->recv_line_buf[client->recv_line_len - 1];
+
+                /* current receive is response */
+                client->recv_line_buf[client->recv_line_len - 1] = '\0';
+                if (resp->buf_len + client->recv_line_len < resp->buf_size)
+                {
+                    /* copy response lines, separated by '\0' */
+                    rt_memcpy(resp->buf + resp->buf_len, client->recv_line_buf, client->recv_line_len);
+
+                    /* update the current response information */
+                    resp->buf_len += client->recv_line_len;
+                    resp->line_counts++;
+                }
+                else
+                {
+                    client->resp_status = AT_RESP_BUFF_FULL;
+                    LOG_E("Read response buffer failed. The Response buffer size is out of buffer size(%d)!",
+                          (int) resp->buf_size);
+                }
+
+                /* check response result */
+                if ((client->end_sign != 0) && (end_ch == client->end_sign) && (resp->line_num == 0))
+                {
+                    /* get the end sign, return response state END_OK.*/
+                    client->resp_status = AT_RESP_OK;
+                }
+                else if (rt_memcmp(client->recv_line_buf, AT_RESP_END_OK, rt_strlen(AT_RESP_END_OK)) == 0
+                         && resp->line_num == 0)
+                {
+                    /* get the end data by response result, return response state END_OK. */
+                    client->resp_status = AT_RESP_OK;
+                }
+                else if (rt_strstr(client->recv_line_buf, AT_RESP_END_ERROR)
+                         || (rt_memcmp(client->recv_line_buf, AT_RESP_END_FAIL, rt_strlen(AT_RESP_END_FAIL)) == 0))
+                {
+                    client->resp_status = AT_RESP_ERROR;
+                }
+                else if (resp->line_counts == resp->line_num && resp->line_num)
+                {
+                    /* get the end data by response line, return response state END_OK.*/
+                    client->resp_status = AT_RESP_OK;
+                }
+                else
+                {
+                    rt_exit_critical();
+                    continue;
+                }
+
+                client->resp = RT_NULL;
+                rt_exit_critical();
+                rt_sem_release(&client->resp_notice);
+            }
+        }
+    }
+}
+
+int at_client_init(const char *dev_name, rt_size_t recv_bufsz, rt_size_t send_bufsz)
+{
+    int idx = 0;
+    char name[RT_NAME_MAX];
+    at_client_t client = RT_NULL;
+    rt_device_t device = RT_NULL;
+
+    RT_ASSERT(dev_name);
+    RT_ASSERT(recv_bufsz > 0);
+    RT_ASSERT(send_bufsz > 0);
+
+    if (at_client_get(dev_name) != RT_NULL)
+    {
+        return RT_EOK;
+    }
+
+    for (idx = 0; idx < AT_CLIENT_NUM_MAX && at_client_table[idx].device; idx++);
+    if (idx >= AT_CLIENT_NUM_MAX)
+    {
+        LOG_E("AT client initialize failed! Check the maximum number(%d) of AT client.", AT_CLIENT_NUM_MAX);
+        return -RT_EFULL;
+    }
+
+    device = rt_device_find(dev_name);
+    if (device == RT_NULL)
+    {
+        LOG_E("AT client initialize failed! Not find the device(%s).", dev_name);
+        return -RT_ERROR;
+    }
+
+    client = &at_client_table[idx];
+    client->fd = *(int *) device->user_data;
+    client->recv_bufsz = recv_bufsz;
+    client->send_bufsz = send_bufsz > AT_CMD_MAX_LEN ? send_bufsz : AT_CMD_MAX_LEN;
+
+    client->recv_line_buf = (char *) rt_calloc(1, client->recv_bufsz);
+    client->send_buf = (char *) rt_calloc(1, client->send_bufsz);
+    client->urc_table = (struct at_urc_table *) rt_calloc(AT_CLIENT_URC_TABLE_NUM, sizeof(struct at_urc_table));
+    if (client->recv_line_buf == RT_NULL || client->send_buf == RT_NULL || client->urc_table == RT_NULL)
+    {
+        LOG_E("AT client initialize failed! No memory for buffers.");
+        return -RT_ENOMEM;
+    }
+
+    rt_snprintf(name, RT_NAME_MAX, "at_%d", idx);
+    rt_mutex_init(&client->lock, name, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&client->resp_notice, name, 0, RT_IPC_FLAG_FIFO);
+
+    client->parser = rt_thread_create("at_clnt", client_parser, client, 2048, RT_THREAD_PRIORITY_MAX / 3 - 1, 5);
+    if (client->parser == RT_NULL)
+    {
+        LOG_E("AT client initialize failed! Create the parser thread failed.");
+        return -RT_ERROR;
+    }
+
+    client->device = device;
+    client->status = AT_STATUS_INITIALIZED;
+    rt_thread_startup(client->parser);
+
+    LOG_I("AT client(V%s) on device %s initialize success.", AT_SW_VERSION, dev_name);
+
+    return RT_EOK;
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __AT_LOG_H__
+#define __AT_LOG_H__
+
+#ifdef LOG_TAG
+#define DBG_TAG             LOG_TAG
+#endif
+
+#ifndef LOG_LVL
+#define DBG_LVL             DBG_INFO
+#else
+#define DBG_LVL             LOG_LVL
+#endif
+
+#include <rtdbg.h>
+
+#endif /* __AT_LOG_H__ */
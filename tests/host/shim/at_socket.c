@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <at_device.h>
+
+#define DBG_TAG              "at.skt"
+#define DBG_LVL              DBG_INFO
+#include <rtdbg.h>
+
+#include "host.h"
+
+/*
+ * The AT socket layer of the host test build. The sockets are allocated in
+ * the socket array of the AT device like AT socket of RT-Thread does, and the
+ * received data is appended to one buffer per socket for the test cases.
+ */
+
+#define HOST_SOCKET_NUM                16
+
+static struct at_socket *host_sockets[HOST_SOCKET_NUM];
+
+struct at_socket *at_get_socket(int socket)
+{
+    if (socket < 0 || socket >= HOST_SOCKET_NUM)
+    {
+        return RT_NULL;
+    }
+
+    if (host_sockets[socket] == RT_NULL || host_sockets[socket]->magic != AT_SOCKET_MAGIC)
+    {
+        return RT_NULL;
+    }
+
+    return host_sockets[socket];
+}
+
+struct at_socket *at_get_base_socket(int base_socket)
+{
+    int i;
+
+    for (i = 0; i < HOST_SOCKET_NUM; i++)
+    {
+        if (host_sockets[i] && host_sockets[i]->magic == AT_SOCKET_MAGIC &&
+                (int) (rt_ubase_t) host_sockets[i]->user_data == base_socket)
+        {
+            return host_sockets[i];
+        }
+    }
+
+    return RT_NULL;
+}
+
+struct at_socket *host_socket_get(int socket)
+{
+    return at_get_socket(socket);
+}
+
+static void host_socket_recv_cb(struct at_socket *sock, at_socket_evt_t event, const char *buff, size_t bfsz)
+{
+    char *buf = RT_NULL;
+
+    RT_ASSERT(sock);
+    RT_ASSERT(event == AT_SOCKET_EVT_RECV);
+
+    /* the receive buffer is taken over from the device class */
+    rt_mutex_take(&sock->recv_lock, RT_WAITING_FOREVER);
+    buf = (char *) rt_realloc(sock->recv_buf, sock->recv_len + bfsz);
+    if (buf)
+    {
+        rt_memcpy(buf + sock->recv_len, buff, bfsz);
+        sock->recv_buf = buf;
+        sock->recv_len += bfsz;
+    }
+    rt_mutex_release(&sock->recv_lock);
+
+    rt_free((void *) buff);
+    rt_sem_release(&sock->recv_notice);
+}
+
+static void host_socket_closed_cb(struct at_socket *sock, at_socket_evt_t event, const char *buff, size_t bfsz)
+{
+    RT_ASSERT(sock);
+    RT_ASSERT(event == AT_SOCKET_EVT_CLOSED);
+
+    sock->state = AT_SOCKET_CLOSED;
+    rt_sem_release(&sock->recv_notice);
+}
+
+static void host_socket_free(struct at_socket *sock)
+{
+    host_sockets[sock->socket] = RT_NULL;
+
+    rt_mutex_detach(&sock->recv_lock);
+    rt_sem_detach(&sock->recv_notice);
+    if (sock->recv_buf)
+    {
+        rt_free(sock->recv_buf);
+    }
+
+    rt_memset(sock, 0x00, sizeof(struct at_socket));
+}
+
+int host_socket_open(struct at_device *device, enum at_socket_type type)
+{
+    int i = -1, idx;
+    rt_base_t level;
+    struct at_socket *sock = RT_NULL;
+
+    RT_ASSERT(device);
+
+    /* the classes creating the socket by command choose the device socket like AT socket does */
+    if (device->class->socket_ops->at_socket)
+    {
+        i = device->class->socket_ops->at_socket(device, type);
+        if (i < 0)
+        {
+            LOG_E("device(%s) create socket failed.", device->name);
+            return -1;
+        }
+    }
+
+    level = rt_hw_interrupt_disable();
+
+    for (idx = 0; idx < HOST_SOCKET_NUM && host_sockets[idx]; idx++);
+    if (device->class->socket_ops->at_socket == RT_NULL)
+    {
+        for (i = 0; i < (int) device->class->socket_num && device->sockets[i].magic == AT_SOCKET_MAGIC; i++);
+    }
+    if (idx >= HOST_SOCKET_NUM || i >= (int) device->class->socket_num || device->sockets[i].magic == AT_SOCKET_MAGIC)
+    {
+        rt_hw_interrupt_enable(level);
+        LOG_E("no free socket on device(%s).", device->name);
+        return -1;
+    }
+
+    sock = &(device->sockets[i]);
+    rt_memset(sock, 0x00, sizeof(struct at_socket));
+    sock->magic = AT_SOCKET_MAGIC;
+    sock->socket = idx;
+    sock->device = device;
+    sock->type = type;
+    sock->state = AT_SOCKET_OPEN;
+    sock->ops = device->class->socket_ops;
+    sock->user_data = (void *) (rt_ubase_t) i;
+    rt_mutex_init(&sock->recv_lock, "skt_lk", RT_IPC_FLAG_PRIO);
+    rt_sem_init(&sock->recv_notice, "skt_nt", 0, RT_IPC_FLAG_FIFO);
+    host_sockets[idx] = sock;
+
+    rt_hw_interrupt_enable(level);
+
+    /* AT socket sets the event callbacks on every socket allocation */
+    sock->ops->at_set_event_cb(AT_SOCKET_EVT_RECV, host_socket_recv_cb);
+    sock->ops->at_set_event_cb(AT_SOCKET_EVT_CLOSED, host_socket_closed_cb);
+
+    return idx;
+}
+
+int host_socket_connect(int socket, const char *ip, int32_t port)
+{
+    int result;
+    char ipstr[16] = {0};
+    struct at_socket *sock = at_get_socket(socket);
+
+    if (sock == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    rt_strncpy(ipstr, ip, sizeof(ipstr) - 1);
+    result = sock->ops->at_connect(sock, ipstr, port, sock->type, RT_TRUE);
+    if (result == RT_EOK)
+    {
+        sock->state = AT_SOCKET_CONNECT;
+    }
+
+    return result;
+}
+
+int host_socket_send(int socket, const void *buf, size_t len)
+{
+    struct at_socket *sock = at_get_socket(socket);
+
+    if (sock == RT_NULL || sock->state != AT_SOCKET_CONNECT)
+    {
+        return -RT_ERROR;
+    }
+
+    return sock->ops->at_send(sock, (const char *) buf, len, sock->type);
+}
+
+int host_socket_recv(int socket, void *buf, size_t len, rt_int32_t timeout)
+{
+    size_t size = 0;
+    rt_tick_t start = rt_tick_get();
+    struct at_socket *sock = at_get_socket(socket);
+
+    if (sock == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    while (1)
+    {
+        rt_mutex_take(&sock->recv_lock, RT_WAITING_FOREVER);
+        if (sock->recv_len > 0)
+        {
+            size = sock->recv_len < len ? sock->recv_len : len;
+            rt_memcpy(buf, sock->recv_buf, size);
+            rt_memmove(sock->recv_buf, sock->recv_buf + size, sock->recv_len - size);
+            sock->recv_len -= size;
+        }
+        rt_mutex_release(&sock->recv_lock);
+
+        if (size > 0)
+        {
+            return (int) size;
+        }
+
+        if (sock->state == AT_SOCKET_CLOSED)
+        {
+            return 0;
+        }
+
+        if (rt_tick_get() - start >= (rt_tick_t) timeout)
+        {
+            return -RT_ETIMEOUT;
+        }
+
+        rt_sem_take(&sock->recv_notice, timeout - (rt_int32_t) (rt_tick_get() - start));
+    }
+}
+
+rt_bool_t host_socket_closed(int socket)
+{
+    struct at_socket *sock = at_get_socket(socket);
+
+    return (sock == RT_NULL || sock->state == AT_SOCKET_CLOSED) ? RT_TRUE : RT_FALSE;
+}
+
+int at_closesocket(int socket)
+{
+    int result = RT_EOK;
+    enum at_socket_state last_state;
+    struct at_socket *sock = at_get_socket(socket);
+
+    if (sock == RT_NULL)
+    {
+        return -1;
+    }
+
+    last_state = sock->state;
+
+    /* the close command needs some time, so the state is changed in advance */
+    sock->state = AT_SOCKET_CLOSED;
+
+    if (last_state != AT_SOCKET_CLOSED && sock->ops->at_closesocket(sock) != 0)
+    {
+        LOG_E("AT socket(%d) closesocket failed.", socket);
+        result = -1;
+    }
+
+    host_socket_free(sock);
+
+    return result;
+}
+
+int host_domain_resolve(struct at_device *device, const char *name, char ip[16])
+{
+    RT_ASSERT(device);
+
+    return device->class->socket_ops->at_domain_resolve(name, ip);
+}
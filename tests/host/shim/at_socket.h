@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __AT_SOCKET_H__
+#define __AT_SOCKET_H__
+
+#include <rtthread.h>
+#include <netdev.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The AT socket layer of the host test build, it keeps the received data of
+ * every socket for the test cases instead of the SAL socket interface */
+
+#define AT_SOCKET_MAGIC                0xA100
+#define AT_SOCKET_INFO_LEN             (sizeof("SOCKET:") + 4)
+
+enum at_socket_state
+{
+    AT_SOCKET_NONE,
+    AT_SOCKET_OPEN,
+    AT_SOCKET_LISTEN,
+    AT_SOCKET_CONNECT,
+    AT_SOCKET_CLOSED
+};
+
+enum at_socket_type
+{
+    AT_SOCKET_INVALID   = 0,
+    AT_SOCKET_TCP       = 1,
+    AT_SOCKET_UDP       = 2,
+};
+
+typedef enum
+{
+    AT_SOCKET_EVT_RECV,
+    AT_SOCKET_EVT_CLOSED,
+#ifdef AT_USING_SOCKET_SERVER
+    AT_SOCKET_EVT_CONNECTED,
+#endif
+} at_socket_evt_t;
+
+struct at_socket;
+struct at_device;
+
+typedef void (*at_evt_cb_t)(struct at_socket *socket, at_socket_evt_t event, const char *buff, size_t bfsz);
+
+/* AT socket operations function */
+struct at_socket_ops
+{
+    int (*at_connect)(struct at_socket *socket, char *ip, int32_t port, enum at_socket_type type, rt_bool_t is_client);
+    int (*at_closesocket)(struct at_socket *socket);
+    int (*at_send)(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type);
+    int (*at_domain_resolve)(const char *name, char ip[16]);
+    void (*at_set_event_cb)(at_socket_evt_t event, at_evt_cb_t cb);
+    int (*at_socket)(struct at_device *device, enum at_socket_type type);
+#ifdef AT_USING_SOCKET_SERVER
+    int (*at_listen)(struct at_socket *socket, int backlog);
+#endif
+};
+
+struct at_listen
+{
+    int port;
+    rt_bool_t is_listen;
+};
+
+struct at_socket
+{
+    /* AT socket magic word */
+    uint32_t magic;
+
+    int socket;
+    /* AT socket device */
+    void *device;
+    /* type of the AT socket (TCP, UDP) */
+    enum at_socket_type type;
+    /* current state of the AT socket */
+    enum at_socket_state state;
+    /* sockets operations */
+    const struct at_socket_ops *ops;
+    /* user-specific data, the device socket number */
+    void *user_data;
+    struct at_listen listen;
+    rt_slist_t list;
+
+    /* the received data kept for the test cases */
+    struct rt_mutex recv_lock;
+    struct rt_semaphore recv_notice;
+    char *recv_buf;
+    rt_size_t recv_len;
+};
+
+struct at_socket *at_get_socket(int socket);
+struct at_socket *at_get_base_socket(int base_socket);
+int at_closesocket(int socket);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AT_SOCKET_H__ */
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __FINSH_H__
+#define __FINSH_H__
+
+#include <rtthread.h>
+
+/* the shell commands are kept referenced, the host test build has no shell */
+#define MSH_CMD_EXPORT(command, desc) \
+    static const void *__fsym_##command RT_USED = (const void *) command
+#define MSH_CMD_EXPORT_ALIAS(command, alias, desc) \
+    static const void *__fsym_##alias RT_USED = (const void *) command
+
+#endif /* __FINSH_H__ */
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __HOST_H__
+#define __HOST_H__
+
+#include <rtthread.h>
+#include <at_socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The helpers of the host test build, they are not part of RT-Thread */
+
+/* Monotonic clock, and the offset added to the tick seen by the code under test */
+rt_uint64_t host_time_ms(void);
+rt_uint64_t host_time_us(void);
+void host_tick_advance(rt_uint32_t ms);
+
+/* Log level of the code under test, set by the AT_HOST_LOG environment variable */
+int host_log_level(void);
+void host_log(int level, const char *tag, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+
+/* Register the serial device of the AT client backed by a file descriptor */
+int host_serial_register(const char *name, int fd);
+
+/* Level written to the pin, -1 for the pin never written */
+int host_pin_get(rt_base_t pin);
+
+/* AT socket layer of the host test build, one socket number for every
+ * socket of every AT device */
+int host_socket_open(struct at_device *device, enum at_socket_type type);
+int host_socket_connect(int socket, const char *ip, int32_t port);
+int host_socket_send(int socket, const void *buf, size_t len);
+int host_socket_recv(int socket, void *buf, size_t len, rt_int32_t timeout);
+rt_bool_t host_socket_closed(int socket);
+struct at_socket *host_socket_get(int socket);
+int host_domain_resolve(struct at_device *device, const char *name, char ip[16]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HOST_H__ */
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdio.h>
+
+#include <netdev.h>
+#include <arpa/inet.h>
+
+/*
+ * The network interface devices of the host test build, the low level setters
+ * update the flags and addresses and call the status callback like netdev of
+ * RT-Thread, without SAL and the network stack.
+ */
+
+struct netdev *netdev_list = RT_NULL;
+struct netdev *netdev_default = RT_NULL;
+
+int netdev_register(struct netdev *netdev, const char *name, void *user_data)
+{
+    rt_base_t level;
+    rt_slist_t *node = RT_NULL;
+
+    RT_ASSERT(netdev);
+    RT_ASSERT(name);
+
+    netdev->flags = 0;
+    rt_strncpy(netdev->name, name, RT_NAME_MAX - 1);
+    netdev->user_data = user_data;
+    rt_slist_init(&(netdev->list));
+
+    level = rt_hw_interrupt_disable();
+    if (netdev_list == RT_NULL)
+    {
+        netdev_list = netdev;
+    }
+    else
+    {
+        for (node = &(netdev_list->list); node->next; node = node->next);
+        node->next = &(netdev->list);
+    }
+    if (netdev_default == RT_NULL)
+    {
+        netdev_default = netdev;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+int netdev_unregister(struct netdev *netdev)
+{
+    rt_base_t level;
+    rt_slist_t *node = RT_NULL;
+
+    RT_ASSERT(netdev);
+
+    level = rt_hw_interrupt_disable();
+    if (netdev_list == netdev)
+    {
+        netdev_list = netdev->list.next ? rt_slist_entry(netdev->list.next, struct netdev, list) : RT_NULL;
+    }
+    else if (netdev_list)
+    {
+        for (node = &(netdev_list->list); node->next && node->next != &(netdev->list); node = node->next);
+        if (node->next)
+        {
+            node->next = netdev->list.next;
+        }
+    }
+    if (netdev_default == netdev)
+    {
+        netdev_default = netdev_list;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+struct netdev *netdev_get_by_name(const char *name)
+{
+    rt_slist_t *node = RT_NULL;
+    struct netdev *netdev = RT_NULL;
+
+    if (netdev_list == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    for (node = &(netdev_list->list); node; node = rt_slist_next(node))
+    {
+        netdev = rt_slist_entry(node, struct netdev, list);
+        if (netdev && rt_strncmp(netdev->name, name, RT_NAME_MAX) == 0)
+        {
+            return netdev;
+        }
+    }
+
+    return RT_NULL;
+}
+
+void netdev_set_default(struct netdev *netdev)
+{
+    if (netdev && netdev != netdev_default)
+    {
+        netdev_default = netdev;
+
+        if (netdev->status_callback)
+        {
+            netdev->status_callback(netdev, NETDEV_CB_DEFAULT_CHANGE);
+        }
+    }
+}
+
+void netdev_set_status_callback(struct netdev *netdev, netdev_callback_fn status_callback)
+{
+    RT_ASSERT(netdev);
+
+    netdev->status_callback = status_callback;
+}
+
+static void netdev_status_notify(struct netdev *netdev, enum netdev_cb_type type)
+{
+    if (netdev->status_callback)
+    {
+        netdev->status_callback(netdev, type);
+    }
+}
+
+void netdev_low_level_set_ipaddr(struct netdev *netdev, const ip_addr_t *ip_addr)
+{
+    if (netdev && ip_addr && !ip_addr_cmp(&(netdev->ip_addr), ip_addr))
+    {
+        ip_addr_copy(netdev->ip_addr, *ip_addr);
+        netdev_status_notify(netdev, NETDEV_CB_ADDR_IP);
+    }
+}
+
+void netdev_low_level_set_netmask(struct netdev *netdev, const ip_addr_t *netmask)
+{
+    if (netdev && netmask && !ip_addr_cmp(&(netdev->netmask), netmask))
+    {
+        ip_addr_copy(netdev->netmask, *netmask);
+        netdev_status_notify(netdev, NETDEV_CB_ADDR_NETMASK);
+    }
+}
+
+void netdev_low_level_set_gw(struct netdev *netdev, const ip_addr_t *gw)
+{
+    if (netdev && gw && !ip_addr_cmp(&(netdev->gw), gw))
+    {
+        ip_addr_copy(netdev->gw, *gw);
+        netdev_status_notify(netdev, NETDEV_CB_ADDR_GATEWAY);
+    }
+}
+
+void netdev_low_level_set_dns_server(struct netdev *netdev, uint8_t dns_num, const ip_addr_t *dns_server)
+{
+    if (netdev && dns_server && dns_num < NETDEV_DNS_SERVERS_NUM)
+    {
+        ip_addr_copy(netdev->dns_servers[dns_num], *dns_server);
+        netdev_status_notify(netdev, NETDEV_CB_ADDR_DNS_SERVER);
+    }
+}
+
+void netdev_low_level_set_status(struct netdev *netdev, rt_bool_t is_up)
+{
+    if (netdev && netdev_is_up(netdev) != is_up)
+    {
+        if (is_up)
+        {
+            netdev->flags |= NETDEV_FLAG_UP;
+        }
+        else
+        {
+            netdev->flags &= ~NETDEV_FLAG_UP;
+        }
+        netdev_status_notify(netdev, is_up ? NETDEV_CB_STATUS_UP : NETDEV_CB_STATUS_DOWN);
+    }
+}
+
+void netdev_low_level_set_link_status(struct netdev *netdev, rt_bool_t is_up)
+{
+    if (netdev && netdev_is_link_up(netdev) != is_up)
+    {
+        if (is_up)
+        {
+            netdev->flags |= NETDEV_FLAG_LINK_UP;
+        }
+        else
+        {
+            netdev->flags &= ~(NETDEV_FLAG_LINK_UP | NETDEV_FLAG_INTERNET_UP);
+        }
+        netdev_status_notify(netdev, is_up ? NETDEV_CB_STATUS_LINK_UP : NETDEV_CB_STATUS_LINK_DOWN);
+    }
+}
+
+void netdev_low_level_set_internet_status(struct netdev *netdev, rt_bool_t is_up)
+{
+    if (netdev && netdev_is_internet_up(netdev) != is_up)
+    {
+        if (is_up)
+        {
+            netdev->flags |= NETDEV_FLAG_INTERNET_UP;
+        }
+        else
+        {
+            netdev->flags &= ~NETDEV_FLAG_INTERNET_UP;
+        }
+        netdev_status_notify(netdev, is_up ? NETDEV_CB_STATUS_INTERNET_UP : NETDEV_CB_STATUS_INTERNET_DOWN);
+    }
+}
+
+void netdev_low_level_set_dhcp_status(struct netdev *netdev, rt_bool_t is_enable)
+{
+    if (netdev && netdev_is_dhcp_enabled(netdev) != is_enable)
+    {
+        if (is_enable)
+        {
+            netdev->flags |= NETDEV_FLAG_DHCP;
+        }
+        else
+        {
+            netdev->flags &= ~NETDEV_FLAG_DHCP;
+        }
+        netdev_status_notify(netdev, is_enable ? NETDEV_CB_STATUS_DHCP_ENABLE : NETDEV_CB_STATUS_DHCP_DISABLE);
+    }
+}
+
+int host_inet_aton(const char *cp, ip_addr_t *addr)
+{
+    unsigned int a, b, c, d;
+    char tail = 0;
+
+    if (cp == RT_NULL || sscanf(cp, "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4 ||
+            a > 255 || b > 255 || c > 255 || d > 255)
+    {
+        return 0;
+    }
+
+    if (addr)
+    {
+        /* the address is kept in network byte order */
+        addr->addr = (rt_uint32_t) (a | (b << 8) | (c << 16) | (d << 24));
+    }
+
+    return 1;
+}
+
+char *host_inet_ntoa(const ip_addr_t *addr)
+{
+    static __thread char str[16];
+    rt_uint32_t ip = addr->addr;
+
+    rt_snprintf(str, sizeof(str), "%u.%u.%u.%u",
+                ip & 0xFF, (ip >> 8) & 0xFF, (ip >> 16) & 0xFF, (ip >> 24) & 0xFF);
+
+    return str;
+}
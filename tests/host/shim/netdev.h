@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __NETDEV_H__
+#define __NETDEV_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The network interface device of the host test build, IPv4 only */
+
+typedef struct
+{
+    rt_uint32_t addr;
+} ip_addr_t;
+
+#define ip_addr_cmp(addr1, addr2)      ((addr1)->addr == (addr2)->addr)
+#define ip_addr_copy(dest, src)        ((dest) = (src))
+#define ip_addr_set_zero(ipaddr)       ((ipaddr)->addr = 0)
+#define ip_addr_isany(ipaddr)          ((ipaddr) == RT_NULL || (ipaddr)->addr == 0)
+#define ip4_addr_get_u32(ipaddr)       ((ipaddr)->addr)
+
+#define NETDEV_HWADDR_MAX_LEN          8
+
+#define NETDEV_FLAG_UP                 0x01U
+#define NETDEV_FLAG_BROADCAST          0x02U
+#define NETDEV_FLAG_LINK_UP            0x04U
+#define NETDEV_FLAG_ETHARP             0x08U
+#define NETDEV_FLAG_ETHERNET           0x10U
+#define NETDEV_FLAG_IGMP               0x20U
+#define NETDEV_FLAG_MLD6               0x40U
+#define NETDEV_FLAG_INTERNET_UP        0x80U
+#define NETDEV_FLAG_DHCP               0x100U
+
+struct netdev;
+
+enum netdev_cb_type
+{
+    NETDEV_CB_ADDR_IP,
+    NETDEV_CB_ADDR_NETMASK,
+    NETDEV_CB_ADDR_GATEWAY,
+    NETDEV_CB_ADDR_DNS_SERVER,
+    NETDEV_CB_STATUS_UP,
+    NETDEV_CB_STATUS_DOWN,
+    NETDEV_CB_STATUS_LINK_UP,
+    NETDEV_CB_STATUS_LINK_DOWN,
+    NETDEV_CB_STATUS_INTERNET_UP,
+    NETDEV_CB_STATUS_INTERNET_DOWN,
+    NETDEV_CB_STATUS_DHCP_ENABLE,
+    NETDEV_CB_STATUS_DHCP_DISABLE,
+    NETDEV_CB_REGISTER,
+    NETDEV_CB_DEFAULT_CHANGE,
+};
+
+typedef void (*netdev_callback_fn)(struct netdev *netdev, enum netdev_cb_type type);
+
+struct netdev_ping_resp
+{
+    ip_addr_t ip_addr;
+    uint16_t data_len;
+    uint16_t ttl;
+    uint32_t ticks;
+    void *user_data;
+};
+
+struct netdev_ops
+{
+    int (*set_up)(struct netdev *netdev);
+    int (*set_down)(struct netdev *netdev);
+
+    int (*set_addr_info)(struct netdev *netdev, ip_addr_t *ip_addr, ip_addr_t *netmask, ip_addr_t *gw);
+    int (*set_dns_server)(struct netdev *netdev, uint8_t dns_num, ip_addr_t *dns_server);
+    int (*set_dhcp)(struct netdev *netdev, rt_bool_t is_enabled);
+
+#ifdef NETDEV_USING_PING
+    int (*ping)(struct netdev *netdev, const char *host, size_t data_len, uint32_t timeout,
+                struct netdev_ping_resp *ping_resp, rt_bool_t isbind);
+#endif
+#ifdef NETDEV_USING_NETSTAT
+    void (*netstat)(struct netdev *netdev);
+#endif
+
+    int (*set_default)(struct netdev *netdev);
+};
+
+struct netdev
+{
+    rt_slist_t list;
+
+    char name[RT_NAME_MAX];
+    ip_addr_t ip_addr;
+    ip_addr_t netmask;
+    ip_addr_t gw;
+    ip_addr_t dns_servers[NETDEV_DNS_SERVERS_NUM];
+    uint8_t hwaddr_len;
+    uint8_t hwaddr[NETDEV_HWADDR_MAX_LEN];
+
+    uint16_t flags;
+    uint16_t mtu;
+    const struct netdev_ops *ops;
+
+    netdev_callback_fn status_callback;
+    netdev_callback_fn addr_callback;
+
+    void *user_data;
+};
+
+extern struct netdev *netdev_default;
+
+#define netdev_is_up(netdev)           (((netdev)->flags & NETDEV_FLAG_UP) ? (uint8_t) 1 : (uint8_t) 0)
+#define netdev_is_link_up(netdev)      (((netdev)->flags & NETDEV_FLAG_LINK_UP) ? (uint8_t) 1 : (uint8_t) 0)
+#define netdev_is_internet_up(netdev)  (((netdev)->flags & NETDEV_FLAG_INTERNET_UP) ? (uint8_t) 1 : (uint8_t) 0)
+#define netdev_is_dhcp_enabled(netdev) (((netdev)->flags & NETDEV_FLAG_DHCP) ? (uint8_t) 1 : (uint8_t) 0)
+
+int netdev_register(struct netdev *netdev, const char *name, void *user_data);
+int netdev_unregister(struct netdev *netdev);
+struct netdev *netdev_get_by_name(const char *name);
+void netdev_set_default(struct netdev *netdev);
+void netdev_set_status_callback(struct netdev *netdev, netdev_callback_fn status_callback);
+
+void netdev_low_level_set_ipaddr(struct netdev *netdev, const ip_addr_t *ipaddr);
+void netdev_low_level_set_netmask(struct netdev *netdev, const ip_addr_t *netmask);
+void netdev_low_level_set_gw(struct netdev *netdev, const ip_addr_t *gw);
+void netdev_low_level_set_dns_server(struct netdev *netdev, uint8_t dns_num, const ip_addr_t *dns_server);
+void netdev_low_level_set_status(struct netdev *netdev, rt_bool_t is_up);
+void netdev_low_level_set_link_status(struct netdev *netdev, rt_bool_t is_up);
+void netdev_low_level_set_internet_status(struct netdev *netdev, rt_bool_t is_up);
+void netdev_low_level_set_dhcp_status(struct netdev *netdev, rt_bool_t is_enable);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NETDEV_H__ */
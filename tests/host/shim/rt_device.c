@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#include "host.h"
+
+/*
+ * The devices of the host test build: the serial devices backed by a file
+ * descriptor, the pins kept in memory, the work queue and the log output.
+ */
+
+#define HOST_DEVICE_NUM                8
+#define HOST_PIN_NUM                   256
+
+struct host_serial
+{
+    struct rt_device parent;
+    int fd;
+};
+
+static struct host_serial host_serials[HOST_DEVICE_NUM];
+static rt_int8_t host_pins[HOST_PIN_NUM];
+static rt_bool_t host_pins_init = RT_FALSE;
+
+int host_log_level(void)
+{
+    static int level = -2;
+    const char *env = RT_NULL;
+
+    if (level == -2)
+    {
+        env = getenv("AT_HOST_LOG");
+        level = env ? atoi(env) : -1;
+    }
+
+    return level;
+}
+
+void host_log(int level, const char *tag, const char *fmt, ...)
+{
+    static const char *names[] = {"E", "W", "I", "D"};
+    va_list args;
+
+    if (level > host_log_level())
+    {
+        return;
+    }
+
+    va_start(args, fmt);
+    fprintf(stderr, "[%s/%s] ", names[level & 0x03], tag);
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+}
+
+int host_serial_register(const char *name, int fd)
+{
+    int i;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    for (i = 0; i < HOST_DEVICE_NUM; i++)
+    {
+        if (host_serials[i].parent.parent.name[0] == '\0' ||
+                rt_strncmp(host_serials[i].parent.parent.name, name, RT_NAME_MAX) == 0)
+        {
+            rt_strncpy(host_serials[i].parent.parent.name, name, RT_NAME_MAX - 1);
+            host_serials[i].fd = fd;
+            host_serials[i].parent.user_data = &(host_serials[i].fd);
+            break;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    return i < HOST_DEVICE_NUM ? RT_EOK : -RT_EFULL;
+}
+
+rt_device_t rt_device_find(const char *name)
+{
+    int i;
+
+    for (i = 0; i < HOST_DEVICE_NUM; i++)
+    {
+        if (host_serials[i].parent.parent.name[0] != '\0' &&
+                rt_strncmp(host_serials[i].parent.parent.name, name, RT_NAME_MAX) == 0)
+        {
+            return &(host_serials[i].parent);
+        }
+    }
+
+    return RT_NULL;
+}
+
+rt_err_t rt_device_control(rt_device_t dev, int cmd, void *arg)
+{
+    RT_UNUSED(dev);
+    RT_UNUSED(cmd);
+    RT_UNUSED(arg);
+
+    /* the pseudo-terminal has no line settings to change */
+    return RT_EOK;
+}
+
+rt_err_t rt_device_close(rt_device_t dev)
+{
+    RT_UNUSED(dev);
+
+    /* the pseudo-terminal stays open for the AT client */
+    return RT_EOK;
+}
+
+static void host_pin_check(void)
+{
+    if (host_pins_init == RT_FALSE)
+    {
+        rt_memset(host_pins, -1, sizeof(host_pins));
+        host_pins_init = RT_TRUE;
+    }
+}
+
+void rt_pin_mode(rt_base_t pin, rt_uint8_t mode)
+{
+    RT_UNUSED(mode);
+    host_pin_check();
+}
+
+void rt_pin_write(rt_base_t pin, rt_uint8_t value)
+{
+    host_pin_check();
+    if (pin >= 0 && pin < HOST_PIN_NUM)
+    {
+        host_pins[pin] = (rt_int8_t) value;
+    }
+}
+
+rt_int8_t rt_pin_read(rt_base_t pin)
+{
+    host_pin_check();
+    if (pin >= 0 && pin < HOST_PIN_NUM && host_pins[pin] >= 0)
+    {
+        return host_pins[pin];
+    }
+
+    return PIN_LOW;
+}
+
+int host_pin_get(rt_base_t pin)
+{
+    host_pin_check();
+
+    return (pin >= 0 && pin < HOST_PIN_NUM) ? host_pins[pin] : -1;
+}
+
+void rt_work_init(struct rt_work *work, void (*work_func)(struct rt_work *work, void *work_data),
+                  void *work_data)
+{
+    work->work_func = work_func;
+    work->work_data = work_data;
+    work->timeout_tick = 0;
+}
+
+static void host_work_entry(void *parameter)
+{
+    struct rt_work *work = (struct rt_work *) parameter;
+
+    rt_thread_mdelay((rt_int32_t) work->timeout_tick);
+    /* the work may be released by its own function */
+    work->work_func(work, work->work_data);
+}
+
+rt_err_t rt_work_submit(struct rt_work *work, rt_tick_t ticks)
+{
+    rt_thread_t tid = RT_NULL;
+
+    work->timeout_tick = ticks;
+    tid = rt_thread_create("work", host_work_entry, work, 2048, RT_THREAD_PRIORITY_MAX / 2, 20);
+    if (tid == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+
+    return rt_thread_startup(tid);
+}
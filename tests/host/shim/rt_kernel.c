@@ -0,0 +1,943 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <rtthread.h>
+
+#include "host.h"
+
+/*
+ * The kernel objects are implemented by POSIX threads. The waits take the
+ * real time of the monotonic clock, and the tick reported to the code under
+ * test can be moved forward by host_tick_advance() to expire the caches.
+ */
+
+static pthread_mutex_t host_irq_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static volatile rt_tick_t host_tick_offset = 0;
+static __thread struct rt_thread *host_thread_current = RT_NULL;
+
+struct host_thread
+{
+    pthread_t tid;
+    void (*entry)(void *parameter);
+    void *parameter;
+    struct rt_thread *next;                      /* the started threads, found by name */
+};
+
+struct host_mutex
+{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    pthread_t owner;
+    rt_bool_t owned;
+    rt_uint32_t hold;
+};
+
+struct host_sem
+{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    rt_uint32_t value;
+};
+
+struct host_event
+{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    rt_uint32_t set;
+};
+
+struct host_mq
+{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    rt_size_t msg_size;
+    rt_size_t max_msgs;
+    rt_size_t head;
+    rt_size_t count;
+    char *pool;
+};
+
+struct host_timer
+{
+    void (*timeout)(void *parameter);
+    void *parameter;
+    rt_tick_t time;
+    rt_uint8_t flag;
+    rt_bool_t active;
+    rt_uint64_t expire;
+    rt_bool_t dynamic;
+    struct host_timer *next;
+};
+
+static struct rt_thread *host_thread_list = RT_NULL;
+
+static pthread_mutex_t host_timer_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t host_timer_cond;
+static struct host_timer *host_timer_list = RT_NULL;
+static rt_bool_t host_timer_started = RT_FALSE;
+
+/* milliseconds of the monotonic clock */
+rt_uint64_t host_time_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (rt_uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* microseconds of the monotonic clock */
+rt_uint64_t host_time_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (rt_uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void host_tick_advance(rt_uint32_t ms)
+{
+    rt_base_t level = rt_hw_interrupt_disable();
+    host_tick_offset += ms;
+    rt_hw_interrupt_enable(level);
+}
+
+static void host_cond_init(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/* the absolute time of a timeout in ticks */
+static void host_deadline(struct timespec *ts, rt_int32_t timeout)
+{
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    ts->tv_sec += timeout / 1000;
+    ts->tv_nsec += (long) (timeout % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L)
+    {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+/* wait the condition, returns RT_FALSE when the timeout expired */
+static rt_bool_t host_cond_wait(pthread_cond_t *cond, pthread_mutex_t *lock, rt_int32_t timeout,
+                                const struct timespec *deadline)
+{
+    if (timeout < 0)
+    {
+        pthread_cond_wait(cond, lock);
+        return RT_TRUE;
+    }
+
+    return pthread_cond_timedwait(cond, lock, deadline) != ETIMEDOUT;
+}
+
+static void host_object_name(struct rt_object *object, const char *name)
+{
+    rt_memset(object->name, 0x00, sizeof(object->name));
+    if (name)
+    {
+        rt_strncpy(object->name, name, RT_NAME_MAX - 1);
+    }
+}
+
+void rt_assert_handler(const char *ex, const char *func, rt_size_t line)
+{
+    fprintf(stderr, "(%s) assertion failed at function:%s, line number:%d\n", ex, func, (int) line);
+    abort();
+}
+
+int rt_kprintf(const char *fmt, ...)
+{
+    int len;
+    va_list args;
+
+    va_start(args, fmt);
+    len = vprintf(fmt, args);
+    va_end(args);
+    fflush(stdout);
+
+    return len;
+}
+
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    pthread_mutex_lock(&host_irq_lock);
+    return 0;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+    RT_UNUSED(level);
+    pthread_mutex_unlock(&host_irq_lock);
+}
+
+#ifdef RT_USING_SMP
+rt_base_t rt_spin_lock_irqsave(struct rt_spinlock *lock)
+{
+    while (__sync_lock_test_and_set(&(lock->lock), 1))
+    {
+        sched_yield();
+    }
+    return 0;
+}
+
+void rt_spin_unlock_irqrestore(struct rt_spinlock *lock, rt_base_t level)
+{
+    RT_UNUSED(level);
+    __sync_lock_release(&(lock->lock));
+}
+#endif /* RT_USING_SMP */
+
+void rt_enter_critical(void)
+{
+    pthread_mutex_lock(&host_irq_lock);
+}
+
+void rt_exit_critical(void)
+{
+    pthread_mutex_unlock(&host_irq_lock);
+}
+
+rt_tick_t rt_tick_get(void)
+{
+    return (rt_tick_t) host_time_ms() + host_tick_offset;
+}
+
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms)
+{
+    return ms < 0 ? (rt_tick_t) RT_WAITING_FOREVER : (rt_tick_t) ms;
+}
+
+/* thread */
+
+static void *host_thread_entry(void *parameter)
+{
+    struct rt_thread *thread = (struct rt_thread *) parameter;
+    struct host_thread *impl = (struct host_thread *) thread->impl;
+
+    host_thread_current = thread;
+    impl->entry(impl->parameter);
+
+    return RT_NULL;
+}
+
+rt_thread_t rt_thread_create(const char *name, void (*entry)(void *parameter), void *parameter,
+                             rt_uint32_t stack_size, rt_uint8_t priority, rt_uint32_t tick)
+{
+    struct rt_thread *thread = RT_NULL;
+    struct host_thread *impl = RT_NULL;
+
+    RT_UNUSED(stack_size);
+    RT_UNUSED(priority);
+    RT_UNUSED(tick);
+
+    thread = (struct rt_thread *) rt_calloc(1, sizeof(struct rt_thread));
+    impl = (struct host_thread *) rt_calloc(1, sizeof(struct host_thread));
+    if (thread == RT_NULL || impl == RT_NULL)
+    {
+        rt_free(thread);
+        rt_free(impl);
+        return RT_NULL;
+    }
+
+    host_object_name(&(thread->parent), name);
+    impl->entry = entry;
+    impl->parameter = parameter;
+    thread->impl = impl;
+
+    return thread;
+}
+
+rt_err_t rt_thread_startup(rt_thread_t thread)
+{
+    struct host_thread *impl = (struct host_thread *) thread->impl;
+
+    rt_base_t level;
+
+    if (pthread_create(&(impl->tid), RT_NULL, host_thread_entry, thread) != 0)
+    {
+        return -RT_ERROR;
+    }
+    pthread_detach(impl->tid);
+
+    level = rt_hw_interrupt_disable();
+    impl->next = host_thread_list;
+    host_thread_list = thread;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_delete(rt_thread_t thread)
+{
+    /* the threads under test never exit, the object is only dropped before startup */
+    rt_free(thread->impl);
+    rt_free(thread);
+
+    return RT_EOK;
+}
+
+rt_thread_t rt_thread_find(char *name)
+{
+    rt_base_t level;
+    struct rt_thread *thread = RT_NULL;
+
+    level = rt_hw_interrupt_disable();
+    for (thread = host_thread_list; thread; thread = ((struct host_thread *) thread->impl)->next)
+    {
+        if (rt_strncmp(thread->parent.name, name, RT_NAME_MAX) == 0)
+        {
+            break;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    return thread;
+}
+
+rt_thread_t rt_thread_self(void)
+{
+    if (host_thread_current == RT_NULL)
+    {
+        /* the threads not created by the kernel shim, as the test main thread */
+        host_thread_current = (struct rt_thread *) rt_calloc(1, sizeof(struct rt_thread));
+        host_object_name(&(host_thread_current->parent), "main");
+    }
+
+    return host_thread_current;
+}
+
+rt_err_t rt_thread_delay(rt_tick_t tick)
+{
+    return rt_thread_mdelay((rt_int32_t) tick);
+}
+
+rt_err_t rt_thread_mdelay(rt_int32_t ms)
+{
+    if (ms > 0)
+    {
+        usleep((useconds_t) ms * 1000);
+    }
+
+    return RT_EOK;
+}
+
+/* semaphore */
+
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    struct host_sem *impl = (struct host_sem *) rt_calloc(1, sizeof(struct host_sem));
+
+    RT_ASSERT(impl);
+
+    host_object_name(&(sem->parent), name);
+    sem->parent.flag = flag;
+    pthread_mutex_init(&(impl->lock), RT_NULL);
+    host_cond_init(&(impl->cond));
+    impl->value = value;
+    sem->impl = impl;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_detach(rt_sem_t sem)
+{
+    struct host_sem *impl = (struct host_sem *) sem->impl;
+
+    pthread_cond_destroy(&(impl->cond));
+    pthread_mutex_destroy(&(impl->lock));
+    rt_free(impl);
+    sem->impl = RT_NULL;
+
+    return RT_EOK;
+}
+
+rt_sem_t rt_sem_create(const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    rt_sem_t sem = (rt_sem_t) rt_calloc(1, sizeof(struct rt_semaphore));
+
+    if (sem)
+    {
+        rt_sem_init(sem, name, value, flag);
+    }
+
+    return sem;
+}
+
+rt_err_t rt_sem_delete(rt_sem_t sem)
+{
+    rt_sem_detach(sem);
+    rt_free(sem);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t timeout)
+{
+    rt_err_t result = RT_EOK;
+    struct timespec deadline;
+    struct host_sem *impl = (struct host_sem *) sem->impl;
+
+    host_deadline(&deadline, timeout);
+
+    pthread_mutex_lock(&(impl->lock));
+    while (impl->value == 0)
+    {
+        if (timeout == 0 || host_cond_wait(&(impl->cond), &(impl->lock), timeout, &deadline) == RT_FALSE)
+        {
+            result = -RT_ETIMEOUT;
+            break;
+        }
+    }
+    if (result == RT_EOK)
+    {
+        impl->value--;
+    }
+    pthread_mutex_unlock(&(impl->lock));
+
+    return result;
+}
+
+rt_err_t rt_sem_trytake(rt_sem_t sem)
+{
+    return rt_sem_take(sem, RT_WAITING_NO);
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+    struct host_sem *impl = (struct host_sem *) sem->impl;
+
+    pthread_mutex_lock(&(impl->lock));
+    impl->value++;
+    pthread_cond_signal(&(impl->cond));
+    pthread_mutex_unlock(&(impl->lock));
+
+    return RT_EOK;
+}
+
+/* mutex */
+
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag)
+{
+    struct host_mutex *impl = (struct host_mutex *) rt_calloc(1, sizeof(struct host_mutex));
+
+    RT_ASSERT(impl);
+
+    host_object_name(&(mutex->parent), name);
+    mutex->parent.flag = flag;
+    pthread_mutex_init(&(impl->lock), RT_NULL);
+    host_cond_init(&(impl->cond));
+    mutex->impl = impl;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_detach(rt_mutex_t mutex)
+{
+    struct host_mutex *impl = (struct host_mutex *) mutex->impl;
+
+    pthread_cond_destroy(&(impl->cond));
+    pthread_mutex_destroy(&(impl->lock));
+    rt_free(impl);
+    mutex->impl = RT_NULL;
+
+    return RT_EOK;
+}
+
+rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag)
+{
+    rt_mutex_t mutex = (rt_mutex_t) rt_calloc(1, sizeof(struct rt_mutex));
+
+    if (mutex)
+    {
+        rt_mutex_init(mutex, name, flag);
+    }
+
+    return mutex;
+}
+
+rt_err_t rt_mutex_delete(rt_mutex_t mutex)
+{
+    rt_mutex_detach(mutex);
+    rt_free(mutex);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
+{
+    rt_err_t result = RT_EOK;
+    struct timespec deadline;
+    struct host_mutex *impl = (struct host_mutex *) mutex->impl;
+    pthread_t self = pthread_self();
+
+    host_deadline(&deadline, timeout);
+
+    pthread_mutex_lock(&(impl->lock));
+    if (impl->owned && pthread_equal(impl->owner, self))
+    {
+        impl->hold++;
+    }
+    else
+    {
+        while (impl->owned)
+        {
+            if (timeout == 0 || host_cond_wait(&(impl->cond), &(impl->lock), timeout, &deadline) == RT_FALSE)
+            {
+                result = -RT_ETIMEOUT;
+                break;
+            }
+        }
+        if (result == RT_EOK)
+        {
+            impl->owned = RT_TRUE;
+            impl->owner = self;
+            impl->hold = 1;
+        }
+    }
+    pthread_mutex_unlock(&(impl->lock));
+
+    return result;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+    rt_err_t result = RT_EOK;
+    struct host_mutex *impl = (struct host_mutex *) mutex->impl;
+
+    pthread_mutex_lock(&(impl->lock));
+    if (impl->owned == RT_FALSE || pthread_equal(impl->owner, pthread_self()) == 0)
+    {
+        result = -RT_ERROR;
+    }
+    else if (--impl->hold == 0)
+    {
+        impl->owned = RT_FALSE;
+        pthread_cond_signal(&(impl->cond));
+    }
+    pthread_mutex_unlock(&(impl->lock));
+
+    RT_ASSERT(result == RT_EOK);
+
+    return result;
+}
+
+/* event */
+
+rt_err_t rt_event_init(rt_event_t event, const char *name, rt_uint8_t flag)
+{
+    struct host_event *impl = (struct host_event *) rt_calloc(1, sizeof(struct host_event));
+
+    RT_ASSERT(impl);
+
+    host_object_name(&(event->parent), name);
+    event->parent.flag = flag;
+    pthread_mutex_init(&(impl->lock), RT_NULL);
+    host_cond_init(&(impl->cond));
+    event->impl = impl;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_event_detach(rt_event_t event)
+{
+    struct host_event *impl = (struct host_event *) event->impl;
+
+    pthread_cond_destroy(&(impl->cond));
+    pthread_mutex_destroy(&(impl->lock));
+    rt_free(impl);
+    event->impl = RT_NULL;
+
+    return RT_EOK;
+}
+
+rt_event_t rt_event_create(const char *name, rt_uint8_t flag)
+{
+    rt_event_t event = (rt_event_t) rt_calloc(1, sizeof(struct rt_event));
+
+    if (event)
+    {
+        rt_event_init(event, name, flag);
+    }
+
+    return event;
+}
+
+rt_err_t rt_event_delete(rt_event_t event)
+{
+    rt_event_detach(event);
+    rt_free(event);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set)
+{
+    struct host_event *impl = (struct host_event *) event->impl;
+
+    pthread_mutex_lock(&(impl->lock));
+    impl->set |= set;
+    pthread_cond_broadcast(&(impl->cond));
+    pthread_mutex_unlock(&(impl->lock));
+
+    return RT_EOK;
+}
+
+rt_err_t rt_event_recv(rt_event_t event, rt_uint32_t set, rt_uint8_t opt,
+                       rt_int32_t timeout, rt_uint32_t *recved)
+{
+    rt_err_t result = RT_EOK;
+    struct timespec deadline;
+    struct host_event *impl = (struct host_event *) event->impl;
+
+    host_deadline(&deadline, timeout);
+
+    pthread_mutex_lock(&(impl->lock));
+    while (1)
+    {
+        if ((opt & RT_EVENT_FLAG_AND) ? ((impl->set & set) == set) : ((impl->set & set) != 0))
+        {
+            break;
+        }
+
+        if (timeout == 0 || host_cond_wait(&(impl->cond), &(impl->lock), timeout, &deadline) == RT_FALSE)
+        {
+            result = -RT_ETIMEOUT;
+            break;
+        }
+    }
+    if (result == RT_EOK)
+    {
+        if (recved)
+        {
+            *recved = impl->set & set;
+        }
+        if (opt & RT_EVENT_FLAG_CLEAR)
+        {
+            impl->set &= ~set;
+        }
+    }
+    pthread_mutex_unlock(&(impl->lock));
+
+    return result;
+}
+
+/* message queue */
+
+rt_mq_t rt_mq_create(const char *name, rt_size_t msg_size, rt_size_t max_msgs, rt_uint8_t flag)
+{
+    rt_mq_t mq = (rt_mq_t) rt_calloc(1, sizeof(struct rt_messagequeue));
+    struct host_mq *impl = (struct host_mq *) rt_calloc(1, sizeof(struct host_mq));
+
+    if (mq == RT_NULL || impl == RT_NULL)
+    {
+        rt_free(mq);
+        rt_free(impl);
+        return RT_NULL;
+    }
+
+    impl->pool = (char *) rt_calloc(max_msgs, msg_size);
+    if (impl->pool == RT_NULL)
+    {
+        rt_free(mq);
+        rt_free(impl);
+        return RT_NULL;
+    }
+
+    host_object_name(&(mq->parent), name);
+    mq->parent.flag = flag;
+    pthread_mutex_init(&(impl->lock), RT_NULL);
+    host_cond_init(&(impl->cond));
+    impl->msg_size = msg_size;
+    impl->max_msgs = max_msgs;
+    mq->impl = impl;
+
+    return mq;
+}
+
+rt_err_t rt_mq_delete(rt_mq_t mq)
+{
+    struct host_mq *impl = (struct host_mq *) mq->impl;
+
+    pthread_cond_destroy(&(impl->cond));
+    pthread_mutex_destroy(&(impl->lock));
+    rt_free(impl->pool);
+    rt_free(impl);
+    rt_free(mq);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mq_send(rt_mq_t mq, const void *buffer, rt_size_t size)
+{
+    rt_err_t result = RT_EOK;
+    struct host_mq *impl = (struct host_mq *) mq->impl;
+
+    if (size > impl->msg_size)
+    {
+        return -RT_ERROR;
+    }
+
+    pthread_mutex_lock(&(impl->lock));
+    if (impl->count == impl->max_msgs)
+    {
+        result = -RT_EFULL;
+    }
+    else
+    {
+        rt_memcpy(impl->pool + ((impl->head + impl->count) % impl->max_msgs) * impl->msg_size, buffer, size);
+        impl->count++;
+        pthread_cond_signal(&(impl->cond));
+    }
+    pthread_mutex_unlock(&(impl->lock));
+
+    return result;
+}
+
+rt_ssize_t rt_mq_recv(rt_mq_t mq, void *buffer, rt_size_t size, rt_int32_t timeout)
+{
+    rt_ssize_t result = 0;
+    struct timespec deadline;
+    struct host_mq *impl = (struct host_mq *) mq->impl;
+
+    host_deadline(&deadline, timeout);
+
+    pthread_mutex_lock(&(impl->lock));
+    while (impl->count == 0)
+    {
+        if (timeout == 0 || host_cond_wait(&(impl->cond), &(impl->lock), timeout, &deadline) == RT_FALSE)
+        {
+            result = -RT_ETIMEOUT;
+            break;
+        }
+    }
+    if (result == 0)
+    {
+        result = (rt_ssize_t) (size < impl->msg_size ? size : impl->msg_size);
+        rt_memcpy(buffer, impl->pool + impl->head * impl->msg_size, (rt_size_t) result);
+        impl->head = (impl->head + 1) % impl->max_msgs;
+        impl->count--;
+    }
+    pthread_mutex_unlock(&(impl->lock));
+
+    return result;
+}
+
+/* timer */
+
+static void *host_timer_thread_entry(void *parameter)
+{
+    struct host_timer *timer = RT_NULL, *next = RT_NULL;
+    rt_uint64_t now = 0;
+    struct timespec ts;
+
+    RT_UNUSED(parameter);
+
+    pthread_mutex_lock(&host_timer_lock);
+    while (1)
+    {
+        next = RT_NULL;
+        for (timer = host_timer_list; timer; timer = timer->next)
+        {
+            if (timer->active && (next == RT_NULL || timer->expire < next->expire))
+            {
+                next = timer;
+            }
+        }
+
+        now = host_time_ms();
+        if (next == RT_NULL)
+        {
+            pthread_cond_wait(&host_timer_cond, &host_timer_lock);
+            continue;
+        }
+
+        if (next->expire > now)
+        {
+            ts.tv_sec = (time_t) (next->expire / 1000);
+            ts.tv_nsec = (long) (next->expire % 1000) * 1000000L;
+            pthread_cond_timedwait(&host_timer_cond, &host_timer_lock, &ts);
+            continue;
+        }
+
+        if (next->flag & RT_TIMER_FLAG_PERIODIC)
+        {
+            next->expire = now + (next->time ? next->time : 1);
+        }
+        else
+        {
+            next->active = RT_FALSE;
+        }
+
+        /* the timeout function may start or stop timers */
+        pthread_mutex_unlock(&host_timer_lock);
+        next->timeout(next->parameter);
+        pthread_mutex_lock(&host_timer_lock);
+    }
+
+    return RT_NULL;
+}
+
+static struct host_timer *host_timer_new(rt_timer_t timer, const char *name, void (*timeout)(void *parameter),
+                                         void *parameter, rt_tick_t time, rt_uint8_t flag)
+{
+    pthread_t tid;
+    struct host_timer *impl = (struct host_timer *) rt_calloc(1, sizeof(struct host_timer));
+
+    RT_ASSERT(impl);
+
+    host_object_name(&(timer->parent), name);
+    impl->timeout = timeout;
+    impl->parameter = parameter;
+    impl->time = time;
+    impl->flag = flag;
+    timer->impl = impl;
+
+    pthread_mutex_lock(&host_timer_lock);
+    if (host_timer_started == RT_FALSE)
+    {
+        host_cond_init(&host_timer_cond);
+        pthread_create(&tid, RT_NULL, host_timer_thread_entry, RT_NULL);
+        pthread_detach(tid);
+        host_timer_started = RT_TRUE;
+    }
+    impl->next = host_timer_list;
+    host_timer_list = impl;
+    pthread_mutex_unlock(&host_timer_lock);
+
+    return impl;
+}
+
+static void host_timer_free(rt_timer_t timer)
+{
+    struct host_timer **node = RT_NULL;
+    struct host_timer *impl = (struct host_timer *) timer->impl;
+
+    pthread_mutex_lock(&host_timer_lock);
+    for (node = &host_timer_list; *node; node = &((*node)->next))
+    {
+        if (*node == impl)
+        {
+            *node = impl->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&host_timer_lock);
+
+    rt_free(impl);
+    timer->impl = RT_NULL;
+}
+
+void rt_timer_init(rt_timer_t timer, const char *name, void (*timeout)(void *parameter),
+                   void *parameter, rt_tick_t time, rt_uint8_t flag)
+{
+    host_timer_new(timer, name, timeout, parameter, time, flag);
+}
+
+rt_err_t rt_timer_detach(rt_timer_t timer)
+{
+    host_timer_free(timer);
+
+    return RT_EOK;
+}
+
+rt_timer_t rt_timer_create(const char *name, void (*timeout)(void *parameter),
+                           void *parameter, rt_tick_t time, rt_uint8_t flag)
+{
+    rt_timer_t timer = (rt_timer_t) rt_calloc(1, sizeof(struct rt_timer));
+
+    if (timer)
+    {
+        host_timer_new(timer, name, timeout, parameter, time, flag)->dynamic = RT_TRUE;
+    }
+
+    return timer;
+}
+
+rt_err_t rt_timer_delete(rt_timer_t timer)
+{
+    host_timer_free(timer);
+    rt_free(timer);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_start(rt_timer_t timer)
+{
+    struct host_timer *impl = (struct host_timer *) timer->impl;
+
+    pthread_mutex_lock(&host_timer_lock);
+    impl->expire = host_time_ms() + impl->time;
+    impl->active = RT_TRUE;
+    pthread_cond_signal(&host_timer_cond);
+    pthread_mutex_unlock(&host_timer_lock);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_stop(rt_timer_t timer)
+{
+    rt_err_t result = RT_EOK;
+    struct host_timer *impl = (struct host_timer *) timer->impl;
+
+    pthread_mutex_lock(&host_timer_lock);
+    if (impl->active == RT_FALSE)
+    {
+        result = -RT_ERROR;
+    }
+    impl->active = RT_FALSE;
+    pthread_cond_signal(&host_timer_cond);
+    pthread_mutex_unlock(&host_timer_lock);
+
+    return result;
+}
+
+rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg)
+{
+    struct host_timer *impl = (struct host_timer *) timer->impl;
+
+    pthread_mutex_lock(&host_timer_lock);
+    switch (cmd)
+    {
+    case RT_TIMER_CTRL_SET_TIME:
+        impl->time = *(rt_tick_t *) arg;
+        break;
+    case RT_TIMER_CTRL_GET_TIME:
+        *(rt_tick_t *) arg = impl->time;
+        break;
+    case RT_TIMER_CTRL_SET_ONESHOT:
+        impl->flag &= ~RT_TIMER_FLAG_PERIODIC;
+        break;
+    case RT_TIMER_CTRL_SET_PERIODIC:
+        impl->flag |= RT_TIMER_FLAG_PERIODIC;
+        break;
+    default:
+        break;
+    }
+    pthread_mutex_unlock(&host_timer_lock);
+
+    return RT_EOK;
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __RT_CONFIG_H__
+#define __RT_CONFIG_H__
+
+/* RT-Thread configuration of the host test build, the AT device options are
+ * passed by the Makefile of every test variant */
+
+#define RT_NAME_MAX                    8
+#define RT_TICK_PER_SECOND             1000
+#define RT_THREAD_PRIORITY_MAX         32
+#define RT_USING_HEAP
+
+#define RT_USING_NETDEV
+#define NETDEV_USING_PING
+#define NETDEV_USING_NETSTAT
+#define NETDEV_DNS_SERVERS_NUM         2
+
+#define RT_USING_AT
+#define AT_USING_CLIENT
+#define AT_USING_SOCKET
+#define AT_CMD_MAX_LEN                 128
+
+#define FINSH_USING_MSH
+
+#endif /* __RT_CONFIG_H__ */
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __RT_DBG_H__
+#define __RT_DBG_H__
+
+#include <rtthread.h>
+
+#define DBG_ERROR           0
+#define DBG_WARNING         1
+#define DBG_INFO            2
+#define DBG_LOG             3
+
+#ifndef DBG_TAG
+#define DBG_TAG             "DBG"
+#endif
+
+#ifndef DBG_LVL
+#define DBG_LVL             DBG_WARNING
+#endif
+
+/* the logs are printed by the host_log() of the kernel shim, the level is
+ * checked again there against the AT_HOST_LOG environment variable */
+void host_log(int level, const char *tag, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+
+#define dbg_log(level, ...)                                      \
+    do {                                                         \
+        if ((level) <= DBG_LVL)                                  \
+        {                                                        \
+            host_log((level), DBG_TAG, __VA_ARGS__);             \
+        }                                                        \
+    } while (0)
+
+#define LOG_D(...)          dbg_log(DBG_LOG, __VA_ARGS__)
+#define LOG_I(...)          dbg_log(DBG_INFO, __VA_ARGS__)
+#define LOG_W(...)          dbg_log(DBG_WARNING, __VA_ARGS__)
+#define LOG_E(...)          dbg_log(DBG_ERROR, __VA_ARGS__)
+#define LOG_RAW(...)        rt_kprintf(__VA_ARGS__)
+#define LOG_HEX(name, width, buf, size)
+
+#endif /* __RT_DBG_H__ */
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __RT_DEVICE_H__
+#define __RT_DEVICE_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* pin */
+#define PIN_LOW                        0x00
+#define PIN_HIGH                       0x01
+
+#define PIN_MODE_OUTPUT                0x00
+#define PIN_MODE_INPUT                 0x01
+#define PIN_MODE_INPUT_PULLUP          0x02
+#define PIN_MODE_INPUT_PULLDOWN        0x03
+#define PIN_MODE_OUTPUT_OD             0x04
+
+void rt_pin_mode(rt_base_t pin, rt_uint8_t mode);
+void rt_pin_write(rt_base_t pin, rt_uint8_t value);
+rt_int8_t rt_pin_read(rt_base_t pin);
+
+/* serial */
+#define BAUD_RATE_9600                 9600
+#define BAUD_RATE_115200               115200
+#define BAUD_RATE_460800               460800
+#define BAUD_RATE_921600               921600
+
+#define DATA_BITS_8                    8
+#define STOP_BITS_1                    0
+#define PARITY_NONE                    0
+#define BIT_ORDER_LSB                  0
+#define NRZ_NORMAL                     0
+#define RT_SERIAL_RB_BUFSZ             64
+
+struct serial_configure
+{
+    rt_uint32_t baud_rate;
+    rt_uint32_t data_bits               :4;
+    rt_uint32_t stop_bits               :2;
+    rt_uint32_t parity                  :2;
+    rt_uint32_t bit_order               :1;
+    rt_uint32_t invert                  :1;
+    rt_uint32_t bufsz                   :16;
+    rt_uint32_t flowcontrol             :1;
+    rt_uint32_t reserved                :5;
+};
+
+#define RT_SERIAL_CONFIG_DEFAULT                   \
+{                                                  \
+    BAUD_RATE_115200,                              \
+    DATA_BITS_8,                                   \
+    STOP_BITS_1,                                   \
+    PARITY_NONE,                                   \
+    BIT_ORDER_LSB,                                 \
+    NRZ_NORMAL,                                    \
+    RT_SERIAL_RB_BUFSZ,                            \
+    0,                                             \
+    0                                              \
+}
+
+/* work queue, every submitted work runs in its own thread after the delay */
+struct rt_work
+{
+    void (*work_func)(struct rt_work *work, void *work_data);
+    void *work_data;
+    rt_tick_t timeout_tick;
+};
+
+void rt_work_init(struct rt_work *work, void (*work_func)(struct rt_work *work, void *work_data),
+                  void *work_data);
+rt_err_t rt_work_submit(struct rt_work *work, rt_tick_t ticks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RT_DEVICE_H__ */
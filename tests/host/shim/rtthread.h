@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __RT_THREAD_H__
+#define __RT_THREAD_H__
+
+/*
+ * The thin RT-Thread kernel shim of the host test build. The kernel objects
+ * are backed by POSIX threads, one tick is one millisecond, and the interrupt
+ * lock is a process wide recursive lock.
+ */
+
+#include <rtconfig.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RT_VERSION_CHECK(major, minor, revise)  (((major) * 10000) + ((minor) * 100) + (revise))
+#define RT_VERSION_MAJOR               5
+#define RT_VERSION_MINOR               2
+#define RT_VERSION_PATCH               2
+#define RTTHREAD_VERSION               RT_VERSION_CHECK(RT_VERSION_MAJOR, RT_VERSION_MINOR, RT_VERSION_PATCH)
+#define RT_VER_NUM                     0x50202
+
+typedef int                            rt_bool_t;
+typedef long                           rt_base_t;
+typedef unsigned long                  rt_ubase_t;
+typedef int8_t                         rt_int8_t;
+typedef int16_t                        rt_int16_t;
+typedef int32_t                        rt_int32_t;
+typedef int64_t                        rt_int64_t;
+typedef uint8_t                        rt_uint8_t;
+typedef uint16_t                       rt_uint16_t;
+typedef uint32_t                       rt_uint32_t;
+typedef uint64_t                       rt_uint64_t;
+typedef rt_base_t                      rt_err_t;
+typedef rt_uint32_t                    rt_tick_t;
+typedef size_t                         rt_size_t;
+typedef long                           rt_ssize_t;
+typedef rt_base_t                      rt_off_t;
+
+#define RT_TRUE                        1
+#define RT_FALSE                       0
+#define RT_NULL                        0
+
+#define RT_EOK                         0
+#define RT_ERROR                       1
+#define RT_ETIMEOUT                    2
+#define RT_EFULL                       3
+#define RT_EEMPTY                      4
+#define RT_ENOMEM                      5
+#define RT_ENOSYS                      6
+#define RT_EBUSY                       7
+#define RT_EIO                         8
+#define RT_EINTR                       9
+#define RT_EINVAL                      10
+
+#define RT_WAITING_FOREVER             -1
+#define RT_WAITING_NO                  0
+
+#define RT_IPC_FLAG_FIFO               0x00
+#define RT_IPC_FLAG_PRIO               0x01
+
+#define RT_EVENT_FLAG_AND              0x01
+#define RT_EVENT_FLAG_OR               0x02
+#define RT_EVENT_FLAG_CLEAR            0x04
+
+#define RT_TIMER_FLAG_ONE_SHOT         0x0
+#define RT_TIMER_FLAG_PERIODIC         0x2
+#define RT_TIMER_FLAG_HARD_TIMER       0x0
+#define RT_TIMER_FLAG_SOFT_TIMER       0x4
+
+#define RT_TIMER_CTRL_SET_TIME         0x0
+#define RT_TIMER_CTRL_GET_TIME         0x1
+#define RT_TIMER_CTRL_SET_ONESHOT      0x2
+#define RT_TIMER_CTRL_SET_PERIODIC     0x3
+
+#define RT_DEVICE_CTRL_CONFIG          0x03
+
+#define RT_ALIGN_SIZE                  4
+#define RT_ALIGN(size, align)          (((size) + (align) - 1) & ~((align) - 1))
+#define RT_ALIGN_DOWN(size, align)     ((size) & ~((align) - 1))
+
+#define rt_inline                      static inline
+#define RT_UNUSED(x)                   ((void) (x))
+#define RT_USED                        __attribute__((used))
+#define RT_WEAK                        __attribute__((weak))
+#define rt_weak                        __attribute__((weak))
+
+#define rt_container_of(ptr, type, member) \
+    ((type *) ((char *) (ptr) - (unsigned long) (&((type *) 0)->member)))
+
+/* The assertion aborts the test process */
+void rt_assert_handler(const char *ex, const char *func, rt_size_t line);
+#define RT_ASSERT(EX)                                            \
+    do {                                                         \
+        if (!(EX))                                               \
+        {                                                        \
+            rt_assert_handler(#EX, __FUNCTION__, __LINE__);      \
+        }                                                        \
+    } while (0)
+
+/* The components are registered by the test cases, only the device classes
+ * are registered before main() like the automatic initialization does */
+typedef int (*init_fn_t)(void);
+#define INIT_BOARD_EXPORT(fn)          static init_fn_t __rt_init_##fn RT_USED = fn
+#define INIT_PREV_EXPORT(fn)           static init_fn_t __rt_init_##fn RT_USED = fn
+#define INIT_DEVICE_EXPORT(fn)         static void __attribute__((constructor)) __rt_init_##fn(void) { fn(); }
+#define INIT_COMPONENT_EXPORT(fn)      static init_fn_t __rt_init_##fn RT_USED = fn
+#define INIT_ENV_EXPORT(fn)            static init_fn_t __rt_init_##fn RT_USED = fn
+#define INIT_APP_EXPORT(fn)            static init_fn_t __rt_init_##fn RT_USED = fn
+
+/* single list */
+struct rt_slist_node
+{
+    struct rt_slist_node *next;
+};
+typedef struct rt_slist_node rt_slist_t;
+
+#define RT_SLIST_OBJECT_INIT(object)   { RT_NULL }
+
+rt_inline void rt_slist_init(rt_slist_t *l)
+{
+    l->next = RT_NULL;
+}
+
+rt_inline void rt_slist_append(rt_slist_t *l, rt_slist_t *n)
+{
+    struct rt_slist_node *node = l;
+
+    while (node->next)
+    {
+        node = node->next;
+    }
+
+    node->next = n;
+    n->next = RT_NULL;
+}
+
+rt_inline void rt_slist_insert(rt_slist_t *l, rt_slist_t *n)
+{
+    n->next = l->next;
+    l->next = n;
+}
+
+rt_inline unsigned int rt_slist_len(const rt_slist_t *l)
+{
+    unsigned int len = 0;
+    const rt_slist_t *list = l->next;
+
+    while (list != RT_NULL)
+    {
+        list = list->next;
+        len++;
+    }
+
+    return len;
+}
+
+rt_inline rt_slist_t *rt_slist_remove(rt_slist_t *l, rt_slist_t *n)
+{
+    struct rt_slist_node *node = l;
+
+    while (node->next && node->next != n)
+    {
+        node = node->next;
+    }
+
+    if (node->next != (rt_slist_t *) 0)
+    {
+        node->next = node->next->next;
+    }
+
+    return l;
+}
+
+rt_inline rt_slist_t *rt_slist_first(rt_slist_t *l)
+{
+    return l->next;
+}
+
+rt_inline rt_slist_t *rt_slist_next(rt_slist_t *n)
+{
+    return n->next;
+}
+
+rt_inline int rt_slist_isempty(rt_slist_t *l)
+{
+    return l->next == RT_NULL;
+}
+
+#define rt_slist_entry(node, type, member)  rt_container_of(node, type, member)
+#define rt_slist_for_each(pos, head)        for (pos = (head)->next; pos != RT_NULL; pos = pos->next)
+
+/* kernel objects, the POSIX object behind is kept in impl */
+struct rt_object
+{
+    char name[RT_NAME_MAX];
+    rt_uint8_t type;
+    rt_uint8_t flag;
+};
+
+struct rt_thread
+{
+    struct rt_object parent;
+    void *impl;
+};
+typedef struct rt_thread *rt_thread_t;
+
+struct rt_semaphore
+{
+    struct rt_object parent;
+    void *impl;
+};
+typedef struct rt_semaphore *rt_sem_t;
+
+struct rt_mutex
+{
+    struct rt_object parent;
+    void *impl;
+};
+typedef struct rt_mutex *rt_mutex_t;
+
+struct rt_event
+{
+    struct rt_object parent;
+    void *impl;
+};
+typedef struct rt_event *rt_event_t;
+
+struct rt_messagequeue
+{
+    struct rt_object parent;
+    void *impl;
+};
+typedef struct rt_messagequeue *rt_mq_t;
+
+struct rt_timer
+{
+    struct rt_object parent;
+    void *impl;
+};
+typedef struct rt_timer *rt_timer_t;
+
+struct rt_device
+{
+    struct rt_object parent;
+    void *user_data;
+};
+typedef struct rt_device *rt_device_t;
+
+/* interrupt lock and scheduler lock */
+rt_base_t rt_hw_interrupt_disable(void);
+void rt_hw_interrupt_enable(rt_base_t level);
+void rt_enter_critical(void);
+void rt_exit_critical(void);
+
+#ifdef RT_USING_SMP
+/* spinlock of the SMP build, zero initialized is unlocked */
+struct rt_spinlock
+{
+    volatile int lock;
+};
+
+rt_base_t rt_spin_lock_irqsave(struct rt_spinlock *lock);
+void rt_spin_unlock_irqrestore(struct rt_spinlock *lock, rt_base_t level);
+#define rt_hw_dmb()                    __sync_synchronize()
+#endif /* RT_USING_SMP */
+
+/* thread */
+rt_thread_t rt_thread_create(const char *name, void (*entry)(void *parameter), void *parameter,
+                             rt_uint32_t stack_size, rt_uint8_t priority, rt_uint32_t tick);
+rt_err_t rt_thread_startup(rt_thread_t thread);
+rt_err_t rt_thread_delete(rt_thread_t thread);
+rt_thread_t rt_thread_find(char *name);
+rt_thread_t rt_thread_self(void);
+rt_err_t rt_thread_delay(rt_tick_t tick);
+rt_err_t rt_thread_mdelay(rt_int32_t ms);
+
+/* clock */
+rt_tick_t rt_tick_get(void);
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms);
+
+/* semaphore */
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value, rt_uint8_t flag);
+rt_err_t rt_sem_detach(rt_sem_t sem);
+rt_sem_t rt_sem_create(const char *name, rt_uint32_t value, rt_uint8_t flag);
+rt_err_t rt_sem_delete(rt_sem_t sem);
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t timeout);
+rt_err_t rt_sem_trytake(rt_sem_t sem);
+rt_err_t rt_sem_release(rt_sem_t sem);
+
+/* mutex, it's recursive for the owner thread */
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag);
+rt_err_t rt_mutex_detach(rt_mutex_t mutex);
+rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag);
+rt_err_t rt_mutex_delete(rt_mutex_t mutex);
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout);
+rt_err_t rt_mutex_release(rt_mutex_t mutex);
+
+/* event */
+rt_err_t rt_event_init(rt_event_t event, const char *name, rt_uint8_t flag);
+rt_err_t rt_event_detach(rt_event_t event);
+rt_event_t rt_event_create(const char *name, rt_uint8_t flag);
+rt_err_t rt_event_delete(rt_event_t event);
+rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set);
+rt_err_t rt_event_recv(rt_event_t event, rt_uint32_t set, rt_uint8_t opt,
+                       rt_int32_t timeout, rt_uint32_t *recved);
+
+/* message queue */
+rt_mq_t rt_mq_create(const char *name, rt_size_t msg_size, rt_size_t max_msgs, rt_uint8_t flag);
+rt_err_t rt_mq_delete(rt_mq_t mq);
+rt_err_t rt_mq_send(rt_mq_t mq, const void *buffer, rt_size_t size);
+rt_ssize_t rt_mq_recv(rt_mq_t mq, void *buffer, rt_size_t size, rt_int32_t timeout);
+
+/* timer, the timeout functions run in one timer thread */
+void rt_timer_init(rt_timer_t timer, const char *name, void (*timeout)(void *parameter),
+                   void *parameter, rt_tick_t time, rt_uint8_t flag);
+rt_err_t rt_timer_detach(rt_timer_t timer);
+rt_timer_t rt_timer_create(const char *name, void (*timeout)(void *parameter),
+                           void *parameter, rt_tick_t time, rt_uint8_t flag);
+rt_err_t rt_timer_delete(rt_timer_t timer);
+rt_err_t rt_timer_start(rt_timer_t timer);
+rt_err_t rt_timer_stop(rt_timer_t timer);
+rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg);
+
+/* device */
+rt_device_t rt_device_find(const char *name);
+rt_err_t rt_device_control(rt_device_t dev, int cmd, void *arg);
+rt_err_t rt_device_close(rt_device_t dev);
+
+/* memory and string, they are the C library ones */
+#define rt_malloc(size)                malloc(size)
+#define rt_calloc(count, size)         calloc(count, size)
+#define rt_realloc(ptr, size)          realloc(ptr, size)
+#define rt_free(ptr)                   free(ptr)
+#define rt_memcpy                      memcpy
+#define rt_memmove                     memmove
+#define rt_memset                      memset
+#define rt_memcmp                      memcmp
+#define rt_strlen                      strlen
+#define rt_strnlen                     strnlen
+#define rt_strcmp                      strcmp
+#define rt_strncmp                     strncmp
+#define rt_strcpy                      strcpy
+#define rt_strncpy                     strncpy
+#define rt_strstr                      strstr
+#define rt_strdup                      strdup
+#define rt_strcasecmp                  strcasecmp
+#define rt_sprintf                     sprintf
+#define rt_snprintf                    snprintf
+#define rt_vsnprintf                   vsnprintf
+#define rt_sscanf                      sscanf
+
+int rt_kprintf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RT_THREAD_H__ */
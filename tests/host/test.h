@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __TEST_H__
+#define __TEST_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The test cases of the host test build, a failed check ends the case */
+
+struct test_case
+{
+    const char *name;
+    void (*func)(void);
+};
+
+void test_fail(const char *file, int line, const char *expr, long actual, long expect);
+
+#define TEST_ASSERT(expr)                                                  \
+    do {                                                                   \
+        if (!(expr))                                                       \
+        {                                                                  \
+            test_fail(__FILE__, __LINE__, #expr, 0, 0);                    \
+            return;                                                        \
+        }                                                                  \
+    } while (0)
+
+#define TEST_ASSERT_EQ(actual, expect)                                     \
+    do {                                                                   \
+        long __actual = (long) (actual), __expect = (long) (expect);       \
+        if (__actual != __expect)                                          \
+        {                                                                  \
+            test_fail(__FILE__, __LINE__, #actual " == " #expect,          \
+                      __actual, __expect);                                 \
+            return;                                                        \
+        }                                                                  \
+    } while (0)
+
+#define TEST_ASSERT_STR_EQ(actual, expect)                                 \
+    TEST_ASSERT(rt_strcmp((actual), (expect)) == 0)
+
+/* the test cases of every module, ended by an empty case */
+extern const struct test_case test_core_cases[];
+extern const struct test_case test_esp8266_cases[];
+extern const struct test_case test_ec20_cases[];
+extern const struct test_case test_bc28_cases[];
+extern const struct test_case test_ml307_cases[];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TEST_H__ */
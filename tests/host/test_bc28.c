@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+
+#ifdef AT_DEVICE_USING_BC28
+
+#include <at_device_bc28.h>
+
+#include "host.h"
+#include "test.h"
+#include "emu/modem_bc28.h"
+
+/*
+ * The BC28 cases run the NB-IoT NSO* class against the modem emulator, the
+ * data is hex encoded on the send command lines and in the receive URCs. The
+ * class initialization waits for the module reboot, so it takes seconds.
+ */
+
+#define BC28_SAMPLE_DEIVCE_NAME        "nb0"
+#define BC28_SAMPLE_CLIENT_NAME        "uart_n"
+
+static struct modem_bc28 modem;
+
+static struct at_device_bc28 nb0 =
+{
+    BC28_SAMPLE_DEIVCE_NAME,
+    BC28_SAMPLE_CLIENT_NAME,
+
+    -1,
+    -1,
+    2048,
+};
+
+static int test_bc28_recv_all(int socket, char *buf, size_t len)
+{
+    int result = 0;
+    size_t recved = 0;
+
+    while (recved < len)
+    {
+        result = host_socket_recv(socket, buf + recved, len - recved, 2 * RT_TICK_PER_SECOND);
+        if (result <= 0)
+        {
+            break;
+        }
+        recved += (size_t) result;
+    }
+
+    return (int) recved;
+}
+
+/* the device socket number of the AT socket is the socket of the module */
+static int test_bc28_id(int socket)
+{
+    return (int) (rt_ubase_t) host_socket_get(socket)->user_data;
+}
+
+static int test_bc28_wait_closed(int socket)
+{
+    int i;
+
+    for (i = 0; i < 100 && host_socket_closed(socket) == RT_FALSE; i++)
+    {
+        rt_thread_mdelay(10);
+    }
+
+    return host_socket_closed(socket);
+}
+
+static void test_bc28_register(void)
+{
+    int i;
+
+    TEST_ASSERT_EQ(modem_bc28_open(&modem, 0), 0);
+    TEST_ASSERT_EQ(host_serial_register(BC28_SAMPLE_CLIENT_NAME, modem.emu.slave), RT_EOK);
+
+    TEST_ASSERT_EQ(at_device_register(&(nb0.device), nb0.device_name, nb0.client_name,
+                                      AT_DEVICE_CLASS_BC28, (void *) &nb0), RT_EOK);
+    TEST_ASSERT(nb0.device.is_init);
+    TEST_ASSERT(nb0.device.netdev != RT_NULL);
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+NRB"), 1);
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+NSONMI="), 1);
+
+    /* the link status is set by the polling thread of the class */
+    for (i = 0; i < 100 && netdev_is_link_up(nb0.device.netdev) == RT_FALSE; i++)
+    {
+        rt_thread_mdelay(10);
+    }
+    TEST_ASSERT(netdev_is_link_up(nb0.device.netdev));
+
+    /* the domain resolves go to this device from now on */
+    netdev_set_default(nb0.device.netdev);
+}
+
+static void test_bc28_tcp(void)
+{
+    int i, socket = -1, id = -1;
+    uint32_t sends = 0, sent = 0;
+    static char data[3000], echo[3000];
+
+    for (i = 0; i < (int) sizeof(data); i++)
+    {
+        data[i] = (char) (i * 7 + 1);
+    }
+
+    socket = host_socket_open(&(nb0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.2.10", 7000), RT_EOK);
+    id = test_bc28_id(socket);
+    TEST_ASSERT(modem.connected[id]);
+
+    /* the data larger than one send command is split, every byte is sent as two hex digits */
+    sends = modem_emu_count(&modem.emu, "AT+NSOSD=");
+    sent = modem.sent_bytes;
+    TEST_ASSERT_EQ(host_socket_send(socket, data, sizeof(data)), sizeof(data));
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+NSOSD="), sends + 3);
+    TEST_ASSERT_EQ(modem.sent_bytes - sent, sizeof(data));
+    TEST_ASSERT_EQ(modem.bad_sends, 0);
+
+    /* the echo is decoded from the "+NSONMI" URCs */
+    TEST_ASSERT_EQ(test_bc28_recv_all(socket, echo, sizeof(echo)), sizeof(echo));
+    TEST_ASSERT(rt_memcmp(data, echo, sizeof(echo)) == 0);
+
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+    TEST_ASSERT_EQ(modem.created[id], 0);
+}
+
+static void test_bc28_udp(void)
+{
+    int socket = -1, id = -1;
+    uint32_t closes = 0;
+    char echo[32] = {0};
+
+    socket = host_socket_open(&(nb0.device), AT_SOCKET_UDP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.2.20", 7001), RT_EOK);
+    id = test_bc28_id(socket);
+
+    /* the datagram names the peer in every send command */
+    TEST_ASSERT_EQ(host_socket_send(socket, "datagram", 8), 8);
+    TEST_ASSERT_STR_EQ(modem.remote_ip[id], "10.64.2.20");
+    TEST_ASSERT_EQ(modem.remote_port[id], 7001);
+    TEST_ASSERT_EQ(test_bc28_recv_all(socket, echo, 8), 8);
+    TEST_ASSERT(rt_memcmp(echo, "datagram", 8) == 0);
+
+    closes = modem_emu_count(&modem.emu, "AT+NSOCL=");
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+NSOCL="), closes + 1);
+}
+
+static void test_bc28_remote_close(void)
+{
+    int socket = -1;
+
+    socket = host_socket_open(&(nb0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.2.10", 7002), RT_EOK);
+
+    modem_bc28_remote_close(&modem, test_bc28_id(socket));
+    TEST_ASSERT(test_bc28_wait_closed(socket));
+
+    at_closesocket(socket);
+}
+
+static void test_bc28_connect_fail(void)
+{
+    int socket = -1;
+
+    modem_bc28_connect_fail(&modem, "10.64.2.99");
+
+    socket = host_socket_open(&(nb0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT(host_socket_connect(socket, "10.64.2.99", 7003) < 0);
+    at_closesocket(socket);
+
+    /* the module is usable after the failed connect */
+    socket = host_socket_open(&(nb0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.2.10", 7003), RT_EOK);
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+}
+
+static void test_bc28_domain_resolve(void)
+{
+    char ip[16] = {0};
+    uint32_t resolves = 0;
+
+    modem_bc28_domain_add(&modem, "nb.example", "93.184.216.36");
+
+    resolves = modem_emu_count(&modem.emu, "AT+QDNS=");
+    TEST_ASSERT_EQ(host_domain_resolve(&(nb0.device), "nb.example", ip), RT_EOK);
+    TEST_ASSERT_STR_EQ(ip, "93.184.216.36");
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+QDNS="), resolves + 1);
+
+    TEST_ASSERT(host_domain_resolve(&(nb0.device), "nx.example", ip) < 0);
+}
+
+const struct test_case test_bc28_cases[] =
+{
+    {"bc28_register",          test_bc28_register},
+    {"bc28_tcp",               test_bc28_tcp},
+    {"bc28_udp",               test_bc28_udp},
+    {"bc28_remote_close",      test_bc28_remote_close},
+    {"bc28_connect_fail",      test_bc28_connect_fail},
+    {"bc28_domain_resolve",    test_bc28_domain_resolve},
+    {RT_NULL,                  RT_NULL},
+};
+
+#endif /* AT_DEVICE_USING_BC28 */
@@ -0,0 +1,647 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdio.h>
+
+#include <at_device.h>
+
+#include "host.h"
+#include "test.h"
+
+/*
+ * The core cases run on a fake device class answering without module, they
+ * cover the send completion queue, the TCP send window, the DNS cache and the
+ * completion events of the sockets under concurrent operations.
+ */
+
+#define FAKE_CLASS_ID                  0x7F
+#define FAKE_SOCKET_NUM                5
+#define FAKE_SEND_WINDOW               4096
+#define FAKE_FAIL_IP                   "10.0.1.1"
+#define FAKE_SLOW_MS                   200
+
+/* the stress device has more sockets than the 16 event bits once held, every
+ * socket waits for its completions while two URC threads send them */
+#define FAKE_STRESS_CLASS_ID           0x7E
+#define FAKE_STRESS_SOCKET_NUM         32
+#define FAKE_STRESS_URC_NUM            2
+#define FAKE_STRESS_ROUNDS             200
+#define FAKE_EVENT_OK                  (1L << 0)
+#define FAKE_EVENT_FAIL                (1L << 1)
+/* the completion carries the socket it's sent for */
+#define FAKE_EVENT_TAG(socket)         (((socket) + 1L) << 8)
+#define FAKE_EVENT_ALL                 (FAKE_EVENT_OK | FAKE_EVENT_FAIL | (0xFFFFL << 8))
+
+static struct at_device fake_device;
+static struct netdev fake_netdev;
+
+static int fake_resolves = 0;
+static size_t fake_acked = 0, fake_unacked = 0;
+static int fake_ack_error = 0;
+
+/* the completions of the asynchronous resolves in completion order */
+struct fake_dns_done
+{
+    int id;
+    int result;
+    rt_thread_t thread;
+};
+
+static struct fake_dns_done fake_dns_done[4];
+static int fake_dns_done_num = 0;
+static rt_sem_t fake_dns_sem = RT_NULL;
+
+static int fake_init(struct at_device *device)
+{
+    return RT_EOK;
+}
+
+static const struct at_device_ops fake_device_ops =
+{
+    fake_init,
+    RT_NULL,
+    RT_NULL,
+};
+
+static int fake_connect(struct at_socket *socket, char *ip, int32_t port,
+        enum at_socket_type type, rt_bool_t is_client)
+{
+    return rt_strcmp(ip, FAKE_FAIL_IP) == 0 ? -RT_ERROR : RT_EOK;
+}
+
+static int fake_closesocket(struct at_socket *socket)
+{
+    return RT_EOK;
+}
+
+static int fake_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+{
+    return (int) bfsz;
+}
+
+static void fake_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
+{
+}
+
+static const struct at_socket_ops fake_socket_ops =
+{
+    fake_connect,
+    fake_closesocket,
+    fake_send,
+    RT_NULL,
+    fake_set_event_cb,
+    RT_NULL,
+};
+
+/* the names tell the fake answer: "fail" fails, "multi" has three addresses,
+ * "ttl" lives 10 seconds, "huge" reports the largest TTL and "slow" takes
+ * FAKE_SLOW_MS to answer */
+static int fake_domain_resolve(struct at_device *device, const char *name, char ip[16])
+{
+    fake_resolves++;
+
+    if (rt_strncmp(name, "slow", 4) == 0)
+    {
+        rt_thread_mdelay(FAKE_SLOW_MS);
+    }
+
+    if (rt_strncmp(name, "fail", 4) == 0)
+    {
+        return -RT_ERROR;
+    }
+
+    if (rt_strncmp(name, "multi", 5) == 0)
+    {
+        at_device_dns_addr_add(device, FAKE_FAIL_IP);
+        at_device_dns_addr_add(device, "10.0.1.2");
+        at_device_dns_addr_add(device, "10.0.1.3");
+        return RT_EOK;
+    }
+
+    if (rt_strncmp(name, "ttl", 3) == 0)
+    {
+        device->dns_ttl = 10;
+    }
+    else if (rt_strncmp(name, "huge", 4) == 0)
+    {
+        device->dns_ttl = 0xFFFFFFFF;
+    }
+
+    rt_snprintf(ip, 16, "10.0.0.%d", fake_resolves);
+
+    return RT_EOK;
+}
+
+static int fake_send_ack(struct at_device *device, int device_socket, size_t *acked, size_t *unacked)
+{
+    if (fake_ack_error)
+    {
+        return -RT_ERROR;
+    }
+
+    *acked = fake_acked;
+    *unacked = fake_unacked;
+
+    return RT_EOK;
+}
+
+static void fake_resolve_cb(int id, const char *name, int result, const char *ip, void *user_data)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (fake_dns_done_num < (int) (sizeof(fake_dns_done) / sizeof(fake_dns_done[0])))
+    {
+        fake_dns_done[fake_dns_done_num].id = id;
+        fake_dns_done[fake_dns_done_num].result = result;
+        fake_dns_done[fake_dns_done_num].thread = rt_thread_self();
+        fake_dns_done_num++;
+    }
+    rt_hw_interrupt_enable(level);
+
+    rt_sem_release(fake_dns_sem);
+}
+
+static void fake_resolve_reset(void)
+{
+    if (fake_dns_sem == RT_NULL)
+    {
+        fake_dns_sem = rt_sem_create("fk_dns", 0, RT_IPC_FLAG_FIFO);
+    }
+    fake_dns_done_num = 0;
+}
+
+static struct at_device_class fake_class;
+
+static void test_core_dns_early(void)
+{
+    int id = 0;
+
+    /* the asynchronous resolve before any class registered, no device answers */
+    fake_resolve_reset();
+    id = at_device_domain_resolve_async("early.example", fake_resolve_cb, RT_NULL);
+    TEST_ASSERT(id > 0);
+    TEST_ASSERT_EQ(rt_sem_take(fake_dns_sem, 5 * RT_TICK_PER_SECOND), RT_EOK);
+    TEST_ASSERT_EQ(fake_dns_done[0].id, id);
+    TEST_ASSERT(fake_dns_done[0].result < 0);
+}
+
+static void test_core_register(void)
+{
+    fake_class.device_ops = &fake_device_ops;
+    fake_class.socket_num = FAKE_SOCKET_NUM;
+    fake_class.recv_mtu = 1460;
+    fake_class.socket_ops = &fake_socket_ops;
+    fake_class.domain_resolve = fake_domain_resolve;
+    fake_class.send_window = FAKE_SEND_WINDOW;
+    fake_class.send_ack = fake_send_ack;
+    TEST_ASSERT_EQ(at_device_class_register(&fake_class, FAKE_CLASS_ID), RT_EOK);
+
+    /* the fake device owns the default network interface in the core cases */
+    TEST_ASSERT_EQ(netdev_register(&fake_netdev, "fk0", RT_NULL), RT_EOK);
+    netdev_low_level_set_status(&fake_netdev, RT_TRUE);
+    netdev_low_level_set_link_status(&fake_netdev, RT_TRUE);
+    netdev_set_default(&fake_netdev);
+
+    TEST_ASSERT_EQ(at_device_register(&fake_device, "fk0", "fk_client", FAKE_CLASS_ID, RT_NULL), RT_EOK);
+    fake_device.netdev = &fake_netdev;
+    TEST_ASSERT(fake_device.is_init);
+    TEST_ASSERT(fake_device.send_windows != RT_NULL);
+    TEST_ASSERT(at_device_get_by_name(AT_DEVICE_NAMETYPE_NETDEV, "fk0") == &fake_device);
+}
+
+static void test_core_send_queue(void)
+{
+    int i;
+
+    TEST_ASSERT_EQ(at_device_socket_send_pop(&fake_device), -1);
+
+    /* the sends complete in issue order, the queue keeps room for the cancelled sends */
+    for (i = 0; i < FAKE_SOCKET_NUM * 2; i++)
+    {
+        TEST_ASSERT_EQ(at_device_socket_send_push(&fake_device, (i * 3) % FAKE_SOCKET_NUM), RT_EOK);
+    }
+    TEST_ASSERT_EQ(at_device_socket_send_push(&fake_device, 0), -RT_EFULL);
+
+    for (i = 0; i < FAKE_SOCKET_NUM * 2; i++)
+    {
+        TEST_ASSERT_EQ(at_device_socket_send_pop(&fake_device), (i * 3) % FAKE_SOCKET_NUM);
+    }
+    TEST_ASSERT_EQ(at_device_socket_send_pop(&fake_device), -1);
+
+    /* the given up send is removed from the middle of the wrapped queue */
+    for (i = 0; i < FAKE_SOCKET_NUM * 2 - 1; i++)
+    {
+        TEST_ASSERT_EQ(at_device_socket_send_push(&fake_device, 1), RT_EOK);
+        TEST_ASSERT_EQ(at_device_socket_send_pop(&fake_device), 1);
+    }
+    for (i = 0; i < FAKE_SOCKET_NUM; i++)
+    {
+        TEST_ASSERT_EQ(at_device_socket_send_push(&fake_device, i), RT_EOK);
+    }
+    at_device_socket_send_remove(&fake_device, 2);
+    at_device_socket_send_remove(&fake_device, 2);
+
+    TEST_ASSERT_EQ(at_device_socket_send_pop(&fake_device), 0);
+    TEST_ASSERT_EQ(at_device_socket_send_pop(&fake_device), 1);
+    TEST_ASSERT_EQ(at_device_socket_send_pop(&fake_device), 3);
+    TEST_ASSERT_EQ(at_device_socket_send_pop(&fake_device), 4);
+    TEST_ASSERT_EQ(at_device_socket_send_pop(&fake_device), -1);
+
+    /* the late result of the timed out send doesn't complete the next send */
+    TEST_ASSERT_EQ(at_device_socket_send_push(&fake_device, 1), RT_EOK);
+    TEST_ASSERT_EQ(at_device_socket_send_push(&fake_device, 2), RT_EOK);
+    at_device_socket_send_cancel(&fake_device, 1, 1000);
+    TEST_ASSERT_EQ(at_device_socket_send_pop(&fake_device), -1);
+    TEST_ASSERT_EQ(at_device_socket_send_pop(&fake_device), 2);
+
+    /* the cancelled send whose result never comes is dropped after the timeout */
+    TEST_ASSERT_EQ(at_device_socket_send_push(&fake_device, 3), RT_EOK);
+    at_device_socket_send_cancel(&fake_device, 3, 1000);
+    TEST_ASSERT_EQ(at_device_socket_send_push(&fake_device, 4), RT_EOK);
+    host_tick_advance(1000);
+    TEST_ASSERT_EQ(at_device_socket_send_pop(&fake_device), 4);
+    TEST_ASSERT_EQ(at_device_socket_send_pop(&fake_device), -1);
+}
+
+static void test_core_resp_pool(void)
+{
+    at_response_t resp = RT_NULL, other = RT_NULL;
+
+    /* the buffer resized by at_resp_set_info() is restored when the object is returned */
+    resp = at_device_resp_get(&fake_device, 100, 0, RT_TICK_PER_SECOND);
+    TEST_ASSERT(resp != RT_NULL);
+    TEST_ASSERT_EQ(resp->buf_size, AT_DEVICE_RESP_POOL_SMALL_SIZE);
+    TEST_ASSERT(at_resp_set_info(resp, 1024, 2, RT_TICK_PER_SECOND) == resp);
+    at_device_resp_put(&fake_device, resp);
+
+    /* no pool object is large enough, a new one is created */
+    other = at_device_resp_get(&fake_device, 1000, 0, RT_TICK_PER_SECOND);
+    TEST_ASSERT(other != RT_NULL && other != resp);
+    TEST_ASSERT_EQ(other->buf_size, 1000);
+    at_device_resp_put(&fake_device, other);
+
+    other = at_device_resp_get(&fake_device, 100, 0, RT_TICK_PER_SECOND);
+    TEST_ASSERT(other == resp);
+    TEST_ASSERT_EQ(other->buf_size, AT_DEVICE_RESP_POOL_SMALL_SIZE);
+    TEST_ASSERT_EQ(other->line_num, 0);
+    at_device_resp_put(&fake_device, other);
+}
+
+static void test_core_send_window(void)
+{
+    int i;
+    struct at_device_stats stats;
+    rt_uint32_t polls = 0, stalls = 0;
+
+    at_device_stats_get(&fake_device, &stats);
+    polls = stats.window_polls;
+    stalls = stats.window_stalls;
+
+    /* the module isn't asked while the packets fit into the window */
+    at_device_send_window_reset(&fake_device, 0);
+    for (i = 0; i < 4; i++)
+    {
+        TEST_ASSERT_EQ(at_device_send_window_wait(&fake_device, 0, 1000, 100), RT_EOK);
+        at_device_send_window_sent(&fake_device, 0, 1000);
+    }
+    at_device_stats_get(&fake_device, &stats);
+    TEST_ASSERT_EQ(stats.window_polls, polls);
+
+    /* the window is exhausted, the acknowledged bytes make room */
+    fake_ack_error = 0;
+    fake_acked = 2000;
+    fake_unacked = 2000;
+    TEST_ASSERT_EQ(at_device_send_window_wait(&fake_device, 0, 1000, 100), RT_EOK);
+    at_device_stats_get(&fake_device, &stats);
+    TEST_ASSERT_EQ(stats.window_polls, polls + 1);
+    TEST_ASSERT_EQ(stats.window_stalls, stalls);
+    TEST_ASSERT_EQ(fake_device.send_windows[0].acked, 2000);
+
+    /* the peer doesn't acknowledge */
+    fake_acked = 0;
+    fake_unacked = FAKE_SEND_WINDOW;
+    at_device_send_window_reset(&fake_device, 1);
+    at_device_send_window_sent(&fake_device, 1, FAKE_SEND_WINDOW);
+    TEST_ASSERT_EQ(at_device_send_window_wait(&fake_device, 1, 1000, 50), -RT_ETIMEOUT);
+    at_device_stats_get(&fake_device, &stats);
+    TEST_ASSERT_EQ(stats.window_stalls, stalls + 1);
+
+    /* the window is not kept when the module doesn't report */
+    fake_ack_error = 1;
+    TEST_ASSERT_EQ(at_device_send_window_wait(&fake_device, 1, 1000, 50), RT_EOK);
+    TEST_ASSERT_EQ(fake_device.send_windows[1].acked, fake_device.send_windows[1].sent);
+    fake_ack_error = 0;
+
+    /* the sockets out of the class range have no window */
+    TEST_ASSERT_EQ(at_device_send_window_wait(&fake_device, FAKE_SOCKET_NUM, 1 << 20, 0), RT_EOK);
+}
+
+static void test_core_dns_cache(void)
+{
+    int resolves = 0;
+    char ip[16] = {0}, ip_hit[16] = {0};
+
+    TEST_ASSERT_EQ(host_domain_resolve(&fake_device, "hit.example", ip), RT_EOK);
+    resolves = fake_resolves;
+
+    /* the cached name is answered without the module */
+    TEST_ASSERT_EQ(host_domain_resolve(&fake_device, "hit.example", ip_hit), RT_EOK);
+    TEST_ASSERT_EQ(fake_resolves, resolves);
+    TEST_ASSERT_STR_EQ(ip_hit, ip);
+
+    /* the TTL reported by the module */
+    TEST_ASSERT_EQ(host_domain_resolve(&fake_device, "ttl.example", ip), RT_EOK);
+    resolves = fake_resolves;
+    host_tick_advance(9 * 1000);
+    TEST_ASSERT_EQ(host_domain_resolve(&fake_device, "ttl.example", ip), RT_EOK);
+    TEST_ASSERT_EQ(fake_resolves, resolves);
+    host_tick_advance(2 * 1000);
+    TEST_ASSERT_EQ(host_domain_resolve(&fake_device, "ttl.example", ip), RT_EOK);
+    TEST_ASSERT_EQ(fake_resolves, resolves + 1);
+}
+
+static void test_core_dns_ttl_clamp(void)
+{
+    int resolves = 0;
+    char ip[16] = {0};
+
+    /* the largest TTL is clamped, it doesn't overflow the expire tick */
+    TEST_ASSERT_EQ(host_domain_resolve(&fake_device, "huge.example", ip), RT_EOK);
+    resolves = fake_resolves;
+    host_tick_advance(1000 * 1000);
+    TEST_ASSERT_EQ(host_domain_resolve(&fake_device, "huge.example", ip), RT_EOK);
+    TEST_ASSERT_EQ(fake_resolves, resolves);
+}
+
+static void test_core_dns_negative(void)
+{
+    int resolves = 0;
+    char ip[16] = {0};
+
+    TEST_ASSERT(host_domain_resolve(&fake_device, "fail.example", ip) < 0);
+    resolves = fake_resolves;
+
+    /* the failed resolve is cached for a short time */
+    TEST_ASSERT(host_domain_resolve(&fake_device, "fail.example", ip) < 0);
+    TEST_ASSERT_EQ(fake_resolves, resolves);
+
+    host_tick_advance(5 * 1000 + 1);
+    TEST_ASSERT(host_domain_resolve(&fake_device, "fail.example", ip) < 0);
+    TEST_ASSERT_EQ(fake_resolves, resolves + 1);
+}
+
+static void test_core_dns_lru(void)
+{
+    int i, resolves = 0;
+    char name[16] = {0};
+    char addrs[AT_DEVICE_DNS_ADDR_NUM][AT_DEVICE_DNS_ADDR_LEN];
+
+    /* the new names replace all entries of the former cases */
+    host_tick_advance(1);
+    for (i = 0; i < 8; i++)
+    {
+        rt_snprintf(name, sizeof(name), "lru%d.example", i);
+        TEST_ASSERT_EQ(at_device_domain_resolve_all(name, addrs, AT_DEVICE_DNS_ADDR_NUM), 1);
+        host_tick_advance(1);
+    }
+    resolves = fake_resolves;
+
+    /* the used name is kept and the least recently used one is replaced */
+    TEST_ASSERT_EQ(at_device_domain_resolve_all("lru0.example", addrs, AT_DEVICE_DNS_ADDR_NUM), 1);
+    host_tick_advance(1);
+    TEST_ASSERT_EQ(at_device_domain_resolve_all("lru8.example", addrs, AT_DEVICE_DNS_ADDR_NUM), 1);
+    TEST_ASSERT_EQ(fake_resolves, resolves + 1);
+    host_tick_advance(1);
+
+    TEST_ASSERT_EQ(at_device_domain_resolve_all("lru0.example", addrs, AT_DEVICE_DNS_ADDR_NUM), 1);
+    TEST_ASSERT_EQ(fake_resolves, resolves + 1);
+    TEST_ASSERT_EQ(at_device_domain_resolve_all("lru1.example", addrs, AT_DEVICE_DNS_ADDR_NUM), 1);
+    TEST_ASSERT_EQ(fake_resolves, resolves + 2);
+}
+
+static void test_core_dns_demote(void)
+{
+    int resolves = 0;
+    char ip[16] = {0};
+    char addrs[AT_DEVICE_DNS_ADDR_NUM][AT_DEVICE_DNS_ADDR_LEN];
+    struct at_socket sock;
+
+    TEST_ASSERT_EQ(at_device_domain_resolve_all("multi.example", addrs, AT_DEVICE_DNS_ADDR_NUM), 3);
+    TEST_ASSERT_STR_EQ(addrs[0], FAKE_FAIL_IP);
+    resolves = fake_resolves;
+
+    /* the failed connect moves the address behind the others */
+    rt_memset(&sock, 0x00, sizeof(sock));
+    sock.device = &fake_device;
+    sock.type = AT_SOCKET_TCP;
+    sock.user_data = (void *) 0;
+    TEST_ASSERT(fake_class.socket_ops->at_connect(&sock, FAKE_FAIL_IP, 80, AT_SOCKET_TCP, RT_TRUE) < 0);
+
+    TEST_ASSERT_EQ(at_device_domain_resolve_all("multi.example", addrs, AT_DEVICE_DNS_ADDR_NUM), 3);
+    TEST_ASSERT_EQ(fake_resolves, resolves);
+    TEST_ASSERT_STR_EQ(addrs[0], "10.0.1.2");
+    TEST_ASSERT_STR_EQ(addrs[1], "10.0.1.3");
+    TEST_ASSERT_STR_EQ(addrs[2], FAKE_FAIL_IP);
+
+    TEST_ASSERT_EQ(host_domain_resolve(&fake_device, "multi.example", ip), RT_EOK);
+    TEST_ASSERT_STR_EQ(ip, "10.0.1.2");
+
+    /* the caller buffer smaller than the reported addresses */
+    TEST_ASSERT_EQ(at_device_domain_resolve_all("multi.example", addrs, 1), 1);
+    TEST_ASSERT_STR_EQ(addrs[0], "10.0.1.2");
+}
+
+static void test_core_dns_async(void)
+{
+    int i, resolves = 0;
+    int id_hit = 0, id_slow = 0, id_same = 0;
+    char ip[16] = {0};
+
+    TEST_ASSERT_EQ(host_domain_resolve(&fake_device, "async.example", ip), RT_EOK);
+    fake_resolve_reset();
+
+    /* the cached name completes in the resolve thread, not before the id is returned */
+    id_hit = at_device_domain_resolve_async("async.example", fake_resolve_cb, RT_NULL);
+    TEST_ASSERT(id_hit > 0);
+    TEST_ASSERT_EQ(rt_sem_take(fake_dns_sem, 5 * RT_TICK_PER_SECOND), RT_EOK);
+    TEST_ASSERT_EQ(fake_dns_done[0].id, id_hit);
+    TEST_ASSERT_EQ(fake_dns_done[0].result, RT_EOK);
+    TEST_ASSERT(fake_dns_done[0].thread != rt_thread_self());
+
+    /* the cached name doesn't wait for the slow one, and the same slow name is resolved once */
+    fake_resolve_reset();
+    resolves = fake_resolves;
+    id_slow = at_device_domain_resolve_async("slow.example", fake_resolve_cb, RT_NULL);
+    id_hit = at_device_domain_resolve_async("async.example", fake_resolve_cb, RT_NULL);
+    id_same = at_device_domain_resolve_async("slow.example", fake_resolve_cb, RT_NULL);
+    TEST_ASSERT(id_slow > 0 && id_hit > 0 && id_same > 0);
+    for (i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_EQ(rt_sem_take(fake_dns_sem, 5 * RT_TICK_PER_SECOND), RT_EOK);
+    }
+    TEST_ASSERT_EQ(fake_dns_done_num, 3);
+    TEST_ASSERT_EQ(fake_dns_done[0].id, id_hit);
+    TEST_ASSERT_EQ(fake_dns_done[1].result, RT_EOK);
+    TEST_ASSERT_EQ(fake_dns_done[2].result, RT_EOK);
+    TEST_ASSERT_EQ(fake_resolves, resolves + 1);
+}
+
+static struct at_device_class fake_stress_class;
+static struct at_device fake_stress_device;
+
+/* the operations waiting for their completion, the socket and the round */
+struct fake_stress_req
+{
+    int socket;
+    int round;
+};
+
+static rt_mq_t fake_stress_mq = RT_NULL;
+static rt_sem_t fake_stress_sem = RT_NULL;
+static int fake_stress_done[FAKE_STRESS_SOCKET_NUM];
+static int fake_stress_lost[FAKE_STRESS_SOCKET_NUM];
+static int fake_stress_crossed[FAKE_STRESS_SOCKET_NUM];
+
+/* the completion of the round, OK and FAIL in turn */
+static uint32_t fake_stress_event(int socket, int round)
+{
+    return FAKE_EVENT_TAG(socket) | ((round & 1) ? FAKE_EVENT_FAIL : FAKE_EVENT_OK);
+}
+
+/* the URC thread completes the operations of all sockets in the request order */
+static void fake_stress_urc_entry(void *parameter)
+{
+    struct fake_stress_req req;
+
+    while (rt_mq_recv(fake_stress_mq, &req, sizeof(req), RT_WAITING_FOREVER) > 0 && req.socket >= 0)
+    {
+        at_device_socket_event_send(&fake_stress_device, req.socket, fake_stress_event(req.socket, req.round));
+    }
+
+    rt_sem_release(fake_stress_sem);
+}
+
+/* the socket thread issues one operation at a time and waits for its completion */
+static void fake_stress_socket_entry(void *parameter)
+{
+    int round, recved = 0;
+    struct fake_stress_req req;
+
+    req.socket = (int) (rt_ubase_t) parameter;
+    for (round = 0; round < FAKE_STRESS_ROUNDS; round++)
+    {
+        req.round = round;
+        rt_mq_send(fake_stress_mq, &req, sizeof(req));
+
+        recved = at_device_socket_event_recv(&fake_stress_device, req.socket, FAKE_EVENT_ALL,
+                                             RT_TICK_PER_SECOND, RT_EVENT_FLAG_OR);
+        if (recved < 0)
+        {
+            fake_stress_lost[req.socket]++;
+        }
+        else if ((uint32_t) recved != fake_stress_event(req.socket, round))
+        {
+            fake_stress_crossed[req.socket]++;
+        }
+        else
+        {
+            fake_stress_done[req.socket]++;
+        }
+    }
+
+    rt_sem_release(fake_stress_sem);
+}
+
+static void test_core_socket_events(void)
+{
+    int i, lost = 0, crossed = 0, done = 0;
+    char name[RT_NAME_MAX] = {0};
+    rt_thread_t thread = RT_NULL;
+    rt_uint64_t start = 0;
+    struct fake_stress_req stop = {-1, 0};
+
+    /* the stress device isn't selected for the domain resolve, its class has none */
+    fake_stress_class.device_ops = &fake_device_ops;
+    fake_stress_class.socket_num = FAKE_STRESS_SOCKET_NUM;
+    fake_stress_class.socket_ops = &fake_socket_ops;
+    TEST_ASSERT_EQ(at_device_class_register(&fake_stress_class, FAKE_STRESS_CLASS_ID), RT_EOK);
+    TEST_ASSERT_EQ(at_device_register(&fake_stress_device, "fs0", "fs_client", FAKE_STRESS_CLASS_ID, RT_NULL), RT_EOK);
+
+    fake_stress_mq = rt_mq_create("fk_stress", sizeof(struct fake_stress_req),
+                                  FAKE_STRESS_SOCKET_NUM + FAKE_STRESS_URC_NUM, RT_IPC_FLAG_FIFO);
+    fake_stress_sem = rt_sem_create("fk_stress", 0, RT_IPC_FLAG_FIFO);
+    TEST_ASSERT(fake_stress_mq != RT_NULL && fake_stress_sem != RT_NULL);
+
+    start = host_time_us();
+    for (i = 0; i < FAKE_STRESS_URC_NUM; i++)
+    {
+        rt_snprintf(name, RT_NAME_MAX, "fk_urc%d", i);
+        thread = rt_thread_create(name, fake_stress_urc_entry, RT_NULL, 1024, 10, 5);
+        TEST_ASSERT(thread != RT_NULL);
+        rt_thread_startup(thread);
+    }
+    for (i = 0; i < FAKE_STRESS_SOCKET_NUM; i++)
+    {
+        rt_snprintf(name, RT_NAME_MAX, "fk_so%d", i);
+        thread = rt_thread_create(name, fake_stress_socket_entry, (void *) (rt_ubase_t) i, 1024, 10, 5);
+        TEST_ASSERT(thread != RT_NULL);
+        rt_thread_startup(thread);
+    }
+
+    for (i = 0; i < FAKE_STRESS_SOCKET_NUM; i++)
+    {
+        TEST_ASSERT_EQ(rt_sem_take(fake_stress_sem, 30 * RT_TICK_PER_SECOND), RT_EOK);
+    }
+    for (i = 0; i < FAKE_STRESS_URC_NUM; i++)
+    {
+        rt_mq_send(fake_stress_mq, &stop, sizeof(stop));
+    }
+    for (i = 0; i < FAKE_STRESS_URC_NUM; i++)
+    {
+        TEST_ASSERT_EQ(rt_sem_take(fake_stress_sem, 5 * RT_TICK_PER_SECOND), RT_EOK);
+    }
+
+    for (i = 0; i < FAKE_STRESS_SOCKET_NUM; i++)
+    {
+        lost += fake_stress_lost[i];
+        crossed += fake_stress_crossed[i];
+        done += fake_stress_done[i];
+
+        /* no completion is left behind for the next operation */
+        TEST_ASSERT_EQ(at_device_socket_event_recv(&fake_stress_device, i, FAKE_EVENT_ALL, 0, RT_EVENT_FLAG_OR),
+                       -RT_ETIMEOUT);
+    }
+    printf("    %d completions on %d sockets in %d ms\n", done, FAKE_STRESS_SOCKET_NUM,
+           (int) ((host_time_us() - start) / 1000));
+    TEST_ASSERT_EQ(lost, 0);
+    TEST_ASSERT_EQ(crossed, 0);
+    TEST_ASSERT_EQ(done, FAKE_STRESS_SOCKET_NUM * FAKE_STRESS_ROUNDS);
+
+    rt_mq_delete(fake_stress_mq);
+    rt_sem_delete(fake_stress_sem);
+}
+
+const struct test_case test_core_cases[] =
+{
+    {"core_dns_early",         test_core_dns_early},
+    {"core_register",          test_core_register},
+    {"core_send_queue",        test_core_send_queue},
+    {"core_resp_pool",         test_core_resp_pool},
+    {"core_send_window",       test_core_send_window},
+    {"core_socket_events",     test_core_socket_events},
+    {"core_dns_cache",         test_core_dns_cache},
+    {"core_dns_ttl_clamp",     test_core_dns_ttl_clamp},
+    {"core_dns_negative",      test_core_dns_negative},
+    {"core_dns_lru",           test_core_dns_lru},
+    {"core_dns_demote",        test_core_dns_demote},
+    {"core_dns_async",         test_core_dns_async},
+    {RT_NULL,                  RT_NULL},
+};
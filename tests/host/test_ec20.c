@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdio.h>
+
+#include <rtthread.h>
+
+#ifdef AT_DEVICE_USING_EC20
+
+#include <at_device_ec20.h>
+
+#include "host.h"
+#include "test.h"
+#include "emu/modem_ec20.h"
+
+/*
+ * The EC20 cases run the Quectel QIOPEN/QISEND class against the modem
+ * emulator, the received data is pushed by the module or read by the pull
+ * engine depending on AT_DEVICE_EC20_RECV_PULL of the test variant. The link
+ * status follows the registration reports, the lost packet data context is
+ * activated again by the link thread, and with AT_DEVICE_USING_FAILOVER the
+ * sockets fail over to the ESP8266 device of the ESP8266 cases.
+ */
+
+#define EC20_SAMPLE_DEIVCE_NAME        "ec0"
+#define EC20_SAMPLE_CLIENT_NAME        "uart_q"
+
+static struct modem_ec20 modem;
+
+static struct at_device_ec20 ec0 =
+{
+    EC20_SAMPLE_DEIVCE_NAME,
+    EC20_SAMPLE_CLIENT_NAME,
+
+    -1,
+    -1,
+    512,
+};
+
+static int test_ec20_recv_all(int socket, char *buf, size_t len)
+{
+    int result = 0;
+    size_t recved = 0;
+
+    while (recved < len)
+    {
+        result = host_socket_recv(socket, buf + recved, len - recved, 2 * RT_TICK_PER_SECOND);
+        if (result <= 0)
+        {
+            break;
+        }
+        recved += (size_t) result;
+    }
+
+    return (int) recved;
+}
+
+/* the device socket number of the AT socket is the connection ID of the module */
+static int test_ec20_id(int socket)
+{
+    return (int) (rt_ubase_t) host_socket_get(socket)->user_data;
+}
+
+static int test_ec20_wait_closed(int socket)
+{
+    int i;
+
+    for (i = 0; i < 100 && host_socket_closed(socket) == RT_FALSE; i++)
+    {
+        rt_thread_mdelay(10);
+    }
+
+    return host_socket_closed(socket);
+}
+
+/* the link status is set by the link thread after the report */
+static rt_bool_t test_ec20_wait_link(rt_bool_t up)
+{
+    int i;
+
+    for (i = 0; i < 100 && netdev_is_link_up(ec0.device.netdev) != up; i++)
+    {
+        rt_thread_mdelay(10);
+    }
+
+    return netdev_is_link_up(ec0.device.netdev) == up;
+}
+
+static void test_ec20_register(void)
+{
+    TEST_ASSERT_EQ(modem_ec20_open(&modem, 0), 0);
+    TEST_ASSERT_EQ(host_serial_register(EC20_SAMPLE_CLIENT_NAME, modem.emu.slave), RT_EOK);
+
+    TEST_ASSERT_EQ(at_device_register(&(ec0.device), ec0.device_name, ec0.client_name,
+                                      AT_DEVICE_CLASS_EC20, (void *) &ec0), RT_EOK);
+    TEST_ASSERT(ec0.device.is_init);
+    TEST_ASSERT(ec0.device.netdev != RT_NULL);
+    TEST_ASSERT(modem.context);
+    TEST_ASSERT_EQ(modem.reg_report, 1);
+    TEST_ASSERT(test_ec20_wait_link(RT_TRUE));
+
+    /* the domain resolves go to this device from now on */
+    netdev_set_default(ec0.device.netdev);
+}
+
+static void test_ec20_tcp(void)
+{
+    int i, socket = -1, id = -1;
+    uint32_t sends = 0;
+    static char data[3000], echo[3000];
+
+    for (i = 0; i < (int) sizeof(data); i++)
+    {
+        data[i] = (char) (i * 7 + 1);
+    }
+
+    socket = host_socket_open(&(ec0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.1.10", 6000), RT_EOK);
+    id = test_ec20_id(socket);
+    TEST_ASSERT(modem.connected[id]);
+#ifdef AT_DEVICE_EC20_RECV_PULL
+    TEST_ASSERT_EQ(modem.push[id], 0);
+#else
+    TEST_ASSERT_EQ(modem.push[id], 1);
+#endif
+
+    /* the data larger than one send command is split, the window holds it all */
+    sends = modem_emu_count(&modem.emu, "AT+QISEND=");
+    TEST_ASSERT_EQ(host_socket_send(socket, data, sizeof(data)), sizeof(data));
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+QISEND="), sends + 3);
+    TEST_ASSERT_EQ(modem.sent[id], sizeof(data));
+
+    TEST_ASSERT_EQ(test_ec20_recv_all(socket, echo, sizeof(echo)), sizeof(echo));
+    TEST_ASSERT(rt_memcmp(data, echo, sizeof(echo)) == 0);
+
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+    TEST_ASSERT_EQ(modem.connected[id], 0);
+}
+
+static void test_ec20_udp(void)
+{
+    int socket = -1;
+    uint32_t closes = 0;
+    char echo[32] = {0};
+
+    socket = host_socket_open(&(ec0.device), AT_SOCKET_UDP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.1.20", 6001), RT_EOK);
+
+    TEST_ASSERT_EQ(host_socket_send(socket, "datagram", 8), 8);
+    TEST_ASSERT_EQ(test_ec20_recv_all(socket, echo, 8), 8);
+    TEST_ASSERT(rt_memcmp(echo, "datagram", 8) == 0);
+
+    closes = modem_emu_count(&modem.emu, "AT+QICLOSE=");
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+QICLOSE="), closes + 1);
+}
+
+static void test_ec20_send_window(void)
+{
+    int i, socket = -1;
+    uint32_t sends = 0;
+    static char data[8 * 1460], echo[8 * 1460];
+
+    for (i = 0; i < (int) sizeof(data); i++)
+    {
+        data[i] = (char) (i * 13 + 5);
+    }
+
+    socket = host_socket_open(&(ec0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.1.10", 6002), RT_EOK);
+
+    /* the data is twice the send window, the acknowledged bytes are asked by "AT+QISEND=<id>,0" */
+    sends = modem_emu_count(&modem.emu, "AT+QISEND=");
+    TEST_ASSERT_EQ(host_socket_send(socket, data, sizeof(data)), sizeof(data));
+    TEST_ASSERT(modem_emu_count(&modem.emu, "AT+QISEND=") > sends + 8);
+
+    TEST_ASSERT_EQ(test_ec20_recv_all(socket, echo, sizeof(echo)), sizeof(echo));
+    TEST_ASSERT(rt_memcmp(data, echo, sizeof(echo)) == 0);
+
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+}
+
+static void test_ec20_remote_close(void)
+{
+    int socket = -1;
+    uint32_t closes = 0;
+
+    socket = host_socket_open(&(ec0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.1.10", 6003), RT_EOK);
+
+    modem_ec20_remote_close(&modem, test_ec20_id(socket));
+    TEST_ASSERT(test_ec20_wait_closed(socket));
+
+    /* the socket closed by remote is not closed by command again */
+    closes = modem_emu_count(&modem.emu, "AT+QICLOSE=");
+    at_closesocket(socket);
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+QICLOSE="), closes);
+}
+
+static void test_ec20_connect_fail(void)
+{
+    int socket = -1;
+    uint32_t opens = 0;
+
+    modem_ec20_connect_fail(&modem, "10.64.1.99");
+
+    /* the failed connect is closed and tried once more */
+    socket = host_socket_open(&(ec0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    opens = modem_emu_count(&modem.emu, "AT+QIOPEN=");
+    TEST_ASSERT(host_socket_connect(socket, "10.64.1.99", 6004) < 0);
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+QIOPEN="), opens + 2);
+    at_closesocket(socket);
+
+    /* the context is usable after the failed connect */
+    socket = host_socket_open(&(ec0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.1.10", 6004), RT_EOK);
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+}
+
+static void test_ec20_domain_resolve(void)
+{
+    char ip[16] = {0};
+    uint32_t resolves = 0;
+
+    modem_ec20_domain_add(&modem, "ec20.example", "93.184.216.35");
+
+    resolves = modem_emu_count(&modem.emu, "AT+QIDNSGIP=");
+    TEST_ASSERT_EQ(host_domain_resolve(&(ec0.device), "ec20.example", ip), RT_EOK);
+    TEST_ASSERT_STR_EQ(ip, "93.184.216.35");
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+QIDNSGIP="), resolves + 1);
+
+    /* answered by the DNS cache */
+    rt_memset(ip, 0x00, sizeof(ip));
+    TEST_ASSERT_EQ(host_domain_resolve(&(ec0.device), "ec20.example", ip), RT_EOK);
+    TEST_ASSERT_STR_EQ(ip, "93.184.216.35");
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+QIDNSGIP="), resolves + 1);
+}
+
+#ifdef AT_DEVICE_EC20_RECV_PULL
+static void test_ec20_pull_retry(void)
+{
+    int socket = -1;
+    uint32_t reads = 0;
+    char buf[16] = {0};
+
+    socket = host_socket_open(&(ec0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.1.10", 6005), RT_EOK);
+
+    /* the failed reads are retried, the data is not left in the module */
+    reads = modem_emu_count(&(modem.emu), "AT+QIRD=");
+    modem.read_fail = 2;
+
+    TEST_ASSERT_EQ(host_socket_send(socket, "retry", 5), 5);
+    TEST_ASSERT_EQ(test_ec20_recv_all(socket, buf, 5), 5);
+    TEST_ASSERT(rt_memcmp(buf, "retry", 5) == 0);
+    TEST_ASSERT_EQ(modem_emu_count(&(modem.emu), "AT+QIRD=") - reads, 3);
+
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+}
+#endif /* AT_DEVICE_EC20_RECV_PULL */
+
+static void test_ec20_link_report(void)
+{
+    /* the registration lost and regained is reported, nothing is polled */
+    modem_ec20_reg_set(&modem, 2);
+    TEST_ASSERT(test_ec20_wait_link(RT_FALSE));
+
+    modem_ec20_reg_set(&modem, 5);
+    TEST_ASSERT(test_ec20_wait_link(RT_TRUE));
+}
+
+static void test_ec20_pdp_deact(void)
+{
+    int i, socket = -1;
+    uint32_t acts = 0;
+    rt_tick_t start = 0;
+
+    socket = host_socket_open(&(ec0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.1.10", 6006), RT_EOK);
+
+    /* the link is down with the context whatever the registration, the first activation fails */
+    modem.act_fail = 1;
+    acts = modem_emu_count(&modem.emu, "AT+QIACT=");
+    start = rt_tick_get();
+    modem_ec20_pdp_deact(&modem);
+    TEST_ASSERT(test_ec20_wait_link(RT_FALSE));
+    TEST_ASSERT(ec0.device.link_lost);
+
+    /* the socket lost with the context is noticed closed */
+    TEST_ASSERT(test_ec20_wait_closed(socket));
+    at_closesocket(socket);
+
+    /* the link thread activates the context again, after 1 s and the doubled 2 s */
+    for (i = 0; i < 500 && (netdev_is_link_up(ec0.device.netdev) == RT_FALSE || ec0.device.link_lost); i++)
+    {
+        rt_thread_mdelay(10);
+    }
+    TEST_ASSERT(netdev_is_link_up(ec0.device.netdev));
+    TEST_ASSERT(ec0.device.link_lost == RT_FALSE);
+    TEST_ASSERT_EQ(modem.context, 1);
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+QIACT="), acts + 2);
+    TEST_ASSERT(rt_tick_get() - start >= rt_tick_from_millisecond(3000));
+
+    /* the sockets are usable on the context activated again */
+    socket = host_socket_open(&(ec0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.1.10", 6007), RT_EOK);
+    TEST_ASSERT_EQ(host_socket_send(socket, "again", 5), 5);
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+}
+
+#ifdef AT_DEVICE_USING_FAILOVER
+static int failover_socket = -1;
+static int failover_count = 0;
+static rt_uint64_t failover_time = 0;
+
+/* the reconnect callback of failover, it runs in the failover thread */
+static void test_ec20_failover_cb(struct at_device *standby, const char *ip, int32_t port,
+                                  enum at_socket_type type, void *user_data)
+{
+    int socket = -1;
+
+    socket = host_socket_open(standby, type);
+    if (socket >= 0 && host_socket_connect(socket, ip, port) == RT_EOK)
+    {
+        failover_socket = socket;
+    }
+    failover_time = host_time_us();
+    failover_count++;
+}
+
+static void test_ec20_failover(void)
+{
+    int i, closed = -1, socket = -1;
+    rt_uint64_t start = 0;
+    struct at_device *standby = RT_NULL;
+
+    standby = at_device_get_by_name(AT_DEVICE_NAMETYPE_DEVICE, "esp0");
+    TEST_ASSERT(standby != RT_NULL);
+    TEST_ASSERT(netdev_is_link_up(standby->netdev));
+    TEST_ASSERT_EQ(at_device_failover_set(EC20_SAMPLE_DEIVCE_NAME, "esp0"), RT_EOK);
+    at_device_failover_set_reconnect_cb(test_ec20_failover_cb, RT_NULL);
+    netdev_set_default(ec0.device.netdev);
+
+    /* the closed socket is not followed, its AT socket object is reused */
+    closed = host_socket_open(&(ec0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(closed >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(closed, "10.64.1.10", 6008), RT_EOK);
+    TEST_ASSERT_EQ(at_closesocket(closed), RT_EOK);
+
+    socket = host_socket_open(&(ec0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.1.10", 6009), RT_EOK);
+
+    /* the socket is reconnected on the standby device */
+    start = host_time_us();
+    modem_ec20_pdp_deact(&modem);
+    for (i = 0; i < 200 && failover_count == 0; i++)
+    {
+        rt_thread_mdelay(5);
+    }
+    TEST_ASSERT_EQ(failover_count, 1);
+    TEST_ASSERT(failover_socket >= 0);
+    TEST_ASSERT(netdev_default == standby->netdev);
+    TEST_ASSERT(test_ec20_wait_closed(socket));
+    printf("    failover from %s to %s reconnected in %d us\n", ec0.device.name, standby->name,
+           (int) (failover_time - start));
+    at_closesocket(socket);
+
+    /* the reconnected socket carries the data */
+    TEST_ASSERT_EQ(host_socket_send(failover_socket, "standby", 7), 7);
+
+    /* the context is activated again, the default network interface falls back */
+    for (i = 0; i < 300 && netdev_default != ec0.device.netdev; i++)
+    {
+        rt_thread_mdelay(10);
+    }
+    TEST_ASSERT(netdev_default == ec0.device.netdev);
+    printf("    fall back to %s in %d ms\n", ec0.device.name, (int) ((host_time_us() - start) / 1000));
+
+    TEST_ASSERT_EQ(at_closesocket(failover_socket), RT_EOK);
+}
+#endif /* AT_DEVICE_USING_FAILOVER */
+
+const struct test_case test_ec20_cases[] =
+{
+    {"ec20_register",          test_ec20_register},
+    {"ec20_tcp",               test_ec20_tcp},
+    {"ec20_udp",               test_ec20_udp},
+    {"ec20_send_window",       test_ec20_send_window},
+    {"ec20_remote_close",      test_ec20_remote_close},
+    {"ec20_connect_fail",      test_ec20_connect_fail},
+    {"ec20_domain_resolve",    test_ec20_domain_resolve},
+#ifdef AT_DEVICE_EC20_RECV_PULL
+    {"ec20_pull_retry",        test_ec20_pull_retry},
+#endif
+    {"ec20_link_report",       test_ec20_link_report},
+    {"ec20_pdp_deact",         test_ec20_pdp_deact},
+#ifdef AT_DEVICE_USING_FAILOVER
+    {"ec20_failover",          test_ec20_failover},
+#endif
+    {RT_NULL,                  RT_NULL},
+};
+
+#endif /* AT_DEVICE_USING_EC20 */
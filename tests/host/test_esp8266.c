@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <at_device_esp8266.h>
+
+#include "host.h"
+#include "test.h"
+#include "emu/modem_esp8266.h"
+
+/*
+ * The ESP8266 cases run the device class against the modem emulator, the
+ * received data is pushed by the module or read by the pull engine depending
+ * on AT_DEVICE_ESP8266_RECV_PASSIVE of the test variant. The passthrough
+ * variant runs the one connection of AT_DEVICE_ESP8266_PASSTHROUGH.
+ */
+
+#define ESP8266_SAMPLE_DEIVCE_NAME     "esp0"
+#define ESP8266_SAMPLE_CLIENT_NAME     "uart_e"
+
+static struct modem_esp8266 modem;
+
+static struct at_device_esp8266 esp0 =
+{
+    ESP8266_SAMPLE_DEIVCE_NAME,
+    ESP8266_SAMPLE_CLIENT_NAME,
+
+    "host_ssid",
+    "host_password",
+    512,
+};
+
+static int test_esp8266_recv_all(int socket, char *buf, size_t len)
+{
+    int result = 0;
+    size_t recved = 0;
+
+    while (recved < len)
+    {
+        result = host_socket_recv(socket, buf + recved, len - recved, 2 * RT_TICK_PER_SECOND);
+        if (result <= 0)
+        {
+            break;
+        }
+        recved += (size_t) result;
+    }
+
+    return (int) recved;
+}
+
+#ifndef AT_DEVICE_ESP8266_PASSTHROUGH
+/* the device socket number of the AT socket is the link ID of the module */
+static int test_esp8266_link(int socket)
+{
+    return (int) (rt_ubase_t) host_socket_get(socket)->user_data;
+}
+
+static int test_esp8266_wait_closed(int socket)
+{
+    int i;
+
+    for (i = 0; i < 100 && host_socket_closed(socket) == RT_FALSE; i++)
+    {
+        rt_thread_mdelay(10);
+    }
+
+    return host_socket_closed(socket);
+}
+#endif /* AT_DEVICE_ESP8266_PASSTHROUGH */
+
+static void test_esp8266_register(void)
+{
+    TEST_ASSERT_EQ(modem_esp8266_open(&modem, 0), 0);
+    TEST_ASSERT_EQ(host_serial_register(ESP8266_SAMPLE_CLIENT_NAME, modem.emu.slave), RT_EOK);
+
+    TEST_ASSERT_EQ(at_device_register(&(esp0.device), esp0.device_name, esp0.client_name,
+                                      AT_DEVICE_CLASS_ESP8266, (void *) &esp0), RT_EOK);
+    TEST_ASSERT(esp0.device.is_init);
+    TEST_ASSERT(esp0.device.netdev != RT_NULL);
+    TEST_ASSERT(netdev_is_link_up(esp0.device.netdev));
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+CWJAP="), 1);
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+CIPMUX="), 1);
+#ifdef AT_DEVICE_ESP8266_RECV_PASSIVE
+    TEST_ASSERT(modem.passive);
+#else
+    TEST_ASSERT(modem.passive == 0);
+#endif
+
+    /* the domain resolves go to this device from now on */
+    netdev_set_default(esp0.device.netdev);
+}
+
+#ifndef AT_DEVICE_ESP8266_PASSTHROUGH
+static void test_esp8266_tcp(void)
+{
+    int i, socket = -1, link = -1;
+    uint32_t sends = 0;
+    static char data[3000], echo[3000];
+
+    for (i = 0; i < (int) sizeof(data); i++)
+    {
+        data[i] = (char) (i * 7 + 1);
+    }
+
+    socket = host_socket_open(&(esp0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "192.168.1.10", 5000), RT_EOK);
+    link = test_esp8266_link(socket);
+    TEST_ASSERT(modem.connected[link]);
+
+    /* the data larger than one send command is split */
+    sends = modem_emu_count(&modem.emu, "AT+CIPSEND=");
+    TEST_ASSERT_EQ(host_socket_send(socket, data, sizeof(data)), sizeof(data));
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+CIPSEND="), sends + 2);
+
+    TEST_ASSERT_EQ(test_esp8266_recv_all(socket, echo, sizeof(echo)), sizeof(echo));
+    TEST_ASSERT(rt_memcmp(data, echo, sizeof(echo)) == 0);
+
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+    TEST_ASSERT_EQ(modem.connected[link], 0);
+}
+
+static void test_esp8266_udp(void)
+{
+    int socket = -1;
+    uint32_t closes = 0;
+    char echo[32] = {0};
+
+    socket = host_socket_open(&(esp0.device), AT_SOCKET_UDP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "192.168.1.20", 5001), RT_EOK);
+
+    TEST_ASSERT_EQ(host_socket_send(socket, "datagram", 8), 8);
+    TEST_ASSERT_EQ(test_esp8266_recv_all(socket, echo, 8), 8);
+    TEST_ASSERT(rt_memcmp(echo, "datagram", 8) == 0);
+
+    closes = modem_emu_count(&modem.emu, "AT+CIPCLOSE");
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+CIPCLOSE"), closes + 1);
+}
+
+static void test_esp8266_remote_close(void)
+{
+    int socket = -1;
+    uint32_t closes = 0;
+
+    socket = host_socket_open(&(esp0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "192.168.1.10", 5002), RT_EOK);
+
+    modem_esp8266_remote_close(&modem, test_esp8266_link(socket));
+    TEST_ASSERT(test_esp8266_wait_closed(socket));
+
+    /* the socket closed by remote is not closed by command again */
+    closes = modem_emu_count(&modem.emu, "AT+CIPCLOSE");
+    at_closesocket(socket);
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+CIPCLOSE"), closes);
+}
+
+static void test_esp8266_connect_fail(void)
+{
+    int socket = -1;
+
+    modem_esp8266_connect_fail(&modem, "192.168.1.99");
+
+    socket = host_socket_open(&(esp0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT(host_socket_connect(socket, "192.168.1.99", 5003) < 0);
+    at_closesocket(socket);
+
+    /* the link is usable after the failed connect */
+    socket = host_socket_open(&(esp0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "192.168.1.10", 5003), RT_EOK);
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+}
+
+#endif /* AT_DEVICE_ESP8266_PASSTHROUGH */
+
+static void test_esp8266_domain_resolve(void)
+{
+    char ip[16] = {0};
+    uint32_t resolves = 0;
+
+    modem_esp8266_domain_add(&modem, "esp.example", "93.184.216.34");
+
+    resolves = modem_emu_count(&modem.emu, "AT+CIPDOMAIN=");
+    TEST_ASSERT_EQ(host_domain_resolve(&(esp0.device), "esp.example", ip), RT_EOK);
+    TEST_ASSERT_STR_EQ(ip, "93.184.216.34");
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+CIPDOMAIN="), resolves + 1);
+
+    /* answered by the DNS cache */
+    rt_memset(ip, 0x00, sizeof(ip));
+    TEST_ASSERT_EQ(host_domain_resolve(&(esp0.device), "esp.example", ip), RT_EOK);
+    TEST_ASSERT_STR_EQ(ip, "93.184.216.34");
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+CIPDOMAIN="), resolves + 1);
+
+    TEST_ASSERT(host_domain_resolve(&(esp0.device), "nx.example", ip) < 0);
+}
+
+#ifdef AT_DEVICE_ESP8266_PASSTHROUGH
+static void test_esp8266_passthrough(void)
+{
+    int i, socket = -1;
+    uint32_t closes = 0;
+    static char data[3000], echo[3000];
+
+    for (i = 0; i < (int) sizeof(data); i++)
+    {
+        data[i] = (char) (i * 7 + 1);
+    }
+
+    socket = host_socket_open(&(esp0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "192.168.1.10", 5006), RT_EOK);
+    TEST_ASSERT(esp0.device.passthrough);
+
+    /* the prompt after the response is not taken as socket data */
+    TEST_ASSERT_EQ(host_socket_send(socket, data, sizeof(data)), sizeof(data));
+    TEST_ASSERT_EQ(test_esp8266_recv_all(socket, echo, sizeof(echo)), sizeof(echo));
+    TEST_ASSERT(rt_memcmp(data, echo, sizeof(echo)) == 0);
+    TEST_ASSERT_EQ(host_socket_recv(socket, echo, sizeof(echo), 100), -RT_ETIMEOUT);
+    TEST_ASSERT_EQ(modem.stream_bytes, sizeof(data));
+
+    closes = modem_emu_count(&modem.emu, "AT+CIPCLOSE");
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+    TEST_ASSERT(esp0.device.passthrough == RT_FALSE);
+    TEST_ASSERT_EQ(modem.mode, 0);
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+CIPCLOSE"), closes + 1);
+}
+#endif /* AT_DEVICE_ESP8266_PASSTHROUGH */
+
+#ifdef AT_DEVICE_USING_PULL
+static void test_esp8266_pull_notice(void)
+{
+    int first = -1, second = -1;
+    char buf[16] = {0};
+
+    first = host_socket_open(&(esp0.device), AT_SOCKET_TCP);
+    second = host_socket_open(&(esp0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(first >= 0 && second >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(first, "192.168.1.10", 5004), RT_EOK);
+    TEST_ASSERT_EQ(host_socket_connect(second, "192.168.1.10", 5005), RT_EOK);
+
+    /* the notice of the second socket arrives while the first one is read,
+     * it must not be lost when the read finishes */
+    modem.read_inject_data = "late";
+    modem.read_inject_socket = test_esp8266_link(second);
+
+    TEST_ASSERT_EQ(host_socket_send(first, "early", 5), 5);
+    TEST_ASSERT_EQ(test_esp8266_recv_all(first, buf, 5), 5);
+    TEST_ASSERT(rt_memcmp(buf, "early", 5) == 0);
+
+    rt_memset(buf, 0x00, sizeof(buf));
+    TEST_ASSERT_EQ(test_esp8266_recv_all(second, buf, 4), 4);
+    TEST_ASSERT(rt_memcmp(buf, "late", 4) == 0);
+
+    TEST_ASSERT_EQ(at_closesocket(first), RT_EOK);
+    TEST_ASSERT_EQ(at_closesocket(second), RT_EOK);
+}
+
+static void test_esp8266_pull_retry(void)
+{
+    int socket = -1;
+    uint32_t reads = 0;
+    char buf[16] = {0};
+
+    socket = host_socket_open(&(esp0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "192.168.1.10", 5006), RT_EOK);
+
+    /* the failed reads are retried, the data is not left in the module */
+    reads = modem_emu_count(&(modem.emu), "AT+CIPRECVDATA=");
+    modem.read_fail = 2;
+
+    TEST_ASSERT_EQ(host_socket_send(socket, "retry", 5), 5);
+    TEST_ASSERT_EQ(test_esp8266_recv_all(socket, buf, 5), 5);
+    TEST_ASSERT(rt_memcmp(buf, "retry", 5) == 0);
+    TEST_ASSERT_EQ(modem_emu_count(&(modem.emu), "AT+CIPRECVDATA=") - reads, 3);
+
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+}
+#endif /* AT_DEVICE_USING_PULL */
+
+const struct test_case test_esp8266_cases[] =
+{
+    {"esp8266_register",       test_esp8266_register},
+#ifdef AT_DEVICE_ESP8266_PASSTHROUGH
+    {"esp8266_passthrough",    test_esp8266_passthrough},
+#else
+    {"esp8266_tcp",            test_esp8266_tcp},
+    {"esp8266_udp",            test_esp8266_udp},
+    {"esp8266_remote_close",   test_esp8266_remote_close},
+    {"esp8266_connect_fail",   test_esp8266_connect_fail},
+#endif
+    {"esp8266_domain_resolve", test_esp8266_domain_resolve},
+#ifdef AT_DEVICE_USING_PULL
+    {"esp8266_pull_notice",    test_esp8266_pull_notice},
+    {"esp8266_pull_retry",     test_esp8266_pull_retry},
+#endif
+    {RT_NULL,                  RT_NULL},
+};
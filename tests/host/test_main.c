@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "test.h"
+
+static int test_failed = 0;
+
+void test_fail(const char *file, int line, const char *expr, long actual, long expect)
+{
+    test_failed = 1;
+
+    if (actual != expect)
+    {
+        printf("    %s:%d: check failed: %s (%ld, expected %ld)\n", file, line, expr, actual, expect);
+    }
+    else
+    {
+        printf("    %s:%d: check failed: %s\n", file, line, expr);
+    }
+}
+
+static int test_run(const struct test_case *cases, const char *filter, int *total)
+{
+    int failed = 0;
+
+    for (; cases->name; cases++)
+    {
+        if (filter && strstr(cases->name, filter) == NULL)
+        {
+            continue;
+        }
+
+        test_failed = 0;
+        cases->func();
+        printf("%s %s\n", test_failed ? "FAIL" : "PASS", cases->name);
+        fflush(stdout);
+
+        failed += test_failed;
+        (*total)++;
+    }
+
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    int failed = 0, total = 0;
+    const char *filter = argc > 1 ? argv[1] : NULL;
+
+#ifndef AT_DEVICE_USING_SINGLE_CLASS
+    /* the core cases run first, the ESP8266 device becomes the default network interface after them */
+    failed += test_run(test_core_cases, filter, &total);
+#else
+    /* the core cases register their fake class beside the ESP8266, a second class isn't taken */
+#endif
+    failed += test_run(test_esp8266_cases, filter, &total);
+    /* the cellular cases make their device the default network interface in turn */
+#ifdef AT_DEVICE_USING_EC20
+    failed += test_run(test_ec20_cases, filter, &total);
+#endif
+#ifdef AT_DEVICE_USING_BC28
+    failed += test_run(test_bc28_cases, filter, &total);
+#endif
+#ifdef AT_DEVICE_USING_ML307
+    failed += test_run(test_ml307_cases, filter, &total);
+#endif
+
+    printf("%d of %d test cases passed\n", total - failed, total);
+
+    return failed ? 1 : 0;
+}
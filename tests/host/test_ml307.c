@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+
+#ifdef AT_DEVICE_USING_ML307
+
+#include <at_device_ml307.h>
+
+#include "host.h"
+#include "test.h"
+#include "emu/modem_ml307.h"
+
+/*
+ * The ML307 cases run the China Mobile MIPOPEN/MIPSEND class against the
+ * modem emulator, the results of the commands come as URCs after the "OK"
+ * and the received data is inline in the "+MIPURC" line.
+ */
+
+#define ML307_SAMPLE_DEIVCE_NAME       "ml0"
+#define ML307_SAMPLE_CLIENT_NAME       "uart_m"
+
+static struct modem_ml307 modem;
+
+/* the receive URC line holds a TCP segment */
+static struct at_device_ml307 ml0 =
+{
+    ML307_SAMPLE_DEIVCE_NAME,
+    ML307_SAMPLE_CLIENT_NAME,
+
+    -1,
+    -1,
+    MODEM_ML307_SEGMENT_SIZE + 64,
+};
+
+static int test_ml307_recv_all(int socket, char *buf, size_t len)
+{
+    int result = 0;
+    size_t recved = 0;
+
+    while (recved < len)
+    {
+        result = host_socket_recv(socket, buf + recved, len - recved, 2 * RT_TICK_PER_SECOND);
+        if (result <= 0)
+        {
+            break;
+        }
+        recved += (size_t) result;
+    }
+
+    return (int) recved;
+}
+
+/* the device socket number of the AT socket is the connection ID of the module */
+static int test_ml307_id(int socket)
+{
+    return (int) (rt_ubase_t) host_socket_get(socket)->user_data;
+}
+
+static void test_ml307_register(void)
+{
+    TEST_ASSERT_EQ(modem_ml307_open(&modem, 0), 0);
+    TEST_ASSERT_EQ(host_serial_register(ML307_SAMPLE_CLIENT_NAME, modem.emu.slave), RT_EOK);
+
+    TEST_ASSERT_EQ(at_device_register(&(ml0.device), ml0.device_name, ml0.client_name,
+                                      AT_DEVICE_CLASS_ML307, (void *) &ml0), RT_EOK);
+    TEST_ASSERT(ml0.device.is_init);
+    TEST_ASSERT(ml0.device.netdev != RT_NULL);
+    TEST_ASSERT(netdev_is_link_up(ml0.device.netdev));
+
+    /* the domain resolves go to this device from now on */
+    netdev_set_default(ml0.device.netdev);
+}
+
+static void test_ml307_tcp(void)
+{
+    int i, socket = -1, id = -1;
+    uint32_t sends = 0;
+    static char data[5000], echo[5000];
+
+    for (i = 0; i < (int) sizeof(data); i++)
+    {
+        data[i] = (char) ('a' + i % 26);
+    }
+
+    socket = host_socket_open(&(ml0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.1.10", 7000), RT_EOK);
+    id = test_ml307_id(socket);
+    TEST_ASSERT(modem.connected[id]);
+
+    /* the data larger than one send command is split, the whole size is returned */
+    sends = modem_emu_count(&modem.emu, "AT+MIPSEND=");
+    TEST_ASSERT_EQ(host_socket_send(socket, data, sizeof(data)), sizeof(data));
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+MIPSEND="), sends + 2);
+    TEST_ASSERT_EQ(modem.sent[id], sizeof(data));
+
+    TEST_ASSERT_EQ(test_ml307_recv_all(socket, echo, sizeof(echo)), sizeof(echo));
+    TEST_ASSERT(rt_memcmp(data, echo, sizeof(echo)) == 0);
+
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+    TEST_ASSERT_EQ(modem.connected[id], 0);
+}
+
+static void test_ml307_udp(void)
+{
+    int socket = -1;
+    char echo[32] = {0};
+
+    socket = host_socket_open(&(ml0.device), AT_SOCKET_UDP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.1.20", 7001), RT_EOK);
+    TEST_ASSERT(modem.udp[test_ml307_id(socket)]);
+
+    TEST_ASSERT_EQ(host_socket_send(socket, "datagram", 8), 8);
+    TEST_ASSERT_EQ(test_ml307_recv_all(socket, echo, 8), 8);
+    TEST_ASSERT(rt_memcmp(echo, "datagram", 8) == 0);
+
+    TEST_ASSERT_EQ(at_closesocket(socket), RT_EOK);
+}
+
+static void test_ml307_close(void)
+{
+    int first = -1, second = -1;
+
+    first = host_socket_open(&(ml0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(first >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(first, "10.64.1.10", 7002), RT_EOK);
+    second = host_socket_open(&(ml0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(second >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(second, "10.64.1.10", 7003), RT_EOK);
+    TEST_ASSERT(test_ml307_id(second) != 0);
+
+    /* the "+MIPCLOSE" result of a connection other than 0 ends its close */
+    TEST_ASSERT_EQ(at_closesocket(second), RT_EOK);
+    TEST_ASSERT_EQ(at_closesocket(first), RT_EOK);
+}
+
+static void test_ml307_remote_close(void)
+{
+    int i, socket = -1;
+    uint32_t closes = 0;
+
+    socket = host_socket_open(&(ml0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    TEST_ASSERT_EQ(host_socket_connect(socket, "10.64.1.10", 7004), RT_EOK);
+
+    modem_ml307_remote_close(&modem, test_ml307_id(socket));
+    for (i = 0; i < 100 && host_socket_closed(socket) == RT_FALSE; i++)
+    {
+        rt_thread_mdelay(10);
+    }
+    TEST_ASSERT(host_socket_closed(socket));
+
+    /* the socket closed by remote is not closed by command again */
+    closes = modem_emu_count(&modem.emu, "AT+MIPCLOSE=");
+    at_closesocket(socket);
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+MIPCLOSE="), closes);
+}
+
+static void test_ml307_connect_fail(void)
+{
+    int socket = -1;
+    uint32_t opens = 0;
+
+    modem_ml307_connect_fail(&modem, "10.64.1.99");
+
+    /* the failed connect is closed and tried once more */
+    socket = host_socket_open(&(ml0.device), AT_SOCKET_TCP);
+    TEST_ASSERT(socket >= 0);
+    opens = modem_emu_count(&modem.emu, "AT+MIPOPEN=");
+    TEST_ASSERT(host_socket_connect(socket, "10.64.1.99", 7005) < 0);
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+MIPOPEN="), opens + 2);
+    at_closesocket(socket);
+}
+
+static void test_ml307_domain_resolve(void)
+{
+    char ip[16] = {0};
+    uint32_t resolves = 0;
+
+    modem_ml307_domain_add(&modem, "ml307.example", "93.184.216.36");
+
+    resolves = modem_emu_count(&modem.emu, "AT+MDNSGIP=");
+    TEST_ASSERT_EQ(host_domain_resolve(&(ml0.device), "ml307.example", ip), RT_EOK);
+    TEST_ASSERT_STR_EQ(ip, "93.184.216.36");
+    TEST_ASSERT_EQ(modem_emu_count(&modem.emu, "AT+MDNSGIP="), resolves + 1);
+}
+
+const struct test_case test_ml307_cases[] =
+{
+    {"ml307_register",         test_ml307_register},
+    {"ml307_tcp",              test_ml307_tcp},
+    {"ml307_udp",              test_ml307_udp},
+    {"ml307_close",            test_ml307_close},
+    {"ml307_remote_close",     test_ml307_remote_close},
+    {"ml307_connect_fail",     test_ml307_connect_fail},
+    {"ml307_domain_resolve",   test_ml307_domain_resolve},
+    {RT_NULL,                  RT_NULL},
+};
+
+#endif /* AT_DEVICE_USING_ML307 */